@@ -0,0 +1,68 @@
+#ifndef SRC_S21_CONTAINERS_1_SRC_BENCH_BENCH_ENTRY_H_
+#define SRC_S21_CONTAINERS_1_SRC_BENCH_BENCH_ENTRY_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+namespace bench {
+
+/// Время выполнения fn в миллисекундах
+template <typename Fn>
+double Measure(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+/// Печать строки результата: имя, время и пропускная способность
+inline void Report(const char *name, double ms, std::size_t ops) {
+  std::printf("%-48s %10.2f ms %12.2f Mops/s\n", name, ms,
+              ms > 0 ? static_cast<double>(ops) / ms / 1000.0 : 0.0);
+}
+
+/// Размер задачи: первый аргумент командной строки или значение по умолчанию
+inline std::size_t ProblemSize(int argc, char **argv, std::size_t def) {
+  return argc > 1 ? std::strtoull(argv[1], nullptr, 10) : def;
+}
+
+/// Перемешанная последовательность 0..n-1
+inline std::vector<int> ShuffledKeys(std::size_t n, unsigned seed = 42) {
+  std::vector<int> keys(n);
+  for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<int>(i);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(seed));
+  return keys;
+}
+
+/// Байт кучи, занятых программой: занятые блоки арены и крупные блоки,
+/// выделенные через mmap (в них попадают блоки пула узлов). Без glibc 0
+inline std::size_t HeapInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+  struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+#else
+  return 0;
+#endif
+}
+
+/// Не дает компилятору выбросить вычисленное значение
+template <typename T>
+inline void DoNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}  // namespace bench
+
+#endif  // SRC_S21_CONTAINERS_1_SRC_BENCH_BENCH_ENTRY_H_
@@ -0,0 +1,56 @@
+#include "bench_entry.h"
+
+/// Сумма значений по окну ключей (метки времени): aggregate_map за
+/// O(log n) против обхода окна в s21::map. Ширина окна - от 0.1% до 10%
+/// ключей
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 1000000);
+  std::vector<int> keys = bench::ShuffledKeys(n);
+  std::printf("window sum, n = %zu\n", n);
+
+  s21::aggregate_map<int, long> aggregated;
+  s21::map<int, long> plain;
+  double ms = bench::Measure([&] {
+    for (int key : keys) aggregated.insert(key, key % 1000);
+  });
+  bench::Report("aggregate_map insert", ms, n);
+  ms = bench::Measure([&] {
+    for (int key : keys) plain.insert(key, key % 1000);
+  });
+  bench::Report("map insert", ms, n);
+
+  /// обход окна на порядки медленнее, поэтому время на запрос
+  auto report = [](const char *name, std::size_t per_mille, double time,
+                   std::size_t queries) {
+    char label[64];
+    std::snprintf(label, sizeof(label), "%s, window %zu%%o", name, per_mille);
+    std::printf("%-48s %10.2f us/query\n", label,
+                time * 1000.0 / static_cast<double>(queries));
+  };
+  for (std::size_t per_mille : {1, 10, 100}) {
+    int width = static_cast<int>(n * per_mille / 1000);
+    std::size_t walks = 2000 / per_mille;
+    long total = 0;
+    ms = bench::Measure([&] {
+      for (std::size_t q = 0; q < walks; ++q) {
+        int lo = keys[q];
+        for (auto it = plain.lower_bound(lo);
+             it != plain.end() && (*it).first < lo + width; ++it) {
+          total += (*it).second;
+        }
+      }
+    });
+    bench::DoNotOptimize(total);
+    report("map window walk", per_mille, ms, walks);
+    total = 0;
+    const std::size_t queries = 100000;
+    ms = bench::Measure([&] {
+      for (std::size_t q = 0; q < queries; ++q) {
+        total += aggregated.aggregate(keys[q], keys[q] + width);
+      }
+    });
+    bench::DoNotOptimize(total);
+    report("aggregate_map::aggregate", per_mille, ms, queries);
+  }
+  return 0;
+}
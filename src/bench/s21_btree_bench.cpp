@@ -0,0 +1,89 @@
+#include <map>
+#include <set>
+
+#include "bench_entry.h"
+
+namespace {
+
+/// то же сравнение, что std::less<int>, но без поиска через btree_simd
+struct PlainLess {
+  bool operator()(int a, int b) const { return a < b; }
+};
+
+/// вставка, поиск, обход и память на элемент одного контейнера
+template <typename Set>
+void Run(const char *name, const std::vector<int> &keys,
+         const std::vector<int> &queries) {
+  std::printf("%s\n", name);
+  std::size_t heap = bench::HeapInUse();
+  Set *set = new Set;
+  bench::Report("  insert, shuffled keys", bench::Measure([&] {
+                  for (int key : keys) set->insert(key);
+                }),
+                keys.size());
+  std::size_t bytes = bench::HeapInUse() - heap;
+  std::size_t found = 0;
+  bench::Report("  find, hits and misses", bench::Measure([&] {
+                  for (int key : queries) found += set->find(key) != set->end();
+                }),
+                queries.size());
+  bench::DoNotOptimize(found);
+  long long total = 0;
+  bench::Report("  in-order traversal", bench::Measure([&] {
+                  for (int key : *set) total += key;
+                }),
+                keys.size());
+  bench::DoNotOptimize(total);
+  if (bytes) {
+    std::printf("  %-46s %10.2f bytes\n", "heap per element",
+                static_cast<double>(bytes) / keys.size());
+  }
+  delete set;
+}
+
+}  // namespace
+
+/// B-дерево против Avl дерева и std::set: вставка, поиск, обход и память
+/// на элемент для множества целых чисел
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 1000000);
+  std::vector<int> keys = bench::ShuffledKeys(n);
+  /// половина запросов - отсутствующие ключи
+  std::vector<int> queries = bench::ShuffledKeys(2 * n, 7);
+  std::printf("btree, n = %zu, %zu queries\n", n, queries.size());
+  Run<s21::btree_set<int>>("s21::btree_set<int> (SIMD node search)", keys,
+                           queries);
+  Run<s21::btree_set<int, PlainLess>>(
+      "s21::btree_set<int> (binary node search)", keys, queries);
+  Run<s21::set<int>>("s21::set<int> (AVL)", keys, queries);
+  Run<std::set<int>>("std::set<int>", keys, queries);
+
+  std::printf("map<int, int> lookups\n");
+  s21::btree_map<int, int> btree;
+  s21::map<int, int> avl;
+  std::map<int, int> orig;
+  for (int key : keys) {
+    btree.insert(key, key);
+    avl.insert(key, key);
+    orig.emplace(key, key);
+  }
+  auto lookup = [&](const char *name, auto &map) {
+    std::size_t found = 0;
+    bench::Report(name, bench::Measure([&] {
+                    for (int key : queries) found += map.contains(key);
+                  }),
+                  queries.size());
+    bench::DoNotOptimize(found);
+  };
+  lookup("  s21::btree_map::contains", btree);
+  lookup("  s21::map::contains", avl);
+  std::size_t found = 0;
+  bench::Report("  std::map::count", bench::Measure([&] {
+                  for (int key : queries) found += orig.count(key);
+                }),
+                queries.size());
+  bench::DoNotOptimize(found);
+  std::printf("  %-46s %10.2f bytes\n", "s21::btree_map memory per element",
+              static_cast<double>(btree.memory_usage()) / n);
+  return 0;
+}
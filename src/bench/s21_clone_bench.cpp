@@ -0,0 +1,59 @@
+#include <map>
+
+#include "bench_entry.h"
+
+/// Снимок большого дерева: копия в один поток и параллельная, обход копии
+/// в сравнении с копией std::map
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 2000000);
+  std::vector<int> keys = bench::ShuffledKeys(n);
+  using Tree = s21::AvlTree<int, std::pair<const int, int>,
+                            s21::SelectFirst<std::pair<const int, int>>,
+                            std::less<int>, true>;
+  Tree tree;
+  std::map<int, int> orig;
+  for (int key : keys) {
+    tree.Insert(std::pair<const int, int>(key, key));
+    orig.emplace(key, key);
+  }
+  s21::ThreadPool sequential(0);
+  s21::ThreadPool &parallel = s21::ThreadPool::Instance();
+  std::printf("clone, n = %zu, %zu threads\n", n, parallel.Concurrency());
+
+  auto sum = [](auto &container) {
+    long long total = 0;
+    for (const auto &entry : container) total += entry.second;
+    return total;
+  };
+  {
+    Tree copy;
+    bench::Report("AvlTree Clone, 1 thread", bench::Measure([&] {
+                    copy = tree.Clone(sequential);
+                  }),
+                  n);
+    long long total = 0;
+    bench::Report("  in-order traversal of the clone",
+                  bench::Measure([&] { total = sum(copy); }), n);
+    bench::DoNotOptimize(total);
+  }
+  {
+    Tree copy;
+    bench::Report("AvlTree Clone, thread pool", bench::Measure([&] {
+                    copy = tree.Clone(parallel);
+                  }),
+                  n);
+    bench::DoNotOptimize(copy.size());
+  }
+  long long total = 0;
+  bench::Report("  traversal of the insertion-built tree",
+                bench::Measure([&] { total = sum(tree); }), n);
+  bench::DoNotOptimize(total);
+  {
+    std::map<int, int> copy;
+    bench::Report("std::map copy", bench::Measure([&] { copy = orig; }), n);
+    bench::Report("  traversal of the std::map copy",
+                  bench::Measure([&] { total = sum(copy); }), n);
+    bench::DoNotOptimize(total);
+  }
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include <cstring>
+#include <set>
+
+#include "bench_entry.h"
+
+namespace {
+
+/// вставка, поиск и память на элемент одного множества
+template <typename Set>
+void Run(const char *name, const std::vector<int> &keys,
+         const std::vector<int> &queries) {
+  std::printf("%s\n", name);
+  std::size_t heap = bench::HeapInUse();
+  Set *set = new Set;
+  bench::Report("  insert, shuffled keys", bench::Measure([&] {
+                  for (int key : keys) set->insert(key);
+                }),
+                keys.size());
+  std::size_t bytes = bench::HeapInUse() - heap;
+  std::size_t found = 0;
+  bench::Report("  find, hits and misses", bench::Measure([&] {
+                  for (int key : queries) found += set->count(key);
+                }),
+                queries.size());
+  bench::DoNotOptimize(found);
+  long long total = 0;
+  bench::Report("  in-order traversal", bench::Measure([&] {
+                  for (int key : *set) total += key;
+                }),
+                keys.size());
+  bench::DoNotOptimize(total);
+  if (bytes) {
+    std::printf("  %-46s %10.2f bytes\n", "heap per element",
+                static_cast<double>(bytes) / keys.size());
+  }
+  if constexpr (std::is_same<Set, s21::compact_set<int>>::value) {
+    std::printf("  %-46s %10.2f bytes\n", "memory_usage() per element",
+                static_cast<double>(set->memory_usage()) / keys.size());
+  }
+  delete set;
+}
+
+}  // namespace
+
+/// Компактное Avl дерево на 32-битных индексах против s21::set и std::set:
+/// память на элемент, вставка, поиск и обход множества целых чисел. Второй
+/// аргумент "compact" оставляет только компактное множество, чтобы
+/// поместить 100M ключей в память
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 10000000);
+  bool compact_only = argc > 2 && std::strcmp(argv[2], "compact") == 0;
+  std::vector<int> keys = bench::ShuffledKeys(n);
+  /// половина запросов - отсутствующие ключи
+  std::vector<int> queries = bench::ShuffledKeys(2 * n, 7);
+  std::printf("compact avl tree, n = %zu, %zu queries\n", n, queries.size());
+  Run<s21::compact_set<int>>("s21::compact_set<int>", keys, queries);
+  if (compact_only) return 0;
+  Run<s21::set<int>>("s21::set<int> (AVL)", keys, queries);
+  Run<std::set<int>>("std::set<int>", keys, queries);
+  return 0;
+}
@@ -0,0 +1,64 @@
+#include <mutex>
+#include <thread>
+
+#include "bench_entry.h"
+
+/// Пропускная способность словаря при росте числа потоков: s21::map под
+/// одним общим мьютексом против concurrent_map с частями под мьютексами
+/// читателей-писателей. Нагрузка - 90% поисков и 10% insert_or_assign по
+/// случайным ключам
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 1000000);
+  std::vector<int> keys = bench::ShuffledKeys(n);
+  const std::size_t ops_per_thread = 200000;
+  std::printf("concurrent map, n = %zu, %zu ops per thread, %u cpus\n", n,
+              ops_per_thread, std::thread::hardware_concurrency());
+
+  s21::map<int, int> locked;
+  std::mutex locked_mutex;
+  s21::concurrent_map<int, int, 64> sharded;
+  for (int key : keys) {
+    locked.insert(key, key);
+    sharded.insert(key, key);
+  }
+
+  /// каждый поток проходит свой отрезок перемешанных ключей
+  auto run = [&](const char *name, std::size_t threads, auto op) {
+    double ms = bench::Measure([&] {
+      std::vector<std::thread> workers;
+      for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+          std::size_t found = 0;
+          for (std::size_t i = 0; i < ops_per_thread; ++i) {
+            int key = keys[(t * ops_per_thread + i * 7919) % n];
+            found += op(key, i % 10 == 0);
+          }
+          bench::DoNotOptimize(found);
+        });
+      }
+      for (std::thread &worker : workers) worker.join();
+    });
+    char label[64];
+    std::snprintf(label, sizeof(label), "%s, %zu threads", name, threads);
+    bench::Report(label, ms, threads * ops_per_thread);
+  };
+  for (std::size_t threads : {1, 2, 4, 8, 16}) {
+    run("s21::map + std::mutex", threads, [&](int key, bool write) {
+      std::lock_guard<std::mutex> lock(locked_mutex);
+      if (write) return locked.insert_or_assign(key, key).second;
+      return locked.contains(key);
+    });
+    run("s21::concurrent_map<64 shards>", threads, [&](int key, bool write) {
+      if (write) return sharded.insert_or_assign(key, key);
+      return sharded.contains(key);
+    });
+  }
+
+  std::size_t visited = 0;
+  double ms = bench::Measure([&] {
+    sharded.for_each([&](const std::pair<const int, int> &) { ++visited; });
+  });
+  bench::DoNotOptimize(visited);
+  bench::Report("concurrent_map::for_each (64-way merge)", ms, visited);
+  return 0;
+}
@@ -0,0 +1,59 @@
+#include <algorithm>
+
+#include "bench_entry.h"
+
+/// Поиск в неизменяемом индексе Эйтцингера (set::freeze, map::freeze) в
+/// сравнении с живым Avl деревом и двоичным поиском в отсортированном
+/// массиве, память на элемент
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 1000000);
+  std::vector<int> keys = bench::ShuffledKeys(n);
+  /// половина запросов - отсутствующие ключи
+  std::vector<int> queries = bench::ShuffledKeys(2 * n, 7);
+  std::printf("frozen lookups, n = %zu, %zu queries\n", n, queries.size());
+
+  std::size_t heap = bench::HeapInUse();
+  s21::set<int> *live = new s21::set<int>(keys.begin(), keys.end());
+  std::size_t live_bytes = bench::HeapInUse() - heap;
+  s21::frozen_set<int> frozen;
+  bench::Report("set::freeze", bench::Measure([&] { frozen = live->freeze(); }),
+                n);
+  std::vector<int> sorted(keys);
+  std::sort(sorted.begin(), sorted.end());
+
+  auto run = [&](const char *name, auto lookup) {
+    std::size_t found = 0;
+    double ms = bench::Measure([&] {
+      for (int key : queries) found += lookup(key);
+    });
+    bench::DoNotOptimize(found);
+    bench::Report(name, ms, queries.size());
+  };
+  run("s21::set::contains (AvlTree)",
+      [&](int key) { return live->contains(key); });
+  run("s21::frozen_set::contains",
+      [&](int key) { return frozen.contains(key); });
+  run("s21::set::lower_bound (AvlTree)",
+      [&](int key) { return live->lower_bound(key) != live->end(); });
+  run("s21::frozen_set::lower_bound",
+      [&](int key) { return frozen.lower_bound(key) != frozen.end(); });
+  run("std::binary_search on a sorted vector", [&](int key) {
+    return std::binary_search(sorted.begin(), sorted.end(), key);
+  });
+  std::printf("%-48s %10.2f bytes\n", "s21::set heap per element",
+              static_cast<double>(live_bytes) / n);
+  std::printf("%-48s %10.2f bytes\n", "s21::frozen_set memory per element",
+              static_cast<double>(frozen.memory_usage()) / n);
+  delete live;
+
+  s21::map<int, int> table;
+  for (int key : keys) table.insert(key, key);
+  s21::frozen_map<int, int> frozen_table = table.freeze();
+  run("s21::map::contains (AvlTree)",
+      [&](int key) { return table.contains(key); });
+  run("s21::frozen_map::contains",
+      [&](int key) { return frozen_table.contains(key); });
+  std::printf("%-48s %10.2f bytes\n", "s21::frozen_map memory per element",
+              static_cast<double>(frozen_table.memory_usage()) / n);
+  return 0;
+}
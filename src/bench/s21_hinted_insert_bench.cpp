@@ -0,0 +1,61 @@
+#include <map>
+#include <set>
+
+#include "bench_entry.h"
+
+/// Вставка возрастающего и почти возрастающего потока ключей (метки
+/// времени) в s21::set / s21::map и std::set с подсказкой end() и без нее.
+/// Подсказка экономит сравнения ключей при спуске, но не подъем до корня:
+/// размеры поддеревьев обновляются при каждой вставке, так что s21 остается
+/// O(log n) на элемент, а не амортизированное O(1), как у std::set
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 1000000);
+  std::vector<int> sorted(n);
+  for (std::size_t i = 0; i < n; ++i) sorted[i] = static_cast<int>(i);
+  /// почти упорядоченный поток: каждый 16-й ключ меняется местами с соседом
+  std::vector<int> nearly = sorted;
+  for (std::size_t i = 16; i < n; i += 16) std::swap(nearly[i - 1], nearly[i]);
+
+  std::printf("append-heavy insert, n = %zu\n", n);
+  auto run = [&](const char *name, const std::vector<int> &keys, auto insert) {
+    double ms = bench::Measure([&] { insert(keys); });
+    bench::Report(name, ms, keys.size());
+  };
+  for (const auto &[label, keys] :
+       {std::make_pair("sorted", &sorted), std::make_pair("nearly", &nearly)}) {
+    std::printf("%s keys\n", label);
+    run("s21::set insert(key)", *keys, [](const std::vector<int> &v) {
+      s21::set<int> set;
+      for (int key : v) set.insert(key);
+      bench::DoNotOptimize(set.size());
+    });
+    run("s21::set insert(end(), key)", *keys, [](const std::vector<int> &v) {
+      s21::set<int> set;
+      for (int key : v) set.insert(set.end(), key);
+      bench::DoNotOptimize(set.size());
+    });
+    run("std::set insert(key)", *keys, [](const std::vector<int> &v) {
+      std::set<int> set;
+      for (int key : v) set.insert(key);
+      bench::DoNotOptimize(set.size());
+    });
+    run("std::set insert(end(), key)", *keys, [](const std::vector<int> &v) {
+      std::set<int> set;
+      for (int key : v) set.insert(set.end(), key);
+      bench::DoNotOptimize(set.size());
+    });
+    run("s21::map emplace_hint(end(), key, value)", *keys,
+        [](const std::vector<int> &v) {
+          s21::map<int, int> map;
+          for (int key : v) map.emplace_hint(map.end(), key, key);
+          bench::DoNotOptimize(map.begin());
+        });
+    run("std::map emplace_hint(end(), key, value)", *keys,
+        [](const std::vector<int> &v) {
+          std::map<int, int> map;
+          for (int key : v) map.emplace_hint(map.end(), key, key);
+          bench::DoNotOptimize(map.size());
+        });
+  }
+  return 0;
+}
@@ -0,0 +1,59 @@
+#include "bench_entry.h"
+
+/// Запросы пересечения с отрезками: interval_map (наибольший правый конец
+/// в узлах) против линейного просмотра multiset отрезков. Отрезки длиной до
+/// 1000 разбросаны так, что точку покрывают в среднем 5 отрезков. Размер
+/// задачи задается аргументом, например 1000000 и 10000000
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 1000000);
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> start(0, static_cast<int>(n * 100));
+  std::uniform_int_distribution<int> length(0, 1000);
+  std::printf("interval queries, n = %zu intervals\n", n);
+
+  s21::interval_map<int, int> intervals;
+  s21::multiset<std::pair<std::pair<int, int>, int>> scanned;
+  double ms = bench::Measure([&] {
+    for (std::size_t i = 0; i < n; ++i) {
+      int lo = start(gen);
+      intervals.insert(lo, lo + length(gen), static_cast<int>(i));
+    }
+  });
+  bench::Report("interval_map insert", ms, n);
+  for (auto it = intervals.begin(); it != intervals.end(); ++it) {
+    scanned.insert(*it);
+  }
+
+  auto run = [&](const char *name, std::size_t queries, int width,
+                 auto query) {
+    std::size_t found = 0;
+    double time = bench::Measure([&] {
+      for (std::size_t q = 0; q < queries; ++q) {
+        int lo = start(gen);
+        found += query(lo, lo + width);
+      }
+    });
+    bench::DoNotOptimize(found);
+    /// линейный просмотр медленнее на порядки, поэтому время на запрос
+    std::printf("%-48s %10.2f us/query %8.1f found/query\n", name,
+                time * 1000.0 / static_cast<double>(queries),
+                static_cast<double>(found) / static_cast<double>(queries));
+  };
+  auto scan = [&](int lo, int hi) {
+    std::size_t found = 0;
+    for (auto it = scanned.begin(); it != scanned.end(); ++it) {
+      found += (*it).first.first <= hi && (*it).first.second >= lo;
+    }
+    return found;
+  };
+  run("stab, linear scan", 20, 0, scan);
+  run("stab, interval_map", 200000, 0,
+      [&](int lo, int hi) { return intervals.overlapping(lo, hi).size(); });
+  run("overlap 10000 wide, linear scan", 20, 10000, scan);
+  run("overlap 10000 wide, interval_map", 200000, 10000,
+      [&](int lo, int hi) { return intervals.overlapping(lo, hi).size(); });
+  run("overlaps (any), interval_map", 200000, 0, [&](int lo, int hi) {
+    return static_cast<std::size_t>(intervals.overlaps(lo, hi));
+  });
+  return 0;
+}
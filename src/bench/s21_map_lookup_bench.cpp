@@ -0,0 +1,76 @@
+#include <cstdint>
+
+#include "bench_entry.h"
+
+namespace {
+
+/// значение в 1 КБ: T() обнуляет весь массив
+struct Padded {
+  char bytes[1024];
+};
+
+/// небольшое значение с дорогим T(): выделение и заполнение 1 КБ в куче
+struct Heavy {
+  std::vector<int> data = std::vector<int>(256, 1);
+};
+
+/// поиск в словаре с одним типом значения: время не должно зависеть от T
+template <typename T>
+void Run(const char *name, const std::vector<int> &keys,
+         const std::vector<int> &queries) {
+  std::printf("s21::map<int, %s>, sizeof(T) = %zu\n", name, sizeof(T));
+  s21::map<int, T> map;
+  for (int key : keys) map.insert(key, T());
+  std::size_t n = keys.size();
+  std::size_t found = 0;
+  bench::Report("  find, hits and misses", bench::Measure([&] {
+                  for (int key : queries) found += map.find(key) != map.end();
+                }),
+                queries.size());
+  bench::Report("  contains, hits and misses", bench::Measure([&] {
+                  for (int key : queries) found += map.contains(key);
+                }),
+                queries.size());
+  bench::Report("  at, hits", bench::Measure([&] {
+                  for (int key : queries) {
+                    found += reinterpret_cast<std::uintptr_t>(
+                        &map.at(static_cast<int>(key % n)));
+                  }
+                }),
+                queries.size());
+  /// operator[] при существующем ключе: один спуск, T() не создается
+  bench::Report("  operator[], hits", bench::Measure([&] {
+                  for (int key : queries) {
+                    found += reinterpret_cast<std::uintptr_t>(
+                        &map[static_cast<int>(key % n)]);
+                  }
+                }),
+                queries.size());
+  bench::DoNotOptimize(found);
+}
+
+}  // namespace
+
+/// Поиск в s21::map по ключу для значений разного размера и разной цены
+/// конструктора по умолчанию. find, contains и at спускаются только по
+/// ключу и не создают временных значений, поэтому их время одинаково для
+/// всех трех типов значений. operator[] создает T() только для нового
+/// ключа и на попаданиях не зависит от типа значения. Словарь по
+/// умолчанию небольшой, чтобы узлы всех трех словарей помещались в кэш: на
+/// больших n узлы по 1 КБ дают промахи кэша, не связанные с созданием
+/// значений
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 1000);
+  std::vector<int> keys = bench::ShuffledKeys(n);
+  /// половина ключей запросов отсутствует в словаре
+  std::vector<int> shuffled = bench::ShuffledKeys(2 * n, 7);
+  std::vector<int> queries(2000000);
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    queries[i] = shuffled[i % shuffled.size()];
+  }
+  std::printf("map lookups, n = %zu, %zu queries\n", n, queries.size());
+  Run<int>("int", keys, queries);
+  Run<Padded>("Padded", keys, queries);
+  Run<Heavy>("Heavy", keys, queries);
+  return 0;
+}
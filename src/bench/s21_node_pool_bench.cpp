@@ -0,0 +1,34 @@
+#include "bench_entry.h"
+
+/// Пропускная способность вставки и удаления в AvlTree. Собирается дважды:
+/// с пулом узлов и с S21_AVLTREE_HEAP_NODES (отдельный new на каждый узел)
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 1000000);
+  std::vector<int> keys = bench::ShuffledKeys(n);
+#ifdef S21_AVLTREE_HEAP_NODES
+  std::printf("AvlTree nodes: operator new per node, n = %zu\n", n);
+#else
+  std::printf("AvlTree nodes: slab pool, n = %zu\n", n);
+#endif
+  s21::multiset<int> set;
+  bench::Report("insert", bench::Measure([&] {
+                  for (int key : keys) set.insert(key);
+                }),
+                n);
+  bench::Report("erase", bench::Measure([&] {
+                  for (int key : keys) set.erase(set.find(key));
+                }),
+                n);
+  bench::Report("insert + clear", bench::Measure([&] {
+                  for (int key : keys) set.insert(key);
+                  set.clear();
+                }),
+                n);
+  s21::multiset<std::string> strings;
+  bench::Report("insert string + destroy", bench::Measure([&] {
+                  for (int key : keys) strings.insert(std::to_string(key));
+                  strings.clear();
+                }),
+                n);
+  return 0;
+}
@@ -0,0 +1,73 @@
+#include "bench_entry.h"
+
+/// Моментальные снимки словаря: глубокая копия s21::map против снимка
+/// persistent_map за O(1), цена копирования пути при вставках, пока снимки
+/// живы, и память на снимок
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 1000000);
+  std::vector<int> keys = bench::ShuffledKeys(n);
+  /// новые ключи для вставок после снимков
+  std::vector<int> extra = bench::ShuffledKeys(n / 10, 7);
+  for (int &key : extra) key += static_cast<int>(n);
+  std::printf("persistent snapshots, n = %zu\n", n);
+
+  s21::map<int, int> map;
+  double ms = bench::Measure([&] {
+    for (int key : keys) map.insert(key, key);
+  });
+  bench::Report("s21::map::insert", ms, n);
+  s21::persistent_map<int, int> persistent;
+  ms = bench::Measure([&] {
+    for (int key : keys) persistent.insert(key, key);
+  });
+  bench::Report("persistent_map::insert, no snapshots", ms, n);
+
+  const std::size_t copies = 10;
+  ms = bench::Measure([&] {
+    for (std::size_t i = 0; i < copies; ++i) {
+      s21::map<int, int> copy(map);
+      bench::DoNotOptimize(copy.empty());
+    }
+  });
+  bench::Report("s21::map copy constructor", ms, copies);
+  ms = bench::Measure([&] {
+    for (std::size_t i = 0; i < copies; ++i) {
+      s21::persistent_map<int, int> copy = persistent.snapshot();
+      bench::DoNotOptimize(copy.size());
+    }
+  });
+  bench::Report("persistent_map::snapshot", ms, copies);
+
+  /// снимок после каждой вставки: каждая вставка копирует весь путь
+  std::vector<s21::persistent_map<int, int>> snapshots;
+  snapshots.reserve(extra.size());
+  s21::persistent_map<int, int> versioned = persistent;
+  std::size_t heap = bench::HeapInUse();
+  ms = bench::Measure([&] {
+    for (int key : extra) {
+      versioned.insert(key, key);
+      snapshots.push_back(versioned.snapshot());
+    }
+  });
+  std::size_t path_bytes = bench::HeapInUse() - heap;
+  bench::Report("persistent_map::insert + snapshot", ms, extra.size());
+  ms = bench::Measure([&] {
+    for (int key : extra) map.insert(key, key);
+  });
+  bench::Report("s21::map::insert, no snapshots", ms, extra.size());
+  std::printf("%-48s %10.2f bytes\n", "memory per retained snapshot",
+              static_cast<double>(path_bytes) / extra.size());
+
+  std::size_t found = 0;
+  ms = bench::Measure([&] {
+    for (int key : keys) found += snapshots.front().contains(key);
+  });
+  bench::DoNotOptimize(found);
+  bench::Report("persistent_map::contains on a snapshot", ms, n);
+  ms = bench::Measure([&] {
+    for (int key : keys) found += map.contains(key);
+  });
+  bench::DoNotOptimize(found);
+  bench::Report("s21::map::contains", ms, n);
+  return 0;
+}
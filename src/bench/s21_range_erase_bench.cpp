@@ -0,0 +1,37 @@
+#include "bench_entry.h"
+
+/// Удаление всех записей старше отметки времени из map<метка, значение>:
+/// поэлементное erase по итератору против erase_range (два разделения и
+/// соединение). Доля удаляемых записей - от 1% до 100%
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 1000000);
+  std::vector<std::pair<int, int>> items(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    items[i] = {static_cast<int>(i), static_cast<int>(i)};
+  }
+  std::printf("map<int, int> expiry, n = %zu\n", n);
+  for (std::size_t percent : {1, 10, 50, 100}) {
+    int cutoff = static_cast<int>(n * percent / 100);
+    std::size_t k = static_cast<std::size_t>(cutoff);
+    char name[64];
+
+    s21::map<int, int> loop;
+    loop.assign_sorted(items.begin(), items.end());
+    double ms = bench::Measure([&] {
+      while (!loop.empty() && (*loop.begin()).first < cutoff) {
+        loop.erase(loop.begin());
+      }
+    });
+    std::snprintf(name, sizeof(name), "erase loop, %zu%%", percent);
+    bench::Report(name, ms, k);
+
+    s21::map<int, int> range;
+    range.assign_sorted(items.begin(), items.end());
+    std::size_t erased = 0;
+    ms = bench::Measure([&] { erased = range.erase_range(0, cutoff); });
+    bench::DoNotOptimize(erased);
+    std::snprintf(name, sizeof(name), "erase_range, %zu%%", percent);
+    bench::Report(name, ms, k);
+  }
+  return 0;
+}
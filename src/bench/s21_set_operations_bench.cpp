@@ -0,0 +1,58 @@
+#include <thread>
+
+#include "bench_entry.h"
+
+/// Масштабирование объединения, пересечения и разности множеств по числу
+/// потоков: 1, 2, 4 ... до количества ядер машины
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 2000000);
+  std::vector<int> evens(n);
+  std::vector<int> thirds(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    evens[i] = static_cast<int>(i * 2);
+    thirds[i] = static_cast<int>(i * 3);
+  }
+  s21::set<int> first;
+  s21::set<int> second;
+  first.assign_sorted(evens.begin(), evens.end());
+  second.assign_sorted(thirds.begin(), thirds.end());
+
+  unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  std::printf("set<int> operations, n = %zu per input, %u cores\n", n, cores);
+  {
+    /// merge с семантикой std: повторы остаются в источнике
+    s21::set<int> a(first);
+    s21::set<int> b(second);
+    double ms = bench::Measure([&] { a.merge(b); });
+    bench::DoNotOptimize(b.size());
+    bench::Report("merge, default thread pool", ms, 2 * n);
+  }
+  for (unsigned threads = 1;; threads *= 2) {
+    threads = std::min(threads, cores);
+    s21::ThreadPool pool(threads - 1);
+    char name[64];
+    auto run = [&](const char *op, auto fn) {
+      s21::set<int> a(first);
+      s21::set<int> b(second);
+      std::size_t result = 0;
+      double ms = bench::Measure([&] {
+        result = fn(std::move(a), std::move(b), pool).size();
+      });
+      bench::DoNotOptimize(result);
+      std::snprintf(name, sizeof(name), "%s, %u threads", op, threads);
+      bench::Report(name, ms, 2 * n);
+    };
+    run("union", [](s21::set<int> a, s21::set<int> b, s21::ThreadPool &p) {
+      return s21::set_union(std::move(a), std::move(b), p);
+    });
+    run("intersection",
+        [](s21::set<int> a, s21::set<int> b, s21::ThreadPool &p) {
+          return s21::set_intersection(std::move(a), std::move(b), p);
+        });
+    run("difference", [](s21::set<int> a, s21::set<int> b, s21::ThreadPool &p) {
+      return s21::set_difference(std::move(a), std::move(b), p);
+    });
+    if (threads == cores) break;
+  }
+  return 0;
+}
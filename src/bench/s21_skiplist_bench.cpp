@@ -0,0 +1,73 @@
+#include <mutex>
+#include <thread>
+
+#include "bench_entry.h"
+
+/// Пропускная способность упорядоченных словарей с частыми изменениями при
+/// числе потоков от 1 до 64: неблокирующий список с пропусками, словарь из
+/// частей под мьютексами читателей-писателей и s21::set под общим
+/// мьютексом. Нагрузка - 25% вставок, 25% удалений и 50% поисков по ключам
+/// из узкого горячего диапазона
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 100000);
+  std::vector<int> keys = bench::ShuffledKeys(n);
+  const std::size_t total_ops = 1000000;
+  std::printf("concurrent ordered sets, n = %zu, %zu ops, %u cpus\n", n,
+              total_ops, std::thread::hardware_concurrency());
+
+  s21::concurrent_skiplist_set<int> skiplist;
+  s21::concurrent_map<int, int, 64> sharded;
+  s21::set<int> locked;
+  std::mutex locked_mutex;
+  for (std::size_t i = 0; i < n; i += 2) {
+    skiplist.insert(keys[i]);
+    sharded.insert(keys[i], keys[i]);
+    locked.insert(keys[i]);
+  }
+
+  /// общее количество операций делится между потоками
+  auto run = [&](const char *name, std::size_t threads, auto op) {
+    std::size_t per_thread = total_ops / threads;
+    double ms = bench::Measure([&] {
+      std::vector<std::thread> workers;
+      for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+          std::size_t hits = 0;
+          std::size_t at = t * 7919;
+          for (std::size_t i = 0; i < per_thread; ++i) {
+            at = (at + 104729) % n;
+            hits += op(keys[at], i % 4);
+          }
+          bench::DoNotOptimize(hits);
+        });
+      }
+      for (std::thread &worker : workers) worker.join();
+    });
+    char label[64];
+    std::snprintf(label, sizeof(label), "%s, %zu threads", name, threads);
+    bench::Report(label, ms, per_thread * threads);
+  };
+  for (std::size_t threads : {1, 2, 4, 8, 16, 32, 64}) {
+    run("concurrent_skiplist_set", threads, [&](int key, std::size_t kind) {
+      if (kind == 0) return skiplist.insert(key).second;
+      if (kind == 1) return skiplist.erase(key) == 1;
+      return skiplist.contains(key);
+    });
+    run("concurrent_map<64 shards>", threads, [&](int key, std::size_t kind) {
+      if (kind == 0) return sharded.insert(key, key);
+      if (kind == 1) return sharded.erase(key) == 1;
+      return sharded.contains(key);
+    });
+    run("s21::set + std::mutex", threads, [&](int key, std::size_t kind) {
+      std::lock_guard<std::mutex> lock(locked_mutex);
+      if (kind == 0) return locked.insert(key).second;
+      if (kind == 1) {
+        bool found = locked.contains(key);
+        if (found) locked.erase(locked.find(key));
+        return found;
+      }
+      return locked.contains(key);
+    });
+  }
+  return 0;
+}
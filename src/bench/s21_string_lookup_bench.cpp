@@ -0,0 +1,53 @@
+#include <string_view>
+
+#include "bench_entry.h"
+
+/// Поиск по строковым ключам: с временным std::string на каждый запрос
+/// (обычный компаратор) и без него (прозрачный компаратор std::less<>)
+int main(int argc, char **argv) {
+  std::size_t n = bench::ProblemSize(argc, argv, 200000);
+  std::size_t queries = 4 * n;
+  /// ключи длиннее буфера короткой строки, чтобы временная строка
+  /// выделяла память
+  std::vector<std::string> keys(n);
+  std::vector<int> order = bench::ShuffledKeys(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "s21_bench_key_%08d", order[i]);
+    keys[i] = buffer;
+  }
+  std::vector<std::string_view> views(keys.begin(), keys.end());
+  std::vector<const char *> pointers(n);
+  for (std::size_t i = 0; i < n; ++i) pointers[i] = keys[i].c_str();
+
+  s21::set<std::string> plain(keys.begin(), keys.end());
+  s21::set<std::string, std::less<>> transparent(keys.begin(), keys.end());
+  s21::map<std::string, int, std::less<>> table;
+  for (std::size_t i = 0; i < n; ++i) table.insert(keys[i], order[i]);
+
+  std::printf("string lookups, n = %zu, %zu queries\n", n, queries);
+  auto run = [&](const char *name, auto lookup) {
+    std::size_t found = 0;
+    double ms = bench::Measure([&] {
+      for (std::size_t q = 0; q < queries; ++q) found += lookup(q % n);
+    });
+    bench::DoNotOptimize(found);
+    bench::Report(name, ms, queries);
+  };
+  run("set<string>::find(string)",
+      [&](std::size_t i) { return plain.find(keys[i]) != plain.end(); });
+  run("set<string>::find(const char *), temporary", [&](std::size_t i) {
+    return plain.find(pointers[i]) != plain.end();
+  });
+  run("set<string>::find(string(string_view))", [&](std::size_t i) {
+    return plain.find(std::string(views[i])) != plain.end();
+  });
+  run("set<string, less<>>::find(string_view)", [&](std::size_t i) {
+    return transparent.find(views[i]) != transparent.end();
+  });
+  run("set<string, less<>>::contains(const char *)",
+      [&](std::size_t i) { return transparent.contains(pointers[i]); });
+  run("map<string, int, less<>>::contains(string_view)",
+      [&](std::size_t i) { return table.contains(views[i]); });
+  return 0;
+}
@@ -8,13 +8,31 @@
  * @file SqContainer Описание интерфейса SqContainer
  * @addtogroup SqContainerD @{
  */
+#include <cstddef>
+#include <type_traits>
+
 namespace s21 {
+/**
+ * часть интерфейса с копирующей вставкой. Для некопируемых T ее нет:
+ * push_back(const T &) в контейнере тогда не виртуальный, создается только
+ * при вызове и не компилируется вместо ошибки во время выполнения
+ * @tparam T некоторый произвольный объект
+ */
+template <typename T, bool = std::is_copy_constructible<T>::value>
+class SqCopyInsert {
+ public:
+  virtual void push_back(const T &value) = 0;
+};
+
+template <typename T>
+class SqCopyInsert<T, false> {};
+
 /**
  * интерфейс последовательного контейнера
  * @tparam T некоторый произвольный объект
  */
 template <typename T>
-class SqContainer {
+class SqContainer : public SqCopyInsert<T> {
  public:
   /// описание типа
   using value_type = T;
@@ -37,7 +55,6 @@ class SqContainer {
   virtual size_type max_size() = 0;
 
   virtual void clear() = 0;
-  virtual void push_back(const_reference value) = 0;
   virtual void pop_back() = 0;
 };
 }  // namespace s21
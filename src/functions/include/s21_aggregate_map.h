@@ -0,0 +1,174 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_AGGREGATE_MAP_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_AGGREGATE_MAP_H_
+/**
+ * @file
+ * @brief Словарь с агрегатами значений по диапазонам ключей
+ * @details Каждый узел AvlTree хранит агрегат (сумму, минимум и т.п.)
+ * значений своего поддерева, агрегат пересчитывается вместе с высотой при
+ * поворотах и перестройках. Агрегат по полуинтервалу ключей собирается из
+ * O(log n) узлов и поддеревьев на границах, без обхода элементов
+ */
+
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_avltree.h"
+
+namespace s21 {
+
+/**
+ * Политика агрегата - сумма значений. Политика задает тип агрегата type,
+ * нейтральный элемент Neutral(), агрегат одного значения Make(value) и
+ * ассоциативное объединение Combine(left, right). Коммутативность не нужна:
+ * части объединяются по возрастанию ключей
+ * @tparam T тип значения
+ */
+template <typename T>
+struct SumAggregate {
+  using type = T;
+  static type Neutral() { return T(); }
+  static type Make(const T &value) { return value; }
+  static type Combine(const type &a, const type &b) { return a + b; }
+};
+
+/// Политика агрегата - минимум значений, см. SumAggregate
+template <typename T>
+struct MinAggregate {
+  using type = T;
+  static type Neutral() { return std::numeric_limits<T>::max(); }
+  static type Make(const T &value) { return value; }
+  static type Combine(const type &a, const type &b) { return b < a ? b : a; }
+};
+
+/// Политика агрегата - максимум значений, см. SumAggregate
+template <typename T>
+struct MaxAggregate {
+  using type = T;
+  static type Neutral() { return std::numeric_limits<T>::lowest(); }
+  static type Make(const T &value) { return value; }
+  static type Combine(const type &a, const type &b) { return a < b ? b : a; }
+};
+
+/**
+ * Ключ пары словаря и политика дополнения узлов агрегатом значений
+ * @tparam Pair тип пары
+ * @tparam Aggregate политика агрегата, см. SumAggregate
+ */
+template <typename Pair, typename Aggregate>
+struct AggregateKeyOf : SelectFirst<Pair> {
+  struct augment {
+    using type = typename Aggregate::type;
+    static type Make(const Pair &value) {
+      return Aggregate::Make(value.second);
+    }
+    static type Combine(const type &a, const type &b) {
+      return Aggregate::Combine(a, b);
+    }
+  };
+};
+
+/**
+ * Словарь с уникальными ключами и агрегатом значений по диапазону ключей
+ * за O(log n)
+ * @details значения доступны только на чтение: изменение значения на месте
+ * сделало бы агрегаты узлов неверными. Значение меняют insert_or_assign и
+ * update, которые пересчитывают агрегаты на пути к корню
+ * @tparam Key тип ключа
+ * @tparam T тип значения
+ * @tparam Aggregate политика агрегата, см. SumAggregate
+ * @tparam Compare строгий порядок на ключах
+ */
+template <typename Key, typename T, typename Aggregate = SumAggregate<T>,
+          typename Compare = std::less<Key>>
+class aggregate_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using aggregate_type = typename Aggregate::type;
+  using key_compare = Compare;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+
+ private:
+  using tree_type = AvlTree<key_type, value_type,
+                            AggregateKeyOf<value_type, Aggregate>, Compare,
+                            true>;
+  tree_type _tree;
+
+ public:
+  using const_iterator = typename tree_type::const_iterator;
+
+  aggregate_map() = default;
+  /**
+   * Конструктор с инициализацией из списка пар. При повторе ключа остается
+   * первая пара
+   * @param items список пар
+   */
+  aggregate_map(std::initializer_list<value_type> const &items);
+
+  const_iterator begin() { return const_iterator(_tree.begin()); }
+  const_iterator end() { return const_iterator(_tree.end()); }
+  bool empty() { return _tree.IsEmpty(); }
+  size_type size() { return _tree.size(); }
+  void clear() { _tree.Clear(); }
+
+  /**
+   * Значение по ключу
+   * @throw std::out_of_range если ключа нет
+   */
+  const T &at(const Key &key);
+  /// Поиск пары по ключу, end() если ее нет
+  const_iterator find(const Key &key) {
+    return const_iterator(_tree.Find(key));
+  }
+  bool contains(const Key &key) { return _tree.Include(key); }
+
+  /**
+   * Вставка пары, если ключа еще нет
+   * @return итератор на пару с ключом и признак вставки
+   */
+  std::pair<const_iterator, bool> insert(const Key &key, const T &obj);
+  /**
+   * Вставка пары или замена значения существующей пары. Агрегаты
+   * пересчитываются на пути от пары к корню
+   * @return итератор на пару и true, если пара вставлена
+   */
+  std::pair<const_iterator, bool> insert_or_assign(const Key &key,
+                                                   const T &obj);
+  /**
+   * Изменение значения на месте функцией fn(T &) с пересчетом агрегатов
+   * @return false если ключа нет
+   */
+  template <typename F>
+  bool update(const Key &key, F fn);
+  /// Удаление пары по итератору
+  void erase(const_iterator pos);
+  /// Удаление пары по ключу, количество удаленных пар (0 или 1)
+  size_type erase(const Key &key);
+
+  /**
+   * Агрегат значений пар с ключами из полуинтервала [lo, hi) за O(log n)
+   * @param lo нижняя граница (включительно)
+   * @param hi верхняя граница (не включительно)
+   * @return агрегат, Aggregate::Neutral() для пустого полуинтервала
+   */
+  aggregate_type aggregate(const Key &lo, const Key &hi) const;
+  /// Агрегат всех значений за O(1)
+  aggregate_type aggregate() const;
+  /// Проверка инвариантов дерева и агрегатов узлов
+  bool validate() const { return _tree.Validate(); }
+};
+
+}  // namespace s21
+
+#include "../templates/s21_aggregate_map.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_AGGREGATE_MAP_H_
@@ -10,44 +10,146 @@
  * @details @ref ExplanationAvl
  */
 
+#include <algorithm>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <optional>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_node_pool.h"
+#include "s21_thread_pool.h"
 
 namespace s21 {
 
+/**
+ * Получение ключа из значения для множеств: ключ - само значение
+ * @tparam T тип значения
+ */
+template <typename T>
+struct Identity {
+  const T &operator()(const T &value) const { return value; }
+};
+
+/**
+ * Получение ключа из значения для словарей: ключ - первый элемент пары
+ * @tparam Pair тип пары
+ */
+template <typename Pair>
+struct SelectFirst {
+  const typename Pair::first_type &operator()(const Pair &value) const {
+    return value.first;
+  }
+};
+
+/**
+ * Проверка прозрачности компаратора: прозрачный компаратор объявляет тип
+ * is_transparent и умеет сравнивать ключи разных типов
+ * @tparam C тип компаратора
+ */
+template <typename C, typename = void>
+struct IsTransparent : std::false_type {};
+
+template <typename C>
+struct IsTransparent<C, std::void_t<typename C::is_transparent>>
+    : std::true_type {};
+
+/**
+ * Политика дополнения узлов по умолчанию: кроме высоты и размера поддерева
+ * узлы ничего не хранят
+ */
+struct NoAugment {};
+
+/**
+ * Политика дополнения узлов дерева. KeyOfValue может объявить тип augment
+ * с типом значения type и статическими функциями Make(value) - значение для
+ * одного элемента и Combine(left, right) - ассоциативное объединение
+ * значений соседних частей. Узел хранит объединение по своему поддереву
+ * слева направо, оно пересчитывается вместе с высотой при любом изменении
+ * структуры
+ * @tparam KeyOfValue функтор, возвращающий ключ значения
+ */
+template <typename KeyOfValue, typename = void>
+struct AugmentOf {
+  using type = NoAugment;
+};
+
+template <typename KeyOfValue>
+struct AugmentOf<KeyOfValue, std::void_t<typename KeyOfValue::augment>> {
+  using type = typename KeyOfValue::augment;
+};
+
+/// Дополнительное значение узла, для NoAugment память не занимается
+template <typename Augment>
+struct AugmentStorage {
+  typename Augment::type augment{};
+};
+
+template <>
+struct AugmentStorage<NoAugment> {};
+
 /**
  * Шаблон класса Avl дерево
  * @details многие методы в секции private сделаны статическими для простоты
- * переноса дерева из языка Си
- * @tparam T
- *
+ * переноса дерева из языка Си. Все политики дерева задаются на этапе
+ * компиляции, поэтому в горячих циклах нет проверок уникальности и
+ * сравнений на равенство: значения сравниваются только через Compare
+ * @tparam Key тип ключа
+ * @tparam Value тип хранимого значения
+ * @tparam KeyOfValue функтор, возвращающий ключ значения. Может объявить
+ * политику дополнения узлов augment, см. AugmentOf
+ * @tparam Compare строгий порядок на ключах. Объект функтора создается на
+ * каждое сравнение, поэтому он должен быть конструируемым по умолчанию
+ * @tparam Unique true - дубликаты ключей запрещены, false - разрешены
  */
-template <typename T>
+template <typename Key, typename Value = Key,
+          typename KeyOfValue = Identity<Key>,
+          typename Compare = std::less<Key>, bool Unique = false>
 class AvlTree {
+ public:
+  /// политика дополнения узлов, NoAugment если KeyOfValue ее не объявил
+  using augment_policy = typename AugmentOf<KeyOfValue>::type;
+
  private:
+  /// хранят ли узлы дополнительное значение
+  static constexpr bool kAugmented = !std::is_same_v<augment_policy, NoAugment>;
   /**
    * Структура узла дерева с простым конструктором
+   * @details значение лежит в безымянном объединении, чтобы заголовок дерева
+   * (узел без значения) имел тот же тип, что и остальные узлы. Значение
+   * разрушается явно в DestroyNode. Дополнительное значение политики
+   * augment_policy хранится в базовом классе
    */
-  struct Node {
+  struct Node : AugmentStorage<augment_policy> {
     Node *left;            /// левое поддерево
     Node *right;           /// правое поддерево
     Node *parent;          /// родитель
-    T value;               /// значение
-    unsigned char height;  /// высота поддеревьев
-    /// простой конструктор
-    explicit Node(T k) {
-      value = k;
-      left = right = parent = nullptr;
-      height = 1;
+    size_t count;          /// количество узлов в поддереве
+    union {
+      Value value;  /// значение
+    };
+    unsigned char height;  /// высота поддеревьев, у заголовка 0
+    /// конструктор заголовка, значение не создается
+    Node()
+        : left(nullptr), right(nullptr), parent(nullptr), count(0), height(0) {}
+    /// конструктор значения на месте из аргументов
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args &&...args)
+        : left(nullptr),
+          right(nullptr),
+          parent(nullptr),
+          count(1),
+          value(std::forward<Args>(args)...),
+          height(1) {
+      FixAugment(this);
     }
-  };
-
-  struct triple {
-    Node *now_root = nullptr;
-    Node *current_node = nullptr;
-    bool third = false;
+    /// деструктор не трогает значение, см. DestroyNode
+    ~Node() {}
   };
 
   /**
@@ -57,18 +159,59 @@ class AvlTree {
    * @return высота узла
    */
   static unsigned char GetHeight(Node *node) { return node ? node->height : 0; }
+  /**
+   * Получение размера поддерева с проверкой на существование
+   * @param node корень поддерева
+   * @return количество узлов в поддереве
+   */
+  static size_t GetCount(Node *node) { return node ? node->count : 0; }
   /**
    * Получение разницы высот поддеревьев
    * @param node узел для получения разницы
    * @return разница
    */
   static int BalanceFactor(Node *node);
+  /// Ключ значения, хранящегося в узле
+  static const Key &KeyOf(const Node *node) {
+    return KeyOfValue()(node->value);
+  }
+  /// Сравнение ключей политикой Compare. Аргументы могут иметь разные типы,
+  /// если Compare умеет их сравнивать (прозрачный компаратор)
+  template <typename A, typename B>
+  static bool Less(const A &a, const B &b) {
+    return Compare()(a, b);
+  }
   /**
-   * Возвращение высоты текущего узла в правильный вид, при учете что у правого
-   * и левого поддерева значения верны
+   * Ключ для поиска. При прозрачном компараторе ключ используется как есть,
+   * иначе один раз приводится к Key, а не при каждом сравнении
+   * @param key ключ, переданный в метод поиска
+   * @return ссылка на key или временный Key
+   */
+  template <typename K>
+  static decltype(auto) LookupKey(const K &key) {
+    if constexpr (IsTransparent<Compare>::value || std::is_same_v<K, Key>) {
+      return (key);
+    } else {
+      return Key(key);
+    }
+  }
+  /**
+   * Возвращение высоты и размера поддерева текущего узла в правильный вид, при
+   * учете что у правого и левого поддерева значения верны
    * @param node узел для коррекции высоты
    */
   static void FixHeight(Node *node);
+  /**
+   * Дополнительное значение узла по его значению и поддеревьям. Вызывается
+   * только при kAugmented
+   * @param node узел, у поддеревьев которого значения верны
+   * @return объединение значений поддерева слева направо
+   */
+  static auto NodeAugment(const Node *node);
+  /// Пересчет дополнительного значения узла, см. NodeAugment
+  static void FixAugment(Node *node) {
+    if constexpr (kAugmented) node->augment = NodeAugment(node);
+  }
   /**
    * Правый поворот. смотри @ref ExplanationAvl
    * @param node корень для поворота
@@ -89,18 +232,146 @@ class AvlTree {
    */
   static Node *Balance(Node *node);
   /**
-   * Внутренняя функция для вставки в дерево
-   * @param node корень дерева для вставки
+   * Замена поддерева child у родителя parent на поддерево replacement. Если
+   * родителя нет, то заменяется корень дерева
+   * @param parent родитель заменяемого поддерева
+   * @param child заменяемое поддерево
+   * @param replacement новое поддерево
+   */
+  void ReplaceChild(Node *parent, Node *child, Node *replacement);
+  /**
+   * Балансировка по цепочке родителей от узла node до корня. Как только высота
+   * очередного поддерева не изменилась, повороты прекращаются и выше
+   * обновляются только размеры поддеревьев
+   * @param node первый узел, поддерево которого было изменено
+   */
+  void Rebalance(Node *node);
+  /// Место вставки ключа в дерево
+  struct InsertPos {
+    Node *parent;  /// родитель нового узла, &_header для пустого дерева
+    bool to_left;  /// новый узел становится левым ребенком parent
+    Node *equal;   /// узел с равным ключом (только при Unique = true)
+  };
+  /**
+   * Поиск места вставки ключа. При верной подсказке место находится за
+   * O(1) сравнений ключей без спуска от корня, иначе выполняется обычный
+   * спуск
+   * @param key ключ нового значения
+   * @param hint узел, перед которым, вероятно, окажется ключ (заголовок -
+   * после максимума), nullptr - без подсказки
+   * @return место вставки
+   */
+  InsertPos FindInsertPos(const Key &key, Node *hint = nullptr);
+  /**
+   * Проверка подсказки: ключ должен попасть между соседями узла hint
+   * @param key ключ нового значения
+   * @param hint узел-подсказка или заголовок
+   * @param pos место вставки, заполняется при верной подсказке
+   * @return true если подсказка верна
+   */
+  bool CheckHint(const Key &key, Node *hint, InsertPos &pos);
+  /**
+   * Может ли ключ a стоять левее ключа b: строго меньше при Unique = true,
+   * не больше при повторяющихся ключах
+   */
+  static bool Precedes(const Key &a, const Key &b) {
+    if constexpr (Unique) {
+      return Less(a, b);
+    } else {
+      return !Less(b, a);
+    }
+  }
+  /**
+   * Подвешивание нового узла в найденное место с балансировкой
+   * @param new_node новый узел
+   * @param pos место вставки из FindInsertPos
+   */
+  void LinkNode(Node *new_node, const InsertPos &pos);
+  /**
+   * Внутренняя функция для вставки в дерево. Спуск итеративный, значение
+   * копируется (перемещается) только один раз - в новый узел
    * @param value значение для вставки
-   * @return корень дерева со вставленным элементом true/false вставилось ли
-   * значение
+   * @return узел со вставленным (или уже существующим при Unique = true)
+   * значением и true/false вставилось ли значение
+   */
+  template <typename V>
+  std::pair<Node *, bool> InInsert(V &&value, Node *hint = nullptr);
+  /**
+   * Внутренняя функция для создания значения на месте. Значение создается
+   * один раз прямо в узле
+   * @param hint подсказка места вставки, nullptr - без подсказки
+   * @param args аргументы конструктора значения
+   * @return узел с новым (или уже существующим при Unique = true) значением
+   * и true/false вставилось ли значение
+   */
+  template <typename... Args>
+  std::pair<Node *, bool> InEmplace(Node *hint, Args &&...args);
+  /**
+   * Исключение узла из дерева с последующей балансировкой. Память узла
+   * освобождается
+   * @param node узел для удаления
+   */
+  void RemoveNode(Node *node);
+  /**
+   * Исключение узла из дерева с последующей балансировкой. Узел не
+   * разрушается и становится одиночным (без связей, высота и размер 1)
+   * @param node узел для исключения
    */
-  AvlTree<T>::triple InInsert(AvlTree::Node *node, T value, bool uniq);
+  void UnlinkNode(Node *node);
   /**
-   * Внутренняя функция для деструктора
-   * @param p_node указатель на указатель на корень дерева
+   * Вставка одиночного узла из другого дерева без копирования значения
+   * @param node одиночный узел
+   * @param pool пул, которому принадлежит память узла
+   * @param hint подсказка места вставки, nullptr - без подсказки
+   * @return вставленный узел и true, либо узел с равным ключом и false (при
+   * Unique = true). Во втором случае node остается одиночным
    */
-  static void DeleteTree(Node **p_node);
+  std::pair<Node *, bool> InsertDetached(
+      Node *node, const std::shared_ptr<NodePool<Node>> &pool, Node *hint);
+  /**
+   * Объединение пула дерева с пулом, из которого пришли узлы
+   * @param pool пул памяти чужих узлов
+   */
+  void AdoptPool(const std::shared_ptr<NodePool<Node>> &pool);
+  /**
+   * Перенос пула опустевшего дерева other, чьи узлы перешли в текущее.
+   * other остается без пула, и следующая вставка в него заведет свой.
+   * Пулы с одним владельцем сливаются без отметки общего пула
+   * @param other дерево-источник, уже пустое
+   */
+  void TakePool(AvlTree &other);
+  /**
+   * Создание узла в памяти пула
+   * @param args аргументы конструктора значения узла
+   * @return новый узел
+   */
+  template <typename... Args>
+  Node *CreateNode(Args &&...args);
+  /**
+   * Разрушение узла и возврат его памяти в пул
+   * @param node узел для удаления
+   */
+  void DestroyNode(Node *node);
+  /**
+   * Действующий пул узлов дерева. Создается при первом обращении
+   * @return указатель на пул
+   */
+  NodePool<Node> *Pool();
+  /**
+   * Пул дерева, отмеченный общим. Вызывается перед тем, как отдать пул
+   * второму владельцу (дескриптору узла или другому дереву): владельцы
+   * могут работать в разных потоках
+   * @return владеющий указатель на пул
+   */
+  const std::shared_ptr<NodePool<Node>> &SharedPool();
+  /**
+   * Внутренняя функция для деструктора. Разрушает значения узлов поддерева
+   * @param node корень дерева
+   * @param bulk память будет возвращена пулу целыми блоками, поэтому для
+   * тривиально разрушаемых значений обход не выполняется. При false каждый
+   * узел возвращается в список свободных
+   */
+  void DeleteTree(Node *node, bool bulk);
   /**
    * Вывод дерева на экран по правилу корень-лево-право
    * @param node корень дерева для вывода
@@ -109,10 +380,11 @@ class AvlTree {
   /**
    * Внутренняя функция для проверки включения
    * @param node корень дерева для проверки включения
-   * @param value значения для проверки включения
-   * @return указатель ена узел, содержащий заданный элемент
+   * @param key ключ для проверки включения
+   * @return указатель на первый узел с заданным ключом, nullptr если его нет
    */
-  static Node *InInclude(Node *node, T value);
+  template <typename K>
+  static Node *InInclude(Node *node, const K &key);
   /**
    * Поиск минимального узла в дереве. (самый левый)
    * @param node корень для поиска
@@ -126,85 +398,311 @@ class AvlTree {
    */
   static Node *FindMax(Node *node);
   /**
-   * Удаления минимального элемента дерева
-   * @param node корень для удаления
-   * @return новый корень дерева с удаленным минимальным элементом
+   * Вспомогательная функция для глубокого копирования по одному узлу. Нужна,
+   * когда узлы выделяются отдельно (S21_AVLTREE_HEAP_NODES). При
+   * исключении созданные этим вызовом узлы удаляются
+   * @param node корень дерева для копирования
+   * @param parent родитель копии (для корня nullptr)
+   * @return копия дерева
    */
-  static Node *InRemoveMin(Node *node);
+  Node *CopyNodes(Node *node, Node *parent = nullptr);
   /**
-   * Внутренняя функция для удаления элемента(единожды, если есть дубликаты
-   * вызывай дважды и тд.)
-   * @param node корень дерева для удаления элемента
-   * @param value элемент для удаления
-   * @return новый корень дерева с удаленным элементом
+   * Копирование поддерева в непрерывный блок узлов в симметричном порядке:
+   * i-й по возрастанию ключей узел попадает в block[i], поэтому обход копии
+   * идет по памяти подряд. Высоты, размеры и ссылки на родителей
+   * переносятся без пересчета. Поддеревья от kParallelCutoff узлов
+   * копируются параллельно в непересекающиеся части блока. При исключении
+   * созданные этим вызовом значения разрушаются
+   * @param node корень копируемого поддерева
+   * @param block часть блока под поддерево, node->count узлов
+   * @param parent родитель копии
+   * @param pool пул потоков для параллельного выполнения
+   * @return корень копии
    */
-  Node *InRemove(Node *node, T value);
+  static Node *CloneNodes(Node *node, Node *block, Node *parent,
+                          ThreadPool &pool);
   /**
-   * Вспомогательная функция для глубокого копирования(конструктор копирования)
-   * @param node корень дерева для копирования
-   * @return копия дерева
+   * Разрушение значений узлов блока
+   * @param block начало блока
+   * @param count количество узлов
+   */
+  static void DestroyValues(Node *block, size_t count) noexcept;
+  /**
+   * Замена содержимого дерева копией other
+   * @param other дерево для копирования
+   * @param pool пул потоков для параллельного копирования
+   */
+  void CloneFrom(const AvlTree &other, ThreadPool &pool);
+  /**
+   * Замена содержимого дерева копией other. Общий пул потоков задействуется
+   * только для больших деревьев
+   * @param other дерево для копирования
+   */
+  void CloneFrom(const AvlTree &other);
+  /**
+   * Построение идеально сбалансированного дерева из упорядоченного массива
+   * узлов за O(n). Корнем становится средний узел, высоты и размеры
+   * поддеревьев вычисляются снизу вверх
+   * @param nodes упорядоченный массив узлов
+   * @param count количество узлов
+   * @param parent родитель корня поддерева
+   * @return корень построенного поддерева
+   */
+  static Node *BuildBalanced(Node **nodes, size_t count, Node *parent);
+  /**
+   * Создание узлов из значений диапазона в порядке обхода
+   * @param first начало диапазона
+   * @param last конец диапазона
+   * @param nodes сюда добавляются созданные узлы
+   */
+  template <typename InputIt>
+  void CreateNodes(InputIt first, InputIt last, std::vector<Node *> &nodes);
+  /**
+   * Замена содержимого пустого дерева упорядоченным массивом узлов. При
+   * Unique = true из равных узлов остается первый, остальные освобождаются
+   * @param nodes упорядоченный по ключам массив узлов
+   */
+  void BuildFromNodes(std::vector<Node *> &nodes);
+  /// Операции над множествами, см. CombineNodes
+  enum class SetOp {
+    kUnion,         /// объединение, повторы max(a, b)
+    kMerge,         /// слияние, сохраняются все элементы
+    kIntersection,  /// пересечение, повторы min(a, b)
+    kDifference     /// разность, повторы max(a - b, 0)
+  };
+  /// порог размера задачи, начиная с которого ветви идут в пул потоков
+  static constexpr size_t kParallelCutoff = 1 << 14;
+  /**
+   * Соединение узла mid и двух поддеревьев в одно АВЛ дерево за
+   * O(|h(left) - h(right)|). Все элементы left не больше mid, а все элементы
+   * right не меньше mid
+   * @param left левое поддерево
+   * @param mid отдельный узел
+   * @param right правое поддерево
+   * @return корень результата
+   */
+  static Node *JoinNodes(Node *left, Node *mid, Node *right);
+  /**
+   * Вспомогательная функция для JoinNodes, когда левое дерево выше: спуск
+   * по правой ветви left до поддерева подходящей высоты
+   */
+  static Node *JoinRight(Node *left, Node *mid, Node *right);
+  /**
+   * Вспомогательная функция для JoinNodes, когда правое дерево выше: спуск
+   * по левой ветви right до поддерева подходящей высоты
+   */
+  static Node *JoinLeft(Node *left, Node *mid, Node *right);
+  /**
+   * Соединение двух поддеревьев без среднего узла. Средним становится
+   * минимальный узел правого поддерева
+   * @param left левое поддерево
+   * @param right правое поддерево
+   * @return корень результата
+   */
+  static Node *JoinTwo(Node *left, Node *right);
+  /**
+   * Отделение минимального узла поддерева с балансировкой
+   * @param node корень поддерева
+   * @param min сюда записывается отделенный узел
+   * @return корень оставшегося поддерева
+   */
+  static Node *ExtractMin(Node *node, Node **min);
+  /**
+   * Разделение поддерева по ключу за O(log n)
+   * @param node корень поддерева
+   * @param key ключ разделения
+   * @param inclusive попадают ли элементы, равные key, в левую часть
+   * @return левая часть (элементы меньше key) и правая часть
+   */
+  static std::pair<Node *, Node *> SplitNodes(Node *node, const Key &key,
+                                              bool inclusive);
+  /**
+   * Разделение поддерева по порядковому номеру за O(log n)
+   * @param node корень поддерева
+   * @param k количество элементов в левой части
+   * @return первые k элементов и остальные
+   */
+  static std::pair<Node *, Node *> SplitRank(Node *node, size_t k);
+  /**
+   * Вырезание элементов с номерами [first, last) за O(log n): края дерева
+   * соединяются обратно, вырезанная часть отдается вызывающему
+   * @param first номер первого вырезаемого элемента
+   * @param last номер элемента после последнего, не больше size()
+   * @return корень вырезанной части, nullptr для пустого диапазона
+   */
+  Node *CutRank(size_t first, size_t last);
+  /**
+   * Вырезание элементов с ключами из полуинтервала [lo, hi) за O(log n)
+   * @param lo нижняя граница (включительно)
+   * @param hi верхняя граница (не включительно)
+   * @return корень вырезанной части, nullptr для пустого диапазона
+   */
+  Node *CutRange(const Key &lo, const Key &hi);
+  /**
+   * Операция над множествами на основе split/join. Работа
+   * O(m log(n/m + 1)), где m - размер меньшего дерева. Ветви рекурсии
+   * выполняются параллельно в пуле потоков. Исходные деревья разбираются на
+   * узлы, лишние узлы складываются в garbage
+   * @param a первое дерево
+   * @param b второе дерево
+   * @param op операция
+   * @param garbage корни поддеревьев, не вошедших в результат
+   * @param pool пул потоков
+   * @return корень результата
    */
-  static Node *CopyNodes(Node *node);
+  static Node *CombineNodes(Node *a, Node *b, SetOp op,
+                            std::vector<Node *> &garbage, ThreadPool &pool);
+  /**
+   * Разделение узлов b на новые для a и повторяющие ключи a, с переносом
+   * новых в a. Работа как у CombineNodes, только для Unique = true
+   * @param a корень дерева-приемника
+   * @param b корень дерева-источника
+   * @param rest сюда записывается корень дерева узлов b с ключами из a
+   * @param pool пул потоков
+   * @return корень объединения a и новых узлов b
+   */
+  static Node *AbsorbNodes(Node *a, Node *b, Node *&rest, ThreadPool &pool);
+  /**
+   * Операция над множествами с деревом other. Узлы other переходят в
+   * текущее дерево, other становится пустым и без пула, см. TakePool
+   */
+  void Combine(AvlTree &&other, SetOp op, ThreadPool &pool);
+  /**
+   * Рекурсивная проверка инвариантов поддерева
+   * @param node корень поддерева
+   * @param parent ожидаемый родитель
+   * @return корректно ли поддерево
+   */
+  static bool CheckNode(const Node *node, const Node *parent);
+  /**
+   * Объединение дополнительных значений соседних частей
+   * @param left значение левой части, std::nullopt для пустой
+   * @param right значение правой части, std::nullopt для пустой
+   */
+  template <typename Part>
+  static Part AppendFold(Part left, Part right);
+  /// Объединение значений элементов поддерева с ключами не меньше lo
+  template <typename K>
+  static auto FoldFrom(const Node *node, const K &lo);
+  /// Объединение значений элементов поддерева с ключами меньше hi
+  template <typename K>
+  static auto FoldBefore(const Node *node, const K &hi);
+  /// Вспомогательная функция для ForEachPruned, false - обход закончен
+  template <typename Prune, typename Past, typename Visit>
+  static bool InForEachPruned(Node *node, Prune &prune, Past &past,
+                              Visit &visit);
   /**
    * Вспомогательная функция для подсчета дубликатов
    * @param node корень дерева для подсчета
-   * @param value значение для подсчета
+   * @param key ключ для подсчета
    * @return количество дубликатов
    */
-  static int CountNodes(Node *node, const T &value);
+  template <typename K>
+  static int CountNodes(Node *node, const K &key);
+  /**
+   * Количество элементов дерева, ключи которых меньше (или не больше) key
+   * @param node корень дерева
+   * @param key ключ для сравнения
+   * @param inclusive учитывать ли элементы, равные key
+   * @return количество элементов
+   */
+  template <typename K>
+  static size_t InRank(Node *node, const K &key, bool inclusive);
+  /**
+   * Поиск границы за один спуск по дереву
+   * @param node корень дерева
+   * @param key ключ для сравнения
+   * @param inclusive пропускаются ли элементы, равные key (upper bound)
+   * @return первый узел с ключом, не меньшим (большим при inclusive) key,
+   * nullptr если такого нет
+   */
+  template <typename K>
+  static Node *InBound(Node *node, const K &key, bool inclusive);
   /**
    * получение следующего узла дерева
    * @param node текущий узел дерева
-   * @return возвращает следующий узел либо nullptr при не нахождении
+   * @return возвращает следующий узел, за максимальным - заголовок
    */
   static Node *NextNode(Node *node);
   /**
    * получение предыдущего узла
    * @param node текущий узел дерева
-   * @return возвращает предыдущего узел либо nullptr при не нахождении
+   * @return возвращает предыдущий узел, для заголовка - максимальный узел
    */
   static Node *PrevNode(Node *node);
-  Node *_root;     /// корень дерева
-  bool _unique{};  /// предикат, характеризующий возможность хранения дубликатов
-                   /// в дереве. True - нет дубликатов, false - дубликаты
-                   /// допустимы
+  /// Корень дерева, nullptr для пустого дерева
+  Node *Root() const { return _header.parent; }
+  /**
+   * Подвешивание нового корня к заголовку. Крайние узлы вычисляются заново
+   * за O(log n)
+   * @param root корень (nullptr - дерево становится пустым)
+   */
+  void SetRoot(Node *root);
+  /**
+   * Отцепление всех узлов от заголовка, дерево становится пустым
+   * @return корень отцепленного поддерева (его parent - nullptr)
+   */
+  Node *Detach();
+  /**
+   * Перенос узлов other в текущее пустое дерево за O(1)
+   * @param other дерево, становится пустым
+   */
+  void StealNodes(AvlTree &other);
+  /**
+   * Заголовок дерева, как _Rb_tree_header в libstdc++: parent - корень, left -
+   * минимальный узел, right - максимальный. Заголовок служит узлом end(),
+   * родитель корня - заголовок. У пустого дерева left и right указывают на
+   * сам заголовок
+   */
+  Node _header;
   size_t _size{};  /// количество элементов в дереве
+  /// пул памяти под узлы дерева, общий для деревьев, обменявшихся узлами.
+  /// Общий пул потокобезопасен, см. NodePool::Share
+  std::shared_ptr<NodePool<Node>> _pool;
  public:
   class Iterator;
   class ConstIterator;
+  /// тип ключа
+  using key_type = Key;
   /// тип данных
-  using value_type = T;
+  using value_type = Value;
+  /// сравнение ключей
+  using key_compare = Compare;
   /// ссылка на тип данных
-  using reference = T &;
+  using reference = Value &;
   /// константная ссылка на тип данных
-  using const_reference = const T &;
+  using const_reference = const Value &;
   using iterator = Iterator;
   using const_iterator = ConstIterator;  // TODO
+  class NodeHandle;
 
   /// определение класса итератора дерева
   class Iterator {
    private:
-    Node *cur_node;
-    Node *prev_node;
+    friend class AvlTree;
+    Node *cur_node;  /// текущий узел, для end() - заголовок дерева
     void swap(iterator &other);
 
    public:
+    /// типы для std::iterator_traits
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value *;
+    using reference = Value &;
     Iterator();
     /**
-     * Итератор от корня дерева. Можно создать итератор и от любого другого узла
-     * дерева, указав при этом предыдущий узел
-     * @param cur_node корень дерева
-     * @param prev_node узел, предшествующий cur_node (не родительский, а
-     * предыдущий в порядке расположения узлов на дереве)
+     * Итератор на узел дерева
+     * @param cur_node узел дерева или заголовок (итератор end())
      */
-    explicit Iterator(Node *cur_node, Node *prev_node = nullptr);
+    explicit Iterator(Node *cur_node);
     Iterator(const iterator &other);
     iterator &operator=(const iterator &other);
     iterator &operator++();
     const iterator operator++(int);
     iterator &operator--();
     const iterator operator--(int);
-    virtual reference operator*() const;
+    reference operator*() const;
     bool operator==(const iterator &it) const;
     bool operator!=(const iterator &it) const;
     ~Iterator() = default;
@@ -216,107 +714,450 @@ class AvlTree {
     explicit ConstIterator(const Iterator &other);
     const_reference operator*() const;
   };
+
+  /**
+   * Дескриптор извлеченного узла (node handle). Владеет узлом, вынутым из
+   * дерева через Extract, пока его не вставят в дерево того же типа.
+   * Значение при этом не копируется и не перемещается, память не выделяется
+   */
+  class NodeHandle {
+   public:
+    NodeHandle() = default;
+    NodeHandle(NodeHandle &&other) noexcept
+        : _node(other._node), _pool(std::move(other._pool)) {
+      other._node = nullptr;
+    }
+    NodeHandle &operator=(NodeHandle &&other) noexcept {
+      if (this != &other) {
+        Reset();
+        _node = other._node;
+        _pool = std::move(other._pool);
+        other._node = nullptr;
+      }
+      return *this;
+    }
+    /// деструктор, разрушает значение и возвращает узел в его пул
+    ~NodeHandle() { Reset(); }
+    /// пуст ли дескриптор
+    bool empty() const { return _node == nullptr; }
+    explicit operator bool() const { return _node != nullptr; }
+    /// значение узла
+    reference value() const { return _node->value; }
+    /// ключ узла. Его можно изменить до вставки в дерево
+    key_type &key() const {
+      return const_cast<key_type &>(KeyOfValue()(_node->value));
+    }
+    /// отображаемое значение узла пары ключ-значение
+    template <typename V = Value>
+    typename V::second_type &mapped() const {
+      return _node->value.second;
+    }
+    void swap(NodeHandle &other) noexcept {
+      std::swap(_node, other._node);
+      _pool.swap(other._pool);
+    }
+
+   private:
+    friend class AvlTree;
+    NodeHandle(Node *node, std::shared_ptr<NodePool<Node>> pool)
+        : _node(node), _pool(std::move(pool)) {}
+    void Reset() noexcept {
+      if (_node) {
+        _node->value.~Value();
+        _node->~Node();
+        NodePool<Node>::Resolve(_pool)->Deallocate(_node);
+        _node = nullptr;
+      }
+      _pool.reset();
+    }
+
+    Node *_node = nullptr;                 /// одиночный узел вне дерева
+    std::shared_ptr<NodePool<Node>> _pool;  /// владелец памяти узла
+  };
   /// конструктор по умолчанию
   AvlTree();
   /**
    * конструктор с параметром
    * @param value инициализирующее значение
-   * @param unique уникальность значений дерева. True - запрет дубликатов, false
-   * - дубликаты возможны
    */
-  explicit AvlTree(value_type value, bool unique = false)
-      : _root(new Node(value)), _unique(unique), _size(1) {}
+  explicit AvlTree(const_reference value) : _size(1) {
+    SetRoot(CreateNode(value));
+  }
   /**
    * конструктор копирования
    * @param other объект для копирования
    */
   AvlTree(const AvlTree &other);
+  /**
+   * Копия дерева: все узлы в одном непрерывном блоке в симметричном
+   * порядке, большие поддеревья копируются параллельно
+   * @param pool пул потоков для параллельного копирования
+   * @return копия дерева
+   */
+  AvlTree Clone(ThreadPool &pool = ThreadPool::Instance()) const;
   /**
    * Конструктор перемещения
    * @param other объект для перемещения
    */
-  AvlTree(AvlTree<T> &&other) noexcept {
-    // Переносим ресурсы из объекта other в текущий объект
-    // Например, переносим указатель на корень дерева
-    _root = other._root;
-    _unique = other._unique;
-    _size = other._size;
-    // Обнуляем ресурсы в объекте other, чтобы избежать двойного освобождения
-    other._root = nullptr;
-    other._size = 0;
-    other._unique = false;
+  AvlTree(AvlTree &&other) noexcept {
+    // Переносим узлы из объекта other в текущий объект, other становится
+    // пустым
+    SetRoot(nullptr);
+    _pool = std::move(other._pool);
+    StealNodes(other);
   }
+  /**
+   * Оператор перемещающего присваивания. Узлы не копируются
+   * @param other объект для перемещения
+   * @return текущий объект
+   */
+  AvlTree &operator=(AvlTree &&other) noexcept;
 
   /**
    * вставка в дерево
    * @param value значение для вставки
    * @return iterator с указателем на корень, bool - удалось ли вставить
    */
-  std::pair<iterator, bool> Insert(value_type value);
+  std::pair<iterator, bool> Insert(const_reference value);
+  /**
+   * вставка в дерево перемещением
+   * @param value значение для вставки
+   * @return iterator с указателем на корень, bool - удалось ли вставить
+   */
+  std::pair<iterator, bool> Insert(value_type &&value);
+  /**
+   * создание значения на месте из аргументов конструктора
+   * @param args аргументы конструктора значения
+   * @return iterator на новый (или уже существующий при Unique = true)
+   * элемент, bool - удалось ли вставить
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> Emplace(Args &&...args);
+  /**
+   * вставка значения с подсказкой позиции. Если значение должно оказаться
+   * непосредственно перед hint, место находится за O(1) сравнений ключей без
+   * спуска от корня, иначе как обычная вставка. Сама вставка остается
+   * O(log n): размеры поддеревьев и агрегаты обновляются до корня, на них
+   * опираются порядковая статистика, Split/Join и слияние
+   * @param hint итератор на элемент, перед которым, вероятно, окажется
+   * значение (end() - после максимума)
+   * @param value значение для вставки
+   * @return iterator на новый (или уже существующий при Unique = true)
+   * элемент
+   */
+  iterator Insert(iterator hint, const_reference value);
+  iterator Insert(iterator hint, value_type &&value);
+  /**
+   * создание значения на месте с подсказкой позиции, см. Insert(hint, value)
+   * @param hint итератор на элемент, перед которым, вероятно, окажется
+   * значение
+   * @param args аргументы конструктора значения
+   * @return iterator на новый (или уже существующий при Unique = true)
+   * элемент
+   */
+  template <typename... Args>
+  iterator EmplaceHint(iterator hint, Args &&...args);
+  /**
+   * создание значения на месте, только если ключа еще нет (Unique = true).
+   * Место вставки ищется одним спуском по key до создания значения, поэтому
+   * при существующем ключе значение не создается
+   * @param key ключ, равный ключу создаваемого значения
+   * @param args аргументы конструктора значения
+   * @return iterator на новый или уже существующий элемент и true/false
+   * вставилось ли значение
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(const key_type &key, Args &&...args);
   /**
    * вывод дерева на экран по правилу корень-лево-право
    */
   void Print();
   /**
    * Проверка включения
-   * @param value значение для проверки
+   * @tparam K тип ключа, сравнимый с Key через Compare
+   * @param key ключ для проверки
    * @return содержится/не содержится в дереве
-   * @warning при вставке дубликата при параметре unique = true возвращает
-   * итератор end()
    */
-  bool Include(value_type value);
+  template <typename K>
+  bool Include(const K &key);
   /**
    * Нахождение элемента в дереве
-   * @param value значение для поиска
-   * @return итератор на найденный элемент. пустой итератор если ничего не
+   * @tparam K тип ключа, сравнимый с Key через Compare
+   * @param key ключ для поиска
+   * @return итератор на первый элемент с ключом key, end() если ничего не
    * найдено
    */
-  iterator Find(value_type value);
+  template <typename K>
+  iterator Find(const K &key);
   /**
    * удаление элемента из дерева
-   * @param value значение для удаления
+   * @param key ключ удаляемого элемента
    * @warning может быть ошибка при удалении объекта под который была выделена
    * память вне функции. Поэтому добавляйте объекты только с деструкторами.
    */
-  void Remove(value_type value);
+  void Remove(const key_type &key);
+  /**
+   * Удаление элемента по итератору без повторного поиска: узел
+   * отвязывается, балансировка идет от него к корню по ссылкам на родителя.
+   * Среди равных ключей удаляется именно элемент pos
+   * @param pos итератор на удаляемый элемент
+   * @return итератор на следующий элемент
+   */
+  iterator Erase(iterator pos);
+  /**
+   * Извлечение узла из дерева без разрушения значения за O(log n)
+   * @param pos итератор на извлекаемый элемент
+   * @return дескриптор узла
+   */
+  NodeHandle Extract(iterator pos);
+  /**
+   * Извлечение первого узла с ключом key
+   * @param key ключ извлекаемого элемента
+   * @return дескриптор узла, пустой если ключа нет
+   */
+  NodeHandle Extract(const key_type &key);
+  /**
+   * Вставка извлеченного узла. Память не выделяется, значение не
+   * копируется
+   * @param handle дескриптор узла. При успешной вставке становится пустым,
+   * при повторе ключа (Unique = true) узел остается в нем
+   * @return iterator на вставленный (или уже существующий) элемент, bool -
+   * удалось ли вставить. Для пустого дескриптора end() и false
+   */
+  std::pair<iterator, bool> Insert(NodeHandle &&handle);
+  /**
+   * Вставка извлеченного узла с подсказкой позиции, см. Insert(hint, value)
+   * @param hint итератор на элемент, перед которым, вероятно, окажется узел
+   * @param handle дескриптор узла
+   * @return iterator на вставленный (или уже существующий) элемент
+   */
+  iterator Insert(iterator hint, NodeHandle &&handle);
+  /**
+   * Перенос в дерево узлов other, ключей которых в дереве нет (при
+   * Unique = false переносятся все). Узлы перевешиваются без копирования,
+   * остальные остаются в other в прежнем порядке. Работа на split/join,
+   * O(m log(n/m + 1)), как у Union
+   * @param other дерево-источник
+   */
+  void Absorb(AvlTree &other);
+  /**
+   * Обмен содержимым с деревом other за O(1)
+   * @param other дерево для обмена
+   */
+  void Swap(AvlTree &other) noexcept;
   /**
    * Получение элемента корня дерева
    * @return
    */
-  T Top();
+  Value Top();
   /**
    * Проверка на пустое дерево
    * @return пустое ли дерево
    */
-  bool IsEmpty() { return _root == nullptr; }
+  bool IsEmpty() { return Root() == nullptr; }
   /**
    * Подсчет дубликатов
-   * @param value значение для подсчета
+   * @tparam K тип ключа, сравнимый с Key через Compare
+   * @param key ключ для подсчета
    * @return количество дубликатов
    */
-  int Count(const_reference value) const;
+  template <typename K>
+  int Count(const K &key) const;
   /**
-   * Проверка возможности добавления дубликатов в дерево
-   * @return true - значения в дереве уникальны, false - возможно добавление
-   * дубликатов
+   * k-й по порядку элемент дерева (порядковая статистика) за O(log n)
+   * @param k номер элемента, начиная с 0
+   * @return итератор на элемент, end() если k >= size()
+   */
+  iterator Select(size_t k);
+  /**
+   * Ранг ключа за O(log n)
+   * @tparam K тип ключа, сравнимый с Key через Compare
+   * @param key ключ для сравнения
+   * @return количество элементов дерева, ключи которых строго меньше key
+   */
+  template <typename K>
+  size_t Rank(const K &key) const;
+  /**
+   * Количество элементов в полуинтервале [lo, hi) за O(log n)
+   * @tparam K тип ключа, сравнимый с Key через Compare
+   * @param lo нижняя граница (включительно)
+   * @param hi верхняя граница (не включительно)
+   * @return количество элементов
+   */
+  template <typename K>
+  size_t CountRange(const K &lo, const K &hi) const;
+  /**
+   * Обход элементов по возрастанию ключей с отсечением поддеревьев по
+   * дополнительным значениям узлов (см. augment_policy). Кроме поддеревьев,
+   * где есть нужные элементы, посещается O(log n) узлов
+   * @param prune prune(augment) - в поддереве нет нужных элементов
+   * @param past past(key) - элемент с этим ключом и все следующие не нужны
+   * @param visit visit(iterator) вызывается для каждого элемента из
+   * неотсеченных поддеревьев, подходит ли сам элемент, проверяет visit
+   */
+  template <typename Prune, typename Past, typename Visit>
+  void ForEachPruned(Prune prune, Past past, Visit visit);
+  /**
+   * Объединение дополнительных значений элементов с ключами из
+   * полуинтервала [lo, hi) за O(log n): спуск до первого узла внутри
+   * полуинтервала и по двум его границам
+   * @tparam K тип ключа, сравнимый с Key через Compare
+   * @param lo нижняя граница (включительно)
+   * @param hi верхняя граница (не включительно)
+   * @return std::optional значения augment_policy, пустой без элементов
    */
-  void SetUnique();
+  template <typename K>
+  auto FoldRange(const K &lo, const K &hi) const;
+  /// Объединение значений всех элементов за O(1), пустое для пустого дерева
+  auto Fold() const;
+  /**
+   * Пересчет дополнительных значений от элемента до корня за O(log n).
+   * Вызывается после изменения значения элемента на месте
+   * @param pos итератор на измененный элемент
+   */
+  void Refresh(iterator pos);
+  /**
+   * Первый элемент с ключом, не меньшим key, за O(log n)
+   * @tparam K тип ключа, сравнимый с Key через Compare
+   * @param key ключ для сравнения
+   * @return итератор на элемент, end() если такого нет
+   */
+  template <typename K>
+  iterator LowerBound(const K &key);
+  /**
+   * Первый элемент с ключом, большим key, за O(log n)
+   * @tparam K тип ключа, сравнимый с Key через Compare
+   * @param key ключ для сравнения
+   * @return итератор на элемент, end() если такого нет
+   */
+  template <typename K>
+  iterator UpperBound(const K &key);
   /**
    * Проверка уникальности
-   * @return
+   * @return true - ключи в дереве уникальны, false - возможно добавление
    * дубликатов
    */
-  bool IsUnique() { return _unique; }
+  static constexpr bool IsUnique() { return Unique; }
   /// Количество элементов в дереве
   size_t size() { return _size; }
+  /// Удаление всех элементов дерева. Память узлов возвращается целыми блоками
+  void Clear();
+  /**
+   * Замена содержимого дерева элементами упорядоченного диапазона за O(n).
+   * Дерево строится снизу вверх без поворотов, при Unique = true повторы
+   * отбрасываются (остается первый)
+   * @param first начало диапазона
+   * @param last конец диапазона
+   * @warning диапазон должен быть отсортирован по ключам в порядке Compare
+   */
+  template <typename InputIt>
+  void AssignSorted(InputIt first, InputIt last);
+  /**
+   * Замена содержимого дерева элементами произвольного диапазона. Элементы
+   * один раз сортируются (устойчиво), после чего дерево строится как в
+   * AssignSorted
+   * @param first начало диапазона
+   * @param last конец диапазона
+   */
+  template <typename InputIt>
+  void Assign(InputIt first, InputIt last);
+  /**
+   * Разделение дерева по ключу за O(log n). В дереве остаются элементы с
+   * ключами меньше key, остальные переходят в результат. Узлы не копируются
+   * @param key ключ разделения
+   * @return дерево с элементами не меньше key
+   */
+  AvlTree Split(const key_type &key);
+  /**
+   * Присоединение дерева справа за O(log n). Узлы right переходят в текущее
+   * дерево, right становится пустым и без пула
+   * @param right дерево для присоединения
+   * @warning все элементы right должны быть не меньше элементов дерева
+   */
+  void Join(AvlTree &&right);
+  /**
+   * Извлечение элементов с номерами [first, last) за O(log n): два разделения
+   * по рангу и соединение оставшихся частей. Узлы не копируются
+   * @param first номер первого извлекаемого элемента
+   * @param last номер элемента после последнего извлекаемого
+   * @return дерево с извлеченными элементами в общем пуле (пустое и без
+   * пула для пустого диапазона). Пул потокобезопасен, оба дерева можно
+   * использовать из разных потоков
+   */
+  AvlTree ExtractRank(size_t first, size_t last);
+  /**
+   * Извлечение элементов с ключами из полуинтервала [lo, hi) за O(log n)
+   * @param lo нижняя граница (включительно)
+   * @param hi верхняя граница (не включительно)
+   * @return дерево с извлеченными элементами в общем пуле (пустое и без
+   * пула для пустого диапазона). Пул потокобезопасен, оба дерева можно
+   * использовать из разных потоков
+   */
+  AvlTree ExtractRange(const key_type &lo, const key_type &hi);
+  /**
+   * Удаление элементов с номерами [first, last): вырезание за O(log n) и
+   * разрушение k удаленных узлов. Узлы возвращаются в пул дерева, пул не
+   * становится общим
+   * @param first номер первого удаляемого элемента
+   * @param last номер элемента после последнего удаляемого
+   * @return количество удаленных элементов
+   */
+  size_t EraseRank(size_t first, size_t last);
+  /**
+   * Удаление элементов с ключами из полуинтервала [lo, hi). Узлы
+   * возвращаются в пул дерева, пул не становится общим
+   * @param lo нижняя граница (включительно)
+   * @param hi верхняя граница (не включительно)
+   * @return количество удаленных элементов
+   */
+  size_t EraseRange(const key_type &lo, const key_type &hi);
+  /**
+   * Номер элемента по итератору за O(log n): подъем по родителям
+   * @param pos итератор дерева
+   * @return количество элементов перед pos, size() для end()
+   */
+  size_t IndexOf(iterator pos) const;
+  /**
+   * Объединение с деревом other (повторы - max из двух деревьев)
+   * @param other дерево, узлы которого переходят в текущее
+   * @param pool пул потоков для параллельного выполнения
+   */
+  void Union(AvlTree &&other, ThreadPool &pool = ThreadPool::Instance());
+  /**
+   * Слияние с деревом other: сохраняются все элементы обоих деревьев
+   * (при Unique = true повторы отбрасываются)
+   * @param other дерево, узлы которого переходят в текущее
+   * @param pool пул потоков для параллельного выполнения
+   */
+  void Merge(AvlTree &&other, ThreadPool &pool = ThreadPool::Instance());
+  /**
+   * Пересечение с деревом other (повторы - min из двух деревьев)
+   * @param other дерево, узлы которого освобождаются
+   * @param pool пул потоков для параллельного выполнения
+   */
+  void Intersect(AvlTree &&other, ThreadPool &pool = ThreadPool::Instance());
+  /**
+   * Разность с деревом other (каждый элемент other убирает один повтор)
+   * @param other дерево, узлы которого освобождаются
+   * @param pool пул потоков для параллельного выполнения
+   */
+  void Subtract(AvlTree &&other, ThreadPool &pool = ThreadPool::Instance());
+  /**
+   * Проверка инвариантов дерева: порядок элементов, балансировка, высоты,
+   * размеры поддеревьев и ссылки на родителей
+   * @return корректно ли дерево
+   */
+  bool Validate() const;
   /// Максимальное возможное количество элементов
   size_t max_size() {
     return std::numeric_limits<size_t>::max() / sizeof(Node);
   }
   /// деструктор
   ~AvlTree();
-  AvlTree<T> &operator=(const AvlTree<T> &other);
+  AvlTree &operator=(const AvlTree &other);
+  /// Итератор на минимальный элемент за O(1)
   iterator begin();
+  /// Итератор за последним элементом (заголовок дерева) за O(1)
   iterator end();
 };
 
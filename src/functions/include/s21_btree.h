@@ -0,0 +1,440 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_BTREE_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_BTREE_H_
+/**
+ * @file
+ * @brief B-дерево для упорядоченных контейнеров
+ * @details В отличие от Avl дерева, где на каждый элемент приходится свой
+ * узел с тремя указателями, B-дерево хранит в узле десятки значений подряд.
+ * Узел занимает несколько кэш-линий, поиск внутри узла идет по непрерывному
+ * массиву ключей (для целочисленных ключей - векторными инструкциями SSE2),
+ * а высота дерева в разы меньше. Платой служит перемещение значений внутри
+ * узлов при вставке и удалении: итераторы B-дерева становятся
+ * недействительными после любой вставки или удаления.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "s21_avltree.h"
+
+namespace s21 {
+
+/// Поиск позиции ключа в узле B-дерева векторными инструкциями
+namespace btree_simd {
+
+/**
+ * Количество элементов упорядоченного массива, строго меньших ключа
+ * @details элементы сравниваются блоками по 16 байт, просмотр
+ * останавливается на первом блоке, где меньше ключа не все элементы
+ * @tparam T целочисленный тип размером 4 или 8 байт
+ * @param keys упорядоченный по возрастанию массив
+ * @param count размер массива
+ * @param key ключ
+ * @return индекс первого элемента, не меньшего ключа
+ */
+template <typename T>
+int CountLess(const T *keys, int count, T key);
+/**
+ * Количество элементов упорядоченного массива, не больших ключа, см.
+ * CountLess
+ * @return индекс первого элемента, большего ключа
+ */
+template <typename T>
+int CountNotGreater(const T *keys, int count, T key);
+
+}  // namespace btree_simd
+
+/**
+ * Можно ли искать ключ в узле через btree_simd: значения - сами ключи,
+ * целые числа размером 4 или 8 байт, порядок - обычное сравнение <
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+struct BTreeSimdSearch
+    : std::integral_constant<
+          bool, std::is_same<Key, Value>::value &&
+                    std::is_same<KeyOfValue, Identity<Key>>::value &&
+                    std::is_integral<Key>::value &&
+                    !std::is_same<Key, bool>::value &&
+                    (sizeof(Key) == 4 || sizeof(Key) == 8) &&
+                    (std::is_same<Compare, std::less<Key>>::value ||
+                     std::is_same<Compare, std::less<>>::value)> {};
+
+/**
+ * Шаблон класса B-дерево
+ * @details политики Key, Value, KeyOfValue, Compare и Unique совпадают с
+ * политиками AvlTree, поэтому поверх B-дерева строятся те же множества и
+ * словари. Все значения узла хранятся в одном массиве, у внутренних узлов
+ * дополнительно есть массив из count + 1 дочерних узлов. Каждый узел, кроме
+ * корня, заполнен не меньше чем наполовину, все листья на одной глубине
+ * @tparam Key тип ключа
+ * @tparam Value тип хранимого значения
+ * @tparam KeyOfValue функтор, возвращающий ключ значения
+ * @tparam Compare строгий порядок на ключах
+ * @tparam Unique true - дубликаты ключей запрещены, false - разрешены
+ * @tparam NodeBytes целевой размер листа в байтах, определяет количество
+ * значений в узле (не меньше трех)
+ */
+template <typename Key, typename Value = Key,
+          typename KeyOfValue = Identity<Key>,
+          typename Compare = std::less<Key>, bool Unique = false,
+          std::size_t NodeBytes = 256>
+class BTree {
+ private:
+  struct Node;
+  struct InternalNode;
+  /// служебная часть узла
+  struct NodeHeader {
+    InternalNode *parent = nullptr;  /// родитель, у корня nullptr
+    unsigned short position = 0;     /// номер узла среди детей родителя
+    unsigned short count = 0;        /// количество значений в узле
+    bool leaf = true;                /// лист или внутренний узел
+  };
+  static constexpr std::size_t kFit =
+      NodeBytes > sizeof(NodeHeader)
+          ? (NodeBytes - sizeof(NodeHeader)) / sizeof(Value)
+          : 0;
+
+ public:
+  /// наибольшее количество значений в узле
+  static constexpr int kMaxValues = kFit < 3 ? 3 : kFit > 1024 ? 1024 : kFit;
+  /// наименьшее количество значений в узле, кроме корня
+  static constexpr int kMinValues = (kMaxValues - 1) / 2;
+
+ private:
+  /// лист: служебная часть и массив значений
+  struct Node : NodeHeader {
+    alignas(Value) unsigned char storage[kMaxValues * sizeof(Value)];
+  };
+  /// внутренний узел: лист и массив дочерних узлов
+  struct InternalNode : Node {
+    Node *children[kMaxValues + 1];
+  };
+  /// поиск в узле через btree_simd
+  static constexpr bool kSimd =
+      BTreeSimdSearch<Key, Value, KeyOfValue, Compare>::value;
+  /// значения перемещаются побайтовым копированием
+  static constexpr bool kTrivialRelocate =
+      std::is_trivially_copy_constructible<Value>::value &&
+      std::is_trivially_destructible<Value>::value;
+
+  Node *_root = nullptr;  /// корень, у пустого дерева nullptr
+  std::size_t _size = 0;  /// количество элементов в дереве
+
+ public:
+  /**
+   * Итератор B-дерева: узел и номер значения в нем. Итератор end() -
+   * корень и номер, равный количеству значений в корне
+   * @tparam Const константный итератор или нет
+   */
+  template <bool Const>
+  class IteratorImpl {
+   private:
+    friend class BTree;
+    template <bool>
+    friend class IteratorImpl;
+    Node *_node = nullptr;  /// узел
+    int _position = 0;      /// номер значения в узле
+
+   public:
+    /// типы для std::iterator_traits
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const Value *, Value *>;
+    using reference = std::conditional_t<Const, const Value &, Value &>;
+    IteratorImpl() = default;
+    /**
+     * Итератор на значение узла
+     * @param node узел
+     * @param position номер значения в узле
+     */
+    IteratorImpl(Node *node, int position)
+        : _node(node), _position(position) {}
+    /// преобразование неконстантного итератора в константный
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    IteratorImpl(const IteratorImpl<false> &other)
+        : _node(other._node), _position(other._position) {}
+    reference operator*() const { return *Slot(_node, _position); }
+    pointer operator->() const { return Slot(_node, _position); }
+    IteratorImpl &operator++() {
+      Next(_node, _position);
+      return *this;
+    }
+    IteratorImpl operator++(int) {
+      IteratorImpl old = *this;
+      Next(_node, _position);
+      return old;
+    }
+    IteratorImpl &operator--() {
+      Prev(_node, _position);
+      return *this;
+    }
+    IteratorImpl operator--(int) {
+      IteratorImpl old = *this;
+      Prev(_node, _position);
+      return old;
+    }
+    template <bool C>
+    bool operator==(const IteratorImpl<C> &other) const {
+      return _node == other._node && _position == other._position;
+    }
+    template <bool C>
+    bool operator!=(const IteratorImpl<C> &other) const {
+      return !(*this == other);
+    }
+  };
+
+  /// тип ключа
+  using key_type = Key;
+  /// тип данных
+  using value_type = Value;
+  /// сравнение ключей
+  using key_compare = Compare;
+  using iterator = IteratorImpl<false>;
+  using const_iterator = IteratorImpl<true>;
+
+  BTree() = default;
+  /**
+   * Конструктор копирования. Узлы копируются целиком, без перебалансировки
+   * @param other дерево для копирования
+   */
+  BTree(const BTree &other);
+  /**
+   * Конструктор перемещения за O(1)
+   * @param other дерево для перемещения
+   */
+  BTree(BTree &&other) noexcept
+      : _root(std::exchange(other._root, nullptr)),
+        _size(std::exchange(other._size, 0)) {}
+  BTree &operator=(const BTree &other);
+  BTree &operator=(BTree &&other) noexcept;
+  /// деструктор
+  ~BTree() { Clear(); }
+
+  iterator begin() { return iterator(LeftmostLeaf(), 0); }
+  iterator end() { return iterator(_root, _root ? _root->count : 0); }
+  const_iterator begin() const { return const_iterator(LeftmostLeaf(), 0); }
+  const_iterator end() const {
+    return const_iterator(_root, _root ? _root->count : 0);
+  }
+  /// Пустое ли дерево
+  bool IsEmpty() const { return _size == 0; }
+  /// Количество элементов
+  std::size_t size() const { return _size; }
+  /// Максимальное количество элементов
+  std::size_t max_size() const {
+    return std::numeric_limits<std::size_t>::max() / sizeof(Value);
+  }
+  /// Удаление всех элементов
+  void Clear();
+  /// Обмен содержимым за O(1)
+  void Swap(BTree &other) noexcept {
+    std::swap(_root, other._root);
+    std::swap(_size, other._size);
+  }
+
+  /**
+   * Вставка значения
+   * @param value значение
+   * @return итератор на вставленный (или равный ему) элемент и признак
+   * вставки. При Unique = false вставка всегда удается, новый элемент
+   * становится последним среди равных
+   */
+  std::pair<iterator, bool> Insert(const Value &value) {
+    return InsertValue(value);
+  }
+  std::pair<iterator, bool> Insert(Value &&value) {
+    return InsertValue(std::move(value));
+  }
+  /**
+   * Вставка с подсказкой позиции. Если значение должно оказаться
+   * непосредственно перед hint, спуск от корня не выполняется
+   * @param hint итератор на элемент, перед которым, вероятно, окажется новый
+   * @param value значение
+   * @return итератор на вставленный (или равный ему) элемент
+   */
+  iterator Insert(const_iterator hint, const Value &value) {
+    return EmplaceHint(hint, value);
+  }
+  iterator Insert(const_iterator hint, Value &&value) {
+    return EmplaceHint(hint, std::move(value));
+  }
+  /**
+   * Создание значения из аргументов конструктора и его вставка
+   * @param args аргументы конструктора значения
+   * @return см. Insert
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> Emplace(Args &&...args) {
+    return InsertValue(Value(std::forward<Args>(args)...));
+  }
+  /**
+   * Создание значения и вставка с подсказкой позиции, см. Insert
+   * @param hint итератор на элемент, перед которым, вероятно, окажется новый
+   * @param args аргументы конструктора значения
+   * @return итератор на вставленный (или равный ему) элемент
+   */
+  template <typename... Args>
+  iterator EmplaceHint(const_iterator hint, Args &&...args);
+  /**
+   * Удаление элемента. Все итераторы дерева становятся недействительными
+   * @param pos итератор на элемент
+   */
+  void Erase(const_iterator pos);
+  /**
+   * Перенос элементов другого дерева того же типа. При Unique = true
+   * элементы, ключи которых уже есть в дереве, остаются в other
+   * @param other дерево-источник
+   */
+  void Absorb(BTree &other);
+
+  /**
+   * Поиск по ключу
+   * @tparam K тип ключа, сравнимого со значениями через Compare
+   * @param key ключ
+   * @return итератор на первый элемент с ключом, end() если его нет
+   */
+  template <typename K>
+  iterator Find(const K &key) const;
+  /// Есть ли элемент с ключом
+  template <typename K>
+  bool Include(const K &key) const {
+    return Find(key) != end();
+  }
+  /// Первый элемент, не меньший ключа
+  template <typename K>
+  iterator LowerBound(const K &key) const;
+  /// Первый элемент, больший ключа
+  template <typename K>
+  iterator UpperBound(const K &key) const;
+  /// Количество элементов с ключом
+  template <typename K>
+  std::size_t Count(const K &key) const;
+
+  /**
+   * Память, занятая деревом: объект дерева и все узлы
+   * @return размер в байтах без учета служебных данных malloc
+   */
+  std::size_t MemoryUsage() const;
+  /**
+   * Проверка инвариантов B-дерева: порядок ключей, заполненность узлов,
+   * одинаковая глубина листьев, ссылки на родителей и размер
+   * @return true если дерево корректно
+   */
+  bool Validate() const;
+
+ private:
+  /// значение номер i узла
+  static Value *Slot(Node *node, int i) {
+    return reinterpret_cast<Value *>(node->storage) + i;
+  }
+  static const Value *Slot(const Node *node, int i) {
+    return reinterpret_cast<const Value *>(node->storage) + i;
+  }
+  /// ключ значения номер i узла
+  static const Key &KeyAt(const Node *node, int i) {
+    return KeyOfValue()(*Slot(node, i));
+  }
+  /// массив дочерних узлов внутреннего узла
+  static Node **Children(Node *node) {
+    return static_cast<InternalNode *>(node)->children;
+  }
+  static Node *const *Children(const Node *node) {
+    return static_cast<const InternalNode *>(node)->children;
+  }
+  /// Должен ли ключ a стоять перед b (при Unique = false равные допустимы)
+  static bool Precedes(const Key &a, const Key &b) {
+    if constexpr (Unique) {
+      return Compare()(a, b);
+    } else {
+      return !Compare()(b, a);
+    }
+  }
+  /// переход к следующему значению в порядке обхода
+  static void Next(Node *&node, int &position);
+  /// переход к предыдущему значению, false если его нет
+  static bool Prev(Node *&node, int &position);
+  /// самый левый лист, nullptr у пустого дерева
+  Node *LeftmostLeaf() const;
+  /// номер первого значения узла, не меньшего ключа
+  template <typename K>
+  static int LowerIndex(const Node *node, const K &key);
+  /// номер первого значения узла, большего ключа
+  template <typename K>
+  static int UpperIndex(const Node *node, const K &key);
+
+  /// новый лист или внутренний узел
+  static Node *NewNode(bool leaf);
+  /// освобождение памяти узла, значения должны быть разрушены
+  static void DeleteNode(Node *node) noexcept;
+  /// разрушение значений и освобождение всех узлов поддерева
+  static void DestroySubtree(Node *node) noexcept;
+  /// копия поддерева
+  static Node *CloneSubtree(const Node *src);
+  /**
+   * Перемещение значений [first, last) узла src в узел dst начиная с dest.
+   * Узлы могут совпадать, диапазоны могут перекрываться. Исходные значения
+   * разрушаются, счетчики узлов не меняются
+   */
+  static void Relocate(Node *src, int first, int last, Node *dst, int dest);
+  /**
+   * Перемещение дочерних узлов [first, last] узла src в узел dst начиная с
+   * dest с обновлением ссылок на родителя и позиций
+   */
+  static void MoveChildren(Node *src, int first, int last, Node *dst,
+                           int dest);
+  /// обновление ссылок на родителя у дочерних узлов [first, last]
+  static void FixChildren(Node *node, int first, int last);
+
+  /// вставка значения с поиском позиции от корня
+  template <typename V>
+  std::pair<iterator, bool> InsertValue(V &&value);
+  /**
+   * Создание значения в листе. Полный лист предварительно делится
+   * @param leaf лист
+   * @param position номер нового значения в листе
+   * @param args аргументы конструктора значения
+   * @return итератор на новый элемент
+   */
+  template <typename... Args>
+  iterator EmplaceAt(Node *leaf, int position, Args &&...args);
+  /**
+   * Деление полного узла пополам: медиана переходит в родителя, правая
+   * половина - в новый узел справа. Полный родитель делится первым, при
+   * делении корня дерево растет на один уровень
+   */
+  void SplitNode(Node *node);
+  /// восстановление заполненности узла после удаления значения
+  void Rebalance(Node *node);
+  /// перенос значения из левого соседа через разделитель separator
+  static void RotateRight(Node *parent, int separator);
+  /// перенос значения из правого соседа через разделитель separator
+  static void RotateLeft(Node *parent, int separator);
+  /// слияние детей separator и separator + 1 вместе с разделителем
+  static void MergeChildren(Node *parent, int separator);
+  /// проверка поддерева, возвращает глубину листьев или -1
+  static int ValidateSubtree(const Node *node, std::size_t &count);
+  /// память поддерева
+  static std::size_t SubtreeMemory(const Node *node);
+};
+
+}  // namespace s21
+
+#include "../templates/s21_btree.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_BTREE_H_
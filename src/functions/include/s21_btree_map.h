@@ -0,0 +1,229 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_BTREE_MAP_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_BTREE_MAP_H_
+/**
+ * @file
+ * @brief Словарь на основе B-дерева
+ * @details Интерфейс повторяет s21::map. Отличия: итераторы становятся
+ * недействительными после любой вставки или удаления, нет дескрипторов
+ * узлов и порядковой статистики. Пары хранятся в узле подряд, поэтому поиск
+ * в узле идет двоичным поиском по ключам пар
+ */
+
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+
+#include "s21_btree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+/**
+ * Словарь с уникальными ключами на основе B-дерева
+ * @tparam Key тип ключа
+ * @tparam T тип значения
+ * @tparam Compare строгий порядок на ключах
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class btree_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+
+ private:
+  /// B-дерево пар с уникальными ключами
+  using tree_type =
+      BTree<Key, value_type, SelectFirst<value_type>, Compare, true>;
+  tree_type _tree;
+
+ public:
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = std::size_t;
+
+  btree_map() = default;
+  /**
+   * Конструктор с инициализацией из переменного списка пар
+   * @param items список пар
+   */
+  btree_map(std::initializer_list<value_type> const &items);
+  /**
+   * Конструктор из диапазона пар
+   * @tparam InputIt Тип итератора диапазона
+   * @param first Начало диапазона
+   * @param last Конец диапазона
+   */
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::iterator_category>
+  btree_map(InputIt first, InputIt last);
+  btree_map(const btree_map &other) = default;
+  btree_map(btree_map &&other) noexcept = default;
+  btree_map &operator=(const btree_map &other) = default;
+  btree_map &operator=(btree_map &&other) noexcept = default;
+  ~btree_map() = default;
+
+  /// @brief доступ к значению по ключу с проверкой валидности ключа. Если ключ
+  /// не найден, кидает ошибку std::out_of_range
+  /// @param key ключ словаря
+  /// @return ссылка на значение, соответстующее ключу
+  mapped_type &at(const Key &key);
+  const mapped_type &at(const Key &key) const;
+  /// @brief доступ к значению по ключу; запись новой пары ключ-значение,
+  /// если ключа нет
+  /// @param key ключ словаря
+  /// @return ссылка на значение, соответстующее ключу
+  mapped_type &operator[](const Key &key);
+
+  iterator begin() { return _tree.begin(); }
+  iterator end() { return _tree.end(); }
+  const_iterator begin() const { return _tree.begin(); }
+  const_iterator end() const { return _tree.end(); }
+  /// Проверяет пустая ли коллекция
+  bool empty() const { return _tree.IsEmpty(); }
+  /// Возвращает размер коллекции
+  size_type size() const { return _tree.size(); }
+  /// Возвращает максимальный размер
+  size_type max_size() const { return _tree.max_size(); }
+  /// Очищает коллекцию
+  void clear() { _tree.Clear(); }
+  /**
+   * Вставка пары
+   * @param value пара ключ-значение
+   * @return итератор на вставленную (или существующую) пару и признак
+   * вставки
+   */
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return _tree.Insert(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return _tree.Insert(std::move(value));
+  }
+  /**
+   * Вставка пары с подсказкой позиции
+   * @param hint Итератор на пару, перед которой, вероятно, окажется новая
+   * @param value пара ключ-значение
+   * @return итератор на вставленную (или существующую) пару
+   */
+  iterator insert(const_iterator hint, const value_type &value) {
+    return _tree.Insert(hint, value);
+  }
+  iterator insert(const_iterator hint, value_type &&value) {
+    return _tree.Insert(hint, std::move(value));
+  }
+  /**
+   * Вставка пары из ключа и значения
+   * @param key ключ
+   * @param obj значение
+   * @return см. insert(const value_type &)
+   */
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return _tree.Emplace(key, obj);
+  }
+  /**
+   * Вставка пары или замена значения существующего ключа
+   * @param key ключ
+   * @param obj значение
+   * @return итератор на пару и true, если пара вставлена
+   */
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj);
+  /**
+   * Создание пары из аргументов конструктора и ее вставка
+   * @param args аргументы конструктора пары
+   * @return см. insert(const value_type &)
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return _tree.Emplace(std::forward<Args>(args)...);
+  }
+  /// Создание пары и вставка с подсказкой позиции
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return _tree.EmplaceHint(hint, std::forward<Args>(args)...);
+  }
+  /**
+   * Вставка нескольких пар
+   * @param args Список пар
+   * @return vector пар итератора и успешности добавления. Итераторы
+   * находятся заново после всех вставок, поэтому остаются действительными
+   */
+  template <class... Args>
+  vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+  /**
+   * Удаляет пару по итератору. Итераторы коллекции становятся
+   * недействительными
+   * @param pos Итератор позиции для удаления
+   */
+  void erase(const_iterator pos) { _tree.Erase(pos); }
+  /// Обмен с другой коллекцией за O(1)
+  void swap(btree_map &other) noexcept { _tree.Swap(other._tree); }
+  /**
+   * Перенос пар другой коллекции. Пары с ключами, которые уже есть в
+   * коллекции, остаются в other
+   * @param other Коллекция для слияния
+   */
+  void merge(btree_map &other) { _tree.Absorb(other._tree); }
+  /// Проверка наличия ключа
+  bool contains(const Key &key) const { return _tree.Include(key); }
+  /// Поиск пары по ключу, end() если ее нет
+  iterator find(const Key &key) { return _tree.Find(key); }
+  const_iterator find(const Key &key) const { return _tree.Find(key); }
+  /// Количество пар с ключом (0 или 1)
+  size_type count(const Key &key) const { return _tree.Count(key); }
+  /// Первая пара с ключом, не меньшим key
+  iterator lower_bound(const Key &key) { return _tree.LowerBound(key); }
+  /// Первая пара с ключом, большим key
+  iterator upper_bound(const Key &key) { return _tree.UpperBound(key); }
+  /// Диапазон пар с ключом
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    return {lower_bound(key), upper_bound(key)};
+  }
+  /// Поиск по ключу любого типа при прозрачном компараторе Compare
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) {
+    return _tree.Find(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  mapped_type &at(const K &key) {
+    iterator it = _tree.Find(key);
+    if (it == end()) throw std::out_of_range("s21::btree_map::at: no key");
+    return it->second;
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    return _tree.Include(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K &key) const {
+    return _tree.Count(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) {
+    return _tree.LowerBound(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K &key) {
+    return _tree.UpperBound(key);
+  }
+  /// Память, занятая коллекцией, в байтах
+  size_type memory_usage() const { return _tree.MemoryUsage(); }
+};
+
+}  // namespace s21
+
+#include "../templates/s21_btree_map.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_BTREE_MAP_H_
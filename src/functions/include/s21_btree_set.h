@@ -0,0 +1,194 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_BTREE_SET_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_BTREE_SET_H_
+/**
+ * @file
+ * @brief Множество на основе B-дерева
+ * @details Интерфейс повторяет s21::set. Отличия: итераторы становятся
+ * недействительными после любой вставки или удаления, нет дескрипторов
+ * узлов и порядковой статистики
+ */
+
+#include <initializer_list>
+#include <iterator>
+
+#include "s21_btree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+/**
+ * Множество уникальных элементов на основе B-дерева
+ * @tparam T тип элемента
+ * @tparam Compare строгий порядок на элементах
+ */
+template <typename T, typename Compare = std::less<T>>
+class btree_set {
+ private:
+  /// B-дерево с уникальными значениями
+  using tree_type = BTree<T, T, Identity<T>, Compare, true>;
+  tree_type _tree;
+
+ public:
+  using key_type = T;
+  using value_type = T;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  /// элементы множества не изменяются через итератор
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = iterator;
+  using size_type = std::size_t;
+
+  btree_set() = default;
+  /**
+   * Конструктор с инициализацией из переменного списка элементов
+   * @param items список элементов
+   */
+  btree_set(std::initializer_list<value_type> const &items);
+  /**
+   * Конструктор из диапазона
+   * @tparam InputIt Тип итератора диапазона
+   * @param first Начало диапазона
+   * @param last Конец диапазона
+   */
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::iterator_category>
+  btree_set(InputIt first, InputIt last);
+  btree_set(const btree_set &s) = default;
+  btree_set(btree_set &&s) noexcept = default;
+  btree_set &operator=(const btree_set &s) = default;
+  btree_set &operator=(btree_set &&s) noexcept = default;
+  ~btree_set() = default;
+
+  iterator begin() const { return _tree.begin(); }
+  iterator end() const { return _tree.end(); }
+  /// Проверяет пустая ли коллекция
+  bool empty() const { return _tree.IsEmpty(); }
+  /// Возвращает размер коллекции
+  size_type size() const { return _tree.size(); }
+  /// Возвращает максимальный размер
+  size_type max_size() const { return _tree.max_size(); }
+  /// Очищает коллекцию
+  void clear() { _tree.Clear(); }
+  /**
+   * Операция вставки одного элемента
+   * @param value Элемент для вставки
+   * @return pair итератор на добавленный (или равный ему) элемент и булево
+   * значение успешность добавления
+   */
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return _tree.Insert(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return _tree.Insert(std::move(value));
+  }
+  /**
+   * Операция вставки с подсказкой позиции. Если элемент должен оказаться
+   * непосредственно перед hint, спуск от корня не выполняется
+   * @param hint Итератор на элемент, перед которым, вероятно, окажется новый
+   * @param value Элемент для вставки
+   * @return итератор на добавленный (или равный ему) элемент
+   */
+  iterator insert(iterator hint, const value_type &value) {
+    return _tree.Insert(hint, value);
+  }
+  iterator insert(iterator hint, value_type &&value) {
+    return _tree.Insert(hint, std::move(value));
+  }
+  /**
+   * Создание элемента из аргументов конструктора и его вставка
+   * @param args Аргументы конструктора элемента
+   * @return см. insert
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return _tree.Emplace(std::forward<Args>(args)...);
+  }
+  /// Создание элемента и вставка с подсказкой позиции, см. insert
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args &&...args) {
+    return _tree.EmplaceHint(hint, std::forward<Args>(args)...);
+  }
+  /**
+   * Вставка нескольких элементов
+   * @param args Список элементов
+   * @return vector пар итератора и успешности добавления. Итераторы
+   * находятся заново после всех вставок, поэтому остаются действительными
+   */
+  template <class... Args>
+  vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+  /**
+   * Удаляет элемент по итератору. Итераторы коллекции становятся
+   * недействительными
+   * @param pos Итератор позиции для удаления
+   */
+  void erase(iterator pos) { _tree.Erase(pos); }
+  /// Обмен с другой коллекцией за O(1)
+  void swap(btree_set &other) noexcept { _tree.Swap(other._tree); }
+  /**
+   * Перенос элементов другой коллекции. Элементы, которые уже есть в
+   * коллекции, остаются в other
+   * @param other Коллекция для слияния
+   */
+  void merge(btree_set &other) { _tree.Absorb(other._tree); }
+  /**
+   * Операция поиска по ключу
+   * @param key Ключ для поиска
+   * @return Итератор на найденный элемент, end() если его нет
+   */
+  iterator find(const key_type &key) const { return _tree.Find(key); }
+  /// Проверка наличия элемента в коллекции
+  bool contains(const key_type &key) const { return _tree.Include(key); }
+  /// Количество элементов с ключом (0 или 1)
+  size_type count(const key_type &key) const { return _tree.Count(key); }
+  /// Первый элемент, не меньший ключа
+  iterator lower_bound(const key_type &key) const {
+    return _tree.LowerBound(key);
+  }
+  /// Первый элемент, больший ключа
+  iterator upper_bound(const key_type &key) const {
+    return _tree.UpperBound(key);
+  }
+  /// Диапазон элементов с ключом
+  std::pair<iterator, iterator> equal_range(const key_type &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+  /// Поиск по ключу любого типа при прозрачном компараторе Compare
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) const {
+    return _tree.Find(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    return _tree.Include(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K &key) const {
+    return _tree.Count(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) const {
+    return _tree.LowerBound(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K &key) const {
+    return _tree.UpperBound(key);
+  }
+  /// Память, занятая коллекцией, в байтах
+  size_type memory_usage() const { return _tree.MemoryUsage(); }
+};
+
+}  // namespace s21
+
+#include "../templates/s21_btree_set.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_BTREE_SET_H_
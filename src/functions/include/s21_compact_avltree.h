@@ -0,0 +1,342 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_COMPACT_AVLTREE_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_COMPACT_AVLTREE_H_
+/**
+ * @file
+ * @brief Компактное Avl дерево на 32-битных индексах
+ * @details Узел AvlTree кроме значения хранит три указателя, счетчик
+ * поддерева, высоту и служебные поля пула: для int это 40 байт на элемент.
+ * Компактное дерево держит узлы в собственной арене - наборе блоков,
+ * адресуемых 32-битным индексом, - и хранит в узле только индексы левого и
+ * правого потомка и слово с индексом родителя и фактором баланса в двух
+ * младших битах. Узел int занимает 16 байт. Платой служит отсутствие
+ * порядковой статистики (нет счетчиков поддеревьев) и предел в 2^30 - 1
+ * элементов.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_avltree.h"
+
+namespace s21 {
+
+/**
+ * Шаблон класса компактное Avl дерево
+ * @details политики Key, Value, KeyOfValue, Compare и Unique совпадают с
+ * политиками AvlTree. Индекс 0 обозначает отсутствие узла. Блоки арены
+ * никогда не перемещаются, поэтому значения не переносятся при росте
+ * дерева, а итераторы остаются действительными до удаления их элемента
+ * @tparam Key тип ключа
+ * @tparam Value тип хранимого значения
+ * @tparam KeyOfValue функтор, возвращающий ключ значения
+ * @tparam Compare строгий порядок на ключах
+ * @tparam Unique true - дубликаты ключей запрещены, false - разрешены
+ */
+template <typename Key, typename Value = Key,
+          typename KeyOfValue = Identity<Key>,
+          typename Compare = std::less<Key>, bool Unique = false>
+class CompactAvlTree {
+ private:
+  using index_type = std::uint32_t;
+  /// узел: индексы потомков, родитель со сдвигом на 2 бита и баланс + 1
+  struct Node {
+    index_type left;
+    index_type right;
+    index_type up;
+    alignas(Value) unsigned char storage[sizeof(Value)];
+  };
+  /// узлов в каждом из первых блоков арены, дальше блоки удваиваются
+  static constexpr index_type kFirstChunkBits = 6;
+  /// узлов в каждом блоке, начиная с индекса 1 << kChunkBits
+  static constexpr index_type kChunkBits = 16;
+  /// количество блоков, покрывающих индексы меньше 1 << kChunkBits
+  static constexpr index_type kSmallChunks = kChunkBits - kFirstChunkBits + 1;
+
+  Node **_chunks = nullptr;      /// таблица блоков арены
+  index_type _chunk_count = 0;   /// количество выделенных блоков
+  index_type _chunk_slots = 0;   /// емкость таблицы блоков
+  index_type _capacity = 0;      /// узлов во всех блоках
+  index_type _used = 1;          /// узлов выдано из блоков, включая 0
+  index_type _free = 0;          /// список свободных узлов через left
+  index_type _root = 0;          /// корень, у пустого дерева 0
+  std::size_t _size = 0;         /// количество элементов в дереве
+
+ public:
+  /// наибольшее количество элементов
+  static constexpr std::size_t kMaxNodes = (std::size_t{1} << 30) - 1;
+
+  /**
+   * Итератор компактного дерева: дерево и индекс узла. Итератор end() -
+   * индекс 0
+   * @tparam Const константный итератор или нет
+   */
+  template <bool Const>
+  class IteratorImpl {
+   private:
+    friend class CompactAvlTree;
+    template <bool>
+    friend class IteratorImpl;
+    const CompactAvlTree *_tree = nullptr;  /// дерево
+    index_type _index = 0;                  /// индекс узла
+
+   public:
+    /// типы для std::iterator_traits
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const Value *, Value *>;
+    using reference = std::conditional_t<Const, const Value &, Value &>;
+    IteratorImpl() = default;
+    /**
+     * Итератор на узел дерева
+     * @param tree дерево
+     * @param index индекс узла, 0 для end()
+     */
+    IteratorImpl(const CompactAvlTree *tree, index_type index)
+        : _tree(tree), _index(index) {}
+    /// преобразование неконстантного итератора в константный
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    IteratorImpl(const IteratorImpl<false> &other)
+        : _tree(other._tree), _index(other._index) {}
+    reference operator*() const { return _tree->ValueAt(_index); }
+    pointer operator->() const { return &_tree->ValueAt(_index); }
+    IteratorImpl &operator++() {
+      _index = _tree->Next(_index);
+      return *this;
+    }
+    IteratorImpl operator++(int) {
+      IteratorImpl old = *this;
+      ++*this;
+      return old;
+    }
+    IteratorImpl &operator--() {
+      _index = _tree->Prev(_index);
+      return *this;
+    }
+    IteratorImpl operator--(int) {
+      IteratorImpl old = *this;
+      --*this;
+      return old;
+    }
+    template <bool C>
+    bool operator==(const IteratorImpl<C> &other) const {
+      return _index == other._index;
+    }
+    template <bool C>
+    bool operator!=(const IteratorImpl<C> &other) const {
+      return !(*this == other);
+    }
+  };
+
+  /// тип ключа
+  using key_type = Key;
+  /// тип данных
+  using value_type = Value;
+  /// сравнение ключей
+  using key_compare = Compare;
+  using iterator = IteratorImpl<false>;
+  using const_iterator = IteratorImpl<true>;
+
+  CompactAvlTree() = default;
+  /**
+   * Конструктор копирования за O(n): копия повторяет раскладку узлов по
+   * индексам, перебалансировки и поиска нет
+   * @param other дерево для копирования
+   */
+  CompactAvlTree(const CompactAvlTree &other);
+  /**
+   * Конструктор перемещения за O(1)
+   * @param other дерево для перемещения
+   */
+  CompactAvlTree(CompactAvlTree &&other) noexcept { Swap(other); }
+  CompactAvlTree &operator=(const CompactAvlTree &other);
+  CompactAvlTree &operator=(CompactAvlTree &&other) noexcept;
+  /// деструктор
+  ~CompactAvlTree() { Release(); }
+
+  iterator begin() { return iterator(this, First()); }
+  iterator end() { return iterator(this, 0); }
+  const_iterator begin() const { return const_iterator(this, First()); }
+  const_iterator end() const { return const_iterator(this, 0); }
+  /// Пустое ли дерево
+  bool IsEmpty() const { return _size == 0; }
+  /// Количество элементов
+  std::size_t size() const { return _size; }
+  /// Максимальное количество элементов
+  std::size_t max_size() const { return kMaxNodes; }
+  /// Удаление всех элементов с освобождением арены
+  void Clear() { Release(); }
+  /// Обмен содержимым за O(1)
+  void Swap(CompactAvlTree &other) noexcept;
+
+  /**
+   * Вставка значения
+   * @param value значение
+   * @return итератор на вставленный (или равный ему) элемент и признак
+   * вставки. При Unique = false вставка всегда удается, новый элемент
+   * становится последним среди равных
+   * @throw std::length_error если в дереве уже kMaxNodes элементов
+   */
+  std::pair<iterator, bool> Insert(const Value &value) {
+    return InsertValue(value);
+  }
+  std::pair<iterator, bool> Insert(Value &&value) {
+    return InsertValue(std::move(value));
+  }
+  /**
+   * Создание значения из аргументов конструктора и его вставка
+   * @param args аргументы конструктора значения
+   * @return см. Insert
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> Emplace(Args &&...args) {
+    return InsertValue(Value(std::forward<Args>(args)...));
+  }
+  /**
+   * Удаление элемента. Узел отвязывается и перебалансировка идет от места
+   * удаления без повторного поиска, значения других узлов не перемещаются.
+   * Итераторы остальных элементов остаются действительными
+   * @param pos итератор на элемент
+   * @return итератор на следующий элемент
+   */
+  iterator Erase(const_iterator pos);
+
+  /**
+   * Поиск по ключу
+   * @tparam K тип ключа, сравнимого со значениями через Compare
+   * @param key ключ
+   * @return итератор на первый элемент с ключом, end() если его нет
+   */
+  template <typename K>
+  iterator Find(const K &key) const;
+  /// Есть ли элемент с ключом
+  template <typename K>
+  bool Include(const K &key) const {
+    return Find(key) != end();
+  }
+  /// Первый элемент, не меньший ключа
+  template <typename K>
+  iterator LowerBound(const K &key) const;
+  /// Первый элемент, больший ключа
+  template <typename K>
+  iterator UpperBound(const K &key) const;
+  /// Количество элементов с ключом
+  template <typename K>
+  std::size_t Count(const K &key) const;
+
+  /**
+   * Память, занятая деревом: объект дерева, блоки арены (включая
+   * свободные узлы) и таблица блоков
+   * @return размер в байтах без учета служебных данных malloc
+   */
+  std::size_t MemoryUsage() const;
+  /**
+   * Проверка инвариантов: порядок ключей, ссылки на родителей, факторы
+   * баланса, размер и список свободных узлов
+   * @return true если дерево корректно
+   */
+  bool Validate() const;
+
+ private:
+  /// узел по индексу
+  Node &At(index_type index) const {
+    if (index >> kChunkBits) {
+      return _chunks[kSmallChunks - 1 + (index >> kChunkBits)]
+                    [index & ((index_type{1} << kChunkBits) - 1)];
+    }
+    if (index < (index_type{1} << kFirstChunkBits)) return _chunks[0][index];
+    int bit = 31 - __builtin_clz(index);
+    return _chunks[bit - kFirstChunkBits + 1][index - (index_type{1} << bit)];
+  }
+  /// значение узла
+  Value &ValueAt(index_type index) const {
+    return *std::launder(reinterpret_cast<Value *>(At(index).storage));
+  }
+  /// ключ значения узла
+  const Key &KeyAt(index_type index) const {
+    return KeyOfValue()(ValueAt(index));
+  }
+  index_type Parent(index_type index) const { return At(index).up >> 2; }
+  void SetParent(index_type index, index_type parent) {
+    Node &node = At(index);
+    node.up = parent << 2 | (node.up & 3);
+  }
+  /// фактор баланса: высота правого поддерева минус высота левого
+  int Balance(index_type index) const {
+    return static_cast<int>(At(index).up & 3) - 1;
+  }
+  void SetBalance(index_type index, int balance) {
+    Node &node = At(index);
+    node.up = (node.up & ~index_type{3}) | static_cast<index_type>(balance + 1);
+  }
+  /// Должен ли ключ a стоять перед b (при Unique = false равные допустимы)
+  static bool Precedes(const Key &a, const Key &b) {
+    if constexpr (Unique) {
+      return Compare()(a, b);
+    } else {
+      return !Compare()(b, a);
+    }
+  }
+
+  /// первый узел в порядке обхода, 0 у пустого дерева
+  index_type First() const;
+  /// следующий узел в порядке обхода, 0 после последнего
+  index_type Next(index_type index) const;
+  /// предыдущий узел, для 0 - последний узел дерева
+  index_type Prev(index_type index) const;
+
+  /// новый блок арены
+  void AddChunk();
+  /// свободный узел из списка или из арены, значение не создается
+  index_type NewNode();
+  /// возврат узла с разрушенным значением в список свободных
+  void FreeNode(index_type index) {
+    At(index).left = _free;
+    _free = index;
+  }
+  /// разрушение значений и освобождение арены
+  void Release() noexcept;
+  /// значения в тех же индексах, что у other. Арена уже выделена
+  void CopyValues(const CompactAvlTree &other);
+
+  /// вставка значения с поиском позиции от корня
+  template <typename V>
+  std::pair<iterator, bool> InsertValue(V &&value);
+  /// замена потомка old_child узла parent (или корня) на new_child
+  void ReplaceChild(index_type parent, index_type old_child,
+                    index_type new_child);
+  /// поворот влево вокруг x с правым потомком z, возвращает новый корень
+  index_type RotateLeft(index_type x, index_type z);
+  /// поворот вправо вокруг x с левым потомком z
+  index_type RotateRight(index_type x, index_type z);
+  /// двойной поворот: вправо вокруг правого потомка z, затем влево вокруг x
+  index_type RotateRightLeft(index_type x, index_type z);
+  /// двойной поворот: влево вокруг левого потомка z, затем вправо вокруг x
+  index_type RotateLeftRight(index_type x, index_type z);
+  /// восстановление баланса после роста поддерева node на единицу
+  void RetraceInsert(index_type node);
+  /**
+   * Восстановление баланса после уменьшения высоты одного из поддеревьев
+   * @param parent узел, у которого уменьшилось поддерево
+   * @param left уменьшилось левое (true) или правое (false) поддерево
+   */
+  void RetraceErase(index_type parent, bool left);
+  /// высота поддерева с проверкой факторов баланса и родителей, -1 - ошибка
+  int CheckSubtree(index_type index, index_type parent) const;
+};
+
+}  // namespace s21
+
+#include "../templates/s21_compact_avltree.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_COMPACT_AVLTREE_H_
@@ -0,0 +1,174 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_COMPACT_MAP_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_COMPACT_MAP_H_
+/**
+ * @file
+ * @brief Словарь на основе компактного Avl дерева
+ * @details Интерфейс повторяет s21::map. Отличия: нет дескрипторов узлов и
+ * порядковой статистики, не больше 2^30 - 1 пар. Узел хранит пару и 12
+ * байт ссылок вместо указателей, счетчика и высоты
+ */
+
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+
+#include "s21_compact_avltree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+/**
+ * Словарь с уникальными ключами на основе компактного Avl дерева
+ * @tparam Key тип ключа
+ * @tparam T тип значения
+ * @tparam Compare строгий порядок на ключах
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class compact_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+
+ private:
+  /// компактное дерево пар с уникальными ключами
+  using tree_type =
+      CompactAvlTree<Key, value_type, SelectFirst<value_type>, Compare, true>;
+  tree_type _tree;
+
+ public:
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = std::size_t;
+
+  compact_map() = default;
+  /**
+   * Конструктор с инициализацией из списка пар. При повторе ключа остается
+   * первая пара
+   * @param items список пар
+   */
+  compact_map(std::initializer_list<value_type> const &items);
+  /**
+   * Конструктор из диапазона пар
+   * @tparam InputIt Тип итератора диапазона
+   * @param first Начало диапазона
+   * @param last Конец диапазона
+   */
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::iterator_category>
+  compact_map(InputIt first, InputIt last);
+  compact_map(const compact_map &other) = default;
+  compact_map(compact_map &&other) noexcept = default;
+  compact_map &operator=(const compact_map &other) = default;
+  compact_map &operator=(compact_map &&other) noexcept = default;
+  ~compact_map() = default;
+
+  /// @brief доступ к значению по ключу с проверкой валидности ключа. Если ключ
+  /// не найден, кидает ошибку std::out_of_range
+  /// @param key ключ словаря
+  /// @return ссылка на значение, соответстующее ключу
+  mapped_type &at(const Key &key);
+  const mapped_type &at(const Key &key) const;
+  /// @brief доступ к значению по ключу; запись новой пары ключ-значение,
+  /// если ключа нет
+  /// @param key ключ словаря
+  /// @return ссылка на значение, соответстующее ключу
+  mapped_type &operator[](const Key &key);
+
+  iterator begin() { return _tree.begin(); }
+  iterator end() { return _tree.end(); }
+  const_iterator begin() const { return _tree.begin(); }
+  const_iterator end() const { return _tree.end(); }
+  /// Проверяет пустая ли коллекция
+  bool empty() const { return _tree.IsEmpty(); }
+  /// Возвращает размер коллекции
+  size_type size() const { return _tree.size(); }
+  /// Возвращает максимальный размер
+  size_type max_size() const { return _tree.max_size(); }
+  /// Очищает коллекцию
+  void clear() { _tree.Clear(); }
+  /**
+   * Вставка пары
+   * @param value пара ключ-значение
+   * @return итератор на вставленную (или существующую) пару и признак
+   * вставки
+   */
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return _tree.Insert(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return _tree.Insert(std::move(value));
+  }
+  /**
+   * Вставка пары из ключа и значения
+   * @param key ключ
+   * @param obj значение
+   * @return см. insert(const value_type &)
+   */
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return _tree.Emplace(key, obj);
+  }
+  /**
+   * Вставка пары или замена значения существующего ключа
+   * @param key ключ
+   * @param obj значение
+   * @return итератор на пару и true, если пара вставлена
+   */
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj);
+  /**
+   * Создание пары из аргументов конструктора и ее вставка
+   * @param args аргументы конструктора пары
+   * @return см. insert(const value_type &)
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return _tree.Emplace(std::forward<Args>(args)...);
+  }
+  /**
+   * Вставка нескольких пар
+   * @param args Список пар
+   * @return vector пар итератора и успешности добавления
+   */
+  template <class... Args>
+  vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+  /**
+   * Удаляет пару по итератору. Итераторы остальных пар остаются
+   * действительными
+   * @param pos Итератор позиции для удаления
+   * @return итератор на следующую пару
+   */
+  iterator erase(const_iterator pos) { return _tree.Erase(pos); }
+  /**
+   * Удаляет пару по ключу
+   * @return количество удаленных пар (0 или 1)
+   */
+  size_type erase(const Key &key);
+  /// Обмен с другой коллекцией за O(1)
+  void swap(compact_map &other) noexcept { _tree.Swap(other._tree); }
+  /// Проверка наличия ключа
+  bool contains(const Key &key) const { return _tree.Include(key); }
+  /// Поиск пары по ключу, end() если ее нет
+  iterator find(const Key &key) { return _tree.Find(key); }
+  const_iterator find(const Key &key) const { return _tree.Find(key); }
+  /// Количество пар с ключом (0 или 1)
+  size_type count(const Key &key) const { return _tree.Count(key); }
+  /// Первая пара с ключом, не меньшим key
+  iterator lower_bound(const Key &key) { return _tree.LowerBound(key); }
+  /// Первая пара с ключом, большим key
+  iterator upper_bound(const Key &key) { return _tree.UpperBound(key); }
+  /// Память, занятая коллекцией, в байтах
+  size_type memory_usage() const { return _tree.MemoryUsage(); }
+};
+
+}  // namespace s21
+
+#include "../templates/s21_compact_map.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_COMPACT_MAP_H_
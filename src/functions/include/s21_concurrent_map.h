@@ -0,0 +1,141 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_CONCURRENT_MAP_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_CONCURRENT_MAP_H_
+/**
+ * @file
+ * @brief Потокобезопасный словарь из независимо блокируемых частей
+ * @details Ключи распределяются хешем по Shards деревьям AvlTree, у каждого
+ * дерева свой мьютекс читателей-писателей. Операции с разными частями не
+ * мешают друг другу, чтения одной части идут параллельно. Упорядоченный
+ * обход сливает части k-путевым слиянием под разделяемыми блокировками всех
+ * частей
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+
+#include "s21_avltree.h"
+
+namespace s21 {
+
+/**
+ * Словарь с уникальными ключами для одновременной работы из многих потоков
+ * @details все методы потокобезопасны. Ссылки и итераторы наружу не
+ * выдаются: find возвращает копию значения, изменение на месте выполняет
+ * update под блокировкой части
+ * @tparam Key тип ключа
+ * @tparam T тип значения
+ * @tparam Shards количество частей
+ * @tparam Compare строгий порядок на ключах
+ * @tparam Hash хеш ключа для выбора части
+ */
+template <typename Key, typename T, std::size_t Shards = 16,
+          typename Compare = std::less<Key>, typename Hash = std::hash<Key>>
+class concurrent_map {
+  static_assert(Shards > 0, "concurrent_map needs at least one shard");
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using key_compare = Compare;
+  using size_type = std::size_t;
+
+ private:
+  using tree_type =
+      AvlTree<Key, value_type, SelectFirst<value_type>, Compare, true>;
+  /// часть словаря на отдельной кэш-линии, чтобы мьютексы соседних частей
+  /// не делили линию
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    /// поиск в AvlTree не помечен const, но дерево не изменяет: под
+    /// разделяемой блокировкой его вызывают несколько читателей сразу
+    mutable tree_type tree;
+  };
+  std::array<Shard, Shards> _shards;
+
+  /// часть, в которой лежит ключ. Хеш перемешивается: у std::hash для
+  /// целых он тождественный, и ключи с общим шагом попадали бы в одну часть
+  Shard &ShardOf(const Key &key) const {
+    std::uint64_t hash = static_cast<std::uint64_t>(Hash()(key));
+    hash *= 0x9E3779B97F4A7C15ULL;
+    return const_cast<Shard &>(_shards[(hash >> 32) % Shards]);
+  }
+
+ public:
+  concurrent_map() = default;
+  /**
+   * Конструктор с инициализацией из переменного списка пар. При повторе
+   * ключа остается первая пара
+   * @param items список пар
+   */
+  concurrent_map(std::initializer_list<value_type> const &items) {
+    for (const value_type &item : items) insert(item.first, item.second);
+  }
+  concurrent_map(const concurrent_map &) = delete;
+  concurrent_map &operator=(const concurrent_map &) = delete;
+
+  /**
+   * Поиск значения по ключу под разделяемой блокировкой части
+   * @param key ключ
+   * @return копия значения, пусто если ключа нет
+   */
+  std::optional<mapped_type> find(const Key &key) const;
+  /// Проверка наличия ключа
+  bool contains(const Key &key) const;
+  /**
+   * Вставка пары, если ключа еще нет
+   * @return true если пара вставлена
+   */
+  bool insert(const Key &key, const T &obj);
+  /**
+   * Вставка пары или замена значения существующего ключа
+   * @return true если пара вставлена, false если значение заменено
+   */
+  bool insert_or_assign(const Key &key, const T &obj);
+  /**
+   * Удаление пары по ключу
+   * @return количество удаленных пар (0 или 1)
+   */
+  size_type erase(const Key &key);
+  /**
+   * Изменение значения на месте под исключительной блокировкой части
+   * @tparam F функтор вида void(T &)
+   * @param key ключ
+   * @param fn изменение значения. Не должно обращаться к этому словарю
+   * @return true если ключ найден и fn вызвана
+   */
+  template <typename F>
+  bool update(const Key &key, F fn);
+  /**
+   * Обход пар в порядке возрастания ключей. Все части блокируются на
+   * чтение (по порядку номеров), пары сливаются k-путевым слиянием через
+   * кучу из Shards курсоров, O(log Shards) на пару
+   * @tparam F функтор вида void(const value_type &)
+   * @param fn действие над парой. Не должно изменять этот словарь
+   */
+  template <typename F>
+  void for_each(F fn) const;
+  /// Количество пар. При одновременных изменениях - приблизительное
+  size_type size() const;
+  /// Пустой ли словарь
+  bool empty() const { return size() == 0; }
+  /// Удаление всех пар
+  void clear();
+};
+
+}  // namespace s21
+
+#include "../templates/s21_concurrent_map.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_CONCURRENT_MAP_H_
@@ -0,0 +1,135 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_CONCURRENT_SKIPLIST_MAP_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_CONCURRENT_SKIPLIST_MAP_H_
+/**
+ * @file
+ * @brief Неблокирующий словарь на основе списка с пропусками
+ * @details Интерфейс повторяет s21::map, все методы можно вызывать из
+ * разных потоков одновременно без внешней синхронизации. Пара после вставки
+ * не изменяется: итераторы константные, at возвращает копию значения, нет
+ * operator[] и insert_or_assign (замена значения потребовала бы замены узла
+ * и не была бы атомарной). Итераторы однонаправленные и принадлежат потоку,
+ * в котором получены
+ */
+
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+
+#include "s21_skiplist.h"
+
+namespace s21 {
+
+/**
+ * Неблокирующий словарь с уникальными ключами
+ * @tparam Key тип ключа
+ * @tparam T тип значения
+ * @tparam Compare строгий порядок на ключах
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class concurrent_skiplist_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using key_compare = Compare;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+
+ private:
+  using list_type =
+      SkipList<Key, value_type, SelectFirst<value_type>, Compare>;
+  list_type _list;
+
+ public:
+  using iterator = typename list_type::const_iterator;
+  using const_iterator = iterator;
+  using size_type = std::size_t;
+
+  concurrent_skiplist_map() = default;
+  /**
+   * Конструктор с инициализацией из переменного списка пар. При повторе
+   * ключа остается первая пара
+   * @param items список пар
+   */
+  concurrent_skiplist_map(std::initializer_list<value_type> const &items)
+      : concurrent_skiplist_map(items.begin(), items.end()) {}
+  /**
+   * Конструктор из диапазона пар
+   * @tparam InputIt Тип итератора диапазона
+   * @param first Начало диапазона
+   * @param last Конец диапазона
+   */
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::iterator_category>
+  concurrent_skiplist_map(InputIt first, InputIt last) {
+    for (; first != last; ++first) _list.Insert(*first);
+  }
+
+  /// @brief копия значения по ключу. Если ключ не найден, кидает ошибку
+  /// std::out_of_range
+  /// @param key ключ словаря
+  /// @return значение на момент поиска
+  mapped_type at(const Key &key) const;
+  iterator begin() const { return _list.begin(); }
+  iterator end() const { return _list.end(); }
+  /// Проверяет пустая ли коллекция
+  bool empty() const { return _list.IsEmpty(); }
+  /// Возвращает размер коллекции
+  size_type size() const { return _list.size(); }
+  /// Возвращает максимальный размер
+  size_type max_size() const { return _list.max_size(); }
+  /// Удаляет все пары, видимые на момент обхода
+  void clear();
+  /// @brief вставка пары
+  /// @return итератор на пару с ключом и признак вставки
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return _list.Insert(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return _list.Insert(std::move(value));
+  }
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return _list.Emplace(key, obj);
+  }
+  /// @brief создание пары из аргументов конструктора и ее вставка
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return _list.Emplace(std::forward<Args>(args)...);
+  }
+  /// @brief удаление пары по итератору
+  void erase(iterator pos) { _list.Erase(pos->first); }
+  /// @brief удаление пары по ключу
+  /// @return количество удаленных пар (0 или 1)
+  size_type erase(const Key &key) { return _list.Erase(key) ? 1 : 0; }
+  /// Проверка наличия ключа
+  bool contains(const Key &key) const { return _list.Include(key); }
+  /// Поиск пары по ключу, end() если ее нет
+  iterator find(const Key &key) const { return _list.Find(key); }
+  /// Количество пар с ключом (0 или 1)
+  size_type count(const Key &key) const { return _list.Include(key) ? 1 : 0; }
+  /// Первая пара с ключом, не меньшим key
+  iterator lower_bound(const Key &key) const { return _list.LowerBound(key); }
+  /// Первая пара с ключом, большим key
+  iterator upper_bound(const Key &key) const { return _list.UpperBound(key); }
+  /// Поиск по ключу любого типа при прозрачном компараторе Compare
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) const {
+    return _list.Find(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    return _list.Include(key);
+  }
+};
+
+}  // namespace s21
+
+#include "../templates/s21_concurrent_skiplist_map.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_CONCURRENT_SKIPLIST_MAP_H_
@@ -0,0 +1,144 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_CONCURRENT_SKIPLIST_SET_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_CONCURRENT_SKIPLIST_SET_H_
+/**
+ * @file
+ * @brief Неблокирующее множество на основе списка с пропусками
+ * @details Интерфейс повторяет s21::set, все методы можно вызывать из
+ * разных потоков одновременно без внешней синхронизации. Отличия: итераторы
+ * однонаправленные и принадлежат потоку, в котором получены; size()
+ * приблизителен при одновременных изменениях; нет дескрипторов узлов и
+ * порядковой статистики
+ */
+
+#include <initializer_list>
+#include <iterator>
+
+#include "s21_skiplist.h"
+
+namespace s21 {
+
+/**
+ * Неблокирующее множество уникальных элементов
+ * @tparam T тип элемента
+ * @tparam Compare строгий порядок на элементах
+ */
+template <typename T, typename Compare = std::less<T>>
+class concurrent_skiplist_set {
+ private:
+  using list_type = SkipList<T, T, Identity<T>, Compare>;
+  list_type _list;
+
+ public:
+  using key_type = T;
+  using value_type = T;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  /// элементы множества не изменяются через итератор
+  using iterator = typename list_type::const_iterator;
+  using const_iterator = iterator;
+  using size_type = std::size_t;
+
+  concurrent_skiplist_set() = default;
+  /**
+   * Конструктор с инициализацией из переменного списка элементов
+   * @param items список элементов
+   */
+  concurrent_skiplist_set(std::initializer_list<value_type> const &items)
+      : concurrent_skiplist_set(items.begin(), items.end()) {}
+  /**
+   * Конструктор из диапазона
+   * @tparam InputIt Тип итератора диапазона
+   * @param first Начало диапазона
+   * @param last Конец диапазона
+   */
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::iterator_category>
+  concurrent_skiplist_set(InputIt first, InputIt last) {
+    for (; first != last; ++first) _list.Insert(*first);
+  }
+
+  iterator begin() const { return _list.begin(); }
+  iterator end() const { return _list.end(); }
+  /// Проверяет пустая ли коллекция
+  bool empty() const { return _list.IsEmpty(); }
+  /// Возвращает размер коллекции
+  size_type size() const { return _list.size(); }
+  /// Возвращает максимальный размер
+  size_type max_size() const { return _list.max_size(); }
+  /// Удаляет все элементы, видимые на момент обхода
+  void clear();
+  /**
+   * Операция вставки одного элемента
+   * @param value Элемент для вставки
+   * @return pair итератор на добавленный (или равный ему) элемент и булево
+   * значение успешность добавления
+   */
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return _list.Insert(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return _list.Insert(std::move(value));
+  }
+  /// Создание элемента из аргументов конструктора и его вставка
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return _list.Emplace(std::forward<Args>(args)...);
+  }
+  /**
+   * Удаляет элемент по итератору. Итераторы остаются действительными
+   * @param pos Итератор позиции для удаления
+   */
+  void erase(iterator pos) { _list.Erase(*pos); }
+  /**
+   * Удаляет элемент по ключу
+   * @return количество удаленных элементов (0 или 1)
+   */
+  size_type erase(const key_type &key) { return _list.Erase(key) ? 1 : 0; }
+  /**
+   * Операция поиска по ключу
+   * @param key Ключ для поиска
+   * @return Итератор на найденный элемент, end() если его нет
+   */
+  iterator find(const key_type &key) const { return _list.Find(key); }
+  /// Проверка наличия элемента в коллекции
+  bool contains(const key_type &key) const { return _list.Include(key); }
+  /// Количество элементов с ключом (0 или 1)
+  size_type count(const key_type &key) const {
+    return _list.Include(key) ? 1 : 0;
+  }
+  /// Первый элемент, не меньший ключа
+  iterator lower_bound(const key_type &key) const {
+    return _list.LowerBound(key);
+  }
+  /// Первый элемент, больший ключа
+  iterator upper_bound(const key_type &key) const {
+    return _list.UpperBound(key);
+  }
+  /// Поиск по ключу любого типа при прозрачном компараторе Compare
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) const {
+    return _list.Find(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    return _list.Include(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) const {
+    return _list.LowerBound(key);
+  }
+};
+
+}  // namespace s21
+
+#include "../templates/s21_concurrent_skiplist_set.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_CONCURRENT_SKIPLIST_SET_H_
@@ -0,0 +1,227 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_EPOCH_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_EPOCH_H_
+/**
+ * @file
+ * @brief Освобождение памяти по эпохам для неблокирующих структур
+ * @details Поток, читающий общую структуру, закрепляет текущую глобальную
+ * эпоху (Guard). Узел, исключенный из структуры, не удаляется сразу, а
+ * откладывается (Retire) с номером эпохи на момент исключения. Глобальная
+ * эпоха продвигается, только когда все закрепленные потоки видели текущую.
+ * Через две эпохи после откладывания ни один поток не может держать ссылку
+ * на узел, и он удаляется. Чтение не пишет в общую память, кроме своей
+ * записи потока, и никогда не ждет писателей.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * Домен эпох, общий для всех неблокирующих контейнеров
+ */
+class EpochDomain {
+ private:
+  /// отложенный объект и функция его удаления
+  struct Retired {
+    void *object;
+    void (*deleter)(void *);
+    std::uint64_t epoch;
+  };
+  /// запись потока. Записи не удаляются до разрушения домена, запись
+  /// завершившегося потока переходит к следующему потоку вместе с
+  /// отложенными объектами
+  struct alignas(64) Record {
+    /// закрепленная эпоха, kIdle если поток не читает
+    std::atomic<std::uint64_t> epoch{kIdle};
+    std::atomic<bool> in_use{true};
+    Record *next = nullptr;         /// следующая запись, не меняется
+    unsigned nesting = 0;           /// глубина вложенных Guard, свое поле
+    std::vector<Retired> retired;   /// отложенные объекты, свое поле
+  };
+  static constexpr std::uint64_t kIdle = ~std::uint64_t(0);
+  /// через столько откладываний поток пытается продвинуть эпоху
+  static constexpr std::size_t kCollectPeriod = 64;
+
+  std::atomic<std::uint64_t> _epoch{0};     /// глобальная эпоха
+  std::atomic<Record *> _records{nullptr};  /// список записей
+
+  /// запись текущего потока, освобождается при завершении потока
+  struct Handle {
+    Record *record;
+    explicit Handle(EpochDomain &domain) : record(domain.Acquire()) {}
+    ~Handle() { record->in_use.store(false, std::memory_order_release); }
+  };
+
+  EpochDomain() = default;
+
+ public:
+  /**
+   * Закрепление эпохи на время жизни объекта. Пока существует хотя бы один
+   * Guard потока, узлы, которые поток мог прочитать, не удаляются
+   * @warning Guard принадлежит потоку, в котором создан: копия, созданная в
+   * другом потоке, закрепляет эпоху уже своего потока
+   */
+  class Guard {
+   public:
+    /// пустой Guard ничего не закрепляет
+    Guard() = default;
+    explicit Guard(EpochDomain &domain) : _domain(&domain) { domain.Enter(); }
+    Guard(const Guard &other) : _domain(other._domain) {
+      if (_domain) _domain->Enter();
+    }
+    Guard(Guard &&other) noexcept
+        : _domain(std::exchange(other._domain, nullptr)) {}
+    Guard &operator=(Guard other) noexcept {
+      std::swap(_domain, other._domain);
+      return *this;
+    }
+    ~Guard() {
+      if (_domain) _domain->Leave();
+    }
+
+   private:
+    EpochDomain *_domain = nullptr;
+  };
+
+  EpochDomain(const EpochDomain &) = delete;
+  EpochDomain &operator=(const EpochDomain &) = delete;
+  /// удаляет все отложенные объекты, к этому моменту потоков-читателей нет
+  ~EpochDomain() {
+    Record *record = _records.load(std::memory_order_acquire);
+    while (record) {
+      for (Retired &item : record->retired) item.deleter(item.object);
+      Record *next = record->next;
+      delete record;
+      record = next;
+    }
+  }
+
+  /**
+   * Общий домен процесса
+   * @return ссылка на домен
+   */
+  static EpochDomain &Instance() {
+    static EpochDomain domain;
+    return domain;
+  }
+
+  /// Закрепление эпохи текущим потоком
+  Guard Pin() { return Guard(*this); }
+
+  /**
+   * Отложенное удаление объекта, уже недоступного из структуры
+   * @param object объект
+   * @param deleter функция удаления
+   */
+  void Retire(void *object, void (*deleter)(void *)) {
+    Record *record = Local();
+    record->retired.push_back(
+        {object, deleter, _epoch.load(std::memory_order_acquire)});
+    if (record->retired.size() % kCollectPeriod == 0) {
+      TryAdvance();
+      Reclaim(record);
+    }
+  }
+
+  /**
+   * Продвижение эпохи и удаление всего, что уже можно удалить, в том числе
+   * объектов, отложенных завершившимися потоками. Вызывается, когда
+   * структура какое-то время не используется (например, в тестах)
+   */
+  void Collect() {
+    TryAdvance();
+    TryAdvance();
+    Reclaim(Local());
+    for (Record *record = _records.load(std::memory_order_acquire); record;
+         record = record->next) {
+      bool free = false;
+      if (record->in_use.compare_exchange_strong(free, true,
+                                                 std::memory_order_acquire)) {
+        Reclaim(record);
+        record->in_use.store(false, std::memory_order_release);
+      }
+    }
+  }
+
+ private:
+  /// запись текущего потока
+  Record *Local() {
+    thread_local Handle handle(*this);
+    return handle.record;
+  }
+
+  /// свободная запись завершившегося потока или новая запись в списке
+  Record *Acquire() {
+    for (Record *record = _records.load(std::memory_order_acquire); record;
+         record = record->next) {
+      bool free = false;
+      if (record->in_use.compare_exchange_strong(free, true,
+                                                 std::memory_order_acquire)) {
+        return record;
+      }
+    }
+    Record *record = new Record;
+    record->next = _records.load(std::memory_order_relaxed);
+    while (!_records.compare_exchange_weak(record->next, record,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+    }
+    return record;
+  }
+
+  void Enter() {
+    Record *record = Local();
+    if (record->nesting++ == 0) {
+      record->epoch.store(_epoch.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+      /// закрепление должно стать видимым до чтения общих указателей
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+  }
+
+  void Leave() {
+    Record *record = Local();
+    if (--record->nesting == 0) {
+      record->epoch.store(kIdle, std::memory_order_release);
+    }
+  }
+
+  /// эпоха продвигается, если все закрепленные потоки видели текущую
+  void TryAdvance() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::uint64_t epoch = _epoch.load(std::memory_order_relaxed);
+    for (Record *record = _records.load(std::memory_order_acquire); record;
+         record = record->next) {
+      std::uint64_t local = record->epoch.load(std::memory_order_acquire);
+      if (local != kIdle && local != epoch) return;
+    }
+    _epoch.compare_exchange_strong(epoch, epoch + 1,
+                                   std::memory_order_acq_rel);
+  }
+
+  /// удаление объектов, отложенных не меньше двух эпох назад
+  void Reclaim(Record *record) {
+    std::uint64_t epoch = _epoch.load(std::memory_order_acquire);
+    std::size_t kept = 0;
+    for (Retired &item : record->retired) {
+      if (item.epoch + 2 <= epoch) {
+        item.deleter(item.object);
+      } else {
+        record->retired[kept++] = item;
+      }
+    }
+    record->retired.resize(kept);
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_EPOCH_H_
@@ -0,0 +1,199 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_EYTZINGER_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_EYTZINGER_H_
+/**
+ * @file
+ * @brief Неизменяемый упорядоченный индекс в раскладке Эйтцингера
+ * @details Значения хранятся в одном массиве в порядке обхода дерева поиска
+ * в ширину: корень в ячейке 1, дети ячейки k - в ячейках 2k и 2k + 1.
+ * Указателей нет, поэтому на элемент приходится ровно sizeof(Value) байт.
+ * Спуск по такому дереву не содержит ветвлений по результату сравнения:
+ * номер следующей ячейки вычисляется как 2k + (a[k] < key). Первые уровни
+ * дерева лежат в начале массива и постоянно находятся в кэше, а потомки
+ * ячейки k через несколько уровней занимают одну кэш-линию, которую можно
+ * запросить заранее (prefetch)
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "s21_avltree.h"
+
+namespace s21 {
+
+/**
+ * Шаблон класса индекса Эйтцингера
+ * @details политики Key, Value, KeyOfValue и Compare совпадают с политиками
+ * AvlTree. Индекс строится один раз из упорядоченной последовательности и
+ * больше не изменяется
+ * @tparam Key тип ключа
+ * @tparam Value тип хранимого значения
+ * @tparam KeyOfValue функтор, возвращающий ключ значения
+ * @tparam Compare строгий порядок на ключах
+ */
+template <typename Key, typename Value, typename KeyOfValue = Identity<Key>,
+          typename Compare = std::less<Key>>
+class Eytzinger {
+ private:
+  /// выравнивание массива по кэш-линии
+  static constexpr std::size_t kLine = 64;
+  static constexpr std::size_t kAlign =
+      alignof(Value) > kLine ? alignof(Value) : kLine;
+  /// количество значений в кэш-линии: потомки ячейки k на глубине
+  /// log2(kBlock) занимают ячейки [k * kBlock, (k + 1) * kBlock)
+  static constexpr std::size_t kBlock =
+      sizeof(Value) >= kLine ? 1 : kLine / sizeof(Value);
+
+  /// массив на size + 1 ячейку, ячейка 0 не используется
+  Value *_base = nullptr;
+  std::size_t _size = 0;  /// количество значений
+
+ public:
+  /**
+   * Константный итератор в порядке возрастания ключей. Номер ячейки 0
+   * означает end()
+   */
+  class ConstIterator {
+   private:
+    friend class Eytzinger;
+    const Eytzinger *_index = nullptr;  /// индекс
+    std::size_t _k = 0;                 /// номер ячейки
+
+   public:
+    /// типы для std::iterator_traits
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Value *;
+    using reference = const Value &;
+    ConstIterator() = default;
+    ConstIterator(const Eytzinger *index, std::size_t k)
+        : _index(index), _k(k) {}
+    reference operator*() const { return _index->_base[_k]; }
+    pointer operator->() const { return _index->_base + _k; }
+    ConstIterator &operator++() {
+      _k = _index->Next(_k);
+      return *this;
+    }
+    ConstIterator operator++(int) {
+      ConstIterator old = *this;
+      ++*this;
+      return old;
+    }
+    ConstIterator &operator--() {
+      _k = _index->Prev(_k);
+      return *this;
+    }
+    ConstIterator operator--(int) {
+      ConstIterator old = *this;
+      --*this;
+      return old;
+    }
+    bool operator==(const ConstIterator &other) const {
+      return _k == other._k;
+    }
+    bool operator!=(const ConstIterator &other) const {
+      return _k != other._k;
+    }
+  };
+  using const_iterator = ConstIterator;
+
+  Eytzinger() = default;
+  /**
+   * Построение индекса из упорядоченной последовательности
+   * @tparam InputIt тип итератора последовательности
+   * @param first начало последовательности
+   * @param count количество значений
+   * @warning значения должны идти по возрастанию ключей
+   */
+  template <typename InputIt>
+  Eytzinger(InputIt first, std::size_t count);
+  Eytzinger(const Eytzinger &other);
+  Eytzinger(Eytzinger &&other) noexcept
+      : _base(std::exchange(other._base, nullptr)),
+        _size(std::exchange(other._size, 0)) {}
+  Eytzinger &operator=(const Eytzinger &other);
+  Eytzinger &operator=(Eytzinger &&other) noexcept;
+  ~Eytzinger() { Release(_base, _size); }
+
+  const_iterator begin() const { return const_iterator(this, First()); }
+  const_iterator end() const { return const_iterator(this, 0); }
+  /// Количество значений
+  std::size_t size() const { return _size; }
+  /// Пустой ли индекс
+  bool IsEmpty() const { return _size == 0; }
+  /// Обмен содержимым за O(1)
+  void Swap(Eytzinger &other) noexcept {
+    std::swap(_base, other._base);
+    std::swap(_size, other._size);
+  }
+
+  /**
+   * Первый элемент, не меньший ключа. Спуск без ветвлений по результату
+   * сравнения с упреждающей загрузкой потомков
+   * @tparam K тип ключа, сравнимого со значениями через Compare
+   * @param key ключ
+   * @return итератор на элемент, end() если такого нет
+   */
+  template <typename K>
+  const_iterator LowerBound(const K &key) const {
+    return const_iterator(this, Descend<false>(key));
+  }
+  /// Первый элемент, больший ключа
+  template <typename K>
+  const_iterator UpperBound(const K &key) const {
+    return const_iterator(this, Descend<true>(key));
+  }
+  /// Поиск по ключу, end() если его нет
+  template <typename K>
+  const_iterator Find(const K &key) const {
+    std::size_t k = Descend<false>(key);
+    if (k && Compare()(key, KeyOfValue()(_base[k]))) k = 0;
+    return const_iterator(this, k);
+  }
+  /// Есть ли значение с ключом
+  template <typename K>
+  bool Include(const K &key) const {
+    std::size_t k = Descend<false>(key);
+    return k && !Compare()(key, KeyOfValue()(_base[k]));
+  }
+  /**
+   * Память, занятая индексом: объект и массив значений
+   * @return размер в байтах
+   */
+  std::size_t MemoryUsage() const {
+    return sizeof(*this) + (_size ? (_size + 1) * sizeof(Value) : 0);
+  }
+
+ private:
+  /**
+   * Спуск от корня до листа
+   * @tparam Upper false - поиск первого значения, не меньшего ключа, true -
+   * первого значения, большего ключа
+   * @return номер ячейки найденного значения, 0 если его нет
+   */
+  template <bool Upper, typename K>
+  std::size_t Descend(const K &key) const;
+  /// ячейка первого значения в порядке возрастания
+  std::size_t First() const;
+  /// ячейка следующего значения, 0 после последнего
+  std::size_t Next(std::size_t k) const;
+  /// ячейка предыдущего значения, для 0 - последнее значение
+  std::size_t Prev(std::size_t k) const;
+  /// выделение выровненного массива на count значений и ячейку 0
+  static Value *Allocate(std::size_t count);
+  /// разрушение значений и освобождение массива
+  static void Release(Value *base, std::size_t count) noexcept;
+};
+
+}  // namespace s21
+
+#include "../templates/s21_eytzinger.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_EYTZINGER_H_
@@ -0,0 +1,136 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_FROZEN_MAP_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_FROZEN_MAP_H_
+/**
+ * @file
+ * @brief Неизменяемый словарь для быстрого поиска
+ * @details Словарь строится один раз (обычно через map::freeze) и дальше
+ * только читается. Пары лежат в одном массиве в раскладке Эйтцингера, см.
+ * s21_eytzinger.h
+ */
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_eytzinger.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare>
+class map;
+
+/**
+ * Неизменяемый словарь с уникальными ключами
+ * @tparam Key тип ключа
+ * @tparam T тип значения
+ * @tparam Compare строгий порядок на ключах
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class frozen_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using key_compare = Compare;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+
+ private:
+  friend class map<Key, T, Compare>;
+  /// индекс Эйтцингера над парами
+  using index_type =
+      Eytzinger<Key, value_type, SelectFirst<value_type>, Compare>;
+  index_type _index;
+
+  /**
+   * Построение из последовательности пар, упорядоченной по ключу, без
+   * повторов ключей
+   * @param first начало последовательности
+   * @param count количество пар
+   */
+  template <typename InputIt>
+  frozen_map(InputIt first, std::size_t count) : _index(first, count) {}
+
+ public:
+  using iterator = typename index_type::const_iterator;
+  using const_iterator = iterator;
+  using size_type = std::size_t;
+
+  frozen_map() = default;
+  /**
+   * Конструктор с инициализацией из переменного списка пар
+   * @param items список пар
+   */
+  frozen_map(std::initializer_list<value_type> const &items)
+      : frozen_map(items.begin(), items.end()) {}
+  /**
+   * Конструктор из произвольного диапазона пар. Пары сортируются по ключу,
+   * из пар с равными ключами остается первая
+   * @tparam InputIt Тип итератора диапазона
+   * @param first Начало диапазона
+   * @param last Конец диапазона
+   */
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::iterator_category>
+  frozen_map(InputIt first, InputIt last);
+
+  /// @brief доступ к значению по ключу. Если ключ не найден, кидает ошибку
+  /// std::out_of_range
+  /// @param key ключ словаря
+  /// @return ссылка на значение, соответстующее ключу
+  const mapped_type &at(const Key &key) const;
+  iterator begin() const { return _index.begin(); }
+  iterator end() const { return _index.end(); }
+  /// Проверяет пустая ли коллекция
+  bool empty() const { return _index.IsEmpty(); }
+  /// Возвращает размер коллекции
+  size_type size() const { return _index.size(); }
+  /// Обмен с другой коллекцией за O(1)
+  void swap(frozen_map &other) noexcept { _index.Swap(other._index); }
+  /// Проверка наличия ключа
+  bool contains(const Key &key) const { return _index.Include(key); }
+  /// Поиск пары по ключу, end() если ее нет
+  iterator find(const Key &key) const { return _index.Find(key); }
+  /// Количество пар с ключом (0 или 1)
+  size_type count(const Key &key) const {
+    return _index.Include(key) ? 1 : 0;
+  }
+  /// Первая пара с ключом, не меньшим key
+  iterator lower_bound(const Key &key) const {
+    return _index.LowerBound(key);
+  }
+  /// Первая пара с ключом, большим key
+  iterator upper_bound(const Key &key) const {
+    return _index.UpperBound(key);
+  }
+  /// Проверка наличия по ключу любого типа при прозрачном компараторе
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    return _index.Include(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) const {
+    return _index.Find(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) const {
+    return _index.LowerBound(key);
+  }
+  /// Память, занятая коллекцией, в байтах
+  size_type memory_usage() const { return _index.MemoryUsage(); }
+};
+
+}  // namespace s21
+
+#include "../templates/s21_frozen_map.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_FROZEN_MAP_H_
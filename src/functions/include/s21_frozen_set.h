@@ -0,0 +1,133 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_FROZEN_SET_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_FROZEN_SET_H_
+/**
+ * @file
+ * @brief Неизменяемое множество для быстрого поиска
+ * @details Множество строится один раз (обычно через set::freeze) и дальше
+ * только читается. Элементы лежат в одном массиве в раскладке Эйтцингера,
+ * см. s21_eytzinger.h
+ */
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+#include "s21_eytzinger.h"
+
+namespace s21 {
+
+template <typename T, typename Compare>
+class set;
+
+/**
+ * Неизменяемое множество уникальных элементов
+ * @tparam T тип элемента
+ * @tparam Compare строгий порядок на элементах
+ */
+template <typename T, typename Compare = std::less<T>>
+class frozen_set {
+ private:
+  friend class set<T, Compare>;
+  /// индекс Эйтцингера над самими элементами
+  using index_type = Eytzinger<T, T, Identity<T>, Compare>;
+  index_type _index;
+
+  /**
+   * Построение из упорядоченной последовательности без повторов
+   * @param first начало последовательности
+   * @param count количество элементов
+   */
+  template <typename InputIt>
+  frozen_set(InputIt first, std::size_t count) : _index(first, count) {}
+
+ public:
+  using key_type = T;
+  using value_type = T;
+  using key_compare = Compare;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename index_type::const_iterator;
+  using const_iterator = iterator;
+  using size_type = std::size_t;
+
+  frozen_set() = default;
+  /**
+   * Конструктор с инициализацией из переменного списка элементов
+   * @param items список элементов
+   */
+  frozen_set(std::initializer_list<value_type> const &items)
+      : frozen_set(items.begin(), items.end()) {}
+  /**
+   * Конструктор из произвольного диапазона. Элементы сортируются,
+   * повторы отбрасываются
+   * @tparam InputIt Тип итератора диапазона
+   * @param first Начало диапазона
+   * @param last Конец диапазона
+   */
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::iterator_category>
+  frozen_set(InputIt first, InputIt last);
+
+  iterator begin() const { return _index.begin(); }
+  iterator end() const { return _index.end(); }
+  /// Проверяет пустая ли коллекция
+  bool empty() const { return _index.IsEmpty(); }
+  /// Возвращает размер коллекции
+  size_type size() const { return _index.size(); }
+  /// Обмен с другой коллекцией за O(1)
+  void swap(frozen_set &other) noexcept { _index.Swap(other._index); }
+  /// Проверка наличия элемента
+  bool contains(const key_type &key) const { return _index.Include(key); }
+  /// Поиск элемента, end() если его нет
+  iterator find(const key_type &key) const { return _index.Find(key); }
+  /// Количество элементов с ключом (0 или 1)
+  size_type count(const key_type &key) const {
+    return _index.Include(key) ? 1 : 0;
+  }
+  /// Первый элемент, не меньший ключа
+  iterator lower_bound(const key_type &key) const {
+    return _index.LowerBound(key);
+  }
+  /// Первый элемент, больший ключа
+  iterator upper_bound(const key_type &key) const {
+    return _index.UpperBound(key);
+  }
+  /// Диапазон элементов с ключом
+  std::pair<iterator, iterator> equal_range(const key_type &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+  /// Проверка наличия по ключу любого типа при прозрачном компараторе
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) const {
+    return _index.Include(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) const {
+    return _index.Find(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) const {
+    return _index.LowerBound(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K &key) const {
+    return _index.UpperBound(key);
+  }
+  /// Память, занятая коллекцией, в байтах
+  size_type memory_usage() const { return _index.MemoryUsage(); }
+};
+
+}  // namespace s21
+
+#include "../templates/s21_frozen_set.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_FROZEN_SET_H_
@@ -0,0 +1,166 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_INTERVAL_MAP_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_INTERVAL_MAP_H_
+/**
+ * @file
+ * @brief Словарь отрезков с поиском пересечений
+ * @details Отрезки [lo, hi] хранятся в AvlTree по левому концу (затем по
+ * правому). Каждый узел дополнительно хранит наибольший правый конец в
+ * своем поддереве и пересчитывает его при поворотах. Поиск отрезков,
+ * пересекающих [lo, hi], не заходит в поддеревья, где все отрезки
+ * кончаются левее lo, и останавливается на первом отрезке, начинающемся
+ * правее hi
+ */
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "s21_avltree.h"
+
+namespace s21 {
+
+/**
+ * Порядок на отрезках: по левому концу, при равных левых - по правому
+ * @tparam Key тип концов отрезка
+ * @tparam Compare строгий порядок на концах
+ */
+template <typename Key, typename Compare>
+struct IntervalLess {
+  bool operator()(const std::pair<Key, Key> &a,
+                  const std::pair<Key, Key> &b) const {
+    if (Compare()(a.first, b.first)) return true;
+    if (Compare()(b.first, a.first)) return false;
+    return Compare()(a.second, b.second);
+  }
+};
+
+/**
+ * Ключ пары словаря отрезков и политика дополнения узлов: наибольший
+ * правый конец отрезков поддерева
+ * @tparam Pair тип пары (отрезок, значение)
+ * @tparam Key тип концов отрезка
+ * @tparam Compare строгий порядок на концах
+ */
+template <typename Pair, typename Key, typename Compare>
+struct IntervalKeyOf : SelectFirst<Pair> {
+  struct augment {
+    using type = Key;
+    static const Key &Make(const Pair &value) { return value.first.second; }
+    static const Key &Combine(const Key &a, const Key &b) {
+      return Compare()(a, b) ? b : a;
+    }
+  };
+};
+
+/**
+ * Словарь отрезков с повторяющимися ключами
+ * @details ключ - замкнутый отрезок std::pair<Key, Key>{lo, hi}, lo <= hi.
+ * Одинаковые отрезки допускаются и хранятся в порядке вставки. Запросы
+ * пересечения выполняются за O(log n + k log(n / k)) для k найденных
+ * отрезков, проверка наличия пересечения - за O(log n)
+ * @tparam Key тип концов отрезка, конструируемый по умолчанию
+ * @tparam T тип значения
+ * @tparam Compare строгий порядок на концах
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class interval_map {
+ public:
+  using point_type = Key;
+  using key_type = std::pair<Key, Key>;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, T>;
+  using key_compare = IntervalLess<Key, Compare>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+
+ private:
+  using tree_type =
+      AvlTree<key_type, value_type, IntervalKeyOf<value_type, Key, Compare>,
+              key_compare, false>;
+  tree_type _tree;
+
+  /// visit(iterator) для каждой пары, отрезок которой пересекает [lo, hi]
+  template <typename F>
+  void ForEachOverlap(const Key &lo, const Key &hi, F &visit);
+
+ public:
+  using iterator = typename tree_type::iterator;
+
+  interval_map() = default;
+  /**
+   * Конструктор с инициализацией из списка пар (отрезок, значение)
+   * @param items список пар
+   * @throw std::invalid_argument если у отрезка hi < lo
+   */
+  interval_map(std::initializer_list<value_type> const &items);
+
+  iterator begin() { return _tree.begin(); }
+  iterator end() { return _tree.end(); }
+  bool empty() { return _tree.IsEmpty(); }
+  size_type size() { return _tree.size(); }
+  void clear() { _tree.Clear(); }
+
+  /**
+   * Вставка отрезка со значением
+   * @param lo левый конец
+   * @param hi правый конец
+   * @param obj значение
+   * @return итератор на вставленную пару
+   * @throw std::invalid_argument если hi < lo
+   */
+  iterator insert(const Key &lo, const Key &hi, const T &obj);
+  /// Вставка пары (отрезок, значение), см. insert(lo, hi, obj)
+  iterator insert(const value_type &value);
+  /// Удаление пары по итератору
+  void erase(iterator pos);
+  /**
+   * Удаление всех пар с отрезком [lo, hi]
+   * @return количество удаленных пар
+   */
+  size_type erase(const Key &lo, const Key &hi);
+  /// Первая пара с отрезком [lo, hi], end() если ее нет
+  iterator find(const Key &lo, const Key &hi);
+
+  /**
+   * Есть ли отрезок, пересекающий [lo, hi], за O(log n)
+   * @param lo левый конец запроса
+   * @param hi правый конец запроса
+   */
+  bool overlaps(const Key &lo, const Key &hi);
+  /**
+   * Вызов fn(value) для каждой пары, отрезок которой пересекает [lo, hi],
+   * по возрастанию отрезков
+   * @param lo левый конец запроса
+   * @param hi правый конец запроса
+   * @param fn функция от value_type &
+   */
+  template <typename F>
+  void for_each_overlapping(const Key &lo, const Key &hi, F fn);
+  /**
+   * Все пары, отрезки которых пересекают [lo, hi]
+   * @return итераторы по возрастанию отрезков
+   */
+  std::vector<iterator> overlapping(const Key &lo, const Key &hi);
+  /**
+   * Все пары, отрезки которых содержат точку
+   * @return итераторы по возрастанию отрезков
+   */
+  std::vector<iterator> stab(const Key &point) {
+    return overlapping(point, point);
+  }
+  /// Проверка инвариантов дерева и наибольших правых концов
+  bool validate() const { return _tree.Validate(); }
+};
+
+}  // namespace s21
+
+#include "../templates/s21_interval_map.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_INTERVAL_MAP_H_
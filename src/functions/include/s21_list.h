@@ -4,6 +4,8 @@
 
 #ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_LIST_H_
 #define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_LIST_H_
+#include <utility>
+
 #include "SqContainer.h"
 
 /**
@@ -29,13 +31,13 @@ class list : public s21::SqContainer<T> {
     Node *next; /**< Pointer to the next node in the list */
 
     /**
-     * Constructor to initialize a node with a given value
-     * @param val The value to be stored in the node
+     * Constructor to build the node value in place
+     * @tparam Args The types of the value constructor arguments
+     * @param args The value constructor arguments
      */
-    explicit Node(typename SqContainer<T>::value_type val) {
-      value = val;
-      prev = next = nullptr;
-    }
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args &&...args)
+        : value(std::forward<Args>(args)...), prev(nullptr), next(nullptr) {}
   };
 
   /**
@@ -212,6 +214,24 @@ class list : public s21::SqContainer<T> {
    */
   iterator insert(iterator pos, typename SqContainer<T>::const_reference value);
 
+  /**
+   * Insert an element at a specified position in the list by moving it
+   * @param pos Iterator pointing to the position to insert the element
+   * @param value The value of the element to insert
+   * @return Iterator pointing to the newly inserted element
+   */
+  iterator insert(iterator pos, typename SqContainer<T>::value_type &&value);
+
+  /**
+   * Construct an element in place at a specified position in the list
+   * @tparam Args The types of the element constructor arguments
+   * @param pos Iterator pointing to the position to insert the element
+   * @param args The element constructor arguments
+   * @return Iterator pointing to the newly constructed element
+   */
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args &&...args);
+
   /**
    * Erase the element at a specified position in the list
    * @param pos Iterator pointing to the position of the element to erase
@@ -219,10 +239,27 @@ class list : public s21::SqContainer<T> {
   void erase(iterator pos);
 
   /**
-   * Add an element to the end of the list
+   * Add an element to the end of the list. Overrides the interface method
+   * for copyable T; for move-only T it is an ordinary member that does not
+   * compile when called
+   * @param value The value of the element to add
+   */
+  void push_back(typename SqContainer<T>::const_reference value);
+
+  /**
+   * Add an element to the end of the list by moving it
    * @param value The value of the element to add
    */
-  void push_back(typename SqContainer<T>::const_reference value) override;
+  void push_back(typename SqContainer<T>::value_type &&value);
+
+  /**
+   * Construct an element in place at the end of the list
+   * @tparam Args The types of the element constructor arguments
+   * @param args The element constructor arguments
+   * @return Reference to the newly constructed element
+   */
+  template <class... Args>
+  typename SqContainer<T>::reference emplace_back(Args &&...args);
 
   /**
    * Remove the last element from the list
@@ -235,6 +272,21 @@ class list : public s21::SqContainer<T> {
    */
   void push_front(typename SqContainer<T>::const_reference value);
 
+  /**
+   * Add an element to the beginning of the list by moving it
+   * @param value The value of the element to add
+   */
+  void push_front(typename SqContainer<T>::value_type &&value);
+
+  /**
+   * Construct an element in place at the beginning of the list
+   * @tparam Args The types of the element constructor arguments
+   * @param args The element constructor arguments
+   * @return Reference to the newly constructed element
+   */
+  template <class... Args>
+  typename SqContainer<T>::reference emplace_front(Args &&...args);
+
   /**
    * Remove the first element from the list
    */
@@ -1,63 +1,62 @@
 #ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_MAP_H_
 #define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_MAP_H_
 
+#include <iterator>
+#include <tuple>
 #include <utility>
 
 #include "s21_avltree.h"
+#include "s21_frozen_map.h"
 #include "s21_vector.h"
 
 namespace s21 {
-/// @brief класс-обертка над std::pair. Необходим для того, чтобы определить
-/// собственные опараторы < и ==, так как перегрузки std::pair в данной задаче
-/// неприменимы: сравнивать необходимо только ключи
-/// @tparam Key тип ключа мапы
-/// @tparam T тип значения мапы
-template <typename Key, typename T>
-class Pair {
- public:
-  Pair();
-  Pair(const std::pair<Key, T> &value);
-  Pair(Pair &&p);
-  Pair(const Pair &other);
-
-  Pair &operator=(const Pair &other);
-  Pair &operator=(Pair &&other);
-  bool operator<(const Pair &other);
-  bool operator==(const Pair &other);
-  bool operator>(const Pair &other);
-
-  /// @brief мутатор для перегрузки оператора [] и метода at, которые позволяют
-  /// менять значение по ключу
-  /// @return ссылка на второй элемент пары
-  T &second();
-
- private:
-  void swap(Pair &other);
-  std::pair<Key, T> pair_;
-};
-
-template <typename Key, typename T>
+template <typename Key, typename T, typename Compare = std::less<Key>>
 class map {
  public:
   using key_type = Key;
   using mapped_type = T;
-  using value_type = Pair<key_type, mapped_type>;
+  using key_compare = Compare;
+  /// пары хранятся в дереве как есть, упорядочиваются только по ключу
+  using value_type = std::pair<const key_type, mapped_type>;
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = size_t;
-  struct iterator : AvlTree<value_type>::iterator {
+
+ private:
+  /// дерево с уникальными ключами, ключ пары - ее первый элемент
+  using tree_type = AvlTree<key_type, value_type, SelectFirst<value_type>,
+                            Compare, true>;
+
+ public:
+  struct iterator : tree_type::iterator {
     iterator() {}
-    iterator(typename AvlTree<value_type>::iterator const &it)
-        : AvlTree<value_type>::iterator(it) {}
+    iterator(typename tree_type::iterator const &it)
+        : tree_type::iterator(it) {}
   };
-  struct const_iterator : AvlTree<value_type>::const_iterator {};
-  map();
+  struct const_iterator : tree_type::const_iterator {};
+  /// дескриптор извлеченной ноды
+  using node_type = typename tree_type::NodeHandle;
+  /// результат вставки дескриптора ноды
+  struct insert_return_type {
+    iterator position;  /// вставленная нода или нода с тем же ключом
+    bool inserted;      /// удалась ли вставка
+    node_type node;     /// нода, если ключ уже был в мапе
+  };
+  map() = default;
   map(const std::initializer_list<std::pair<Key, T>> &items);
-  map(const map &other);
-  map(map &&m);
-  map &operator=(map &&m);
-  map &operator=(const map &other);
-  ~map();
+  /// @brief конструктор из диапазона пар. Пары один раз сортируются по ключу,
+  /// после чего дерево строится за O(n). При повторе ключа остается первая
+  /// пара
+  /// @param first начало диапазона
+  /// @param last конец диапазона
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::iterator_category>
+  map(InputIt first, InputIt last);
+  map(const map &other) = default;
+  map(map &&m) noexcept = default;
+  map &operator=(map &&m) noexcept = default;
+  map &operator=(const map &other) = default;
+  ~map() = default;
 
   /// @brief доступ к значению по ключу с проверкой валидности ключа. Если ключ
   /// не найден, кидает ошибку std::out_of_range
@@ -66,11 +65,13 @@ class map {
   mapped_type &at(const Key &key);
 
   /// @brief доступ к значению и возможность его обновления по существующему
-  /// ключу; запись новой пары ключ-значение, если ключа нет
+  /// ключу; запись новой пары ключ-значение, если ключа нет. Один спуск по
+  /// ключу, T() создается только для нового ключа
   /// @param key ключ мапы
   /// @return ссылка на значение, соответстующее ключу, если ключ найден. В
   /// противном случае ссылка на второй член вновь созданной пары
   mapped_type &operator[](const Key &key);
+  mapped_type &operator[](Key &&key);
 
   iterator begin();
   iterator end();
@@ -83,14 +84,52 @@ class map {
 
   void clear();
 
-  /// @brief вставка узла в мапу. При подаче std::pair происходит
-  /// преобразование, так как в классе Pair задан соответствующий конструктор
-  /// @param value пара для мапы типа Pair<key_type, mapped_type> или
-  /// std::pair<key_type, mapped_type>
+  /// @brief вставка узла в мапу
+  /// @param value пара для мапы типа std::pair<const key_type, mapped_type>
   /// @return итератор, указывающий на вставленную ноду и true, если вставка
   /// прошла успешно. Иначе end() и false
   std::pair<iterator, bool> insert(const value_type &value);
 
+  /// @brief вставка узла в мапу перемещением пары
+  /// @param value пара для мапы типа std::pair<const key_type, mapped_type>
+  /// @return итератор, указывающий на вставленную ноду и true, если вставка
+  /// прошла успешно. Иначе итератор на ноду с тем же ключом и false
+  std::pair<iterator, bool> insert(value_type &&value);
+
+  /// @brief вставка пары с подсказкой позиции. Если ключ должен оказаться
+  /// непосредственно перед hint, место находится за O(1) сравнений без
+  /// спуска от корня, иначе как обычная вставка. В обоих случаях O(log n)
+  /// из-за обновления размеров поддеревьев до корня. Для возрастающих ключей
+  /// подсказка - end()
+  /// @param hint итератор на ноду, перед которой, вероятно, окажется новая
+  /// @param value пара для мапы
+  /// @return итератор на вставленную ноду или ноду с тем же ключом
+  iterator insert(iterator hint, const value_type &value);
+  iterator insert(iterator hint, value_type &&value);
+
+  /// @brief создание пары на месте из аргументов конструктора
+  /// std::pair<const key_type, mapped_type>. Подходит для некопируемых
+  /// mapped_type
+  /// @param args аргументы конструктора пары
+  /// @return итератор, указывающий на вставленную ноду и true, если вставка
+  /// прошла успешно. Иначе итератор на ноду с тем же ключом и false
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+
+  /// @brief создание пары на месте с подсказкой позиции
+  /// @param hint итератор на ноду, перед которой, вероятно, окажется новая
+  /// @param args аргументы конструктора пары
+  /// @return итератор на вставленную ноду или ноду с тем же ключом
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args &&...args);
+
+  /// @brief замена содержимого мапы парами отсортированного по ключу
+  /// диапазона за O(n). При повторе ключа остается первая пара
+  /// @param first начало диапазона
+  /// @param last конец диапазона
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last);
+
   /// @brief функция вставки узла в мапу от двух аргументов. Не перезаписывает
   /// значение по уже существующему ключу
   /// @param key ключ
@@ -100,24 +139,178 @@ class map {
   std::pair<iterator, bool> insert(const Key &key, const T &obj);
 
   /// @brief функция вставки узла в мапу от двух аргументов. Перезаписывает
-  /// значение по уже существующему ключу
+  /// значение по уже существующему ключу. Нода ищется одним спуском
   /// @param key ключ
   /// @param obj значение, соответствующее ключу
   /// @return итератор, указывающий на вставленную ноду и true, если вставка
   /// прошла успешно. В случае, если значение по ключу было перезаписано, вернет
   /// итератор, указывающий на ноду и false
   std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj);
+  std::pair<iterator, bool> insert_or_assign(const Key &key, T &&obj);
+
+  /// @brief вставка пары с ключом key и значением из аргументов args, только
+  /// если ключа нет. Место вставки ищется одним спуском по ключу до создания
+  /// значения: при существующем ключе значение не создается, а args не
+  /// перемещаются
+  /// @param key ключ
+  /// @param args аргументы конструктора значения
+  /// @return итератор на вставленную ноду или ноду с тем же ключом и true,
+  /// если вставка прошла успешно
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args);
 
-  /// @brief удаление ноды, на которую указывает итератор
+  /// @brief удаление ноды, на которую указывает итератор, без повторного
+  /// поиска по ключу
   /// @param pos итератор
-  void erase(iterator pos);
+  /// @return итератор на следующую ноду, end() для pos == end()
+  iterator erase(iterator pos);
+
+  /// @brief удаление пар диапазона [first, last) за O(log n) и освобождение
+  /// удаленных нод: дерево разделяется по номерам границ и соединяется
+  /// @param first начало диапазона
+  /// @param last конец диапазона
+  /// @return итератор last
+  iterator erase(iterator first, iterator last);
+
+  /// @brief удаление пар с ключами из полуинтервала [lo, hi) за O(log n) и
+  /// освобождение удаленных нод
+  /// @param lo нижняя граница (включительно)
+  /// @param hi верхняя граница (не включительно)
+  /// @return количество удаленных пар
+  size_type erase_range(const Key &lo, const Key &hi);
+
+  /// @brief извлечение пар с ключами из полуинтервала [lo, hi) в новую мапу
+  /// за O(log n), ноды переходят без копирования. Память у мап остается
+  /// общей, но их можно использовать из разных потоков
+  /// @param lo нижняя граница (включительно)
+  /// @param hi верхняя граница (не включительно)
+  /// @return мапа с извлеченными парами
+  map extract_range(const Key &lo, const Key &hi);
   void swap(map &other);
 
-  /// @brief добавляет узлы мапы в текущую мапу
+  /// @brief извлечение ноды без копирования пары
+  /// @param pos итератор на извлекаемую ноду
+  /// @return дескриптор ноды
+  node_type extract(iterator pos);
+
+  /// @brief извлечение ноды по ключу
+  /// @param key ключ извлекаемой ноды
+  /// @return дескриптор ноды, пустой если ключа нет
+  node_type extract(const Key &key);
+
+  /// @brief вставка извлеченной ноды без выделения памяти
+  /// @param node дескриптор ноды
+  /// @return позиция, успешность вставки и нода, если ключ уже был в мапе
+  insert_return_type insert(node_type &&node);
+
+  /// @brief вставка извлеченной ноды с подсказкой позиции
+  /// @param hint итератор на ноду, перед которой, вероятно, окажется новая
+  /// @param node дескриптор ноды
+  /// @return итератор на вставленную ноду или ноду с тем же ключом
+  iterator insert(iterator hint, node_type &&node);
+
+  /// @brief переносит в текущую мапу ноды other с ключами, которых в ней
+  /// нет. Ноды перевешиваются без копирования, остальные остаются в other
   /// @param other мапа, узлы которой необходимо добавить в текущую
   void merge(map &other);
   bool contains(const Key &key);
 
+  /// @brief первая пара с ключом, не меньшим key, за O(log n)
+  /// @param key ключ для сравнения
+  /// @return итератор на пару, end() если такой нет
+  iterator lower_bound(const Key &key);
+
+  /// @brief первая пара с ключом, большим key, за O(log n)
+  /// @param key ключ для сравнения
+  /// @return итератор на пару, end() если такой нет
+  iterator upper_bound(const Key &key);
+
+  /// @brief поиск пары по ключу за O(log n)
+  /// @param key ключ
+  /// @return итератор на пару, end() если ключа нет
+  iterator find(const Key &key);
+
+  /// @brief количество пар с ключом (0 или 1)
+  /// @param key ключ
+  /// @return количество пар
+  size_type count(const Key &key) const { return _tree.Count(key); }
+
+  /// @brief поиск по ключу любого типа, сравнимого с Key через Compare.
+  /// Доступен только при прозрачном компараторе (например, std::less<>),
+  /// временный Key при этом не создается
+  /// @tparam K тип ключа
+  /// @param key ключ
+  /// @return итератор на пару, end() если ключа нет
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) {
+    return _tree.Find(key);
+  }
+
+  /// @brief доступ к значению по ключу любого типа, см. find(const K &)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  mapped_type &at(const K &key) {
+    typename tree_type::iterator tmp = _tree.Find(key);
+    if (tmp == _tree.end()) {
+      throw std::out_of_range("s21::map::at:  key not found");
+    }
+    return (*tmp).second;
+  }
+
+  /// @brief проверка наличия ключа любого типа, см. find(const K &)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) {
+    return _tree.Include(key);
+  }
+
+  /// @brief количество пар по ключу любого типа, см. find(const K &)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K &key) const {
+    return _tree.Count(key);
+  }
+
+  /// @brief первая пара с ключом, не меньшим key любого типа, см.
+  /// find(const K &)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) {
+    return _tree.LowerBound(key);
+  }
+
+  /// @brief первая пара с ключом, большим key любого типа, см.
+  /// find(const K &)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K &key) {
+    return _tree.UpperBound(key);
+  }
+
+  /// @brief получение k-й по возрастанию ключа пары за O(log n)
+  /// @param k номер пары, начиная с 0
+  /// @return итератор на пару, end() если k >= количества пар
+  iterator nth(size_type k);
+
+  /// @brief количество ключей, строго меньших key, за O(log n)
+  /// @param key ключ для сравнения
+  /// @return ранг ключа
+  size_type rank(const Key &key) const;
+
+  /// @brief количество ключей в полуинтервале [lo, hi) за O(log n)
+  /// @param lo нижняя граница (включительно)
+  /// @param hi верхняя граница (не включительно)
+  /// @return количество ключей
+  size_type count_range(const Key &lo, const Key &hi) const;
+
+  /// @brief неизменяемая копия мапы для быстрого поиска за O(n). Пары
+  /// копируются в один массив без нод, см. frozen_map
+  /// @return frozen_map с теми же парами
+  frozen_map<Key, T, Compare> freeze();
+
   /// @brief вставка сразу нескольких пар в дерево
   /// @tparam ...Args определяются при помощи вывода типов С++, указывать их не
   /// надо
@@ -128,7 +321,9 @@ class map {
   s21::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
 
  private:
-  AvlTree<value_type> *tree_;
+  /// дерево хранится в самой мапе: без лишнего выделения памяти и
+  /// косвенного обращения при каждой операции
+  tree_type _tree;
 };
 }  // namespace s21
 
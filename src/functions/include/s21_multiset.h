@@ -8,53 +8,129 @@
 #include "s21_set.h"
 
 namespace s21 {
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
+class multiset;
+
+/// Объединение мультимножеств (повторы - max), см. set_union для set
+template <typename T, typename Compare>
+multiset<T, Compare> set_union(multiset<T, Compare> a, multiset<T, Compare> b,
+                               ThreadPool &pool = ThreadPool::Instance());
+/// Пересечение мультимножеств (повторы - min), см. set_union для set
+template <typename T, typename Compare>
+multiset<T, Compare> set_intersection(
+    multiset<T, Compare> a, multiset<T, Compare> b,
+    ThreadPool &pool = ThreadPool::Instance());
+/// Разность мультимножеств (повторы - max(a - b, 0)), см. set_union для set
+template <typename T, typename Compare>
+multiset<T, Compare> set_difference(
+    multiset<T, Compare> a, multiset<T, Compare> b,
+    ThreadPool &pool = ThreadPool::Instance());
+
+template <typename T, typename Compare>
 class multiset {
  private:
-  AvlTree<T> _tree;
+  using tree_type = AvlTree<T, T, Identity<T>, Compare>;
+  tree_type _tree;
 
  public:
-  class MultiSetIterator : public AvlTree<T>::Iterator {
-    friend class set<T>;
+  class MultiSetIterator : public tree_type::Iterator {
+    friend class multiset<T, Compare>;
 
    public:
-    explicit MultiSetIterator(typename AvlTree<T>::Iterator it)
-        : AvlTree<T>::Iterator(it) {}
+    explicit MultiSetIterator(typename tree_type::Iterator it)
+        : tree_type::Iterator(it) {}
   };
-  class ConstMultiSetIterator : public AvlTree<T>::ConstIterator {
-    friend class set<T>;
+  class ConstMultiSetIterator : public tree_type::ConstIterator {
+    friend class multiset<T, Compare>;
   };
   using key_type = T;
   using value_type = T;
+  using key_compare = Compare;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using iterator = typename AvlTree<T>::Iterator;
-  using const_iterator = typename AvlTree<T>::ConstIterator;
+  using iterator = typename tree_type::Iterator;
+  using const_iterator = typename tree_type::ConstIterator;
   using size_type = std::size_t;
+  using node_type = typename tree_type::NodeHandle;
   multiset();
   multiset(std::initializer_list<value_type> const &items);
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::iterator_category>
+  multiset(InputIt first, InputIt last);
   multiset(const multiset &s);
   multiset(multiset &&s) noexcept;
-  multiset<T> &operator=(const multiset &s);
+  multiset<T, Compare> &operator=(const multiset &s);
+  multiset<T, Compare> &operator=(multiset &&s) noexcept;
   bool empty();
   size_type size() { return _tree.size(); }
   size_type max_size() { return _tree.max_size(); }
   void clear();
   std::pair<iterator, bool> insert(const value_type &value);
-  void erase(iterator pos);
-  void swap(multiset<T> &other);
-  void merge(multiset<T> &other);
+  std::pair<iterator, bool> insert(value_type &&value);
+  iterator insert(iterator hint, const value_type &value);
+  iterator insert(iterator hint, value_type &&value);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args &&...args);
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last);
+  iterator erase(iterator pos);
+  iterator erase(iterator first, iterator last);
+  size_type erase_range(const key_type &lo, const key_type &hi);
+  multiset extract_range(const key_type &lo, const key_type &hi);
+  node_type extract(iterator pos);
+  node_type extract(const key_type &key);
+  iterator insert(node_type &&node);
+  iterator insert(iterator hint, node_type &&node);
+  void swap(multiset<T, Compare> &other);
+  void merge(multiset<T, Compare> &other);
   size_type count(const key_type &key) { return _tree.Count(key); }
   iterator find(const key_type &key);
   bool contains(const key_type &key);
   std::pair<iterator, iterator> equal_range(const T &key);
   iterator lower_bound(const T &key);
   iterator upper_bound(const T &key);
+  /// Поиск по ключу любого типа при прозрачном компараторе Compare
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) {
+    return MultiSetIterator(_tree.Find(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) {
+    return _tree.Include(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K &key) {
+    return _tree.Count(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) {
+    return MultiSetIterator(_tree.LowerBound(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K &key) {
+    return MultiSetIterator(_tree.UpperBound(key));
+  }
+  iterator nth(size_type k);
+  size_type rank(const key_type &key) const;
+  size_type count_range(const key_type &lo, const key_type &hi) const;
   iterator begin();
   iterator end();
   template <class... Args>
   vector<std::pair<iterator, bool>> insert_many(Args &&...args);
-  ~multiset();
+  ~multiset() = default;
+  friend multiset set_union<T, Compare>(multiset a, multiset b,
+                                        ThreadPool &pool);
+  friend multiset set_intersection<T, Compare>(multiset a, multiset b,
+                                               ThreadPool &pool);
+  friend multiset set_difference<T, Compare>(multiset a, multiset b,
+                                             ThreadPool &pool);
 };
 }  // namespace s21
 #include "../templates/s21_multiset.tpp"
@@ -0,0 +1,188 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_NODE_POOL_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_NODE_POOL_H_
+/**
+ * @file
+ * @brief Пул узлов (slab аллокатор) для деревьев
+ * @details Память под узлы выделяется блоками (slab) растущего размера.
+ * Освобожденные узлы попадают в список свободных и переиспользуются без
+ * обращения к malloc. Вся память пула возвращается целыми блоками при
+ * вызове Release или в деструкторе.
+ *
+ * Деревья, обменивающиеся узлами (split/join, слияния), разделяют один пул
+ * через std::shared_ptr. При объединении двух разных пулов блоки одного
+ * переходят к другому, а опустевший пул перенаправляет на новый (как в
+ * системе непересекающихся множеств), так что память узлов живет, пока жив
+ * хотя бы один владелец.
+ *
+ * Владельцы общего пула - разные контейнеры, и их можно использовать из
+ * разных потоков. Поэтому пул, отданный второму владельцу, помечается
+ * общим, и дальше выделение и освобождение идут под его мьютексом. Пул
+ * с одним владельцем работает без блокировок.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * Шаблон класса пула узлов
+ * @details пул выдает только сырую память: конструирование и разрушение
+ * значений в узлах остается на стороне контейнера. Пул с одним владельцем
+ * не потокобезопасен, общий пул (после Share или Unite) можно одновременно
+ * использовать из разных потоков. При определении макроса
+ * S21_AVLTREE_HEAP_NODES каждый узел выделяется отдельным operator new
+ * (используется для сравнения в бенчмарках)
+ * @tparam N тип узла
+ */
+template <typename N>
+class NodePool {
+ public:
+#ifdef S21_AVLTREE_HEAP_NODES
+  /// Release не освобождает узлы, их нужно возвращать по одному
+  static constexpr bool kBulkRelease = false;
+#else
+  /// Release освобождает и все выданные узлы
+  static constexpr bool kBulkRelease = true;
+#endif
+  NodePool() = default;
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+  /**
+   * Конструктор перемещения. Блоки памяти переходят к новому пулу
+   * @param other пул для перемещения
+   */
+  NodePool(NodePool &&other) noexcept;
+  NodePool &operator=(NodePool &&other) noexcept;
+  /// деструктор, возвращает все блоки
+  ~NodePool() { Release(); }
+
+  /**
+   * Выделение памяти под один узел
+   * @return указатель на неинициализированную память под узел
+   */
+  N *Allocate();
+  /**
+   * Возврат памяти узла в список свободных. Деструктор узла должен быть
+   * вызван заранее
+   * @param node узел для освобождения
+   */
+  void Deallocate(N *node) noexcept;
+  /**
+   * Резервирование блока под count узлов. Следующие count выделений будут
+   * идти подряд из одного блока
+   * @param count количество узлов
+   */
+  void Reserve(std::size_t count);
+#ifndef S21_AVLTREE_HEAP_NODES
+  /**
+   * Выделение непрерывного блока под count узлов. Узлы блока возвращаются
+   * по одному через Deallocate. Только без S21_AVLTREE_HEAP_NODES
+   * @param count количество узлов
+   * @return указатель на первый узел блока
+   */
+  N *AllocateBlock(std::size_t count);
+#endif
+  /**
+   * Возврат всей памяти пула целыми блоками. Все выданные узлы становятся
+   * недействительными
+   */
+  void Release() noexcept;
+  /// Обмен содержимым с другим пулом
+  void swap(NodePool &other) noexcept;
+  /**
+   * Отметка о том, что у пула появляется второй владелец. Вызывается
+   * единственным владельцем до передачи пула, после нее все операции
+   * идут под мьютексом. Отметка не снимается
+   */
+  void Share() noexcept { _shared.store(true, std::memory_order_release); }
+  /// Есть ли у пула другие владельцы
+  bool IsShared() const {
+    return _shared.load(std::memory_order_acquire);
+  }
+  /// Был ли пул поглощен другим пулом
+  bool IsForwarded() const {
+    return _forward.load(std::memory_order_acquire) != nullptr;
+  }
+  /**
+   * Пул, в который перенаправлен данный (корень цепочки перенаправлений)
+   * @param pool пул
+   * @return действующий пул
+   */
+  static std::shared_ptr<NodePool> Resolve(std::shared_ptr<NodePool> pool);
+  /**
+   * Объединение двух пулов. Блоки и свободные узлы пула b переходят к пулу a,
+   * после чего b перенаправляет все запросы в a. Оба пула становятся
+   * общими. Безопасно при одновременной работе других владельцев a и b
+   * @param a первый пул
+   * @param b второй пул
+   * @return действующий объединенный пул
+   */
+  static std::shared_ptr<NodePool> Unite(const std::shared_ptr<NodePool> &a,
+                                         const std::shared_ptr<NodePool> &b);
+  /**
+   * Перенос блоков и свободных узлов пула other в данный. other остается
+   * пустым и не перенаправляется, поэтому у него не должно быть других
+   * владельцев: вызывающий сразу его освобождает
+   * @param other поглощаемый пул
+   */
+  void Absorb(NodePool &other);
+
+ private:
+  /// узел списка свободных, размещается поверх памяти освобожденного узла
+  struct FreeNode {
+    FreeNode *next;
+  };
+  /// блок памяти под узлы
+  struct Slab {
+    N *data;
+    std::size_t capacity;
+  };
+  static_assert(sizeof(N) >= sizeof(FreeNode),
+                "node must fit a free list link");
+  static constexpr std::size_t kMinSlab = 16;     /// минимальный блок
+  static constexpr std::size_t kMaxSlab = 16384;  /// максимальный блок
+
+  /// выделение нового блока на count узлов
+  void AddSlab(std::size_t count);
+  /// выделение узла без блокировки
+  N *TakeNode();
+  /// возврат узла без блокировки
+  void PutNode(N *node) noexcept;
+  /// резервирование без блокировки
+  void ReserveNodes(std::size_t count);
+  /**
+   * Вызов f(pool) под мьютексом действующего пула. Перенаправления
+   * проверяются под мьютексом, так как Unite может выполняться в другом
+   * потоке
+   */
+  template <typename F>
+  decltype(auto) Locked(F &&f);
+
+  std::vector<Slab> _slabs;           /// все блоки пула
+  FreeNode *_free = nullptr;          /// список свободных узлов
+  FreeNode *_free_tail = nullptr;     /// последний свободный узел
+  N *_cursor = nullptr;               /// первый неиспользованный узел блока
+  N *_cursor_end = nullptr;           /// конец текущего блока
+  std::size_t _next_slab = kMinSlab;  /// размер следующего блока
+  /// пул, поглотивший данный. Записывается один раз, до этого
+  /// _forward_owner, поэтому читается без блокировки
+  std::atomic<NodePool *> _forward{nullptr};
+  std::shared_ptr<NodePool> _forward_owner;  /// владение _forward
+  std::atomic<bool> _shared{false};          /// есть другие владельцы
+  std::mutex _mutex;                         /// защита общего пула
+};
+
+}  // namespace s21
+
+#include "../templates/s21_node_pool.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_NODE_POOL_H_
@@ -0,0 +1,285 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_PERSISTENT_AVLTREE_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_PERSISTENT_AVLTREE_H_
+/**
+ * @file
+ * @brief Персистентное Avl дерево с копированием пути
+ * @details Версии дерева разделяют неизменные поддеревья. Узел, на который
+ * ссылается больше одной версии (или больше одного родителя), никогда не
+ * изменяется: вставка и удаление копируют только узлы на пути от корня,
+ * остальные поддеревья переходят в новую версию по ссылке. Узел с
+ * единственной ссылкой принадлежит только текущей версии и изменяется на
+ * месте, поэтому без снимков дерево работает как обычное Avl дерево.
+ *
+ * Снимок - это копия корня с увеличением счетчика ссылок, O(1). Счетчики
+ * атомарные, поэтому снимки можно читать, копировать и уничтожать в других
+ * потоках без блокировок, пока писатель изменяет свою версию. У узлов нет
+ * ссылок на родителя (у общего узла их может быть несколько), итератор
+ * хранит путь от корня.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "s21_avltree.h"
+
+namespace s21 {
+
+/**
+ * Шаблон класса персистентного Avl дерева с уникальными ключами
+ * @details политики Key, Value, KeyOfValue и Compare совпадают с политиками
+ * AvlTree. Узлы выделяются по одному через operator new: пул узлов не
+ * потокобезопасен, а узлы снимка освобождаются в том потоке, где исчезла
+ * последняя ссылка на них. Один объект дерева нельзя изменять из разных
+ * потоков одновременно, разные объекты (версии) - можно
+ * @tparam Key тип ключа
+ * @tparam Value тип хранимого значения
+ * @tparam KeyOfValue функтор, возвращающий ключ значения
+ * @tparam Compare строгий порядок на ключах
+ */
+template <typename Key, typename Value = Key,
+          typename KeyOfValue = Identity<Key>,
+          typename Compare = std::less<Key>>
+class PersistentAvlTree {
+ private:
+  /// узел дерева, общий для всех версий, которые на него ссылаются
+  struct Node {
+    template <typename... Args>
+    explicit Node(Args &&...args) : value(std::forward<Args>(args)...) {}
+    std::atomic<std::size_t> refs{1};  /// количество ссылок на узел
+    Node *left = nullptr;               /// левое поддерево
+    Node *right = nullptr;              /// правое поддерево
+    int height = 1;                     /// высота поддерева
+    Value value;                        /// значение
+  };
+
+  Node *_root = nullptr;  /// корень версии
+  std::size_t _size = 0;  /// количество элементов
+
+ public:
+  /**
+   * Константный итератор. Хранит путь от корня до текущего узла: узлы, из
+   * которых спуск шел влево. Пустой путь означает end()
+   */
+  class ConstIterator {
+   private:
+    friend class PersistentAvlTree;
+    std::vector<const Node *> _path;  /// путь, текущий узел - последний
+
+    /// спуск по левым ссылкам с сохранением пути
+    void PushLeft(const Node *node) {
+      for (; node; node = node->left) _path.push_back(node);
+    }
+
+   public:
+    /// типы для std::iterator_traits
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Value *;
+    using reference = const Value &;
+    ConstIterator() = default;
+    reference operator*() const { return _path.back()->value; }
+    pointer operator->() const { return &_path.back()->value; }
+    ConstIterator &operator++() {
+      const Node *node = _path.back();
+      _path.pop_back();
+      PushLeft(node->right);
+      return *this;
+    }
+    ConstIterator operator++(int) {
+      ConstIterator old = *this;
+      ++*this;
+      return old;
+    }
+    bool operator==(const ConstIterator &other) const {
+      return _path.empty() ? other._path.empty()
+                           : !other._path.empty() &&
+                                 _path.back() == other._path.back();
+    }
+    bool operator!=(const ConstIterator &other) const {
+      return !(*this == other);
+    }
+  };
+  using const_iterator = ConstIterator;
+  /// тип ключа
+  using key_type = Key;
+  /// тип данных
+  using value_type = Value;
+
+  PersistentAvlTree() = default;
+  /**
+   * Конструктор копирования за O(1): версии разделяют все узлы
+   * @param other дерево для копирования
+   */
+  PersistentAvlTree(const PersistentAvlTree &other) noexcept
+      : _root(Acquire(other._root)), _size(other._size) {}
+  PersistentAvlTree(PersistentAvlTree &&other) noexcept
+      : _root(std::exchange(other._root, nullptr)),
+        _size(std::exchange(other._size, 0)) {}
+  PersistentAvlTree &operator=(const PersistentAvlTree &other) noexcept;
+  PersistentAvlTree &operator=(PersistentAvlTree &&other) noexcept;
+  /// деструктор, освобождает узлы, на которые не ссылаются другие версии
+  ~PersistentAvlTree() { Release(_root); }
+
+  /**
+   * Снимок текущей версии за O(1). Последующие изменения дерева не видны в
+   * снимке, и наоборот
+   * @return неизменная копия дерева
+   */
+  PersistentAvlTree Snapshot() const { return *this; }
+
+  const_iterator begin() const {
+    const_iterator it;
+    it.PushLeft(_root);
+    return it;
+  }
+  const_iterator end() const { return const_iterator(); }
+  /// Количество элементов
+  std::size_t size() const { return _size; }
+  /// Пустое ли дерево
+  bool IsEmpty() const { return _size == 0; }
+  /// Максимальное количество элементов
+  std::size_t max_size() const {
+    return std::numeric_limits<std::size_t>::max() / sizeof(Node);
+  }
+  /// Удаление всех элементов текущей версии
+  void Clear() noexcept {
+    Release(_root);
+    _root = nullptr;
+    _size = 0;
+  }
+  /// Обмен содержимым за O(1)
+  void Swap(PersistentAvlTree &other) noexcept {
+    std::swap(_root, other._root);
+    std::swap(_size, other._size);
+  }
+
+  /**
+   * Вставка значения. Копируются только общие с другими версиями узлы на
+   * пути от корня
+   * @param value значение
+   * @return true если значение вставлено, false если ключ уже есть
+   */
+  bool Insert(const Value &value) {
+    return TryEmplace(KeyOfValue()(value), nullptr, value).second;
+  }
+  bool Insert(Value &&value) {
+    /// ключ сравнивается только до создания узла из value
+    return TryEmplace(KeyOfValue()(value), nullptr, std::move(value)).second;
+  }
+  /**
+   * Вставка значения из args, если ключа еще нет, за один спуск с
+   * копированием пути. Значение создается только для нового ключа. Общие с
+   * другими версиями узлы пути копируются и тогда, когда ключ уже есть
+   * @param key ключ значения
+   * @param pos если не nullptr, сюда записывается итератор на элемент
+   * @param args аргументы конструктора значения
+   * @return значение с ключом key и true, если оно вставлено. Путь до
+   * значения принадлежит текущей версии, его можно изменять на месте
+   */
+  template <typename K, typename... Args>
+  std::pair<Value *, bool> TryEmplace(const K &key, const_iterator *pos,
+                                      Args &&...args);
+  /**
+   * Удаление по ключу за один спуск с копированием пути
+   * @param key ключ
+   * @return true если элемент был удален
+   */
+  template <typename K>
+  bool Erase(const K &key);
+  /**
+   * Изменяемый доступ к значению по ключу за один спуск. Путь до узла
+   * копируется, если он общий с другими версиями
+   * @param key ключ
+   * @return указатель на значение, nullptr если ключа нет
+   */
+  template <typename K>
+  Value *Access(const K &key);
+
+  /// Поиск по ключу, end() если его нет
+  template <typename K>
+  const_iterator Find(const K &key) const;
+  /// Есть ли элемент с ключом
+  template <typename K>
+  bool Include(const K &key) const;
+  /// Первый элемент, не меньший ключа
+  template <typename K>
+  const_iterator LowerBound(const K &key) const;
+  /// Первый элемент, больший ключа
+  template <typename K>
+  const_iterator UpperBound(const K &key) const;
+  /**
+   * Проверка инвариантов: порядок ключей, высоты, баланс, счетчики ссылок
+   * и размер
+   * @return true если дерево корректно
+   */
+  bool Validate() const;
+
+ private:
+  /// новая ссылка на узел
+  static Node *Acquire(Node *node) noexcept {
+    if (node) node->refs.fetch_add(1, std::memory_order_relaxed);
+    return node;
+  }
+  /// снятие ссылки, последняя ссылка освобождает узел и его поддеревья
+  static void Release(Node *node) noexcept;
+  /**
+   * Узел в слоте становится собственным для текущей версии: общий узел
+   * заменяется копией со ссылками на те же поддеревья. Содержимое дерева
+   * не меняется, поэтому исключение копирования безопасно
+   */
+  static void MakeUnique(Node *&slot);
+  static int Height(const Node *node) { return node ? node->height : 0; }
+  static int BalanceFactor(const Node *node) {
+    return Height(node->right) - Height(node->left);
+  }
+  static void FixHeight(Node *node) {
+    node->height = std::max(Height(node->left), Height(node->right)) + 1;
+  }
+  /// повороты и балансировка собственного узла в слоте
+  static void RotateLeft(Node *&slot);
+  static void RotateRight(Node *&slot);
+  static void Balance(Node *&slot);
+  /**
+   * Вставка в поддерево слота, если ключа в нем нет
+   * @param inserted признак созданного узла
+   * @param trail если не nullptr, сюда записывается путь от найденного
+   * узла до слота (найденный узел первым)
+   * @return узел с ключом key
+   */
+  template <typename K, typename... Args>
+  static Node *InsertAt(Node *&slot, const K &key, bool &inserted,
+                        std::vector<Node *> *trail, Args &&...args);
+  /**
+   * Восстановление пути trail после балансировки слота: поворот перестроил
+   * вершину поддерева и ее детей, они находятся заново спуском к target
+   * @param top вершина поддерева после балансировки
+   * @param before вершина до балансировки
+   */
+  static void Retrace(Node *top, const Node *before, const Node *target,
+                      std::vector<Node *> &trail);
+  /// удаление из поддерева слота, removed - признак отцепленного узла
+  template <typename K>
+  static void EraseAt(Node *&slot, const K &key, bool &removed);
+  /// отцепление минимального узла поддерева без балансировки
+  static Node *DetachMin(Node *&slot);
+  /// балансировка собственных узлов левой ветви после DetachMin
+  static void BalanceLeftSpine(Node *&slot);
+  /// проверка поддерева, возвращает высоту или -1
+  static int ValidateSubtree(const Node *node, const Node *lo, const Node *hi,
+                             std::size_t &count);
+};
+
+}  // namespace s21
+
+#include "../templates/s21_persistent_avltree.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_PERSISTENT_AVLTREE_H_
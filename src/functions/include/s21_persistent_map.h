@@ -0,0 +1,139 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_PERSISTENT_MAP_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_PERSISTENT_MAP_H_
+/**
+ * @file
+ * @brief Словарь с моментальными снимками
+ * @details Интерфейс повторяет s21::map, а snapshot() за O(1) возвращает
+ * неизменную версию словаря на текущий момент. Писатель продолжает изменять
+ * словарь, читатели работают со снимками в других потоках без блокировок.
+ * Изменения копируют только O(log n) узлов пути, см. s21_persistent_avltree.h
+ */
+
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "s21_persistent_avltree.h"
+
+namespace s21 {
+
+/**
+ * Персистентный словарь с уникальными ключами
+ * @details копирование словаря тоже выполняется за O(1) и дает независимую
+ * версию. Итераторы только константные: изменить значение можно через
+ * operator[], at или insert_or_assign, которые копируют путь до пары
+ * @tparam Key тип ключа
+ * @tparam T тип значения
+ * @tparam Compare строгий порядок на ключах
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class persistent_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using key_compare = Compare;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+
+ private:
+  using tree_type = PersistentAvlTree<Key, value_type,
+                                      SelectFirst<value_type>, Compare>;
+  tree_type _tree;
+
+ public:
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = iterator;
+  using size_type = std::size_t;
+
+  persistent_map() = default;
+  /**
+   * Конструктор с инициализацией из переменного списка пар. При повторе
+   * ключа остается первая пара
+   * @param items список пар
+   */
+  persistent_map(std::initializer_list<value_type> const &items)
+      : persistent_map(items.begin(), items.end()) {}
+  /**
+   * Конструктор из произвольного диапазона пар
+   * @tparam InputIt Тип итератора диапазона
+   * @param first Начало диапазона
+   * @param last Конец диапазона
+   */
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::iterator_category>
+  persistent_map(InputIt first, InputIt last) {
+    for (; first != last; ++first) _tree.Insert(*first);
+  }
+
+  /**
+   * Моментальный снимок словаря за O(1)
+   * @return версия словаря, которую не затрагивают дальнейшие изменения
+   */
+  persistent_map snapshot() const { return *this; }
+
+  /// @brief доступ к значению по ключу. Если ключ не найден, кидает ошибку
+  /// std::out_of_range
+  /// @param key ключ словаря
+  /// @return ссылка на значение, соответстующее ключу
+  const mapped_type &at(const Key &key) const;
+  /// @brief изменяемый доступ к значению по ключу. Путь до пары копируется,
+  /// если он общий со снимками
+  mapped_type &at(const Key &key);
+  /// @brief доступ к значению по ключу, при отсутствии ключа вставляет
+  /// значение по умолчанию
+  mapped_type &operator[](const Key &key);
+  iterator begin() const { return _tree.begin(); }
+  iterator end() const { return _tree.end(); }
+  /// Проверяет пустая ли коллекция
+  bool empty() const { return _tree.IsEmpty(); }
+  /// Возвращает размер коллекции
+  size_type size() const { return _tree.size(); }
+  /// Максимальный размер коллекции
+  size_type max_size() const { return _tree.max_size(); }
+  /// Удаляет все пары текущей версии, снимки не затрагиваются
+  void clear() noexcept { _tree.Clear(); }
+  /// Обмен с другой коллекцией за O(1)
+  void swap(persistent_map &other) noexcept { _tree.Swap(other._tree); }
+
+  /// @brief вставка пары
+  /// @return итератор на пару с ключом и признак вставки
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return insert(value_type(key, obj));
+  }
+  /// @brief вставка пары или замена значения существующего ключа
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  /// @brief удаление пары по ключу
+  /// @return количество удаленных пар (0 или 1)
+  size_type erase(const Key &key) { return _tree.Erase(key) ? 1 : 0; }
+  /// @brief удаление пары по итератору
+  void erase(iterator pos) { _tree.Erase(pos->first); }
+
+  /// Проверка наличия ключа
+  bool contains(const Key &key) const { return _tree.Include(key); }
+  /// Поиск пары по ключу, end() если ее нет
+  iterator find(const Key &key) const { return _tree.Find(key); }
+  /// Количество пар с ключом (0 или 1)
+  size_type count(const Key &key) const { return _tree.Include(key) ? 1 : 0; }
+  /// Первая пара с ключом, не меньшим key
+  iterator lower_bound(const Key &key) const { return _tree.LowerBound(key); }
+  /// Первая пара с ключом, большим key
+  iterator upper_bound(const Key &key) const { return _tree.UpperBound(key); }
+  /// Проверка инвариантов дерева
+  bool validate() const { return _tree.Validate(); }
+};
+
+}  // namespace s21
+
+#include "../templates/s21_persistent_map.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_PERSISTENT_MAP_H_
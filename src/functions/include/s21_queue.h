@@ -101,6 +101,20 @@ class queue {
    */
   void push(typename SqContainer<T>::const_reference value);
 
+  /**
+   * Push an element onto the back of the queue by moving it.
+   * @param value The value of the element to push
+   */
+  void push(typename SqContainer<T>::value_type &&value);
+
+  /**
+   * Construct an element in place at the back of the queue.
+   * @tparam Args The types of the element constructor arguments
+   * @param args The element constructor arguments
+   */
+  template <class... Args>
+  void emplace(Args &&...args);
+
   /**
    * Pop the front element from the queue.
    */
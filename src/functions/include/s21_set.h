@@ -6,39 +6,89 @@
 #define CPP2_S21_CONTAINERS_1_S21_SET_H
 
 #include <iostream>
+#include <iterator>
 
 #include "s21_avltree.h"
+#include "s21_frozen_set.h"
 #include "s21_vector.h"
 
 namespace s21 {
 
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
+class set;
+
+/**
+ * Объединение множеств на основе split/join за O(m log(n/m + 1)), где m -
+ * размер меньшего множества. Ветви рекурсии выполняются параллельно.
+ * Множества передаются по значению: при передаче через std::move узлы не
+ * копируются, а переходят в результат
+ * @param a первое множество
+ * @param b второе множество
+ * @param pool пул потоков
+ * @return объединение (при совпадении остается элемент из a)
+ */
+template <typename T, typename Compare>
+set<T, Compare> set_union(set<T, Compare> a, set<T, Compare> b,
+                          ThreadPool &pool = ThreadPool::Instance());
+/**
+ * Пересечение множеств на основе split/join, см. set_union
+ * @param a первое множество
+ * @param b второе множество
+ * @param pool пул потоков
+ * @return пересечение
+ */
+template <typename T, typename Compare>
+set<T, Compare> set_intersection(set<T, Compare> a, set<T, Compare> b,
+                                 ThreadPool &pool = ThreadPool::Instance());
+/**
+ * Разность множеств на основе split/join, см. set_union
+ * @param a уменьшаемое множество
+ * @param b вычитаемое множество
+ * @param pool пул потоков
+ * @return элементы a, которых нет в b
+ */
+template <typename T, typename Compare>
+set<T, Compare> set_difference(set<T, Compare> a, set<T, Compare> b,
+                               ThreadPool &pool = ThreadPool::Instance());
+
+template <typename T, typename Compare>
 class set {
  private:
+  /// Дерево с уникальными значениями
+  using tree_type = AvlTree<T, T, Identity<T>, Compare, true>;
   /// Дерево как способ реализации коллекции
-  AvlTree<T> _tree;
+  tree_type _tree;
 
  public:
   /// Итератор
-  class SetIterator : public AvlTree<T>::Iterator {
-    friend class set<T>;
+  class SetIterator : public tree_type::Iterator {
+    friend class set<T, Compare>;
 
    public:
-    explicit SetIterator(typename AvlTree<T>::Iterator it)
-        : AvlTree<T>::Iterator(it) {}
+    explicit SetIterator(typename tree_type::Iterator it)
+        : tree_type::Iterator(it) {}
     SetIterator() {}
   };
   /// Константный итератор
-  class ConstSetIterator : public AvlTree<T>::ConstIterator {
-    friend class set<T>;
+  class ConstSetIterator : public tree_type::ConstIterator {
+    friend class set<T, Compare>;
   };
   using key_type = T;
   using value_type = T;
+  using key_compare = Compare;
   using reference = value_type &;
   using const_reference = const value_type &;
   using iterator = SetIterator;
   using const_iterator = ConstSetIterator;
   using size_type = std::size_t;
+  /// Дескриптор извлеченного узла
+  using node_type = typename tree_type::NodeHandle;
+  /// Результат вставки дескриптора узла
+  struct insert_return_type {
+    iterator position;  /// вставленный или равный ему элемент
+    bool inserted;      /// удалась ли вставка
+    node_type node;     /// узел, если вставка не удалась
+  };
   /// Конструктор
   set();
   /**
@@ -46,6 +96,16 @@ class set {
    * @param items список элементов
    */
   set(std::initializer_list<value_type> const &items);
+  /**
+   * Конструктор из диапазона. Элементы сортируются один раз, после чего
+   * дерево строится за O(n)
+   * @tparam InputIt Тип итератора диапазона
+   * @param first Начало диапазона
+   * @param last Конец диапазона
+   */
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::iterator_category>
+  set(InputIt first, InputIt last);
   /**
    * Конструктор копирования
    * @param s Объект для копирования
@@ -61,7 +121,13 @@ class set {
    * @param s Объект для присваивания
    * @return Присвоенные(скопированный) объект
    */
-  set<T> &operator=(const set &s);
+  set<T, Compare> &operator=(const set &s);
+  /**
+   * Оператор перемещающего присваивания. Узлы не копируются
+   * @param s Объект для перемещения
+   * @return Текущий объект
+   */
+  set<T, Compare> &operator=(set &&s) noexcept;
   /// Проверяет пустая ли коллекция
   bool empty();
   /// Возвращает размер коллекции
@@ -78,20 +144,120 @@ class set {
    */
   std::pair<iterator, bool> insert(const value_type &value);
   /**
-   * Удаляет элемент по итератору
+   * Операция вставки одного элемента перемещением
+   * @param value Элемент для вставки
+   * @return pair итератор на добавленный элемент и булево значение успешность
+   * добавления
+   */
+  std::pair<iterator, bool> insert(value_type &&value);
+  /**
+   * Операция вставки с подсказкой позиции. Если элемент должен оказаться
+   * непосредственно перед hint, место находится за O(1) сравнений без
+   * спуска от корня, иначе как обычная вставка. В обоих случаях O(log n) из-за
+   * обновления размеров поддеревьев до корня. Для возрастающего потока
+   * подсказка - end()
+   * @param hint Итератор на элемент, перед которым, вероятно, окажется новый
+   * @param value Элемент для вставки
+   * @return итератор на добавленный (или равный ему) элемент
+   */
+  iterator insert(iterator hint, const value_type &value);
+  iterator insert(iterator hint, value_type &&value);
+  /**
+   * Создание элемента на месте из аргументов конструктора
+   * @tparam Args Типы аргументов
+   * @param args Аргументы конструктора элемента
+   * @return pair итератор на добавленный (или равный ему) элемент и булево
+   * значение успешность добавления
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  /**
+   * Создание элемента на месте с подсказкой позиции
+   * @param hint Итератор на элемент, перед которым, вероятно, окажется новый
+   * @param args Аргументы конструктора элемента
+   * @return итератор на добавленный (или равный ему) элемент
+   */
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args &&...args);
+  /**
+   * Замена содержимого коллекции элементами отсортированного диапазона за
+   * O(n). Повторяющиеся элементы отбрасываются
+   * @tparam InputIt Тип итератора диапазона
+   * @param first Начало диапазона
+   * @param last Конец диапазона
+   * @warning Диапазон должен быть отсортирован по возрастанию
+   */
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last);
+  /**
+   * Удаляет элемент по итератору без повторного поиска
    * @param pos Итератор позиции для удаления
+   * @return итератор на следующий элемент, end() для pos == end()
+   */
+  iterator erase(iterator pos);
+  /**
+   * Удаляет элементы диапазона [first, last) за O(log n) и освобождение
+   * удаленных узлов: дерево разделяется по номерам границ, оставшиеся части
+   * соединяются
+   * @param first Начало диапазона
+   * @param last Конец диапазона
+   * @return Итератор last
+   */
+  iterator erase(iterator first, iterator last);
+  /**
+   * Удаляет элементы с ключами из полуинтервала [lo, hi) за O(log n) и
+   * освобождение удаленных узлов
+   * @param lo Нижняя граница (включительно)
+   * @param hi Верхняя граница (не включительно)
+   * @return Количество удаленных элементов
+   */
+  size_type erase_range(const key_type &lo, const key_type &hi);
+  /**
+   * Извлечение элементов с ключами из полуинтервала [lo, hi) в новое
+   * множество за O(log n). Узлы переходят без копирования, память у
+   * множеств остается общей, но их можно использовать из разных потоков
+   * @param lo Нижняя граница (включительно)
+   * @param hi Верхняя граница (не включительно)
+   * @return Множество с извлеченными элементами
+   */
+  set extract_range(const key_type &lo, const key_type &hi);
+  /**
+   * Извлечение узла без копирования значения
+   * @param pos Итератор на извлекаемый элемент
+   * @return Дескриптор узла
+   */
+  node_type extract(iterator pos);
+  /**
+   * Извлечение узла по ключу
+   * @param key Ключ извлекаемого элемента
+   * @return Дескриптор узла, пустой если ключа нет
+   */
+  node_type extract(const key_type &key);
+  /**
+   * Вставка извлеченного узла без выделения памяти
+   * @param node Дескриптор узла
+   * @return Позиция, успешность вставки и узел, если элемент уже был
    */
-  void erase(iterator pos);
+  insert_return_type insert(node_type &&node);
   /**
-   * Операция обмена с другой коллекцией
+   * Вставка извлеченного узла с подсказкой позиции
+   * @param hint Итератор на элемент, перед которым, вероятно, окажется узел
+   * @param node Дескриптор узла
+   * @return Итератор на вставленный (или равный ему) элемент
+   */
+  iterator insert(iterator hint, node_type &&node);
+  /**
+   * Операция обмена с другой коллекцией за O(1)
    * @param other Коллекция для обмена
    */
-  void swap(set<T> &other);
+  void swap(set<T, Compare> &other);
   /**
-   * Операция слияния с другой коллекцией
+   * Операция слияния с другой коллекцией за O(m log(n + m)). Узлы other
+   * перевешиваются без копирования, элементы, которые уже есть в
+   * коллекции, остаются в other
    * @param other Коллекция для слияния
    */
-  void merge(set<T> &other);
+  void merge(set<T, Compare> &other);
   /**
    * Операция поиска по ключу
    * @param key Ключ для поиска
@@ -104,6 +270,86 @@ class set {
    * @return булево значение наличия элемента в коллекции
    */
   bool contains(const key_type &key);
+  /**
+   * Первый элемент, не меньший ключа, за O(log n)
+   * @param key Ключ для сравнения
+   * @return Итератор на элемент, end() если такого нет
+   */
+  iterator lower_bound(const key_type &key);
+  /**
+   * Первый элемент, больший ключа, за O(log n)
+   * @param key Ключ для сравнения
+   * @return Итератор на элемент, end() если такого нет
+   */
+  iterator upper_bound(const key_type &key);
+  /**
+   * Количество элементов с ключом (0 или 1)
+   * @param key Ключ для поиска
+   * @return Количество элементов
+   */
+  size_type count(const key_type &key) { return _tree.Count(key); }
+  /**
+   * Операция поиска по ключу любого типа, сравнимого с элементами через
+   * Compare. Доступна только при прозрачном компараторе (например,
+   * std::less<>), временный key_type при этом не создается
+   * @tparam K Тип ключа
+   * @param key Ключ для поиска
+   * @return Итератор на найденный элемент, end() если его нет
+   */
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) {
+    return SetIterator(_tree.Find(key));
+  }
+  /// Проверка наличия элемента по ключу любого типа, см. find(const K &)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) {
+    return _tree.Include(key);
+  }
+  /// Количество элементов по ключу любого типа, см. find(const K &)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K &key) {
+    return _tree.Count(key);
+  }
+  /// Первый элемент, не меньший ключа любого типа, см. find(const K &)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) {
+    return SetIterator(_tree.LowerBound(key));
+  }
+  /// Первый элемент, больший ключа любого типа, см. find(const K &)
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K &key) {
+    return SetIterator(_tree.UpperBound(key));
+  }
+  /**
+   * Получение k-го по возрастанию элемента за O(log n)
+   * @param k номер элемента, начиная с 0
+   * @return Итератор на элемент, end() если k >= size()
+   */
+  iterator nth(size_type k);
+  /**
+   * Количество элементов, строго меньших ключа, за O(log n)
+   * @param key Ключ для сравнения
+   * @return Ранг ключа
+   */
+  size_type rank(const key_type &key) const;
+  /**
+   * Количество элементов в полуинтервале [lo, hi) за O(log n)
+   * @param lo Нижняя граница (включительно)
+   * @param hi Верхняя граница (не включительно)
+   * @return Количество элементов
+   */
+  size_type count_range(const key_type &lo, const key_type &hi) const;
+  /**
+   * Неизменяемая копия множества для быстрого поиска за O(n). Элементы
+   * копируются в один массив без узлов, см. frozen_set
+   * @return frozen_set с теми же элементами
+   */
+  frozen_set<T, Compare> freeze();
   iterator begin();
   iterator end();
   /**
@@ -117,8 +363,11 @@ class set {
   vector<std::pair<iterator, bool>> insert_many(Args &&...args);
   /// Вывод содержимого коллекции
   void show() { _tree.Print(); }
+  friend set set_union<T, Compare>(set a, set b, ThreadPool &pool);
+  friend set set_intersection<T, Compare>(set a, set b, ThreadPool &pool);
+  friend set set_difference<T, Compare>(set a, set b, ThreadPool &pool);
   /// Деструктор
-  ~set();
+  ~set() = default;
 };
 
 }  // namespace s21
@@ -0,0 +1,221 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_SKIPLIST_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_SKIPLIST_H_
+/**
+ * @file
+ * @brief Неблокирующий упорядоченный список с пропусками
+ * @details Узел связан в нескольких уровнях: нижний уровень содержит все
+ * узлы по возрастанию ключей, каждый следующий - примерно четверть узлов
+ * предыдущего. Вставка связывает узел снизу вверх одним CAS на уровень.
+ * Удаление логическое: младший бит ссылки next узла помечает его удаленным
+ * (сначала на верхних уровнях, затем на нижнем, где пометка и есть момент
+ * удаления). Помеченные узлы физически исключает любой проходящий поиск.
+ * Исключенный узел удаляется через EpochDomain, когда его не может читать ни
+ * один поток.
+ *
+ * Узел откладывается на удаление, когда закончили с ним оба владельца:
+ * удаливший поток (после исключения узла) и вставивший (после связывания
+ * верхних уровней). Иначе вставка могла бы связать верхний уровень уже
+ * исключенного узла.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <utility>
+
+#include "s21_avltree.h"
+#include "s21_epoch.h"
+
+namespace s21 {
+
+/**
+ * Шаблон класса неблокирующего списка с пропусками с уникальными ключами
+ * @details политики Key, Value, KeyOfValue и Compare совпадают с политиками
+ * AvlTree. Все методы, кроме деструктора, можно вызывать из разных потоков
+ * одновременно. Итераторы закрепляют эпоху: узел, на который указывает
+ * итератор, остается в памяти, даже если его удалили
+ * @tparam Key тип ключа
+ * @tparam Value тип хранимого значения
+ * @tparam KeyOfValue функтор, возвращающий ключ значения
+ * @tparam Compare строгий порядок на ключах
+ */
+template <typename Key, typename Value = Key,
+          typename KeyOfValue = Identity<Key>,
+          typename Compare = std::less<Key>>
+class SkipList {
+ public:
+  /// наибольшее количество уровней: 4^16 узлов
+  static constexpr int kMaxHeight = 16;
+
+ private:
+  using link = std::uintptr_t;
+  /**
+   * Узел списка. Массив next продолжается за концом структуры до height
+   * ячеек, память выделяется под конкретную высоту
+   */
+  struct Node {
+    int height;
+    /// владельцы узла: вставивший и удаливший потоки
+    std::atomic<int> owners;
+    alignas(Value) unsigned char storage[sizeof(Value)];
+    std::atomic<link> next[1];
+    Value &value() { return *std::launder(reinterpret_cast<Value *>(storage)); }
+  };
+
+  Node *_head;                      /// голова без значения, высоты kMaxHeight
+  std::atomic<int> _height{1};      /// текущее количество уровней
+  std::atomic<std::size_t> _size{0};  /// количество элементов
+
+  static Node *Ptr(link value) { return reinterpret_cast<Node *>(value & ~1); }
+  static bool Marked(link value) { return value & 1; }
+  static link Pack(Node *node, bool mark = false) {
+    return reinterpret_cast<link>(node) | mark;
+  }
+  static const Key &KeyOf(Node *node) { return KeyOfValue()(node->value()); }
+
+ public:
+  /**
+   * Константный итератор по нижнему уровню. Пропускает помеченные узлы и
+   * держит закрепленную эпоху
+   * @warning итератор используется в потоке, где получен
+   */
+  class ConstIterator {
+   private:
+    friend class SkipList;
+    EpochDomain::Guard _guard;  /// закрепление эпохи
+    Node *_node = nullptr;      /// текущий узел, nullptr для end()
+    ConstIterator(EpochDomain::Guard guard, Node *node)
+        : _guard(std::move(guard)), _node(node) {}
+
+   public:
+    /// типы для std::iterator_traits
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Value *;
+    using reference = const Value &;
+    ConstIterator() = default;
+    reference operator*() const { return _node->value(); }
+    pointer operator->() const { return &_node->value(); }
+    ConstIterator &operator++() {
+      _node = SkipList::NextLive(_node);
+      return *this;
+    }
+    ConstIterator operator++(int) {
+      ConstIterator old = *this;
+      ++*this;
+      return old;
+    }
+    bool operator==(const ConstIterator &other) const {
+      return _node == other._node;
+    }
+    bool operator!=(const ConstIterator &other) const {
+      return _node != other._node;
+    }
+  };
+  using const_iterator = ConstIterator;
+  /// тип ключа
+  using key_type = Key;
+  /// тип данных
+  using value_type = Value;
+
+  SkipList() : _head(CreateNode(kMaxHeight)) {}
+  SkipList(const SkipList &) = delete;
+  SkipList &operator=(const SkipList &) = delete;
+  /// деструктор. Одновременных операций со списком быть не должно
+  ~SkipList();
+
+  const_iterator begin() const;
+  const_iterator end() const { return const_iterator(); }
+  /// Количество элементов. При одновременных изменениях - приблизительное
+  std::size_t size() const { return _size.load(std::memory_order_relaxed); }
+  /// Пустой ли список
+  bool IsEmpty() const { return size() == 0; }
+  /// Максимальное количество элементов
+  std::size_t max_size() const {
+    return std::numeric_limits<std::size_t>::max() /
+           (sizeof(Node) + sizeof(link));
+  }
+
+  /**
+   * Неблокирующая вставка
+   * @param value значение
+   * @return итератор на элемент с ключом и признак вставки
+   */
+  std::pair<const_iterator, bool> Insert(const Value &value) {
+    return InsertValue(value);
+  }
+  std::pair<const_iterator, bool> Insert(Value &&value) {
+    return InsertValue(std::move(value));
+  }
+  /**
+   * Вставка значения, построенного из аргументов. Узел строится до поиска,
+   * при повторе ключа он удаляется
+   */
+  template <typename... Args>
+  std::pair<const_iterator, bool> Emplace(Args &&...args);
+  /**
+   * Неблокирующее удаление по ключу: пометка узла и его исключение
+   * @param key ключ
+   * @return true если элемент удален этим вызовом
+   */
+  template <typename K>
+  bool Erase(const K &key);
+
+  /// Поиск по ключу, end() если его нет
+  template <typename K>
+  const_iterator Find(const K &key) const;
+  /// Есть ли элемент с ключом
+  template <typename K>
+  bool Include(const K &key) const;
+  /// Первый элемент, не меньший ключа
+  template <typename K>
+  const_iterator LowerBound(const K &key) const;
+  /// Первый элемент, больший ключа
+  template <typename K>
+  const_iterator UpperBound(const K &key) const;
+
+ private:
+  /// узел высоты height без значения
+  static Node *CreateNode(int height);
+  /// удаление узла без значения (голова или неудавшаяся вставка)
+  static void FreeNode(Node *node) noexcept;
+  /// удаление узла со значением, функция удаления для EpochDomain
+  static void DestroyNode(void *node) noexcept;
+  /// случайная высота: уровень k с вероятностью 4^-(k-1)
+  static int RandomHeight();
+  /// следующий непомеченный узел нижнего уровня
+  static Node *NextLive(Node *node);
+  /**
+   * Поиск позиции ключа на всех уровнях с исключением встреченных
+   * помеченных узлов
+   * @param key ключ
+   * @param preds последние узлы с ключом меньше key по уровням
+   * @param succs первые узлы с ключом не меньше key по уровням
+   * @return true если succs[0] содержит key
+   */
+  template <typename K>
+  bool Search(const K &key, Node **preds, Node **succs) const;
+  /// первый непомеченный узел с ключом не меньше (Upper - больше) key
+  template <bool Upper, typename K>
+  Node *Bound(const K &key) const;
+  /// связывание нового узла, false если ключ уже есть
+  std::pair<Node *, bool> Link(Node *node);
+  /// снятие одного владельца, последний откладывает удаление узла
+  static void ReleaseOwner(Node *node);
+  template <typename V>
+  std::pair<const_iterator, bool> InsertValue(V &&value);
+};
+
+}  // namespace s21
+
+#include "../templates/s21_skiplist.tpp"
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_SKIPLIST_H_
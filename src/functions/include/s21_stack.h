@@ -95,6 +95,20 @@ class stack {
    */
   void push(typename SqContainer<T>::const_reference value);
 
+  /**
+   * Push an element onto the top of the stack by moving it.
+   * @param value The value of the element to push
+   */
+  void push(typename SqContainer<T>::value_type &&value);
+
+  /**
+   * Construct an element in place on the top of the stack.
+   * @tparam Args The types of the element constructor arguments
+   * @param args The element constructor arguments
+   */
+  template <class... Args>
+  void emplace(Args &&...args);
+
   /**
    * Pop the top element from the stack.
    */
@@ -0,0 +1,154 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_THREAD_POOL_H_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_THREAD_POOL_H_
+/**
+ * @file
+ * @brief Пул потоков для параллельных алгоритмов над деревьями
+ * @details Пул рассчитан на рекурсивный параллелизм вида fork-join: Invoke
+ * отдает одну ветку в очередь пула и выполняет вторую в текущем потоке. Пока
+ * ветка из очереди не выполнена, ожидающий поток сам берет задачи из очереди,
+ * поэтому вложенные вызовы Invoke не приводят к взаимной блокировке.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * Пул потоков с общей очередью задач
+ */
+class ThreadPool {
+ public:
+  /**
+   * Конструктор
+   * @param workers количество рабочих потоков. Вызывающий поток тоже
+   * участвует в работе, поэтому пул из workers потоков использует до
+   * workers + 1 ядер. При workers = 0 все выполняется последовательно
+   */
+  explicit ThreadPool(std::size_t workers) {
+    for (std::size_t i = 0; i < workers; ++i) {
+      _workers.emplace_back([this] { WorkerLoop(); });
+    }
+  }
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  /// деструктор, дожидается завершения рабочих потоков
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stop = true;
+    }
+    _ready.notify_all();
+    for (std::thread &worker : _workers) worker.join();
+  }
+
+  /**
+   * Общий пул на все ядра машины
+   * @return ссылка на пул
+   */
+  static ThreadPool &Instance() {
+    static ThreadPool pool(std::thread::hardware_concurrency() > 1
+                               ? std::thread::hardware_concurrency() - 1
+                               : 0);
+    return pool;
+  }
+
+  /// Количество потоков, выполняющих работу (включая вызывающий)
+  std::size_t Concurrency() const { return _workers.size() + 1; }
+
+  /**
+   * Параллельное выполнение двух функций. Возвращает управление, когда обе
+   * выполнены. Исключение любой из функций пробрасывается вызывающему
+   * @param left функция, отдаваемая в очередь пула
+   * @param right функция, выполняемая в текущем потоке
+   */
+  template <typename F, typename G>
+  void Invoke(F &&left, G &&right) {
+    if (_workers.empty()) {
+      left();
+      right();
+      return;
+    }
+    std::atomic<bool> done{false};
+    std::exception_ptr left_error;
+    Submit([&] {
+      try {
+        left();
+      } catch (...) {
+        left_error = std::current_exception();
+      }
+      done.store(true, std::memory_order_release);
+    });
+    std::exception_ptr right_error;
+    try {
+      right();
+    } catch (...) {
+      right_error = std::current_exception();
+    }
+    /// пока ждем, помогаем выполнять задачи из очереди
+    while (!done.load(std::memory_order_acquire)) {
+      if (!RunPending()) std::this_thread::yield();
+    }
+    if (right_error) std::rethrow_exception(right_error);
+    if (left_error) std::rethrow_exception(left_error);
+  }
+
+ private:
+  /// постановка задачи в очередь
+  void Submit(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _tasks.push_back(std::move(task));
+    }
+    _ready.notify_one();
+  }
+
+  /// выполнение одной задачи из очереди, false если очередь пуста
+  bool RunPending() {
+    std::function<void()> task;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_tasks.empty()) return false;
+      task = std::move(_tasks.back());
+      _tasks.pop_back();
+    }
+    task();
+    return true;
+  }
+
+  /// цикл рабочего потока
+  void WorkerLoop() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _ready.wait(lock, [this] { return _stop || !_tasks.empty(); });
+        if (_stop && _tasks.empty()) return;
+        task = std::move(_tasks.front());
+        _tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> _workers;        /// рабочие потоки
+  std::deque<std::function<void()>> _tasks;  /// очередь задач
+  std::mutex _mutex;                         /// защита очереди
+  std::condition_variable _ready;            /// появление задачи
+  bool _stop = false;                        /// признак остановки пула
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_S21_THREAD_POOL_H_
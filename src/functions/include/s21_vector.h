@@ -1,6 +1,11 @@
 #ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_vector_H_
 #define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_INCLUDE_vector_H_
 
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
+
 #include "../../s21_containers.h"
 
 /**
@@ -10,6 +15,10 @@ namespace s21 {
 
 /**
  * Класс vector - динамический массив, хранящий элементы типа T.
+ * @details Память выделяется без конструирования элементов, элементы
+ * создаются на месте только в занятой части буфера. Поэтому T не обязан
+ * иметь конструктор по умолчанию или быть копируемым: вектор может хранить
+ * перемещаемые типы, например std::unique_ptr.
  * @tparam T Тип элементов, хранящихся в векторе.
  */
 template <typename T>
@@ -199,6 +208,24 @@ class vector {
    */
   iterator insert(iterator pos, const_reference value);
 
+  /**
+   * Вставка элемента в заданную позицию перемещением.
+   * @param pos Итератор на позицию, в которую необходимо вставить элемент.
+   * @param value Значение элемента для вставки.
+   * @return Итератор на вставленный элемент.
+   */
+  iterator insert(iterator pos, value_type &&value);
+
+  /**
+   * Создание элемента на месте в заданной позиции.
+   * @tparam Args Типы аргументов конструктора элемента.
+   * @param pos Итератор на позицию, в которую необходимо вставить элемент.
+   * @param args Аргументы конструктора элемента.
+   * @return Итератор на созданный элемент.
+   */
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args);
+
   /**
    * Удаление элемента из заданной позиции.
    * @param pos Итератор на позицию элемента для удаления.
@@ -211,6 +238,21 @@ class vector {
    */
   void push_back(const_reference value);
 
+  /**
+   * Добавление элемента в конец вектора перемещением.
+   * @param value Значение элемента для добавления.
+   */
+  void push_back(value_type &&value);
+
+  /**
+   * Создание элемента на месте в конце вектора.
+   * @tparam Args Типы аргументов конструктора элемента.
+   * @param args Аргументы конструктора элемента.
+   * @return Ссылка на созданный элемент.
+   */
+  template <typename... Args>
+  reference emplace_back(Args &&...args);
+
   /**
    * Удаление последнего элемента из вектора.
    */
@@ -252,6 +294,77 @@ class vector {
   void insert_many_back(Args &&...args);
 
  private:
+  /**
+   * Выделение неинициализированной памяти под n элементов.
+   * @param n Количество элементов.
+   * @return Указатель на память, nullptr при n = 0.
+   */
+  static iterator Allocate(size_type n);
+
+  /**
+   * Освобождение памяти, выделенной Allocate.
+   * @param data Указатель на память.
+   */
+  static void Deallocate(iterator data) noexcept;
+
+  /**
+   * Разрушение элементов полуинтервала [first, last).
+   * @param first Начало полуинтервала.
+   * @param last Конец полуинтервала.
+   */
+  static void Destroy(iterator first, iterator last) noexcept;
+
+  /**
+   * Перенос элементов в новый буфер заданной емкости.
+   * @param new_capacity Емкость нового буфера, не меньше size_.
+   */
+  void Reallocate(size_type new_capacity);
+
+  /**
+   * Создание элемента в позиции index с переносом в новый буфер большей
+   * емкости. Новый элемент создается до переноса старых, поэтому аргументы
+   * могут ссылаться на элементы самого вектора.
+   * @param index Позиция нового элемента.
+   * @param args Аргументы конструктора элемента.
+   * @return Итератор на созданный элемент.
+   */
+  template <typename... Args>
+  iterator EmplaceReallocate(size_type index, Args &&...args);
+
+  /**
+   * Создание элементов из args подряд в неинициализированной памяти. При
+   * исключении уже созданные элементы разрушаются.
+   * @param first Начало памяти под sizeof...(args) элементов.
+   * @param args Аргументы, по одному на элемент.
+   */
+  template <typename... Args>
+  static void ConstructMany(iterator first, Args &&...args);
+
+  /**
+   * Вставка элементов из args в позицию index с переносом в новый буфер.
+   * Элементы создаются до переноса старых, как в EmplaceReallocate.
+   * @param index Позиция первого нового элемента.
+   * @param args Аргументы, по одному на элемент.
+   * @return Итератор на первый созданный элемент.
+   */
+  template <typename... Args>
+  iterator InsertManyReallocate(size_type index, Args &&...args);
+
+  /**
+   * Вставка непустого набора элементов в позицию index без перевыделения:
+   * хвост сдвигается один раз на sizeof...(args) позиций. Значения
+   * создаются до сдвига, поэтому аргументы могут ссылаться на элементы
+   * самого вектора.
+   * @param index Позиция первого нового элемента.
+   * @param args Аргументы, по одному на элемент.
+   * @return Итератор на первый созданный элемент.
+   */
+  template <typename... Args>
+  iterator InsertManyShift(size_type index, Args &&...args);
+
+  /// Емкость после увеличения буфера при добавлении одного элемента.
+  size_type GrowthCapacity() const { return capacity_ ? capacity_ * 2 : 1; }
+
   iterator data_; /**< Указатель на начало выделенной памяти для хранения
                      элементов вектора. */
   size_type size_; /**< Текущий размер вектора (количество элементов). */
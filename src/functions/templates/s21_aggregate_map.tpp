@@ -0,0 +1,92 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_AGGREGATE_MAP_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_AGGREGATE_MAP_TPP_
+
+#include "../include/s21_aggregate_map.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Aggregate, typename Compare>
+aggregate_map<Key, T, Aggregate, Compare>::aggregate_map(
+    std::initializer_list<value_type> const &items) {
+  for (const value_type &item : items) _tree.Insert(item);
+}
+
+template <typename Key, typename T, typename Aggregate, typename Compare>
+const T &aggregate_map<Key, T, Aggregate, Compare>::at(const Key &key) {
+  auto it = _tree.Find(key);
+  if (it == _tree.end()) {
+    throw std::out_of_range("aggregate_map: key not found");
+  }
+  return (*it).second;
+}
+
+template <typename Key, typename T, typename Aggregate, typename Compare>
+std::pair<typename aggregate_map<Key, T, Aggregate, Compare>::const_iterator,
+          bool>
+aggregate_map<Key, T, Aggregate, Compare>::insert(const Key &key,
+                                                  const T &obj) {
+  /// один спуск, узел создается только для нового ключа
+  auto result = _tree.TryEmplace(key, key, obj);
+  return {const_iterator(result.first), result.second};
+}
+
+template <typename Key, typename T, typename Aggregate, typename Compare>
+std::pair<typename aggregate_map<Key, T, Aggregate, Compare>::const_iterator,
+          bool>
+aggregate_map<Key, T, Aggregate, Compare>::insert_or_assign(const Key &key,
+                                                            const T &obj) {
+  auto result = _tree.TryEmplace(key, key, obj);
+  if (!result.second) {
+    (*result.first).second = obj;
+    _tree.Refresh(result.first);
+  }
+  return {const_iterator(result.first), result.second};
+}
+
+template <typename Key, typename T, typename Aggregate, typename Compare>
+template <typename F>
+bool aggregate_map<Key, T, Aggregate, Compare>::update(const Key &key, F fn) {
+  auto it = _tree.Find(key);
+  if (it == _tree.end()) return false;
+  fn((*it).second);
+  _tree.Refresh(it);
+  return true;
+}
+
+template <typename Key, typename T, typename Aggregate, typename Compare>
+void aggregate_map<Key, T, Aggregate, Compare>::erase(const_iterator pos) {
+  if (pos != end()) _tree.Erase(pos);
+}
+
+template <typename Key, typename T, typename Aggregate, typename Compare>
+typename aggregate_map<Key, T, Aggregate, Compare>::size_type
+aggregate_map<Key, T, Aggregate, Compare>::erase(const Key &key) {
+  auto it = _tree.Find(key);
+  if (it == _tree.end()) return 0;
+  /// узел возвращается в собственный пул дерева, пул не становится общим
+  _tree.Erase(it);
+  return 1;
+}
+
+template <typename Key, typename T, typename Aggregate, typename Compare>
+typename aggregate_map<Key, T, Aggregate, Compare>::aggregate_type
+aggregate_map<Key, T, Aggregate, Compare>::aggregate(const Key &lo,
+                                                     const Key &hi) const {
+  auto fold = _tree.FoldRange(lo, hi);
+  return fold ? *fold : Aggregate::Neutral();
+}
+
+template <typename Key, typename T, typename Aggregate, typename Compare>
+typename aggregate_map<Key, T, Aggregate, Compare>::aggregate_type
+aggregate_map<Key, T, Aggregate, Compare>::aggregate() const {
+  auto fold = _tree.Fold();
+  return fold ? *fold : Aggregate::Neutral();
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_AGGREGATE_MAP_TPP_
@@ -6,27 +6,94 @@
 #define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_AVLTREE_TPP_
 
 namespace s21 {
-template <typename T>
-AvlTree<T>::AvlTree() {
-  _root = nullptr;
-  _unique = false;
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::AvlTree() {
+  SetRoot(nullptr);
   _size = 0;
 }
 
-template <typename T>
-int AvlTree<T>::BalanceFactor(Node *node) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::SetRoot(Node *root) {
+  _header.parent = root;
+  if (root) {
+    root->parent = &_header;
+    _header.left = FindMin(root);
+    _header.right = FindMax(root);
+  } else {
+    _header.left = &_header;
+    _header.right = &_header;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Detach() {
+  Node *root = Root();
+  if (root) root->parent = nullptr;
+  SetRoot(nullptr);
+  _size = 0;
+  return root;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::StealNodes(
+    AvlTree &other) {
+  /// крайние узлы остаются прежними, меняется только заголовок
+  Node *root = other.Root();
+  _size = other._size;
+  _header.parent = root;
+  if (root) {
+    root->parent = &_header;
+    _header.left = other._header.left;
+    _header.right = other._header.right;
+  } else {
+    _header.left = &_header;
+    _header.right = &_header;
+  }
+  other.SetRoot(nullptr);
+  other._size = 0;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+int AvlTree<Key, Value, KeyOfValue, Compare, Unique>::BalanceFactor(
+    Node *node) {
   return GetHeight(node->right) - GetHeight(node->left);
 }
 
-template <typename T>
-void AvlTree<T>::FixHeight(Node *node) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::FixHeight(Node *node) {
   unsigned char height_left = GetHeight(node->left);
   unsigned char height_right = GetHeight(node->right);
   node->height = (height_left > height_right ? height_left : height_right) + 1;
+  node->count = GetCount(node->left) + GetCount(node->right) + 1;
+  FixAugment(node);
 }
 
-template <typename T>
-typename AvlTree<T>::Node *AvlTree<T>::RotateRight(Node *node) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+auto AvlTree<Key, Value, KeyOfValue, Compare, Unique>::NodeAugment(
+    const Node *node) {
+  /// объединение слева направо: политике не нужна коммутативность
+  typename augment_policy::type augment = augment_policy::Make(node->value);
+  if (node->left) {
+    augment = augment_policy::Combine(node->left->augment, augment);
+  }
+  if (node->right) {
+    augment = augment_policy::Combine(augment, node->right->augment);
+  }
+  return augment;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::RotateRight(Node *node) {
   Node *new_node = node->left;
   node->left = new_node->right;
   new_node->right = node;
@@ -38,8 +105,10 @@ typename AvlTree<T>::Node *AvlTree<T>::RotateRight(Node *node) {
   return new_node;
 }
 
-template <typename T>
-typename AvlTree<T>::Node *AvlTree<T>::RotateLeft(Node *node) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::RotateLeft(Node *node) {
   Node *new_node = node->right;
   node->right = new_node->left;
   new_node->left = node;
@@ -51,8 +120,10 @@ typename AvlTree<T>::Node *AvlTree<T>::RotateLeft(Node *node) {
   return new_node;
 }
 
-template <typename T>
-typename AvlTree<T>::Node *AvlTree<T>::Balance(Node *node) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Balance(Node *node) {
   if (node) {         /// проверка существование узла
     FixHeight(node);  /// корректировка высот
     /// выяснение случая поворота
@@ -75,183 +146,566 @@ typename AvlTree<T>::Node *AvlTree<T>::Balance(Node *node) {
   return node;
 }
 
-template <typename T>
-typename AvlTree<T>::triple AvlTree<T>::InInsert(AvlTree::Node *node, T value,
-                                                 bool uniq) {
-  /// узел не существует, создаем новый. Базовый случай
-  if (!node) {
-    Node *new_node = new Node(value);
-    triple res = {new_node, new_node, true};
-    _size++;
-    return res;
-  }
-  /// Изначально стоит false
-  triple triple = {nullptr, nullptr, false};
-  /// обращение к левому поддереву. с лева всегда меньше корня. иначе правое
-  if (value < node->value) {
-    triple = InInsert(node->left, value, uniq);
-    node->left = triple.now_root;
-    node->left->parent = node;  /// родитель левого поддерева - корень
-    /// уже существующее значение вставляем, если unique == false. Второе
-    /// условие можно бы было сократить до value > node->value, однако требовать
-    /// от класса ключа реализации operator> излишне
-  } else if ((value == node->value && !uniq) ||
-             (!(value < node->value) && !(value == node->value))) {
-    triple = InInsert(node->right, value, uniq);
-    node->right = triple.now_root;
-    node->right->parent = node;  /// родитель правого поддерева - корень
-  }
-  /// если узел существует в дереве и при этом флаг уникальности стоит true
-  /// то вставка не произошла и возвращаем указатель на найденный узел
-  if (value == node->value && uniq) triple.current_node = node;
-  /// всегда балансировка при изменении структуры дерева
-  triple.now_root = Balance(node);
-  return triple;
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::ReplaceChild(
+    Node *parent, Node *child, Node *replacement) {
+  if (parent == &_header) {
+    _header.parent = replacement;
+  } else if (parent->left == child) {
+    parent->left = replacement;
+  } else {
+    parent->right = replacement;
+  }
 }
 
-template <typename T>
-std::pair<typename AvlTree<T>::iterator, bool> AvlTree<T>::Insert(
-    AvlTree<T>::value_type value) {
-  /// реализация обертки
-  triple triple = InInsert(_root, value, _unique);
-  _root =
-      triple.now_root;  /// корень - новый корень(после вставки мог измениться)
-  Node *it_prev_node = PrevNode(triple.current_node);
-  if (!it_prev_node) {
-    it_prev_node = FindMax(_root);
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Rebalance(Node *node) {
+  while (node != &_header) {
+    Node *parent = node->parent;
+    /// высота поддерева до изменения структуры
+    unsigned char old_height = node->height;
+    Node *sub_root = Balance(node);
+    ReplaceChild(parent, node, sub_root);
+    node = parent;
+    /// высота поддерева не изменилась - выше балансировка не нужна
+    if (sub_root->height == old_height) break;
+  }
+  /// выше структура не меняется, но размеры поддеревьев нужно обновить
+  for (; node != &_header; node = node->parent) {
+    node->count = GetCount(node->left) + GetCount(node->right) + 1;
+    FixAugment(node);
   }
-  return std::pair<iterator, bool>(Iterator(triple.current_node, it_prev_node),
-                                   triple.third);
 }
 
-template <typename T>
-typename AvlTree<T>::Node *AvlTree<T>::InInclude(AvlTree::Node *node, T value) {
-  /// при ненахождении возвращаем nullptr
-  if (node == nullptr) return nullptr;
-  /// найдено
-  if (node->value == value) return node;
-  /// ищем в левом или правом поддереве
-  if (value < node->value) {
-    if (node->left) {
-      return InInclude(node->left, value);
-    } else {
-      /// не нашлось
-      return nullptr;
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::InsertPos
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::FindInsertPos(const Key &key,
+                                                               Node *hint) {
+  InsertPos pos{&_header, true, nullptr};
+  if (hint && CheckHint(key, hint, pos)) return pos;
+  Node *node = Root();
+  /// спуск до места вставки. Сравнения идут по ссылке, без копий значения,
+  /// равные ключи уходят вправо
+  while (node) {
+    pos.parent = node;
+    pos.to_left = Less(key, KeyOf(node));
+    node = pos.to_left ? node->left : node->right;
+  }
+  if constexpr (Unique) {
+    /// равный ключ может быть только у предыдущего узла места вставки
+    Node *prev = pos.parent;
+    if (pos.to_left) {
+      prev = pos.parent == _header.left ? nullptr : PrevNode(pos.parent);
     }
-  } else {
-    if (node->right) {
-      return InInclude(node->right, value);
+    if (prev && !Less(KeyOf(prev), key)) pos.equal = prev;
+  }
+  return pos;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+bool AvlTree<Key, Value, KeyOfValue, Compare, Unique>::CheckHint(
+    const Key &key, Node *hint, InsertPos &pos) {
+  if (_size == 0) return false;
+  Node *max = _header.right;
+  if (hint == &_header) {
+    /// вставка после максимума - типичный случай возрастающего потока
+    if (!Precedes(KeyOf(max), key)) return false;
+    pos = InsertPos{max, false, nullptr};
+    return true;
+  }
+  if (Precedes(key, KeyOf(hint))) {
+    /// ключ левее hint: он должен быть правее предыдущего узла
+    if (hint == _header.left) {
+      pos = InsertPos{hint, true, nullptr};
+      return true;
+    }
+    Node *prev = PrevNode(hint);
+    if (!Precedes(KeyOf(prev), key)) return false;
+    /// между соседними узлами свободна ровно одна из двух позиций
+    if (!prev->right) {
+      pos = InsertPos{prev, false, nullptr};
     } else {
-      /// не нашлось
-      return nullptr;
+      pos = InsertPos{hint, true, nullptr};
+    }
+    return true;
+  }
+  if constexpr (Unique) {
+    if (!Less(KeyOf(hint), key)) {
+      pos.equal = hint;
+      return true;
     }
   }
+  /// ключ правее hint: подсказка промахнулась на один узел
+  if (hint == max) {
+    pos = InsertPos{hint, false, nullptr};
+    return true;
+  }
+  Node *next = NextNode(hint);
+  if (!Precedes(key, KeyOf(next))) return false;
+  if (!hint->right) {
+    pos = InsertPos{hint, false, nullptr};
+  } else {
+    pos = InsertPos{next, true, nullptr};
+  }
+  return true;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::LinkNode(
+    Node *new_node, const InsertPos &pos) {
+  /// ключ одиночного узла могли изменить через NodeHandle
+  FixAugment(new_node);
+  Node *parent = pos.parent;
+  new_node->parent = parent;
+  if (parent == &_header) {
+    _header.parent = new_node;
+    _header.left = new_node;
+    _header.right = new_node;
+  } else if (pos.to_left) {
+    parent->left = new_node;
+    /// новый минимум появляется только левее старого минимума
+    if (parent == _header.left) _header.left = new_node;
+  } else {
+    parent->right = new_node;
+    if (parent == _header.right) _header.right = new_node;
+  }
+  _size++;
+  /// всегда балансировка при изменении структуры дерева
+  Rebalance(parent);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename V>
+std::pair<typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *,
+          bool>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::InInsert(V &&value,
+                                                          Node *hint) {
+  InsertPos pos = FindInsertPos(KeyOfValue()(value), hint);
+  if (pos.equal) {
+    /// значение уже есть в дереве, вставка не произошла
+    return std::pair<Node *, bool>(pos.equal, false);
+  }
+  /// единственная копия значения - в новый узел
+  Node *new_node = CreateNode(std::forward<V>(value));
+  LinkNode(new_node, pos);
+  return std::pair<Node *, bool>(new_node, true);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename... Args>
+std::pair<typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *,
+          bool>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::InEmplace(Node *hint,
+                                                           Args &&...args) {
+  /// ключ известен только после создания значения, поэтому узел создается
+  /// до спуска и освобождается, если ключ уже есть
+  Node *new_node = CreateNode(std::forward<Args>(args)...);
+  InsertPos pos = FindInsertPos(KeyOf(new_node), hint);
+  if (pos.equal) {
+    DestroyNode(new_node);
+    return std::pair<Node *, bool>(pos.equal, false);
+  }
+  LinkNode(new_node, pos);
+  return std::pair<Node *, bool>(new_node, true);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+std::pair<typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator,
+          bool>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Insert(
+    const_reference value) {
+  std::pair<Node *, bool> res = InInsert(value);
+  return std::pair<iterator, bool>(Iterator(res.first), res.second);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+std::pair<typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator,
+          bool>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Insert(value_type &&value) {
+  std::pair<Node *, bool> res = InInsert(std::move(value));
+  return std::pair<iterator, bool>(Iterator(res.first), res.second);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename... Args>
+std::pair<typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator,
+          bool>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Emplace(Args &&...args) {
+  std::pair<Node *, bool> res = InEmplace(nullptr, std::forward<Args>(args)...);
+  return std::pair<iterator, bool>(Iterator(res.first), res.second);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Insert(
+    iterator hint, const_reference value) {
+  return Iterator(InInsert(value, hint.cur_node).first);
 }
 
-template <typename T>
-bool AvlTree<T>::Include(value_type value) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Insert(iterator hint,
+                                                        value_type &&value) {
+  return Iterator(InInsert(std::move(value), hint.cur_node).first);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename... Args>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::EmplaceHint(
+    iterator hint, Args &&...args) {
+  return Iterator(InEmplace(hint.cur_node, std::forward<Args>(args)...).first);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename... Args>
+std::pair<typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator,
+          bool>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::TryEmplace(
+    const key_type &key, Args &&...args) {
+  static_assert(Unique, "TryEmplace requires unique keys");
+  InsertPos pos = FindInsertPos(key);
+  if (pos.equal) return std::pair<iterator, bool>(Iterator(pos.equal), false);
+  Node *new_node = CreateNode(std::forward<Args>(args)...);
+  LinkNode(new_node, pos);
+  return std::pair<iterator, bool>(Iterator(new_node), true);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::InInclude(Node *node,
+                                                            const K &key) {
+  /// первый не меньший key узел, равенство проверяется одним сравнением
+  Node *bound = InBound(node, key, false);
+  if (bound && !Less(key, KeyOf(bound))) return bound;
+  return nullptr;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+bool AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Include(const K &key) {
   /// реализация обертки
-  return InInclude(_root, value);
+  return InInclude(Root(), LookupKey(key));
 }
 
-template <typename T>
-typename AvlTree<T>::Node *AvlTree<T>::FindMin(AvlTree::Node *node) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::FindMin(Node *node) {
   if (node == nullptr) return nullptr;
-  /// если слева ничего нет, то это минимальный элемент
-  if (node->left == nullptr) return node;
-  /// иначе идем левее
-  return FindMin(node->left);
+  /// идем левее, пока слева что-то есть
+  while (node->left) node = node->left;
+  return node;
 }
 
-template <typename T>
-typename AvlTree<T>::Node *AvlTree<T>::FindMax(AvlTree::Node *node) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::FindMax(Node *node) {
   if (node == nullptr) return nullptr;
-  /// если справа ничего нет, то это максимальный элемент
-  if (node->right == nullptr) return node;
-  /// иначе идем левее
-  return FindMax(node->right);
-}
-
-template <typename T>
-typename AvlTree<T>::Node *AvlTree<T>::InRemoveMin(AvlTree::Node *node) {
-  if (node) {  /// проверка существование узла
-    /// если слева пусто, то заменяем на правый элемент
-    if (node->left == nullptr) {
-      return node->right;
+  /// идем правее, пока справа что-то есть
+  while (node->right) node = node->right;
+  return node;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::RemoveNode(Node *node) {
+  UnlinkNode(node);
+  DestroyNode(node);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::UnlinkNode(Node *node) {
+  /// крайние узлы переходят к соседям, пока связи узла еще целы
+  if (node == _header.left) _header.left = NextNode(node);
+  if (node == _header.right) _header.right = PrevNode(node);
+  Node *parent = node->parent;
+  /// узел, с которого начинается балансировка
+  Node *rebalance_from = parent;
+  if (!node->left || !node->right) {
+    /// не более одного потомка - подвешиваем его на место узла
+    Node *child = node->left ? node->left : node->right;
+    if (child) child->parent = parent;
+    ReplaceChild(parent, node, child);
+  } else {
+    /// иначе на место узла встает минимальный элемент правого поддерева
+    Node *min = FindMin(node->right);
+    if (min->parent == node) {
+      rebalance_from = min;
+    } else {
+      rebalance_from = min->parent;
+      min->parent->left = min->right;
+      if (min->right) min->right->parent = min->parent;
+      min->right = node->right;
+      node->right->parent = min;
     }
-    /// иначе идем левее
-    node->left = InRemoveMin(node->left);
+    min->left = node->left;
+    node->left->parent = min;
+    min->parent = parent;
+    /// высота позиции пока прежняя, ее исправит балансировка
+    min->height = node->height;
+    ReplaceChild(parent, node, min);
   }
+  /// уменьшаем количество узлов
+  _size--;
   /// всегда балансировка при изменении структуры дерева
-  return Balance(node);
+  Rebalance(rebalance_from);
+  /// узел становится одиночным, как только что созданный
+  node->left = node->right = node->parent = nullptr;
+  node->count = 1;
+  node->height = 1;
+  FixAugment(node);
 }
 
-template <typename T>
-typename AvlTree<T>::Node *AvlTree<T>::InRemove(AvlTree::Node *node, T value) {
-  if (!node) return nullptr;  /// если пусто, то ничего не делаем
-  /// идем либо в лево либо в право по сравнению.
-  /// Для типа должно быть определено сравнение, иначе ошибка
-  if (value < node->value) {
-    /// уход влево
-    node->left = InRemove(node->left, value);
-  } else if (value > node->value) {
-    /// уход вправо
-    node->right = InRemove(node->right, value);
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+std::pair<typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *,
+          bool>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::InsertDetached(
+    Node *node, const std::shared_ptr<NodePool<Node>> &pool, Node *hint) {
+  InsertPos pos = FindInsertPos(KeyOf(node), hint);
+  if (pos.equal) return std::pair<Node *, bool>(pos.equal, false);
+  AdoptPool(pool);
+  LinkNode(node, pos);
+  return std::pair<Node *, bool>(node, true);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::AdoptPool(
+    const std::shared_ptr<NodePool<Node>> &pool) {
+  /// узлы двух пулов теперь живут в одном дереве, память должна жить, пока
+  /// жив хотя бы один из владельцев
+  _pool = NodePool<Node>::Unite(_pool, pool);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::TakePool(
+    AvlTree &other) {
+  if (!other._pool) return;
+  if (!_pool) {
+    _pool = std::move(other._pool);
+  } else if (!_pool->IsShared() && !other._pool->IsShared()) {
+    /// у обоих пулов нет других владельцев, перенаправление не нужно
+    _pool->Absorb(*other._pool);
   } else {
-    /// сохранение левого и правого поддерева
-    Node *left = node->left;
-    Node *right = node->right;
-    Node *parent = node->parent;
-    /// удаление узла
-    delete node;
-    /// уменьшаем количество узлов
-    _size--;
-    /// если правого нет, то замещаем на левое поддерево
-    if (!right) return left;
-    /// иначе ищем минимальный элемент в правом поддереве
-    Node *min = FindMin(right);
-    /// удаляем его справа, и устанавливаем его за место удаленного элемента
-    min->right = InRemoveMin(right);
-    min->left = left;
-    min->parent = parent;
-    /// всегда балансировка при изменении структуры дерева
-    return Balance(min);
+    _pool = NodePool<Node>::Unite(_pool, other._pool);
   }
-  /// всегда балансировка при изменении структуры дерева
-  return Balance(node);
+  other._pool.reset();
 }
 
-template <typename T>
-void AvlTree<T>::Remove(value_type value) {
-  /// реализация обертки
-  _root = InRemove(_root, value);
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::NodeHandle
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Extract(iterator pos) {
+  Node *node = pos.cur_node;
+  UnlinkNode(node);
+  return NodeHandle(node, SharedPool());
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::NodeHandle
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Extract(const Key &key) {
+  Node *node = InInclude(Root(), key);
+  if (!node) return NodeHandle();
+  return Extract(Iterator(node));
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+std::pair<typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator,
+          bool>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Insert(NodeHandle &&handle) {
+  if (handle.empty()) return std::pair<iterator, bool>(end(), false);
+  std::pair<Node *, bool> res =
+      InsertDetached(handle._node, handle._pool, nullptr);
+  if (res.second) {
+    handle._node = nullptr;
+    handle._pool.reset();
+  }
+  return std::pair<iterator, bool>(Iterator(res.first), res.second);
 }
 
-template <typename T>
-void AvlTree<T>::DeleteTree(AvlTree::Node **p_node) {
-  /// проверка существования
-  if (*p_node) {
-    /// проходим по дереву до самого низа и начинаем удаление оттуда
-    if ((*p_node)->left) {
-      DeleteTree(&((*p_node)->left));
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Insert(iterator hint,
+                                                        NodeHandle &&handle) {
+  if (handle.empty()) return end();
+  std::pair<Node *, bool> res =
+      InsertDetached(handle._node, handle._pool, hint.cur_node);
+  if (res.second) {
+    handle._node = nullptr;
+    handle._pool.reset();
+  }
+  return Iterator(res.first);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Absorb(AvlTree &other) {
+  if (this == &other || other.IsEmpty()) return;
+  if constexpr (!Unique) {
+    Merge(std::move(other));
+  } else {
+    Node *rest = nullptr;
+    Node *root = nullptr;
+    if (_size + other._size >= kParallelCutoff) {
+      root = AbsorbNodes(Detach(), other.Detach(), rest,
+                         ThreadPool::Instance());
+    } else {
+      /// пул без рабочих потоков выполняет все ветви в текущем потоке
+      ThreadPool sequential(0);
+      root = AbsorbNodes(Detach(), other.Detach(), rest, sequential);
     }
-    if ((*p_node)->right) {
-      DeleteTree(&((*p_node)->right));
+    SetRoot(root);
+    _size = GetCount(root);
+    other.SetRoot(rest);
+    other._size = GetCount(rest);
+    /// пул делится, только если в other остались узлы
+    if (rest) {
+      AdoptPool(other._pool);
+    } else {
+      TakePool(other);
     }
-    delete *p_node;
   }
 }
 
-template <typename T>
-AvlTree<T>::~AvlTree() {
-  DeleteTree(&_root);
-  /// дополнительно сводим к случаю базовой инициализации для уверенности
-  _root = nullptr;
-  _unique = false;
-  _size = 0;
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Swap(
+    AvlTree &other) noexcept {
+  if (this == &other) return;
+  /// корни ссылаются на заголовки, поэтому обмен идет через перенос узлов
+  AvlTree tmp(std::move(other));
+  other = std::move(*this);
+  *this = std::move(tmp);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Remove(const Key &key) {
+  /// реализация обертки
+  Node *node = InInclude(Root(), key);
+  if (node) RemoveNode(node);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Erase(iterator pos) {
+  Node *node = pos.cur_node;
+  /// следующий узел находится, пока связи удаляемого узла целы
+  Node *next = NextNode(node);
+  RemoveNode(node);
+  return iterator(next);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename... Args>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::CreateNode(Args &&...args) {
+  NodePool<Node> *pool = Pool();
+  Node *node = pool->Allocate();
+  try {
+    new (node) Node(std::in_place, std::forward<Args>(args)...);
+  } catch (...) {
+    pool->Deallocate(node);
+    throw;
+  }
+  return node;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::DestroyNode(Node *node) {
+  node->value.~Value();
+  node->~Node();
+  Pool()->Deallocate(node);
 }
-template <typename T>
-void AvlTree<T>::PrintTree(AvlTree::Node *node) {
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+NodePool<typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node> *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Pool() {
+  if (!_pool) {
+    _pool = std::make_shared<NodePool<Node>>();
+  } else if (_pool->IsForwarded()) {
+    _pool = NodePool<Node>::Resolve(_pool);
+  }
+  return _pool.get();
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+const std::shared_ptr<
+    NodePool<typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node>> &
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::SharedPool() {
+  Pool()->Share();
+  return _pool;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::DeleteTree(Node *node,
+                                                                  bool bulk) {
+  /// память тривиальных узлов вернется пулу целыми блоками без обхода
+  if (bulk && NodePool<Node>::kBulkRelease &&
+      std::is_trivially_destructible<Value>::value)
+    return;
+  /// проходим по дереву до самого низа и начинаем удаление оттуда
+  if (node) {
+    DeleteTree(node->left, bulk);
+    DeleteTree(node->right, bulk);
+    DestroyNode(node);
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Clear() {
+  Node *root = Detach();
+  if (root) {
+    /// пул освобождается целиком, только если им не владеют другие деревья
+    bool sole_owner = _pool.use_count() == 1 && !_pool->IsForwarded();
+    DeleteTree(root, sole_owner);
+    if (sole_owner) _pool->Release();
+  }
+  /// пустому дереву общий пул не нужен: следующая вставка возьмет свой
+  if (_pool && _pool->IsShared()) _pool.reset();
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::~AvlTree() {
+  Clear();
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::PrintTree(Node *node) {
   if (node) {  /// проверка существования
     /// вывод корян
     std::cout << node->value << std::endl;
@@ -269,225 +723,1143 @@ void AvlTree<T>::PrintTree(AvlTree::Node *node) {
   }
 }
 
-template <typename T>
-void AvlTree<T>::Print() {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Print() {
   /// реализация обертки
-  PrintTree(_root);
+  PrintTree(Root());
 }
 
-template <typename T>
-T AvlTree<T>::Top() {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+Value AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Top() {
   /// проверка на существование
-  if (_root == nullptr) {
+  if (Root() == nullptr) {
     throw std::runtime_error("Empty tree");
   }
-  return _root->value;
+  return Root()->value;
 }
 
 /// Вспомогательная функция для глубокой копирования дерева
-template <typename T>
-typename AvlTree<T>::Node *AvlTree<T>::CopyNodes(AvlTree<T>::Node *node) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::CopyNodes(Node *node,
+                                                            Node *parent) {
   if (node == nullptr) {
     return nullptr;
   }
   /// обход корень-лево-право
-  Node *new_node = new Node(node->value);
-  new_node->left = CopyNodes(node->left);
-  new_node->right = CopyNodes(node->right);
+  Node *new_node = CreateNode(node->value);
+  new_node->height = node->height;
+  new_node->count = node->count;
+  new_node->parent = parent;
+  try {
+    new_node->left = CopyNodes(node->left, new_node);
+    new_node->right = CopyNodes(node->right, new_node);
+  } catch (...) {
+    /// при исключении разрушаем уже скопированную часть
+    DeleteTree(new_node, false);
+    throw;
+  }
+  FixAugment(new_node);
   return new_node;
 }
 
-template <typename T>
-AvlTree<T>::AvlTree(const AvlTree<T> &other) {
-  /// Глубокая копия дерева
-  _root = CopyNodes(other._root);
-  _unique = other._unique;
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::CloneNodes(Node *node,
+                                                             Node *block,
+                                                             Node *parent,
+                                                             ThreadPool &pool) {
+  if (node == nullptr) return nullptr;
+  /// номер узла в симметричном порядке - размер левого поддерева
+  size_t left_count = GetCount(node->left);
+  size_t right_count = GetCount(node->right);
+  Node *copy = block + left_count;
+  Node *right_block = copy + 1;
+  Node *left = nullptr;
+  Node *right = nullptr;
+  if (node->count >= kParallelCutoff && pool.Concurrency() > 1) {
+    bool left_done = false;
+    bool right_done = false;
+    try {
+      pool.Invoke(
+          [&] {
+            left = CloneNodes(node->left, block, copy, pool);
+            left_done = true;
+          },
+          [&] {
+            right = CloneNodes(node->right, right_block, copy, pool);
+            right_done = true;
+          });
+    } catch (...) {
+      if (left_done) DestroyValues(block, left_count);
+      if (right_done) DestroyValues(right_block, right_count);
+      throw;
+    }
+  } else {
+    left = CloneNodes(node->left, block, copy, pool);
+    try {
+      right = CloneNodes(node->right, right_block, copy, pool);
+    } catch (...) {
+      DestroyValues(block, left_count);
+      throw;
+    }
+  }
+  try {
+    new (copy) Node(std::in_place, node->value);
+  } catch (...) {
+    DestroyValues(block, left_count);
+    DestroyValues(right_block, right_count);
+    throw;
+  }
+  copy->left = left;
+  copy->right = right;
+  copy->parent = parent;
+  copy->height = node->height;
+  copy->count = node->count;
+  FixAugment(copy);
+  return copy;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::DestroyValues(
+    Node *block, size_t count) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    block[i].value.~Value();
+    block[i].~Node();
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::CloneFrom(
+    const AvlTree &other, ThreadPool &pool) {
+  Clear();
+  if (other.Root() == nullptr) return;
+#ifndef S21_AVLTREE_HEAP_NODES
+  NodePool<Node> *nodes = Pool();
+  Node *block = nodes->AllocateBlock(other._size);
+  try {
+    SetRoot(CloneNodes(other.Root(), block, &_header, pool));
+  } catch (...) {
+    for (size_t i = 0; i < other._size; ++i) nodes->Deallocate(block + i);
+    throw;
+  }
+#else
+  /// отдельные узлы не образуют блок, копируем по одному
+  (void)pool;
+  SetRoot(CopyNodes(other.Root()));
+#endif
   _size = other._size;
 }
 
-template <typename T>
-int AvlTree<T>::CountNodes(AvlTree::Node *node, const T &value) {
-  if (node == nullptr) {
-    return 0;
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::CloneFrom(
+    const AvlTree &other) {
+  if (other._size >= kParallelCutoff) {
+    CloneFrom(other, ThreadPool::Instance());
+  } else {
+    /// пул без рабочих потоков выполняет все ветви в текущем потоке
+    ThreadPool sequential(0);
+    CloneFrom(other, sequential);
   }
-  /// обход корень-лево-право
-  int count = (node->value == value) ? 1 : 0;
-  count += CountNodes(node->left, value);
-  count += CountNodes(node->right, value);
-  return count;
 }
 
-template <typename T>
-int AvlTree<T>::Count(const T &value) const {
-  return CountNodes(_root, value);
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Clone(
+    ThreadPool &pool) const {
+  AvlTree copy;
+  copy.CloneFrom(*this, pool);
+  return copy;
 }
 
-template <typename T>
-void AvlTree<T>::SetUnique() {
-  _unique = true;
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::BuildBalanced(Node **nodes,
+                                                                size_t count,
+                                                                Node *parent) {
+  if (count == 0) return nullptr;
+  /// средний узел - корень, половины - поддеревья
+  size_t middle = count / 2;
+  Node *node = nodes[middle];
+  node->parent = parent;
+  node->left = BuildBalanced(nodes, middle, node);
+  node->right = BuildBalanced(nodes + middle + 1, count - middle - 1, node);
+  FixHeight(node);
+  return node;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename InputIt>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::CreateNodes(
+    InputIt first, InputIt last, std::vector<Node *> &nodes) {
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+  if (std::is_base_of<std::forward_iterator_tag, category>::value) {
+    size_t count = static_cast<size_t>(std::distance(first, last));
+    nodes.reserve(count);
+    /// все узлы подряд в одном блоке пула
+    Pool()->Reserve(count);
+  }
+  try {
+    for (; first != last; ++first) nodes.push_back(CreateNode(*first));
+  } catch (...) {
+    for (Node *node : nodes) DestroyNode(node);
+    throw;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::BuildFromNodes(
+    std::vector<Node *> &nodes) {
+  if constexpr (Unique) {
+    /// из равных остается первый
+    size_t kept = 0;
+    for (Node *node : nodes) {
+      if (kept && !Less(KeyOf(nodes[kept - 1]), KeyOf(node))) {
+        DestroyNode(node);
+      } else {
+        nodes[kept++] = node;
+      }
+    }
+    nodes.resize(kept);
+  }
+  SetRoot(BuildBalanced(nodes.data(), nodes.size(), nullptr));
+  _size = nodes.size();
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename InputIt>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::AssignSorted(
+    InputIt first, InputIt last) {
+  Clear();
+  std::vector<Node *> nodes;
+  CreateNodes(first, last, nodes);
+  BuildFromNodes(nodes);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename InputIt>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Assign(InputIt first,
+                                                              InputIt last) {
+  Clear();
+  std::vector<Node *> nodes;
+  CreateNodes(first, last, nodes);
+  /// сортируются узлы, а не значения: значения не копируются повторно.
+  /// Устойчивая сортировка сохраняет порядок вставки равных элементов
+  std::stable_sort(nodes.begin(), nodes.end(), [](Node *a, Node *b) {
+    return Less(KeyOf(a), KeyOf(b));
+  });
+  BuildFromNodes(nodes);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::JoinRight(Node *left,
+                                                            Node *mid,
+                                                            Node *right) {
+  Node *child = left->right;
+  if (GetHeight(child) <= GetHeight(right) + 1) {
+    /// нашлось поддерево подходящей высоты - подвешиваем mid на его место
+    mid->left = child;
+    mid->right = right;
+    if (child) child->parent = mid;
+    if (right) right->parent = mid;
+    FixHeight(mid);
+    left->right = mid;
+    mid->parent = left;
+  } else {
+    Node *joined = JoinRight(child, mid, right);
+    left->right = joined;
+    joined->parent = left;
+  }
+  return Balance(left);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::JoinLeft(Node *left,
+                                                           Node *mid,
+                                                           Node *right) {
+  Node *child = right->left;
+  if (GetHeight(child) <= GetHeight(left) + 1) {
+    /// нашлось поддерево подходящей высоты - подвешиваем mid на его место
+    mid->left = left;
+    mid->right = child;
+    if (left) left->parent = mid;
+    if (child) child->parent = mid;
+    FixHeight(mid);
+    right->left = mid;
+    mid->parent = right;
+  } else {
+    Node *joined = JoinLeft(left, mid, child);
+    right->left = joined;
+    joined->parent = right;
+  }
+  return Balance(right);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::JoinNodes(Node *left,
+                                                            Node *mid,
+                                                            Node *right) {
+  Node *root = nullptr;
+  if (GetHeight(left) > GetHeight(right) + 1) {
+    root = JoinRight(left, mid, right);
+  } else if (GetHeight(right) > GetHeight(left) + 1) {
+    root = JoinLeft(left, mid, right);
+  } else {
+    /// высоты близки - mid сразу становится корнем
+    mid->left = left;
+    mid->right = right;
+    if (left) left->parent = mid;
+    if (right) right->parent = mid;
+    FixHeight(mid);
+    root = mid;
+  }
+  root->parent = nullptr;
+  return root;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::ExtractMin(Node *node,
+                                                             Node **min) {
+  if (!node->left) {
+    *min = node;
+    Node *right = node->right;
+    if (right) right->parent = node->parent;
+    return right;
+  }
+  node->left = ExtractMin(node->left, min);
+  if (node->left) node->left->parent = node;
+  return Balance(node);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::JoinTwo(Node *left,
+                                                          Node *right) {
+  if (!left) return right;
+  if (!right) return left;
+  Node *min = nullptr;
+  right = ExtractMin(right, &min);
+  if (right) right->parent = nullptr;
+  return JoinNodes(left, min, right);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+std::pair<typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *,
+          typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::SplitNodes(Node *node,
+                                                             const Key &key,
+                                                             bool inclusive) {
+  if (!node) return std::pair<Node *, Node *>(nullptr, nullptr);
+  /// отцепляем поддеревья, узел станет средним при соединении
+  Node *left = node->left;
+  Node *right = node->right;
+  if (left) left->parent = nullptr;
+  if (right) right->parent = nullptr;
+  bool to_left = inclusive ? !Less(key, KeyOf(node)) : Less(KeyOf(node), key);
+  if (to_left) {
+    std::pair<Node *, Node *> parts = SplitNodes(right, key, inclusive);
+    return std::pair<Node *, Node *>(JoinNodes(left, node, parts.first),
+                                     parts.second);
+  }
+  std::pair<Node *, Node *> parts = SplitNodes(left, key, inclusive);
+  return std::pair<Node *, Node *>(parts.first,
+                                   JoinNodes(parts.second, node, right));
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+std::pair<typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *,
+          typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::SplitRank(Node *node,
+                                                            size_t k) {
+  if (!node) return std::pair<Node *, Node *>(nullptr, nullptr);
+  Node *left = node->left;
+  Node *right = node->right;
+  if (left) left->parent = nullptr;
+  if (right) right->parent = nullptr;
+  size_t left_count = GetCount(left);
+  if (k <= left_count) {
+    std::pair<Node *, Node *> parts = SplitRank(left, k);
+    return std::pair<Node *, Node *>(parts.first,
+                                     JoinNodes(parts.second, node, right));
+  }
+  std::pair<Node *, Node *> parts = SplitRank(right, k - left_count - 1);
+  return std::pair<Node *, Node *>(JoinNodes(left, node, parts.first),
+                                   parts.second);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::CombineNodes(
+    Node *a, Node *b, SetOp op, std::vector<Node *> &garbage,
+    ThreadPool &pool) {
+  /// базовые случаи: одно из деревьев пусто
+  if (!a || !b) {
+    if (op == SetOp::kUnion || op == SetOp::kMerge) return a ? a : b;
+    if (b) garbage.push_back(b);
+    if (op == SetOp::kDifference) return a;
+    if (a) garbage.push_back(a);
+    return nullptr;
+  }
+  size_t task_size = a->count + b->count;
+  /// ключ разделения - корень b. Сам узел не освобождается до конца операции
+  const Key &key = KeyOf(b);
+  std::pair<Node *, Node *> a_split = SplitNodes(a, key, false);
+  std::pair<Node *, Node *> a_rest = SplitNodes(a_split.second, key, true);
+  std::pair<Node *, Node *> b_split = SplitNodes(b, key, false);
+  std::pair<Node *, Node *> b_rest = SplitNodes(b_split.second, key, true);
+  Node *a_equal = a_rest.first;
+  Node *b_equal = b_rest.first;
+  size_t a_count = GetCount(a_equal);
+  size_t b_count = GetCount(b_equal);
+  /// средняя часть результата - элементы, равные ключу
+  Node *middle = nullptr;
+  Node *dropped[2] = {nullptr, nullptr};
+  if (op == SetOp::kMerge) {
+    middle = JoinTwo(a_equal, b_equal);
+  } else if (op == SetOp::kUnion) {
+    middle = a_count >= b_count ? a_equal : b_equal;
+    dropped[0] = a_count >= b_count ? b_equal : a_equal;
+  } else if (op == SetOp::kIntersection) {
+    middle = a_count <= b_count ? a_equal : b_equal;
+    dropped[0] = a_count <= b_count ? b_equal : a_equal;
+  } else {
+    std::pair<Node *, Node *> parts = SplitRank(a_equal, b_count);
+    middle = parts.second;
+    dropped[0] = parts.first;
+    dropped[1] = b_equal;
+  }
+  for (Node *node : dropped) {
+    if (node) garbage.push_back(node);
+  }
+  /// меньшие и большие ключа части обрабатываются независимо
+  Node *left = nullptr;
+  Node *right = nullptr;
+  if (task_size >= kParallelCutoff) {
+    std::vector<Node *> left_garbage;
+    pool.Invoke(
+        [&] {
+          left = CombineNodes(a_split.first, b_split.first, op, left_garbage,
+                              pool);
+        },
+        [&] {
+          right = CombineNodes(a_rest.second, b_rest.second, op, garbage, pool);
+        });
+    garbage.insert(garbage.end(), left_garbage.begin(), left_garbage.end());
+  } else {
+    left = CombineNodes(a_split.first, b_split.first, op, garbage, pool);
+    right = CombineNodes(a_rest.second, b_rest.second, op, garbage, pool);
+  }
+  return JoinTwo(JoinTwo(left, middle), right);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::AbsorbNodes(
+    Node *a, Node *b, Node *&rest, ThreadPool &pool) {
+  if (!a || !b) {
+    rest = nullptr;
+    return a ? a : b;
+  }
+  size_t task_size = a->count + b->count;
+  /// корень b разделяет a, поддеревья b обрабатываются независимо
+  Node *b_left = b->left;
+  Node *b_right = b->right;
+  if (b_left) b_left->parent = nullptr;
+  if (b_right) b_right->parent = nullptr;
+  const Key &key = KeyOf(b);
+  std::pair<Node *, Node *> a_split = SplitNodes(a, key, false);
+  std::pair<Node *, Node *> a_rest = SplitNodes(a_split.second, key, true);
+  Node *left = nullptr;
+  Node *right = nullptr;
+  Node *left_rest = nullptr;
+  Node *right_rest = nullptr;
+  if (task_size >= kParallelCutoff) {
+    pool.Invoke(
+        [&] { left = AbsorbNodes(a_split.first, b_left, left_rest, pool); },
+        [&] {
+          right = AbsorbNodes(a_rest.second, b_right, right_rest, pool);
+        });
+  } else {
+    left = AbsorbNodes(a_split.first, b_left, left_rest, pool);
+    right = AbsorbNodes(a_rest.second, b_right, right_rest, pool);
+  }
+  /// ключ уже есть в a: узел b остается в источнике
+  if (a_rest.first) {
+    rest = JoinNodes(left_rest, b, right_rest);
+    return JoinNodes(left, a_rest.first, right);
+  }
+  rest = JoinTwo(left_rest, right_rest);
+  return JoinNodes(left, b, right);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Combine(
+    AvlTree &&other, SetOp op, ThreadPool &pool) {
+  if (this == &other) {
+    AvlTree copy(other);
+    Combine(std::move(copy), op, pool);
+    return;
+  }
+  if (Unique && op == SetOp::kMerge) op = SetOp::kUnion;
+  /// узлы other переходят в текущее дерево вместе с памятью
+  TakePool(other);
+  std::vector<Node *> garbage;
+  Node *root = CombineNodes(Detach(), other.Detach(), op, garbage, pool);
+  for (Node *node : garbage) DeleteTree(node, false);
+  SetRoot(root);
+  _size = GetCount(root);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Union(AvlTree &&other,
+                                                             ThreadPool &pool) {
+  Combine(std::move(other), SetOp::kUnion, pool);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Merge(AvlTree &&other,
+                                                             ThreadPool &pool) {
+  Combine(std::move(other), SetOp::kMerge, pool);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Intersect(
+    AvlTree &&other, ThreadPool &pool) {
+  Combine(std::move(other), SetOp::kIntersection, pool);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Subtract(
+    AvlTree &&other, ThreadPool &pool) {
+  Combine(std::move(other), SetOp::kDifference, pool);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Split(const Key &key) {
+  AvlTree right;
+  /// обе части остаются в общем пуле
+  right._pool = SharedPool();
+  std::pair<Node *, Node *> parts = SplitNodes(Detach(), key, false);
+  SetRoot(parts.first);
+  right.SetRoot(parts.second);
+  _size = GetCount(parts.first);
+  right._size = GetCount(parts.second);
+  return right;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Join(AvlTree &&right) {
+  if (this == &right) return;
+  TakePool(right);
+  Node *root = JoinTwo(Detach(), right.Detach());
+  SetRoot(root);
+  _size = GetCount(root);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::ExtractRank(size_t first,
+                                                              size_t last) {
+  AvlTree middle;
+  if (last > _size) last = _size;
+  /// пустой диапазон не делает пул общим
+  if (first >= last) return middle;
+  Node *cut = CutRank(first, last);
+  /// у непустого дерева пул уже есть, общим он становится без выделений
+  middle._pool = SharedPool();
+  middle.SetRoot(cut);
+  middle._size = GetCount(cut);
+  return middle;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::ExtractRange(const Key &lo,
+                                                               const Key &hi) {
+  AvlTree middle;
+  if (!Less(lo, hi) || _size == 0) return middle;
+  Node *cut = CutRange(lo, hi);
+  if (cut == nullptr) return middle;
+  /// у непустого дерева пул уже есть, общим он становится без выделений
+  middle._pool = SharedPool();
+  middle.SetRoot(cut);
+  middle._size = GetCount(cut);
+  return middle;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+size_t AvlTree<Key, Value, KeyOfValue, Compare, Unique>::EraseRank(
+    size_t first, size_t last) {
+  if (last > _size) last = _size;
+  if (first >= last) return 0;
+  Node *cut = CutRank(first, last);
+  size_t erased = GetCount(cut);
+  DeleteTree(cut, false);
+  return erased;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+size_t AvlTree<Key, Value, KeyOfValue, Compare, Unique>::EraseRange(
+    const Key &lo, const Key &hi) {
+  if (!Less(lo, hi) || _size == 0) return 0;
+  Node *cut = CutRange(lo, hi);
+  size_t erased = GetCount(cut);
+  DeleteTree(cut, false);
+  return erased;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::CutRank(size_t first,
+                                                          size_t last) {
+  std::pair<Node *, Node *> head = SplitRank(Detach(), first);
+  std::pair<Node *, Node *> tail = SplitRank(head.second, last - first);
+  /// края соединяются обратно, середина отдается вызывающему
+  Node *rest = JoinTwo(head.first, tail.second);
+  SetRoot(rest);
+  _size = GetCount(rest);
+  return tail.first;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::CutRange(const Key &lo,
+                                                           const Key &hi) {
+  std::pair<Node *, Node *> head = SplitNodes(Detach(), lo, false);
+  std::pair<Node *, Node *> tail = SplitNodes(head.second, hi, false);
+  Node *rest = JoinTwo(head.first, tail.second);
+  SetRoot(rest);
+  _size = GetCount(rest);
+  return tail.first;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+size_t AvlTree<Key, Value, KeyOfValue, Compare, Unique>::IndexOf(
+    iterator pos) const {
+  Node *node = pos.cur_node;
+  if (node == &_header) return _size;
+  size_t index = GetCount(node->left);
+  /// каждый подъем из правого поддерева добавляет левую часть родителя
+  while (node->parent != &_header) {
+    Node *parent = node->parent;
+    if (node == parent->right) index += GetCount(parent->left) + 1;
+    node = parent;
+  }
+  return index;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+bool AvlTree<Key, Value, KeyOfValue, Compare, Unique>::CheckNode(
+    const Node *node, const Node *parent) {
+  if (!node) return true;
+  if (node->parent != parent) return false;
+  if (!CheckNode(node->left, node) || !CheckNode(node->right, node))
+    return false;
+  unsigned char height_left = node->left ? node->left->height : 0;
+  unsigned char height_right = node->right ? node->right->height : 0;
+  unsigned char height =
+      (height_left > height_right ? height_left : height_right) + 1;
+  size_t count = (node->left ? node->left->count : 0) +
+                 (node->right ? node->right->count : 0) + 1;
+  if constexpr (kAugmented) {
+    if (!(node->augment == NodeAugment(node))) return false;
+  }
+  int balance = height_right - height_left;
+  return node->height == height && node->count == count && balance <= 1 &&
+         balance >= -1;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+bool AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Validate() const {
+  const Node *header = &_header;
+  if (!CheckNode(Root(), header) || GetCount(Root()) != _size) return false;
+  if (!Root()) return _header.left == header && _header.right == header;
+  /// заголовок хранит актуальные крайние узлы
+  if (_header.left != FindMin(Root()) || _header.right != FindMax(Root()))
+    return false;
+  /// элементы в порядке обхода не убывают (и строго возрастают при unique)
+  Node *node = _header.left;
+  for (Node *next = NextNode(node); next != header;
+       node = next, next = NextNode(next)) {
+    if (Less(KeyOf(next), KeyOf(node))) return false;
+    if (Unique && !Less(KeyOf(node), KeyOf(next))) return false;
+  }
+  return true;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::AvlTree(
+    const AvlTree &other) {
+  /// Глубокая копия дерева, все узлы в одном блоке пула
+  CloneFrom(other);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+int AvlTree<Key, Value, KeyOfValue, Compare, Unique>::CountNodes(Node *node,
+                                                                 const K &key) {
+  /// дубликаты занимают непрерывный отрезок, его длина - разность рангов
+  return static_cast<int>(InRank(node, key, true) - InRank(node, key, false));
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+int AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Count(
+    const K &key) const {
+  return CountNodes(Root(), LookupKey(key));
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+size_t AvlTree<Key, Value, KeyOfValue, Compare, Unique>::InRank(
+    Node *node, const K &key, bool inclusive) {
+  size_t rank = 0;
+  while (node) {
+    /// узел входит в ответ вместе со всем левым поддеревом
+    bool counted = inclusive ? !Less(key, KeyOf(node)) : Less(KeyOf(node), key);
+    if (counted) {
+      rank += GetCount(node->left) + 1;
+      node = node->right;
+    } else {
+      node = node->left;
+    }
+  }
+  return rank;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::InBound(Node *node,
+                                                          const K &key,
+                                                          bool inclusive) {
+  Node *bound = nullptr;
+  while (node) {
+    bool before = inclusive ? !Less(key, KeyOf(node)) : Less(KeyOf(node), key);
+    if (before) {
+      node = node->right;
+    } else {
+      bound = node;
+      node = node->left;
+    }
+  }
+  return bound;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::LowerBound(const K &key) {
+  Node *bound = InBound(Root(), LookupKey(key), false);
+  return Iterator(bound ? bound : &_header);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::UpperBound(const K &key) {
+  Node *bound = InBound(Root(), LookupKey(key), true);
+  return Iterator(bound ? bound : &_header);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+size_t AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Rank(
+    const K &key) const {
+  return InRank(Root(), LookupKey(key), false);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+size_t AvlTree<Key, Value, KeyOfValue, Compare, Unique>::CountRange(
+    const K &lo, const K &hi) const {
+  size_t from = InRank(Root(), LookupKey(lo), false);
+  size_t to = InRank(Root(), LookupKey(hi), false);
+  return to > from ? to - from : 0;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename Prune, typename Past, typename Visit>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::ForEachPruned(
+    Prune prune, Past past, Visit visit) {
+  static_assert(kAugmented, "ForEachPruned needs an augment policy");
+  InForEachPruned(Root(), prune, past, visit);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename Part>
+Part AvlTree<Key, Value, KeyOfValue, Compare, Unique>::AppendFold(Part left,
+                                                                  Part right) {
+  if (!left) return right;
+  if (!right) return left;
+  return augment_policy::Combine(*left, *right);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+auto AvlTree<Key, Value, KeyOfValue, Compare, Unique>::FoldFrom(
+    const Node *node, const K &lo) {
+  using fold_type = std::optional<typename augment_policy::type>;
+  if (!node) return fold_type();
+  if (Less(KeyOf(node), lo)) return FoldFrom(node->right, lo);
+  /// узел и все правое поддерево целиком внутри границы
+  fold_type fold = AppendFold(FoldFrom(node->left, lo),
+                              fold_type(augment_policy::Make(node->value)));
+  if (node->right) fold = AppendFold(fold, fold_type(node->right->augment));
+  return fold;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+auto AvlTree<Key, Value, KeyOfValue, Compare, Unique>::FoldBefore(
+    const Node *node, const K &hi) {
+  using fold_type = std::optional<typename augment_policy::type>;
+  if (!node) return fold_type();
+  if (!Less(KeyOf(node), hi)) return FoldBefore(node->left, hi);
+  /// левое поддерево и узел целиком внутри границы
+  fold_type fold(augment_policy::Make(node->value));
+  if (node->left) fold = AppendFold(fold_type(node->left->augment), fold);
+  return AppendFold(fold, FoldBefore(node->right, hi));
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+auto AvlTree<Key, Value, KeyOfValue, Compare, Unique>::FoldRange(
+    const K &lo, const K &hi) const {
+  static_assert(kAugmented, "FoldRange needs an augment policy");
+  using fold_type = std::optional<typename augment_policy::type>;
+  decltype(auto) low = LookupKey(lo);
+  decltype(auto) high = LookupKey(hi);
+  const Node *node = Root();
+  /// спуск до узла, где границы расходятся по разным поддеревьям
+  while (node) {
+    if (Less(KeyOf(node), low)) {
+      node = node->right;
+    } else if (!Less(KeyOf(node), high)) {
+      node = node->left;
+    } else {
+      break;
+    }
+  }
+  if (!node) return fold_type();
+  fold_type fold = AppendFold(FoldFrom(node->left, low),
+                              fold_type(augment_policy::Make(node->value)));
+  return AppendFold(fold, FoldBefore(node->right, high));
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+auto AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Fold() const {
+  static_assert(kAugmented, "Fold needs an augment policy");
+  using fold_type = std::optional<typename augment_policy::type>;
+  return Root() ? fold_type(Root()->augment) : fold_type();
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Refresh(iterator pos) {
+  for (Node *node = pos.cur_node; node != &_header; node = node->parent) {
+    FixAugment(node);
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename Prune, typename Past, typename Visit>
+bool AvlTree<Key, Value, KeyOfValue, Compare, Unique>::InForEachPruned(
+    Node *node, Prune &prune, Past &past, Visit &visit) {
+  if (!node || prune(node->augment)) return true;
+  if (!InForEachPruned(node->left, prune, past, visit)) return false;
+  /// ключи идут по возрастанию: все следующие элементы тоже не нужны
+  if (past(KeyOf(node))) return false;
+  visit(Iterator(node));
+  return InForEachPruned(node->right, prune, past, visit);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Select(size_t k) {
+  if (k >= _size) return end();
+  Node *node = Root();
+  /// спуск по размерам поддеревьев
+  while (GetCount(node->left) != k) {
+    if (k < GetCount(node->left)) {
+      node = node->left;
+    } else {
+      k -= GetCount(node->left) + 1;
+      node = node->right;
+    }
+  }
+  return Iterator(node);
 }
 
 /// реализация интерфейса итератора
-template <typename T>
-AvlTree<T>::Iterator::Iterator() : cur_node(nullptr), prev_node(nullptr) {}
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Iterator::Iterator()
+    : cur_node(nullptr) {}
 
-template <typename T>
-AvlTree<T>::Iterator::Iterator(Node *cur_node, Node *prev_node)
-    : cur_node(cur_node), prev_node(prev_node) {}
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Iterator::Iterator(
+    Node *cur_node)
+    : cur_node(cur_node) {}
 
-template <typename T>
-AvlTree<T>::Iterator::Iterator(const iterator &other)
-    : cur_node(other.cur_node), prev_node(other.prev_node) {}
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Iterator::Iterator(
+    const iterator &other)
+    : cur_node(other.cur_node) {}
 
-template <typename T>
-void AvlTree<T>::Iterator::swap(iterator &other) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Iterator::swap(
+    iterator &other) {
   std::swap(cur_node, other.cur_node);
-  std::swap(prev_node, other.prev_node);
 }
 
-template <typename T>
-typename AvlTree<T>::Iterator &AvlTree<T>::Iterator::operator=(
-    const AvlTree<T>::Iterator &other) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Iterator &
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Iterator::operator=(
+    const Iterator &other) {
   if (this != &other) {
     this->cur_node = other.cur_node;
-    this->prev_node = other.prev_node;
   }
   return *this;
 }
-template <typename T>
-typename AvlTree<T>::Node *AvlTree<T>::NextNode(AvlTree<T>::Node *node) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::NextNode(Node *node) {
   if (!node) {
     return nullptr;
   }
+  /// за заголовком (end()) по кругу идет минимальный узел
+  if (node->height == 0) {
+    return node->left;
+  }
   /// если есть правое поддерево то возвращаем минимальный узел
   if (node->right) {
     return FindMin(node->right);
   }
-  /// если нет правого поддерева то ищем предыдущий узел
+  /// если нет правого поддерева, поднимаемся, пока идем из правого поддерева
   Node *parent = node->parent;
-  while (parent && parent->right == node) {
+  while (node == parent->right) {
     node = parent;
     parent = parent->parent;
   }
-  return parent;
+  /// если корень - максимальный узел, подъем заканчивается на заголовке,
+  /// который и является следующим узлом
+  if (node->right != parent) node = parent;
+  return node;
 }
 
-template <typename T>
-typename AvlTree<T>::iterator &AvlTree<T>::iterator::operator++() {
-  prev_node = cur_node;
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator &
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator::operator++() {
   cur_node = NextNode(cur_node);
   return *this;
 }
 
-template <typename T>
-const typename AvlTree<T>::iterator AvlTree<T>::iterator::operator++(int) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+const typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator::operator++(int) {
   Iterator tmp = *this;
   ++(*this);
   return tmp;
 }
 
-template <typename T>
-typename AvlTree<T>::Node *AvlTree<T>::PrevNode(AvlTree<T>::Node *node) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Node *
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::PrevNode(Node *node) {
   if (!node) {
     return nullptr;
   }
+  /// перед заголовком (end()) стоит максимальный узел
+  if (node->height == 0) {
+    return node->right;
+  }
   /// если есть левое поддерево то возвращаем максимальный узел
   if (node->left) {
     return FindMax(node->left);
   }
   /// если нет левого поддерева то ищем предыдущий узел
   Node *parent = node->parent;
-  while (parent && parent->left == node) {
+  while (parent->height != 0 && parent->left == node) {
     node = parent;
     parent = parent->parent;
   }
   return parent;
 }
 
-template <typename T>
-typename AvlTree<T>::Iterator &AvlTree<T>::Iterator::operator--() {
-  if (cur_node == nullptr) {
-    cur_node = prev_node;
-  } else {
-    cur_node = PrevNode(cur_node);
-  }
-  prev_node = PrevNode(cur_node);
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Iterator &
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Iterator::operator--() {
+  cur_node = PrevNode(cur_node);
   return *this;
 }
 
-template <typename T>
-const typename AvlTree<T>::iterator AvlTree<T>::iterator::operator--(int) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+const typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator::operator--(int) {
   Iterator tmp = *this;
   --(*this);
   return tmp;
 }
 
-template <typename T>
-bool AvlTree<T>::Iterator::operator==(const AvlTree::iterator &it) const {
-  if (this != &it) {
-    if (cur_node != it.cur_node || prev_node != it.prev_node) {
-      return false;
-    }
-  }
-  return true;
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+bool AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Iterator::operator==(
+    const iterator &it) const {
+  return cur_node == it.cur_node;
 }
 
-template <typename T>
-bool AvlTree<T>::Iterator::operator!=(const AvlTree::iterator &it) const {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+bool AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Iterator::operator!=(
+    const iterator &it) const {
   return !(*this == it);
 }
 
-template <typename T>
-typename AvlTree<T>::reference AvlTree<T>::Iterator::operator*() const {
-  if (cur_node == nullptr) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::reference
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Iterator::operator*() const {
+  if (cur_node == nullptr || cur_node->height == 0) {
     throw std::runtime_error("Iterator out of range");
   }
   return cur_node->value;
 }
 
-template <typename T>
-typename AvlTree<T>::iterator AvlTree<T>::begin() {
-  return AvlTree<T>::Iterator(FindMin(_root), nullptr);
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::begin() {
+  return Iterator(_header.left);
 }
 
-template <typename T>
-typename AvlTree<T>::iterator AvlTree<T>::end() {
-  if (_root == nullptr) {
-    return AvlTree<T>::Iterator(nullptr, nullptr);
-  }
-  return AvlTree<T>::Iterator(nullptr, FindMax(_root));
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::end() {
+  return Iterator(&_header);
 }
 
-template <typename T>
-typename AvlTree<T>::iterator AvlTree<T>::Find(value_type value) {
-  Node *result = InInclude(_root, value);
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::Find(const K &key) {
+  Node *result = InInclude(Root(), LookupKey(key));
   if (result == nullptr) {
     return end();
   }
-  return Iterator(result, PrevNode(result));
+  return Iterator(result);
 }
 
-template <typename T>
-AvlTree<T>::ConstIterator::ConstIterator() : Iterator() {}
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::ConstIterator::ConstIterator()
+    : Iterator() {}
 
-template <typename T>
-AvlTree<T>::ConstIterator::ConstIterator(const Iterator &other)
-    : Iterator(other) {}
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::ConstIterator::ConstIterator(
+    const Iterator &other) : Iterator(other) {}
 
-template <typename T>
-typename AvlTree<T>::const_reference AvlTree<T>::ConstIterator::operator*()
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename AvlTree<Key, Value, KeyOfValue, Compare, Unique>::const_reference
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::ConstIterator::operator*()
     const {
   return Iterator::operator*();
 }
 
-template <typename T>
-AvlTree<T> &AvlTree<T>::operator=(const AvlTree<T> &other) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique> &
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::operator=(
+    AvlTree &&other) noexcept {
+  if (this != &other) {
+    Clear();
+    _pool = std::move(other._pool);
+    StealNodes(other);
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+AvlTree<Key, Value, KeyOfValue, Compare, Unique> &
+AvlTree<Key, Value, KeyOfValue, Compare, Unique>::operator=(
+    const AvlTree &other) {
   if (this != &other) {
-    DeleteTree(&_root);
-    /// Глубокая копия дерева
-    _root = CopyNodes(other._root);
-    _unique = other._unique;
-    _size = other._size;
+    /// Глубокая копия дерева, все узлы в одном блоке пула
+    CloneFrom(other);
   }
   return *this;
 }
@@ -0,0 +1,707 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_BTREE_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_BTREE_TPP_
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+namespace s21 {
+namespace btree_simd {
+
+#if defined(__SSE2__)
+/// a > b для 64-битных знаковых целых: в SSE2 нет _mm_cmpgt_epi64
+inline __m128i CompareGreater64(__m128i a, __m128i b) {
+#if defined(__SSE4_2__)
+  return _mm_cmpgt_epi64(a, b);
+#else
+  /// старшие половины сравниваются со знаком. При равных старших половинах
+  /// заем при вычитании b - a означает, что младшая половина a больше
+  __m128i result = _mm_and_si128(_mm_cmpeq_epi32(a, b), _mm_sub_epi64(b, a));
+  result = _mm_or_si128(result, _mm_cmpgt_epi32(a, b));
+  return _mm_shuffle_epi32(result, _MM_SHUFFLE(3, 3, 1, 1));
+#endif
+}
+
+/**
+ * Маска сравнения key > keys[i] (или keys[i] > key при Reverse) для блока
+ * из 16 байт. Беззнаковые числа сдвигаются на половину диапазона, чтобы
+ * сравнивать их знаковыми инструкциями
+ */
+template <bool Reverse, typename T>
+inline int GreaterMask(const T *keys, T key) {
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys));
+  if constexpr (sizeof(T) == 4) {
+    const __m128i bias = _mm_set1_epi32(
+        std::is_signed<T>::value ? 0 : std::numeric_limits<int>::min());
+    __m128i needle =
+        _mm_xor_si128(_mm_set1_epi32(static_cast<int>(key)), bias);
+    block = _mm_xor_si128(block, bias);
+    __m128i mask = Reverse ? _mm_cmpgt_epi32(block, needle)
+                           : _mm_cmpgt_epi32(needle, block);
+    return _mm_movemask_ps(_mm_castsi128_ps(mask));
+  } else {
+    const __m128i bias = _mm_set1_epi64x(
+        std::is_signed<T>::value ? 0 : std::numeric_limits<long long>::min());
+    __m128i needle =
+        _mm_xor_si128(_mm_set1_epi64x(static_cast<long long>(key)), bias);
+    block = _mm_xor_si128(block, bias);
+    __m128i mask = Reverse ? CompareGreater64(block, needle)
+                           : CompareGreater64(needle, block);
+    return _mm_movemask_pd(_mm_castsi128_pd(mask));
+  }
+}
+#endif
+
+template <typename T>
+int CountLess(const T *keys, int count, T key) {
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8, "unsupported key size");
+  int i = 0;
+#if defined(__SSE2__)
+  constexpr int kLanes = 16 / sizeof(T);
+  constexpr int kFull = (1 << kLanes) - 1;
+  for (; i + kLanes <= count; i += kLanes) {
+    /// массив упорядочен: меньшие ключа элементы образуют начало блока
+    int mask = GreaterMask<false>(keys + i, key);
+    if (mask != kFull) return i + __builtin_popcount(mask);
+  }
+#endif
+  while (i < count && keys[i] < key) ++i;
+  return i;
+}
+
+template <typename T>
+int CountNotGreater(const T *keys, int count, T key) {
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8, "unsupported key size");
+  int i = 0;
+#if defined(__SSE2__)
+  constexpr int kLanes = 16 / sizeof(T);
+  for (; i + kLanes <= count; i += kLanes) {
+    /// большие ключа элементы образуют конец блока
+    int mask = GreaterMask<true>(keys + i, key);
+    if (mask != 0) return i + __builtin_ctz(mask);
+  }
+#endif
+  while (i < count && !(key < keys[i])) ++i;
+  return i;
+}
+
+}  // namespace btree_simd
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::BTree(
+    const BTree &other)
+    : _root(other._root ? CloneSubtree(other._root) : nullptr),
+      _size(other._size) {}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes> &
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::operator=(
+    const BTree &other) {
+  if (this != &other) {
+    BTree copy(other);
+    Swap(copy);
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes> &
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::operator=(
+    BTree &&other) noexcept {
+  if (this != &other) {
+    Clear();
+    Swap(other);
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+void BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::Clear() {
+  if (_root) DestroySubtree(_root);
+  _root = nullptr;
+  _size = 0;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+void BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::Next(
+    Node *&node, int &position) {
+  if (!node->leaf) {
+    /// следующее значение - самое левое в правом поддереве
+    node = Children(node)[position + 1];
+    while (!node->leaf) node = Children(node)[0];
+    position = 0;
+    return;
+  }
+  ++position;
+  /// у последнего значения поднимаемся до корня: это итератор end()
+  while (position == node->count && node->parent) {
+    position = node->position;
+    node = node->parent;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+bool BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::Prev(
+    Node *&node, int &position) {
+  if (!node->leaf) {
+    /// предыдущее значение - самое правое в левом поддереве
+    node = Children(node)[position];
+    while (!node->leaf) node = Children(node)[node->count];
+    position = node->count - 1;
+    return true;
+  }
+  Node *cur = node;
+  int pos = position;
+  while (pos == 0 && cur->parent) {
+    pos = cur->position;
+    cur = cur->parent;
+  }
+  if (pos == 0) return false;
+  node = cur;
+  position = pos - 1;
+  return true;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+typename BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::Node *
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::LeftmostLeaf()
+    const {
+  Node *node = _root;
+  if (node) {
+    while (!node->leaf) node = Children(node)[0];
+  }
+  return node;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+template <typename K>
+int BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::LowerIndex(
+    const Node *node, const K &key) {
+  if constexpr (kSimd && std::is_same<K, Key>::value) {
+    return btree_simd::CountLess(Slot(node, 0), node->count, key);
+  } else {
+    int lo = 0;
+    int hi = node->count;
+    while (lo < hi) {
+      int mid = (lo + hi) / 2;
+      if (Compare()(KeyAt(node, mid), key)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+template <typename K>
+int BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::UpperIndex(
+    const Node *node, const K &key) {
+  if constexpr (kSimd && std::is_same<K, Key>::value) {
+    return btree_simd::CountNotGreater(Slot(node, 0), node->count, key);
+  } else {
+    int lo = 0;
+    int hi = node->count;
+    while (lo < hi) {
+      int mid = (lo + hi) / 2;
+      if (Compare()(key, KeyAt(node, mid))) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+    return lo;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+typename BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::Node *
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::NewNode(
+    bool leaf) {
+  Node *node = leaf ? new Node : new InternalNode;
+  node->leaf = leaf;
+  return node;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+void BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::DeleteNode(
+    Node *node) noexcept {
+  if (node->leaf) {
+    delete node;
+  } else {
+    delete static_cast<InternalNode *>(node);
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+void BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::DestroySubtree(
+    Node *node) noexcept {
+  if (!node->leaf) {
+    for (int i = 0; i <= node->count; ++i) DestroySubtree(Children(node)[i]);
+  }
+  if constexpr (!std::is_trivially_destructible<Value>::value) {
+    for (int i = 0; i < node->count; ++i) Slot(node, i)->~Value();
+  }
+  DeleteNode(node);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+typename BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::Node *
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::CloneSubtree(
+    const Node *src) {
+  Node *node = NewNode(src->leaf);
+  int values = 0;
+  int children = 0;
+  try {
+    for (; values < src->count; ++values) {
+      new (Slot(node, values)) Value(*Slot(src, values));
+    }
+    node->count = src->count;
+    if (!src->leaf) {
+      for (; children <= src->count; ++children) {
+        Children(node)[children] = CloneSubtree(Children(src)[children]);
+      }
+      FixChildren(node, 0, node->count);
+    }
+  } catch (...) {
+    /// готовые поддеревья разрушаются целиком, затем значения узла
+    for (int i = 0; i < children; ++i) DestroySubtree(Children(node)[i]);
+    for (int i = 0; i < values; ++i) Slot(node, i)->~Value();
+    DeleteNode(node);
+    throw;
+  }
+  return node;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+void BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::Relocate(
+    Node *src, int first, int last, Node *dst, int dest) {
+  if (first >= last) return;
+  if constexpr (kTrivialRelocate) {
+    std::memmove(static_cast<void *>(Slot(dst, dest)), Slot(src, first),
+                 sizeof(Value) * (last - first));
+  } else if (src == dst && dest > first) {
+    /// перекрытие при сдвиге вправо: идем с конца
+    for (int i = last - 1; i >= first; --i) {
+      new (Slot(dst, dest + i - first)) Value(std::move(*Slot(src, i)));
+      Slot(src, i)->~Value();
+    }
+  } else {
+    for (int i = first; i < last; ++i) {
+      new (Slot(dst, dest + i - first)) Value(std::move(*Slot(src, i)));
+      Slot(src, i)->~Value();
+    }
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+void BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::MoveChildren(
+    Node *src, int first, int last, Node *dst, int dest) {
+  if (first > last) return;
+  std::memmove(Children(dst) + dest, Children(src) + first,
+               sizeof(Node *) * (last - first + 1));
+  FixChildren(dst, dest, dest + last - first);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+void BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::FixChildren(
+    Node *node, int first, int last) {
+  for (int i = first; i <= last; ++i) {
+    Node *child = Children(node)[i];
+    child->parent = static_cast<InternalNode *>(node);
+    child->position = static_cast<unsigned short>(i);
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+template <typename V>
+auto BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::InsertValue(
+    V &&value) -> std::pair<iterator, bool> {
+  if (!_root) _root = NewNode(true);
+  const Key &key = KeyOfValue()(value);
+  Node *node = _root;
+  for (;;) {
+    int i;
+    if constexpr (Unique) {
+      i = LowerIndex(node, key);
+      if (i < node->count && !Compare()(key, KeyAt(node, i))) {
+        return {iterator(node, i), false};
+      }
+    } else {
+      i = UpperIndex(node, key);
+    }
+    if (node->leaf) {
+      return {EmplaceAt(node, i, std::forward<V>(value)), true};
+    }
+    node = Children(node)[i];
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+template <typename... Args>
+typename BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::iterator
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::EmplaceHint(
+    const_iterator hint, Args &&...args) {
+  Value value(std::forward<Args>(args)...);
+  const Key &key = KeyOfValue()(value);
+  Node *node = hint._node;
+  int position = hint._position;
+  if (!node || (position < node->count &&
+                !Precedes(key, KeyAt(node, position)))) {
+    return InsertValue(std::move(value)).first;
+  }
+  Node *prev = node;
+  int prev_position = position;
+  bool has_prev = Prev(prev, prev_position);
+  if (has_prev && !Precedes(KeyAt(prev, prev_position), key)) {
+    return InsertValue(std::move(value)).first;
+  }
+  /// новое значение попадает в лист: перед hint, если hint в листе, иначе
+  /// сразу после предыдущего значения, которое всегда лежит в листе
+  if (node->leaf) return EmplaceAt(node, position, std::move(value));
+  return EmplaceAt(prev, prev_position + 1, std::move(value));
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+template <typename... Args>
+typename BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::iterator
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::EmplaceAt(
+    Node *leaf, int position, Args &&...args) {
+  if (leaf->count == kMaxValues) {
+    SplitNode(leaf);
+    constexpr int kMid = kMaxValues / 2;
+    if (position > kMid) {
+      leaf = Children(leaf->parent)[leaf->position + 1];
+      position -= kMid + 1;
+    }
+  }
+  Relocate(leaf, position, leaf->count, leaf, position + 1);
+  try {
+    new (Slot(leaf, position)) Value(std::forward<Args>(args)...);
+  } catch (...) {
+    Relocate(leaf, position + 1, leaf->count + 1, leaf, position);
+    throw;
+  }
+  ++leaf->count;
+  ++_size;
+  return iterator(leaf, position);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+void BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::SplitNode(
+    Node *node) {
+  constexpr int kMid = kMaxValues / 2;
+  Node *sibling = NewNode(node->leaf);
+  InternalNode *parent = node->parent;
+  if (!parent) {
+    try {
+      parent = static_cast<InternalNode *>(NewNode(false));
+    } catch (...) {
+      DeleteNode(sibling);
+      throw;
+    }
+    parent->children[0] = node;
+    FixChildren(parent, 0, 0);
+    _root = parent;
+  } else if (parent->count == kMaxValues) {
+    try {
+      SplitNode(parent);
+    } catch (...) {
+      DeleteNode(sibling);
+      throw;
+    }
+    parent = node->parent;
+  }
+  /// правая половина уходит в новый узел, медиана - в родителя
+  Relocate(node, kMid + 1, kMaxValues, sibling, 0);
+  if (!node->leaf) MoveChildren(node, kMid + 1, kMaxValues, sibling, 0);
+  sibling->count = kMaxValues - kMid - 1;
+  int position = node->position;
+  Relocate(parent, position, parent->count, parent, position + 1);
+  MoveChildren(parent, position + 1, parent->count, parent, position + 2);
+  Relocate(node, kMid, kMid + 1, parent, position);
+  parent->children[position + 1] = sibling;
+  FixChildren(parent, position + 1, position + 1);
+  ++parent->count;
+  node->count = kMid;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+void BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::Erase(
+    const_iterator pos) {
+  Node *node = pos._node;
+  int position = pos._position;
+  Slot(node, position)->~Value();
+  if (node->leaf) {
+    Relocate(node, position + 1, node->count, node, position);
+  } else {
+    /// значение внутреннего узла заменяется предыдущим, лежащим в листе
+    Node *leaf = Children(node)[position];
+    while (!leaf->leaf) leaf = Children(leaf)[leaf->count];
+    Relocate(leaf, leaf->count - 1, leaf->count, node, position);
+    node = leaf;
+  }
+  --node->count;
+  --_size;
+  Rebalance(node);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+void BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::Rebalance(
+    Node *node) {
+  while (node != _root && node->count < kMinValues) {
+    Node *parent = node->parent;
+    int position = node->position;
+    Node *left = position > 0 ? Children(parent)[position - 1] : nullptr;
+    Node *right =
+        position < parent->count ? Children(parent)[position + 1] : nullptr;
+    if (left && left->count > kMinValues) {
+      RotateRight(parent, position - 1);
+      return;
+    }
+    if (right && right->count > kMinValues) {
+      RotateLeft(parent, position);
+      return;
+    }
+    MergeChildren(parent, left ? position - 1 : position);
+    node = parent;
+  }
+  if (_root->count == 0) {
+    /// опустевший корень: дерево уменьшается на уровень или становится пустым
+    Node *old = _root;
+    _root = old->leaf ? nullptr : Children(old)[0];
+    if (_root) {
+      _root->parent = nullptr;
+      _root->position = 0;
+    }
+    DeleteNode(old);
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+void BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::RotateRight(
+    Node *parent, int separator) {
+  Node *left = Children(parent)[separator];
+  Node *right = Children(parent)[separator + 1];
+  Relocate(right, 0, right->count, right, 1);
+  Relocate(parent, separator, separator + 1, right, 0);
+  Relocate(left, left->count - 1, left->count, parent, separator);
+  if (!right->leaf) {
+    MoveChildren(right, 0, right->count, right, 1);
+    MoveChildren(left, left->count, left->count, right, 0);
+  }
+  --left->count;
+  ++right->count;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+void BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::RotateLeft(
+    Node *parent, int separator) {
+  Node *left = Children(parent)[separator];
+  Node *right = Children(parent)[separator + 1];
+  Relocate(parent, separator, separator + 1, left, left->count);
+  Relocate(right, 0, 1, parent, separator);
+  Relocate(right, 1, right->count, right, 0);
+  if (!left->leaf) {
+    MoveChildren(right, 0, 0, left, left->count + 1);
+    MoveChildren(right, 1, right->count, right, 0);
+  }
+  ++left->count;
+  --right->count;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+void BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::MergeChildren(
+    Node *parent, int separator) {
+  Node *left = Children(parent)[separator];
+  Node *right = Children(parent)[separator + 1];
+  int count = left->count;
+  Relocate(parent, separator, separator + 1, left, count);
+  Relocate(right, 0, right->count, left, count + 1);
+  if (!left->leaf) {
+    MoveChildren(right, 0, right->count, left, count + 1);
+  }
+  left->count = static_cast<unsigned short>(count + 1 + right->count);
+  Relocate(parent, separator + 1, parent->count, parent, separator);
+  MoveChildren(parent, separator + 2, parent->count, parent, separator + 1);
+  --parent->count;
+  DeleteNode(right);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+void BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::Absorb(
+    BTree &other) {
+  if (this == &other) return;
+  BTree rest;
+  for (iterator it = other.begin(); it != other.end(); ++it) {
+    if (Unique && Include(KeyOfValue()(*it))) {
+      /// значения other идут по возрастанию: вставка в конец остатка
+      rest.Insert(rest.end(), std::move(*it));
+    } else {
+      Insert(std::move(*it));
+    }
+  }
+  other = std::move(rest);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::iterator
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::Find(
+    const K &key) const {
+  if constexpr (Unique) {
+    Node *node = _root;
+    while (node) {
+      int i = LowerIndex(node, key);
+      if (i < node->count && !Compare()(key, KeyAt(node, i))) {
+        return iterator(node, i);
+      }
+      if (node->leaf) break;
+      node = Children(node)[i];
+    }
+    return iterator(_root, _root ? _root->count : 0);
+  } else {
+    iterator it = LowerBound(key);
+    if (it != end() && !Compare()(key, KeyOfValue()(*it))) return it;
+    return iterator(_root, _root ? _root->count : 0);
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::iterator
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::LowerBound(
+    const K &key) const {
+  iterator result(_root, _root ? _root->count : 0);
+  Node *node = _root;
+  while (node) {
+    int i = LowerIndex(node, key);
+    if (i < node->count) result = iterator(node, i);
+    if (node->leaf) break;
+    node = Children(node)[i];
+  }
+  return result;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::iterator
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::UpperBound(
+    const K &key) const {
+  iterator result(_root, _root ? _root->count : 0);
+  Node *node = _root;
+  while (node) {
+    int i = UpperIndex(node, key);
+    if (i < node->count) result = iterator(node, i);
+    if (node->leaf) break;
+    node = Children(node)[i];
+  }
+  return result;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+template <typename K>
+std::size_t BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::Count(
+    const K &key) const {
+  if constexpr (Unique) {
+    return Include(key) ? 1 : 0;
+  } else {
+    return static_cast<std::size_t>(
+        std::distance(LowerBound(key), UpperBound(key)));
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+std::size_t
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::MemoryUsage()
+    const {
+  return sizeof(*this) + (_root ? SubtreeMemory(_root) : 0);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+std::size_t
+BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::SubtreeMemory(
+    const Node *node) {
+  if (node->leaf) return sizeof(Node);
+  std::size_t total = sizeof(InternalNode);
+  for (int i = 0; i <= node->count; ++i) {
+    total += SubtreeMemory(Children(node)[i]);
+  }
+  return total;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+bool BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::Validate()
+    const {
+  if (!_root) return _size == 0;
+  if (_root->parent || _root->count == 0) return false;
+  std::size_t count = 0;
+  if (ValidateSubtree(_root, count) < 0 || count != _size) return false;
+  /// порядок значений по всему дереву
+  const_iterator it = begin();
+  for (const_iterator prev = it++; it != end(); prev = it++) {
+    if (!Precedes(KeyOfValue()(*prev), KeyOfValue()(*it))) return false;
+  }
+  return true;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, std::size_t NodeBytes>
+int BTree<Key, Value, KeyOfValue, Compare, Unique, NodeBytes>::ValidateSubtree(
+    const Node *node, std::size_t &count) {
+  if (node->count > kMaxValues) return -1;
+  if (node->parent && node->count < kMinValues) return -1;
+  count += node->count;
+  if (node->leaf) return 0;
+  int depth = -1;
+  for (int i = 0; i <= node->count; ++i) {
+    const Node *child = Children(node)[i];
+    if (child->parent != node || child->position != i) return -1;
+    int child_depth = ValidateSubtree(child, count);
+    if (child_depth < 0 || (depth >= 0 && child_depth != depth)) return -1;
+    depth = child_depth;
+  }
+  return depth + 1;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_BTREE_TPP_
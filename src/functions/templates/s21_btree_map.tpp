@@ -0,0 +1,78 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_BTREE_MAP_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_BTREE_MAP_TPP_
+
+#include "../include/s21_btree_map.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare>
+btree_map<Key, T, Compare>::btree_map(
+    const std::initializer_list<value_type> &items)
+    : btree_map(items.begin(), items.end()) {}
+
+template <typename Key, typename T, typename Compare>
+template <typename InputIt, typename>
+btree_map<Key, T, Compare>::btree_map(InputIt first, InputIt last) {
+  for (; first != last; ++first) _tree.Insert(*first);
+}
+
+template <typename Key, typename T, typename Compare>
+typename btree_map<Key, T, Compare>::mapped_type &
+btree_map<Key, T, Compare>::at(const Key &key) {
+  iterator it = _tree.Find(key);
+  if (it == end()) throw std::out_of_range("s21::btree_map::at: no key");
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare>
+const typename btree_map<Key, T, Compare>::mapped_type &
+btree_map<Key, T, Compare>::at(const Key &key) const {
+  const_iterator it = _tree.Find(key);
+  if (it == end()) throw std::out_of_range("s21::btree_map::at: no key");
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare>
+typename btree_map<Key, T, Compare>::mapped_type &
+btree_map<Key, T, Compare>::operator[](const Key &key) {
+  iterator it = _tree.Find(key);
+  if (it == end()) it = _tree.Emplace(key, T()).first;
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare>
+std::pair<typename btree_map<Key, T, Compare>::iterator, bool>
+btree_map<Key, T, Compare>::insert_or_assign(const Key &key, const T &obj) {
+  iterator it = _tree.Find(key);
+  if (it == end()) return _tree.Emplace(key, obj);
+  it->second = obj;
+  return {it, false};
+}
+
+template <typename Key, typename T, typename Compare>
+template <class... Args>
+vector<std::pair<typename btree_map<Key, T, Compare>::iterator, bool>>
+btree_map<Key, T, Compare>::insert_many(Args &&...args) {
+  /// итераторы B-дерева не переживают следующую вставку: запоминаем
+  /// ключи и ищем их после всех вставок
+  vector<std::pair<Key, bool>> inserted;
+  auto add = [&](auto &&arg) {
+    auto res = emplace(std::forward<decltype(arg)>(arg));
+    inserted.push_back(std::pair<Key, bool>(res.first->first, res.second));
+  };
+  (add(std::forward<Args>(args)), ...);
+  vector<std::pair<iterator, bool>> res_vec;
+  for (const auto &entry : inserted) {
+    res_vec.push_back(
+        std::pair<iterator, bool>(find(entry.first), entry.second));
+  }
+  return res_vec;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_BTREE_MAP_TPP_
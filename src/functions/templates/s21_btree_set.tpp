@@ -0,0 +1,45 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_BTREE_SET_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_BTREE_SET_TPP_
+
+#include "../include/s21_btree_set.h"
+
+namespace s21 {
+
+template <typename T, typename Compare>
+btree_set<T, Compare>::btree_set(
+    const std::initializer_list<value_type> &items)
+    : btree_set(items.begin(), items.end()) {}
+
+template <typename T, typename Compare>
+template <typename InputIt, typename>
+btree_set<T, Compare>::btree_set(InputIt first, InputIt last) {
+  for (; first != last; ++first) _tree.Insert(*first);
+}
+
+template <typename T, typename Compare>
+template <class... Args>
+vector<std::pair<typename btree_set<T, Compare>::iterator, bool>>
+btree_set<T, Compare>::insert_many(Args &&...args) {
+  /// итераторы B-дерева не переживают следующую вставку: запоминаем
+  /// значения и ищем их после всех вставок
+  vector<std::pair<value_type, bool>> inserted;
+  auto add = [&](auto &&arg) {
+    auto res = emplace(std::forward<decltype(arg)>(arg));
+    inserted.push_back(std::pair<value_type, bool>(*res.first, res.second));
+  };
+  (add(std::forward<Args>(args)), ...);
+  vector<std::pair<iterator, bool>> res_vec;
+  for (const auto &entry : inserted) {
+    res_vec.push_back(
+        std::pair<iterator, bool>(find(entry.first), entry.second));
+  }
+  return res_vec;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_BTREE_SET_TPP_
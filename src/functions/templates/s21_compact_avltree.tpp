@@ -0,0 +1,576 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_COMPACT_AVLTREE_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_COMPACT_AVLTREE_TPP_
+
+#include "../include/s21_compact_avltree.h"
+
+namespace s21 {
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::CompactAvlTree(
+    const CompactAvlTree &other) {
+  while (other._size && _capacity < other._used) AddChunk();
+  try {
+    CopyValues(other);
+  } catch (...) {
+    Release();
+    throw;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique> &
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::operator=(
+    const CompactAvlTree &other) {
+  if (this != &other) {
+    CompactAvlTree copy(other);
+    Swap(copy);
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique> &
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::operator=(
+    CompactAvlTree &&other) noexcept {
+  if (this != &other) {
+    Release();
+    Swap(other);
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::Swap(
+    CompactAvlTree &other) noexcept {
+  std::swap(_chunks, other._chunks);
+  std::swap(_chunk_count, other._chunk_count);
+  std::swap(_chunk_slots, other._chunk_slots);
+  std::swap(_capacity, other._capacity);
+  std::swap(_used, other._used);
+  std::swap(_free, other._free);
+  std::swap(_root, other._root);
+  std::swap(_size, other._size);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::CopyValues(
+    const CompactAvlTree &other) {
+  /// ссылки копируются у всех выданных узлов, включая свободные: раскладка
+  /// и список свободных узлов совпадают с other
+  for (index_type i = 1; i < other._used; ++i) {
+    Node &dst = At(i);
+    const Node &src = other.At(i);
+    dst.left = src.left;
+    dst.right = src.right;
+    dst.up = src.up;
+  }
+  _used = other._used;
+  _free = other._free;
+  index_type i = other.First();
+  try {
+    for (; i; i = other.Next(i)) {
+      ::new (static_cast<void *>(At(i).storage)) Value(other.ValueAt(i));
+    }
+  } catch (...) {
+    for (index_type j = other.First(); j != i; j = other.Next(j)) {
+      ValueAt(j).~Value();
+    }
+    _used = 1;
+    _free = 0;
+    throw;
+  }
+  _root = other._root;
+  _size = other._size;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::Release()
+    noexcept {
+  if constexpr (!std::is_trivially_destructible<Value>::value) {
+    for (index_type i = First(); i; i = Next(i)) ValueAt(i).~Value();
+  }
+  for (index_type c = 0; c < _chunk_count; ++c) delete[] _chunks[c];
+  delete[] _chunks;
+  _chunks = nullptr;
+  _chunk_count = _chunk_slots = _capacity = 0;
+  _used = 1;
+  _free = _root = 0;
+  _size = 0;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::AddChunk() {
+  if (_chunk_count == _chunk_slots) {
+    index_type slots = _chunk_slots ? 2 * _chunk_slots : kSmallChunks + 1;
+    Node **chunks = new Node *[slots];
+    for (index_type c = 0; c < _chunk_count; ++c) chunks[c] = _chunks[c];
+    delete[] _chunks;
+    _chunks = chunks;
+    _chunk_slots = slots;
+  }
+  /// первые блоки удваиваются, начиная с 1 << kFirstChunkBits узлов
+  index_type count =
+      _chunk_count == 0 ? index_type{1} << kFirstChunkBits
+      : _chunk_count < kSmallChunks
+          ? index_type{1} << (_chunk_count + kFirstChunkBits - 1)
+          : index_type{1} << kChunkBits;
+  _chunks[_chunk_count] = new Node[count];
+  ++_chunk_count;
+  _capacity += count;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::index_type
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::NewNode() {
+  if (_free) {
+    index_type index = _free;
+    _free = At(index).left;
+    return index;
+  }
+  if (_used > kMaxNodes) {
+    throw std::length_error("s21::CompactAvlTree: too many elements");
+  }
+  if (_used >= _capacity) AddChunk();
+  return _used++;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::index_type
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::First() const {
+  index_type index = _root;
+  if (index) {
+    while (At(index).left) index = At(index).left;
+  }
+  return index;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::index_type
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::Next(
+    index_type index) const {
+  if (At(index).right) {
+    index = At(index).right;
+    while (At(index).left) index = At(index).left;
+    return index;
+  }
+  index_type parent = Parent(index);
+  while (parent && At(parent).right == index) {
+    index = parent;
+    parent = Parent(index);
+  }
+  return parent;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::index_type
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::Prev(
+    index_type index) const {
+  if (!index) {
+    index = _root;
+    if (index) {
+      while (At(index).right) index = At(index).right;
+    }
+    return index;
+  }
+  if (At(index).left) {
+    index = At(index).left;
+    while (At(index).right) index = At(index).right;
+    return index;
+  }
+  index_type parent = Parent(index);
+  while (parent && At(parent).left == index) {
+    index = parent;
+    parent = Parent(index);
+  }
+  return parent;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename V>
+auto CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::InsertValue(
+    V &&value) -> std::pair<iterator, bool> {
+  const Key &key = KeyOfValue()(value);
+  index_type parent = 0;
+  bool left = false;
+  for (index_type index = _root; index;) {
+    parent = index;
+    if constexpr (Unique) {
+      if (Compare()(key, KeyAt(index))) {
+        left = true;
+      } else if (Compare()(KeyAt(index), key)) {
+        left = false;
+      } else {
+        return {iterator(this, index), false};
+      }
+    } else {
+      left = !Precedes(KeyAt(index), key);
+    }
+    index = left ? At(index).left : At(index).right;
+  }
+  index_type index = NewNode();
+  try {
+    ::new (static_cast<void *>(At(index).storage))
+        Value(std::forward<V>(value));
+  } catch (...) {
+    FreeNode(index);
+    throw;
+  }
+  Node &node = At(index);
+  node.left = node.right = 0;
+  node.up = parent << 2 | 1;
+  ++_size;
+  if (!parent) {
+    _root = index;
+  } else {
+    (left ? At(parent).left : At(parent).right) = index;
+    RetraceInsert(index);
+  }
+  return {iterator(this, index), true};
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::ReplaceChild(
+    index_type parent, index_type old_child, index_type new_child) {
+  if (!parent) {
+    _root = new_child;
+  } else if (At(parent).left == old_child) {
+    At(parent).left = new_child;
+  } else {
+    At(parent).right = new_child;
+  }
+  if (new_child) SetParent(new_child, parent);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::index_type
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::RotateLeft(
+    index_type x, index_type z) {
+  index_type inner = At(z).left;
+  At(x).right = inner;
+  if (inner) SetParent(inner, x);
+  At(z).left = x;
+  SetParent(x, z);
+  /// баланс z равен 0 только при удалении: высота поддерева не меняется
+  if (Balance(z) == 0) {
+    SetBalance(x, 1);
+    SetBalance(z, -1);
+  } else {
+    SetBalance(x, 0);
+    SetBalance(z, 0);
+  }
+  return z;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::index_type
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::RotateRight(
+    index_type x, index_type z) {
+  index_type inner = At(z).right;
+  At(x).left = inner;
+  if (inner) SetParent(inner, x);
+  At(z).right = x;
+  SetParent(x, z);
+  if (Balance(z) == 0) {
+    SetBalance(x, -1);
+    SetBalance(z, 1);
+  } else {
+    SetBalance(x, 0);
+    SetBalance(z, 0);
+  }
+  return z;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::index_type
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::RotateRightLeft(
+    index_type x, index_type z) {
+  index_type y = At(z).left;
+  index_type inner = At(y).right;
+  At(z).left = inner;
+  if (inner) SetParent(inner, z);
+  At(y).right = z;
+  SetParent(z, y);
+  inner = At(y).left;
+  At(x).right = inner;
+  if (inner) SetParent(inner, x);
+  At(y).left = x;
+  SetParent(x, y);
+  int balance = Balance(y);
+  SetBalance(x, balance > 0 ? -1 : 0);
+  SetBalance(z, balance < 0 ? 1 : 0);
+  SetBalance(y, 0);
+  return y;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::index_type
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::RotateLeftRight(
+    index_type x, index_type z) {
+  index_type y = At(z).right;
+  index_type inner = At(y).left;
+  At(z).right = inner;
+  if (inner) SetParent(inner, z);
+  At(y).left = z;
+  SetParent(z, y);
+  inner = At(y).right;
+  At(x).left = inner;
+  if (inner) SetParent(inner, x);
+  At(y).right = x;
+  SetParent(x, y);
+  int balance = Balance(y);
+  SetBalance(x, balance < 0 ? 1 : 0);
+  SetBalance(z, balance > 0 ? -1 : 0);
+  SetBalance(y, 0);
+  return y;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::RetraceInsert(
+    index_type node) {
+  for (index_type parent = Parent(node); parent; parent = Parent(node)) {
+    int balance = Balance(parent);
+    if (At(parent).right == node) {
+      if (balance < 0) {
+        SetBalance(parent, 0);
+        return;
+      }
+      if (balance == 0) {
+        SetBalance(parent, 1);
+        node = parent;
+        continue;
+      }
+      index_type up = Parent(parent);
+      index_type top = Balance(node) < 0 ? RotateRightLeft(parent, node)
+                                         : RotateLeft(parent, node);
+      ReplaceChild(up, parent, top);
+      return;
+    }
+    if (balance > 0) {
+      SetBalance(parent, 0);
+      return;
+    }
+    if (balance == 0) {
+      SetBalance(parent, -1);
+      node = parent;
+      continue;
+    }
+    index_type up = Parent(parent);
+    index_type top = Balance(node) > 0 ? RotateLeftRight(parent, node)
+                                       : RotateRight(parent, node);
+    ReplaceChild(up, parent, top);
+    return;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+void CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::RetraceErase(
+    index_type parent, bool left) {
+  while (parent) {
+    int balance = Balance(parent);
+    index_type up = Parent(parent);
+    index_type top;
+    int sibling_balance = 0;
+    if (left) {
+      if (balance < 0) {
+        SetBalance(parent, 0);
+        top = parent;
+      } else if (balance == 0) {
+        SetBalance(parent, 1);
+        return;
+      } else {
+        index_type sibling = At(parent).right;
+        sibling_balance = Balance(sibling);
+        top = sibling_balance < 0 ? RotateRightLeft(parent, sibling)
+                                  : RotateLeft(parent, sibling);
+        ReplaceChild(up, parent, top);
+        /// поворот при нулевом балансе брата не меняет высоту поддерева
+        if (sibling_balance == 0) return;
+      }
+    } else {
+      if (balance > 0) {
+        SetBalance(parent, 0);
+        top = parent;
+      } else if (balance == 0) {
+        SetBalance(parent, -1);
+        return;
+      } else {
+        index_type sibling = At(parent).left;
+        sibling_balance = Balance(sibling);
+        top = sibling_balance > 0 ? RotateLeftRight(parent, sibling)
+                                  : RotateRight(parent, sibling);
+        ReplaceChild(up, parent, top);
+        if (sibling_balance == 0) return;
+      }
+    }
+    left = up && At(up).left == top;
+    parent = up;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+typename CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::Erase(
+    const_iterator pos) {
+  index_type node = pos._index;
+  index_type next = Next(node);
+  Node &removed = At(node);
+  index_type parent = Parent(node);
+  index_type retrace;
+  bool left;
+  if (removed.left && removed.right) {
+    /// место узла занимает следующий за ним узел, значения не перемещаются
+    index_type successor = next;
+    if (successor == removed.right) {
+      retrace = successor;
+      left = false;
+    } else {
+      retrace = Parent(successor);
+      left = true;
+      index_type orphan = At(successor).right;
+      At(retrace).left = orphan;
+      if (orphan) SetParent(orphan, retrace);
+      At(successor).right = removed.right;
+      SetParent(removed.right, successor);
+    }
+    At(successor).left = removed.left;
+    SetParent(removed.left, successor);
+    SetBalance(successor, Balance(node));
+    ReplaceChild(parent, node, successor);
+  } else {
+    index_type child = removed.left ? removed.left : removed.right;
+    retrace = parent;
+    left = parent && At(parent).left == node;
+    ReplaceChild(parent, node, child);
+  }
+  RetraceErase(retrace, left);
+  ValueAt(node).~Value();
+  FreeNode(node);
+  --_size;
+  return iterator(this, next);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+typename CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::Find(
+    const K &key) const {
+  iterator it = LowerBound(key);
+  if (it._index && Compare()(key, KeyAt(it._index))) it._index = 0;
+  return it;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+typename CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::LowerBound(
+    const K &key) const {
+  index_type result = 0;
+  for (index_type index = _root; index;) {
+    if (Compare()(KeyAt(index), key)) {
+      index = At(index).right;
+    } else {
+      result = index;
+      index = At(index).left;
+    }
+  }
+  return iterator(this, result);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+typename CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::iterator
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::UpperBound(
+    const K &key) const {
+  index_type result = 0;
+  for (index_type index = _root; index;) {
+    if (Compare()(key, KeyAt(index))) {
+      result = index;
+      index = At(index).left;
+    } else {
+      index = At(index).right;
+    }
+  }
+  return iterator(this, result);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+template <typename K>
+std::size_t CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::Count(
+    const K &key) const {
+  if constexpr (Unique) {
+    return Include(key) ? 1 : 0;
+  } else {
+    std::size_t count = 0;
+    for (iterator it = LowerBound(key), last = UpperBound(key); it != last;
+         ++it) {
+      ++count;
+    }
+    return count;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+std::size_t
+CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::MemoryUsage() const {
+  return sizeof(*this) + std::size_t{_capacity} * sizeof(Node) +
+         std::size_t{_chunk_slots} * sizeof(Node *);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+int CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::CheckSubtree(
+    index_type index, index_type parent) const {
+  if (!index) return 0;
+  if (index >= _used || Parent(index) != parent) return -1;
+  int left = CheckSubtree(At(index).left, index);
+  int right = CheckSubtree(At(index).right, index);
+  if (left < 0 || right < 0 || right - left != Balance(index)) return -1;
+  return 1 + (left > right ? left : right);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique>
+bool CompactAvlTree<Key, Value, KeyOfValue, Compare, Unique>::Validate()
+    const {
+  if (CheckSubtree(_root, 0) < 0) return false;
+  std::size_t count = 0;
+  for (index_type i = First(), prev = 0; i; prev = i, i = Next(i), ++count) {
+    if (prev && !Precedes(KeyAt(prev), KeyAt(i))) return false;
+  }
+  std::size_t free = 0;
+  for (index_type i = _free; i && free <= _used; i = At(i).left) ++free;
+  return count == _size && count + free + 1 == _used && _used <= _capacity + 1;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_COMPACT_AVLTREE_TPP_
@@ -0,0 +1,76 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_COMPACT_MAP_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_COMPACT_MAP_TPP_
+
+#include "../include/s21_compact_map.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare>
+compact_map<Key, T, Compare>::compact_map(
+    const std::initializer_list<value_type> &items)
+    : compact_map(items.begin(), items.end()) {}
+
+template <typename Key, typename T, typename Compare>
+template <typename InputIt, typename>
+compact_map<Key, T, Compare>::compact_map(InputIt first, InputIt last) {
+  for (; first != last; ++first) _tree.Insert(*first);
+}
+
+template <typename Key, typename T, typename Compare>
+typename compact_map<Key, T, Compare>::mapped_type &
+compact_map<Key, T, Compare>::at(const Key &key) {
+  iterator it = _tree.Find(key);
+  if (it == end()) throw std::out_of_range("s21::compact_map::at: no key");
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare>
+const typename compact_map<Key, T, Compare>::mapped_type &
+compact_map<Key, T, Compare>::at(const Key &key) const {
+  const_iterator it = _tree.Find(key);
+  if (it == end()) throw std::out_of_range("s21::compact_map::at: no key");
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare>
+typename compact_map<Key, T, Compare>::mapped_type &
+compact_map<Key, T, Compare>::operator[](const Key &key) {
+  iterator it = _tree.Find(key);
+  if (it == end()) it = _tree.Emplace(key, T()).first;
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare>
+std::pair<typename compact_map<Key, T, Compare>::iterator, bool>
+compact_map<Key, T, Compare>::insert_or_assign(const Key &key, const T &obj) {
+  iterator it = _tree.Find(key);
+  if (it == end()) return _tree.Emplace(key, obj);
+  it->second = obj;
+  return {it, false};
+}
+
+template <typename Key, typename T, typename Compare>
+template <class... Args>
+vector<std::pair<typename compact_map<Key, T, Compare>::iterator, bool>>
+compact_map<Key, T, Compare>::insert_many(Args &&...args) {
+  vector<std::pair<iterator, bool>> res_vec;
+  (res_vec.push_back(emplace(std::forward<Args>(args))), ...);
+  return res_vec;
+}
+
+template <typename Key, typename T, typename Compare>
+typename compact_map<Key, T, Compare>::size_type
+compact_map<Key, T, Compare>::erase(const Key &key) {
+  iterator it = _tree.Find(key);
+  if (it == end()) return 0;
+  _tree.Erase(it);
+  return 1;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_COMPACT_MAP_TPP_
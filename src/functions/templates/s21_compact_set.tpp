@@ -0,0 +1,43 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_COMPACT_SET_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_COMPACT_SET_TPP_
+
+#include "../include/s21_compact_set.h"
+
+namespace s21 {
+
+template <typename T, typename Compare>
+compact_set<T, Compare>::compact_set(
+    const std::initializer_list<value_type> &items)
+    : compact_set(items.begin(), items.end()) {}
+
+template <typename T, typename Compare>
+template <typename InputIt, typename>
+compact_set<T, Compare>::compact_set(InputIt first, InputIt last) {
+  for (; first != last; ++first) _tree.Insert(*first);
+}
+
+template <typename T, typename Compare>
+template <class... Args>
+vector<std::pair<typename compact_set<T, Compare>::iterator, bool>>
+compact_set<T, Compare>::insert_many(Args &&...args) {
+  vector<std::pair<iterator, bool>> res_vec;
+  (res_vec.push_back(emplace(std::forward<Args>(args))), ...);
+  return res_vec;
+}
+
+template <typename T, typename Compare>
+typename compact_set<T, Compare>::size_type compact_set<T, Compare>::erase(
+    const key_type &key) {
+  iterator it = _tree.Find(key);
+  if (it == end()) return 0;
+  _tree.Erase(it);
+  return 1;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_COMPACT_SET_TPP_
@@ -0,0 +1,138 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_CONCURRENT_MAP_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_CONCURRENT_MAP_TPP_
+
+#include "../include/s21_concurrent_map.h"
+
+namespace s21 {
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash>
+std::optional<T> concurrent_map<Key, T, Shards, Compare, Hash>::find(
+    const Key &key) const {
+  Shard &shard = ShardOf(key);
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  auto it = shard.tree.Find(key);
+  if (it == shard.tree.end()) return std::nullopt;
+  return (*it).second;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash>
+bool concurrent_map<Key, T, Shards, Compare, Hash>::contains(
+    const Key &key) const {
+  Shard &shard = ShardOf(key);
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.tree.Include(key);
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash>
+bool concurrent_map<Key, T, Shards, Compare, Hash>::insert(const Key &key,
+                                                          const T &obj) {
+  Shard &shard = ShardOf(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  /// один спуск, узел создается только для нового ключа
+  return shard.tree.TryEmplace(key, key, obj).second;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash>
+bool concurrent_map<Key, T, Shards, Compare, Hash>::insert_or_assign(
+    const Key &key, const T &obj) {
+  Shard &shard = ShardOf(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  auto res = shard.tree.TryEmplace(key, key, obj);
+  if (!res.second) (*res.first).second = obj;
+  return res.second;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash>
+typename concurrent_map<Key, T, Shards, Compare, Hash>::size_type
+concurrent_map<Key, T, Shards, Compare, Hash>::erase(const Key &key) {
+  Shard &shard = ShardOf(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  auto it = shard.tree.Find(key);
+  if (it == shard.tree.end()) return 0;
+  /// узел уже найден, повторного спуска нет
+  shard.tree.Erase(it);
+  return 1;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash>
+template <typename F>
+bool concurrent_map<Key, T, Shards, Compare, Hash>::update(const Key &key,
+                                                          F fn) {
+  Shard &shard = ShardOf(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  auto it = shard.tree.Find(key);
+  if (it == shard.tree.end()) return false;
+  fn((*it).second);
+  return true;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash>
+template <typename F>
+void concurrent_map<Key, T, Shards, Compare, Hash>::for_each(F fn) const {
+  /// писатели держат не больше одной блокировки, захват всех частей по
+  /// порядку номеров не приводит к взаимной блокировке
+  std::array<std::shared_lock<std::shared_mutex>, Shards> locks;
+  for (std::size_t i = 0; i < Shards; ++i) {
+    locks[i] = std::shared_lock<std::shared_mutex>(_shards[i].mutex);
+  }
+  using cursor = std::pair<typename tree_type::iterator,
+                           typename tree_type::iterator>;
+  std::array<cursor, Shards> heap;
+  std::size_t count = 0;
+  for (const Shard &shard : _shards) {
+    if (!shard.tree.IsEmpty()) {
+      heap[count++] = cursor(shard.tree.begin(), shard.tree.end());
+    }
+  }
+  /// std::push_heap строит max-кучу, поэтому сравнение обратное
+  auto later = [](const cursor &a, const cursor &b) {
+    return Compare()((*b.first).first, (*a.first).first);
+  };
+  std::make_heap(heap.begin(), heap.begin() + count, later);
+  while (count) {
+    std::pop_heap(heap.begin(), heap.begin() + count, later);
+    cursor &top = heap[count - 1];
+    fn(static_cast<const value_type &>(*top.first));
+    if (++top.first == top.second) {
+      --count;
+    } else {
+      std::push_heap(heap.begin(), heap.begin() + count, later);
+    }
+  }
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash>
+typename concurrent_map<Key, T, Shards, Compare, Hash>::size_type
+concurrent_map<Key, T, Shards, Compare, Hash>::size() const {
+  size_type total = 0;
+  for (const Shard &shard : _shards) {
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    total += shard.tree.size();
+  }
+  return total;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash>
+void concurrent_map<Key, T, Shards, Compare, Hash>::clear() {
+  for (Shard &shard : _shards) {
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.tree.Clear();
+  }
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_CONCURRENT_MAP_TPP_
@@ -0,0 +1,29 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_CONCURRENT_SKIPLIST_MAP_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_CONCURRENT_SKIPLIST_MAP_TPP_
+
+#include "../include/s21_concurrent_skiplist_map.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare>
+T concurrent_skiplist_map<Key, T, Compare>::at(const Key &key) const {
+  /// копия снимается, пока итератор держит эпоху
+  iterator it = _list.Find(key);
+  if (it == end()) {
+    throw std::out_of_range("s21::concurrent_skiplist_map::at: no key");
+  }
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare>
+void concurrent_skiplist_map<Key, T, Compare>::clear() {
+  for (iterator it = begin(); it != end(); ++it) _list.Erase(it->first);
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_CONCURRENT_SKIPLIST_MAP_TPP_
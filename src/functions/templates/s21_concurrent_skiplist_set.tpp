@@ -0,0 +1,20 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_CONCURRENT_SKIPLIST_SET_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_CONCURRENT_SKIPLIST_SET_TPP_
+
+#include "../include/s21_concurrent_skiplist_set.h"
+
+namespace s21 {
+
+template <typename T, typename Compare>
+void concurrent_skiplist_set<T, Compare>::clear() {
+  /// итератор держит эпоху, удаленные узлы остаются доступны для ++
+  for (iterator it = begin(); it != end(); ++it) _list.Erase(*it);
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_CONCURRENT_SKIPLIST_SET_TPP_
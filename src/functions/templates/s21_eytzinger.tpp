@@ -0,0 +1,148 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_EYTZINGER_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_EYTZINGER_TPP_
+
+namespace s21 {
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename InputIt>
+Eytzinger<Key, Value, KeyOfValue, Compare>::Eytzinger(InputIt first,
+                                                      std::size_t count) {
+  if (!count) return;
+  _base = Allocate(count);
+  _size = count;
+  /// значения идут по возрастанию, ячейки заполняются в порядке
+  /// симметричного обхода
+  std::size_t k = First();
+  std::size_t built = 0;
+  try {
+    for (; built < count; ++built, ++first, k = Next(k)) {
+      new (_base + k) Value(*first);
+    }
+  } catch (...) {
+    k = First();
+    for (std::size_t i = 0; i < built; ++i, k = Next(k)) _base[k].~Value();
+    Release(_base, 0);
+    _base = nullptr;
+    _size = 0;
+    throw;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+Eytzinger<Key, Value, KeyOfValue, Compare>::Eytzinger(const Eytzinger &other) {
+  if (!other._size) return;
+  Value *base = Allocate(other._size);
+  std::size_t k = 1;
+  try {
+    for (; k <= other._size; ++k) new (base + k) Value(other._base[k]);
+  } catch (...) {
+    Release(base, k - 1);
+    throw;
+  }
+  _base = base;
+  _size = other._size;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+Eytzinger<Key, Value, KeyOfValue, Compare> &
+Eytzinger<Key, Value, KeyOfValue, Compare>::operator=(const Eytzinger &other) {
+  if (this != &other) {
+    Eytzinger copy(other);
+    Swap(copy);
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+Eytzinger<Key, Value, KeyOfValue, Compare> &
+Eytzinger<Key, Value, KeyOfValue, Compare>::operator=(
+    Eytzinger &&other) noexcept {
+  if (this != &other) {
+    Release(_base, _size);
+    _base = std::exchange(other._base, nullptr);
+    _size = std::exchange(other._size, 0);
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <bool Upper, typename K>
+std::size_t Eytzinger<Key, Value, KeyOfValue, Compare>::Descend(
+    const K &key) const {
+  std::size_t k = 1;
+  while (k <= _size) {
+    /// через log2(kBlock) уровней потомки k займут одну кэш-линию: адрес
+    /// может быть за концом массива, prefetch при этом ничего не делает
+    __builtin_prefetch(reinterpret_cast<const void *>(
+        reinterpret_cast<std::uintptr_t>(_base) + k * kBlock * sizeof(Value)));
+    bool right;
+    if constexpr (Upper) {
+      right = !Compare()(key, KeyOfValue()(_base[k]));
+    } else {
+      right = Compare()(KeyOfValue()(_base[k]), key);
+    }
+    k = 2 * k + right;
+  }
+  /// младшие единицы k - последние шаги вправо, ответ - узел, из которого
+  /// был сделан последний шаг влево. Если шагов влево не было, k станет 0
+  return k >> __builtin_ffsll(static_cast<long long>(~k));
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+std::size_t Eytzinger<Key, Value, KeyOfValue, Compare>::First() const {
+  if (!_size) return 0;
+  std::size_t k = 1;
+  while (2 * k <= _size) k *= 2;
+  return k;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+std::size_t Eytzinger<Key, Value, KeyOfValue, Compare>::Next(
+    std::size_t k) const {
+  if (2 * k + 1 <= _size) {
+    /// самое левое значение правого поддерева
+    k = 2 * k + 1;
+    while (2 * k <= _size) k *= 2;
+    return k;
+  }
+  /// поднимаемся, пока узел - правый ребенок. Корень тоже нечетный,
+  /// после последнего значения получаем 0
+  while (k & 1) k >>= 1;
+  return k >> 1;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+std::size_t Eytzinger<Key, Value, KeyOfValue, Compare>::Prev(
+    std::size_t k) const {
+  if (k == 0 || 2 * k <= _size) {
+    /// самое правое значение левого поддерева (для end() - всего дерева)
+    k = k == 0 ? (_size ? 1 : 0) : 2 * k;
+    while (k && 2 * k + 1 <= _size) k = 2 * k + 1;
+    return k;
+  }
+  while (k && !(k & 1)) k >>= 1;
+  return k >> 1;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+Value *Eytzinger<Key, Value, KeyOfValue, Compare>::Allocate(
+    std::size_t count) {
+  return static_cast<Value *>(
+      ::operator new((count + 1) * sizeof(Value), std::align_val_t(kAlign)));
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void Eytzinger<Key, Value, KeyOfValue, Compare>::Release(
+    Value *base, std::size_t count) noexcept {
+  if (!base) return;
+  for (std::size_t k = 1; k <= count; ++k) base[k].~Value();
+  ::operator delete(base, std::align_val_t(kAlign));
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_EYTZINGER_TPP_
@@ -0,0 +1,38 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_FROZEN_MAP_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_FROZEN_MAP_TPP_
+
+#include "../include/s21_frozen_map.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare>
+template <typename InputIt, typename>
+frozen_map<Key, T, Compare>::frozen_map(InputIt first, InputIt last) {
+  /// у value_type константный ключ, сортируются пары без const
+  std::vector<std::pair<Key, T>> items(first, last);
+  auto less = [](const std::pair<Key, T> &a, const std::pair<Key, T> &b) {
+    return Compare()(a.first, b.first);
+  };
+  std::stable_sort(items.begin(), items.end(), less);
+  auto same = [](const std::pair<Key, T> &a, const std::pair<Key, T> &b) {
+    return !Compare()(a.first, b.first);
+  };
+  items.erase(std::unique(items.begin(), items.end(), same), items.end());
+  _index = index_type(items.begin(), items.size());
+}
+
+template <typename Key, typename T, typename Compare>
+const typename frozen_map<Key, T, Compare>::mapped_type &
+frozen_map<Key, T, Compare>::at(const Key &key) const {
+  iterator it = _index.Find(key);
+  if (it == end()) throw std::out_of_range("s21::frozen_map::at: no key");
+  return it->second;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_FROZEN_MAP_TPP_
@@ -0,0 +1,26 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_FROZEN_SET_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_FROZEN_SET_TPP_
+
+#include "../include/s21_frozen_set.h"
+
+namespace s21 {
+
+template <typename T, typename Compare>
+template <typename InputIt, typename>
+frozen_set<T, Compare>::frozen_set(InputIt first, InputIt last) {
+  std::vector<value_type> items(first, last);
+  std::sort(items.begin(), items.end(), Compare());
+  auto same = [](const value_type &a, const value_type &b) {
+    return !Compare()(a, b);
+  };
+  items.erase(std::unique(items.begin(), items.end(), same), items.end());
+  _index = index_type(items.begin(), items.size());
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_FROZEN_SET_TPP_
@@ -0,0 +1,103 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_INTERVAL_MAP_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_INTERVAL_MAP_TPP_
+
+#include "../include/s21_interval_map.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare>
+interval_map<Key, T, Compare>::interval_map(
+    std::initializer_list<value_type> const &items) {
+  for (const value_type &item : items) insert(item);
+}
+
+template <typename Key, typename T, typename Compare>
+typename interval_map<Key, T, Compare>::iterator
+interval_map<Key, T, Compare>::insert(const Key &lo, const Key &hi,
+                                      const T &obj) {
+  return insert(value_type(key_type(lo, hi), obj));
+}
+
+template <typename Key, typename T, typename Compare>
+typename interval_map<Key, T, Compare>::iterator
+interval_map<Key, T, Compare>::insert(const value_type &value) {
+  if (Compare()(value.first.second, value.first.first)) {
+    throw std::invalid_argument("interval_map: interval end before start");
+  }
+  return _tree.Insert(value).first;
+}
+
+template <typename Key, typename T, typename Compare>
+void interval_map<Key, T, Compare>::erase(iterator pos) {
+  if (pos != end()) _tree.Erase(pos);
+}
+
+template <typename Key, typename T, typename Compare>
+typename interval_map<Key, T, Compare>::size_type
+interval_map<Key, T, Compare>::erase(const Key &lo, const Key &hi) {
+  key_type key(lo, hi);
+  size_type from = _tree.IndexOf(_tree.LowerBound(key));
+  /// узлы возвращаются в собственный пул, он не становится общим
+  return _tree.EraseRank(from, _tree.IndexOf(_tree.UpperBound(key)));
+}
+
+template <typename Key, typename T, typename Compare>
+typename interval_map<Key, T, Compare>::iterator
+interval_map<Key, T, Compare>::find(const Key &lo, const Key &hi) {
+  return _tree.Find(key_type(lo, hi));
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename F>
+void interval_map<Key, T, Compare>::ForEachOverlap(const Key &lo,
+                                                   const Key &hi, F &visit) {
+  _tree.ForEachPruned(
+      /// все отрезки поддерева кончаются левее запроса
+      [&lo](const Key &max_hi) { return Compare()(max_hi, lo); },
+      /// отрезок и все следующие начинаются правее запроса
+      [&hi](const key_type &key) { return Compare()(hi, key.first); },
+      [&lo, &visit](iterator it) {
+        if (!Compare()((*it).first.second, lo)) visit(it);
+      });
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename F>
+void interval_map<Key, T, Compare>::for_each_overlapping(const Key &lo,
+                                                         const Key &hi,
+                                                         F fn) {
+  auto visit = [&fn](iterator it) { fn(*it); };
+  ForEachOverlap(lo, hi, visit);
+}
+
+template <typename Key, typename T, typename Compare>
+bool interval_map<Key, T, Compare>::overlaps(const Key &lo, const Key &hi) {
+  bool found = false;
+  /// после первой находки обход сворачивается по пути к корню
+  _tree.ForEachPruned(
+      [&lo](const Key &max_hi) { return Compare()(max_hi, lo); },
+      [&hi, &found](const key_type &key) {
+        return found || Compare()(hi, key.first);
+      },
+      [&lo, &found](iterator it) {
+        if (!Compare()((*it).first.second, lo)) found = true;
+      });
+  return found;
+}
+
+template <typename Key, typename T, typename Compare>
+std::vector<typename interval_map<Key, T, Compare>::iterator>
+interval_map<Key, T, Compare>::overlapping(const Key &lo, const Key &hi) {
+  std::vector<iterator> result;
+  auto visit = [&result](iterator it) { result.push_back(it); };
+  ForEachOverlap(lo, hi, visit);
+  return result;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_INTERVAL_MAP_TPP_
@@ -53,7 +53,7 @@ template <typename T>
 list<T>::list(typename SqContainer<T>::size_type n) {
   if (n <= 0) throw std::out_of_range("ListContainer: Index out of range");
   for (typename SqContainer<T>::size_type i = 0; i < n; i++) {
-    push_back(typename SqContainer<T>::value_type());
+    emplace_back();
   }
 }
 
@@ -61,8 +61,8 @@ template <typename T>
 list<T>::list(
     std::initializer_list<typename SqContainer<T>::value_type> const& items)
     : list() {
-  for (typename SqContainer<T>::value_type i : items) {
-    push_back(i);
+  for (const auto& item : items) {
+    push_back(item);
   }
 }
 
@@ -172,29 +172,44 @@ template <typename T>
 typename list<T>::iterator list<T>::insert(
     typename list<T>::iterator pos,
     typename SqContainer<T>::const_reference value) {
-  list<int>::iterator it_b = begin(), it_e = end();
-  if (pos == it_b) {
-    push_front(value);
-    pos = head;
-  } else if (pos == it_e) {
-    push_back(value);
-    pos = tail;
+  return emplace(pos, value);
+}
+
+template <typename T>
+typename list<T>::iterator list<T>::insert(
+    typename list<T>::iterator pos,
+    typename SqContainer<T>::value_type&& value) {
+  return emplace(pos, std::move(value));
+}
+
+template <typename T>
+template <class... Args>
+typename list<T>::iterator list<T>::emplace(
+    typename list<T>::const_iterator pos, Args&&... args) {
+  iterator it_b = begin(), it_e = end();
+  iterator where = pos;
+  if (where == it_b) {
+    emplace_front(std::forward<Args>(args)...);
+    where = head;
+  } else if (where == it_e) {
+    emplace_back(std::forward<Args>(args)...);
+    where = tail;
   } else {
-    Node* cur = pos.node;
-    Node* ins = new Node(value);
+    Node* cur = where.node;
+    Node* ins = new Node(std::in_place, std::forward<Args>(args)...);
     ins->next = cur;
     ins->prev = cur->prev;
     cur->prev->next = ins;
     cur->prev = ins;
-    pos = ins;
+    where = ins;
   }
 
-  return pos;
+  return where;
 }
 
 template <typename T>
 void list<T>::erase(typename list<T>::iterator pos) {
-  list<int>::iterator it_b = begin(), it_e = end();
+  iterator it_b = begin(), it_e = end();
   if (pos == it_b) {
     pop_front();
   } else if (pos == it_e) {
@@ -209,7 +224,20 @@ void list<T>::erase(typename list<T>::iterator pos) {
 
 template <typename T>
 void list<T>::push_back(typename SqContainer<T>::const_reference value) {
-  Node* node = new Node(value);
+  static_assert(std::is_copy_constructible_v<T>,
+                "list::push_back: value type is not copyable, move it in");
+  emplace_back(value);
+}
+
+template <typename T>
+void list<T>::push_back(typename SqContainer<T>::value_type&& value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T>
+template <class... Args>
+typename SqContainer<T>::reference list<T>::emplace_back(Args&&... args) {
+  Node* node = new Node(std::in_place, std::forward<Args>(args)...);
   node->prev = tail;
   node->next = nullptr;
   if (empty()) {
@@ -218,6 +246,7 @@ void list<T>::push_back(typename SqContainer<T>::const_reference value) {
     tail->next = node;
     tail = node;
   }
+  return node->value;
 }
 
 template <typename T>
@@ -236,7 +265,18 @@ void list<T>::pop_back() {
 
 template <typename T>
 void list<T>::push_front(typename SqContainer<T>::const_reference value) {
-  Node* node = new Node(value);
+  emplace_front(value);
+}
+
+template <typename T>
+void list<T>::push_front(typename SqContainer<T>::value_type&& value) {
+  emplace_front(std::move(value));
+}
+
+template <typename T>
+template <class... Args>
+typename SqContainer<T>::reference list<T>::emplace_front(Args&&... args) {
+  Node* node = new Node(std::in_place, std::forward<Args>(args)...);
   node->prev = nullptr;
   node->next = head;
   if (empty()) {
@@ -245,6 +285,7 @@ void list<T>::push_front(typename SqContainer<T>::const_reference value) {
     head->prev = node;
     head = node;
   }
+  return node->value;
 }
 
 template <typename T>
@@ -271,12 +312,11 @@ template <typename T>
 void list<T>::merge(list& other) {
   list<T>::iterator it_e = end();
   if (empty()) {
-    *this = other;
-    other.clear();
+    swap(other);
   }
   while (!other.empty()) {
     it_e = other.begin();
-    this->push_back(*it_e);
+    this->push_back(std::move(*it_e));
     other.pop_front();
   }
 }
@@ -337,10 +377,8 @@ void list<T>::sort() {
       Node* cur = head;
       while (cur->next) {
         if (cur->value > cur->next->value) {
-          typename SqContainer<T>::value_type temp =
-              cur->value;  /// Swap the values of the current and next elements
-          cur->value = cur->next->value;
-          cur->next->value = temp;
+          /// Swap the values of the current and next elements
+          std::swap(cur->value, cur->next->value);
           swapped = true;
         }
         cur = cur->next;
@@ -353,29 +391,23 @@ template <typename T>
 template <class... Args>
 typename list<T>::iterator list<T>::insert_many(
     typename list<T>::const_iterator pos, Args&&... args) {
-  for (const auto& arg :
-       {args...}) {  /// Iterate through the variadic arguments
-    insert(pos, arg);
-  }
+  /// Construct each argument in place before pos, in order
+  (..., (void)emplace(pos, std::forward<Args>(args)));
   return pos;  /// Return the iterator pointing to the last inserted element
 }
 
 template <typename T>
 template <class... Args>
 void list<T>::insert_many_back(Args&&... args) {
-  for (const auto& arg :
-       {args...}) {  /// Iterate through the variadic arguments
-    push_back(arg);
-  }
+  /// Construct each argument in place at the back, in order
+  (..., (void)emplace_back(std::forward<Args>(args)));
 }
 
 template <typename T>
 template <class... Args>
 void list<T>::insert_many_front(Args&&... args) {
-  for (const auto& arg :
-       {args...}) {  /// Iterate through the variadic arguments
-    push_front(arg);
-  }
+  /// Construct each argument in place at the front, in order
+  (..., (void)emplace_front(std::forward<Args>(args)));
 }
 
 }  // namespace s21
@@ -2,194 +2,260 @@
 #define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_MAP_TPP_
 
 namespace s21 {
-template <typename Key, typename T>
-Pair<Key, T>::Pair() {
-  pair_ = std::pair<Key, T>();
+template <typename Key, typename T, typename Compare>
+map<Key, T, Compare>::map(
+    const std::initializer_list<std::pair<Key, T>> &items) {
+  _tree.Assign(items.begin(), items.end());
 }
 
-template <typename Key, typename T>
-Pair<Key, T>::Pair(const std::pair<Key, T> &value) : pair_(value) {}
+template <typename Key, typename T, typename Compare>
+template <typename InputIt, typename>
+map<Key, T, Compare>::map(InputIt first, InputIt last) {
+  _tree.Assign(first, last);
+}
 
-template <typename Key, typename T>
-Pair<Key, T>::Pair(Pair &&p) {
-  pair_ = std::pair<Key, T>();
-  swap(p);
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::mapped_type &map<Key, T, Compare>::at(
+    const Key &key) {
+  typename tree_type::iterator tmp = _tree.Find(key);
+  if (tmp == _tree.end()) {
+    throw std::out_of_range("s21::map::at:  key not found");
+  }
+  return (*tmp).second;
 }
 
-template <typename Key, typename T>
-Pair<Key, T>::Pair(const Pair &other) {
-  pair_ = other.pair_;
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::mapped_type &map<Key, T, Compare>::operator[](
+    const Key &key) {
+  return (*try_emplace(key).first).second;
 }
 
-template <typename Key, typename T>
-Pair<Key, T> &Pair<Key, T>::operator=(const Pair &other) {
-  Pair(other).swap(*this);
-  return *this;
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::mapped_type &map<Key, T, Compare>::operator[](
+    Key &&key) {
+  return (*try_emplace(std::move(key)).first).second;
 }
 
-template <typename Key, typename T>
-Pair<Key, T> &Pair<Key, T>::operator=(Pair &&other) {
-  swap(other);
-  return *this;
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+std::pair<typename map<Key, T, Compare>::iterator, bool>
+map<Key, T, Compare>::try_emplace(const Key &key, Args &&...args) {
+  return _tree.TryEmplace(key, std::piecewise_construct,
+                          std::forward_as_tuple(key),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
 }
 
-template <typename Key, typename T>
-bool Pair<Key, T>::operator<(const Pair &other) {
-  return pair_.first < other.pair_.first;
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+std::pair<typename map<Key, T, Compare>::iterator, bool>
+map<Key, T, Compare>::try_emplace(Key &&key, Args &&...args) {
+  /// ключ перемещается в пару уже после спуска, который идет по ссылке на
+  /// него
+  return _tree.TryEmplace(key, std::piecewise_construct,
+                          std::forward_as_tuple(std::move(key)),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
 }
 
-template <typename Key, typename T>
-bool Pair<Key, T>::operator==(const Pair &other) {
-  return pair_.first == other.pair_.first;
+template <typename Key, typename T, typename Compare>
+std::pair<typename map<Key, T, Compare>::iterator, bool>
+map<Key, T, Compare>::insert(const value_type &value) {
+  return _tree.Insert(value);
 }
 
-template <typename Key, typename T>
-bool Pair<Key, T>::operator>(const Pair &other) {
-  return pair_.first > other.pair_.first;
+template <typename Key, typename T, typename Compare>
+std::pair<typename map<Key, T, Compare>::iterator, bool>
+map<Key, T, Compare>::insert(value_type &&value) {
+  return _tree.Insert(std::move(value));
 }
 
-template <typename Key, typename T>
-void Pair<Key, T>::swap(Pair &other) {
-  std::swap(pair_, other.pair_);
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+std::pair<typename map<Key, T, Compare>::iterator, bool>
+map<Key, T, Compare>::emplace(Args &&...args) {
+  return _tree.Emplace(std::forward<Args>(args)...);
 }
 
-template <typename Key, typename T>
-T &Pair<Key, T>::second() {
-  return pair_.second;
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::iterator map<Key, T, Compare>::insert(
+    iterator hint, const value_type &value) {
+  return _tree.Insert(hint, value);
 }
 
-template <typename Key, typename T>
-map<Key, T>::map() : tree_(new AvlTree<value_type>()) {
-  /// map не может хранить двух одинаковых ключей
-  tree_->SetUnique();
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::iterator map<Key, T, Compare>::insert(
+    iterator hint, value_type &&value) {
+  return _tree.Insert(hint, std::move(value));
 }
 
-template <typename Key, typename T>
-map<Key, T>::map(const std::initializer_list<std::pair<Key, T>> &items)
-    : tree_(new AvlTree<value_type>()) {
-  /// map не может хранить двух одинаковых ключей
-  tree_->SetUnique();
-  for (value_type i : items) {
-    tree_->Insert(Pair(i));
-  }
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+typename map<Key, T, Compare>::iterator map<Key, T, Compare>::emplace_hint(
+    iterator hint, Args &&...args) {
+  return _tree.EmplaceHint(hint, std::forward<Args>(args)...);
 }
 
-template <typename Key, typename T>
-map<Key, T>::map(const map &other)
-    : tree_(new AvlTree<value_type>(*(other.tree_))) {}
+template <typename Key, typename T, typename Compare>
+std::pair<typename map<Key, T, Compare>::iterator, bool>
+map<Key, T, Compare>::insert(const Key &key, const T &obj) {
+  return _tree.TryEmplace(key, key, obj);
+}
 
-template <typename Key, typename T>
-map<Key, T>::map(map &&m) : map() {
-  swap(m);
+template <typename Key, typename T, typename Compare>
+std::pair<typename map<Key, T, Compare>::iterator, bool>
+map<Key, T, Compare>::insert_or_assign(const Key &key, const T &obj) {
+  std::pair<iterator, bool> res = _tree.TryEmplace(key, key, obj);
+  if (!res.second) (*res.first).second = obj;
+  return res;
 }
 
-template <typename Key, typename T>
-map<Key, T> &map<Key, T>::operator=(map &&m) {
-  swap(m);
-  return *this;
+template <typename Key, typename T, typename Compare>
+std::pair<typename map<Key, T, Compare>::iterator, bool>
+map<Key, T, Compare>::insert_or_assign(const Key &key, T &&obj) {
+  /// obj перемещается ровно один раз: в новую пару или в существующую
+  std::pair<iterator, bool> res = _tree.TryEmplace(key, key, std::move(obj));
+  if (!res.second) (*res.first).second = std::move(obj);
+  return res;
 }
 
-template <typename Key, typename T>
-map<Key, T> &map<Key, T>::operator=(const map &other) {
-  map<Key, T>(other).swap(*this);
-  return *this;
+template <typename Key, typename T, typename Compare>
+template <typename InputIt>
+void map<Key, T, Compare>::assign_sorted(InputIt first, InputIt last) {
+  _tree.AssignSorted(first, last);
 }
 
-template <typename Key, typename T>
-map<Key, T>::~map() {
-  delete tree_;
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::iterator map<Key, T, Compare>::erase(
+    iterator pos) {
+  if (pos == end()) return pos;
+  return _tree.Erase(pos);
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::mapped_type &map<Key, T>::at(const Key &key) {
-  typename AvlTree<value_type>::iterator tmp =
-      tree_->Find(Pair(std::pair<Key, T>(key, T())));
-  if (tmp == tree_->end()) {
-    throw std::out_of_range("s21::map::at:  key not found");
-  }
-  return (*tmp).second();
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::iterator map<Key, T, Compare>::erase(
+    iterator first, iterator last) {
+  if (first == last) return last;
+  size_type from = _tree.IndexOf(first);
+  /// ноды возвращаются в собственный пул, он не становится общим
+  _tree.EraseRank(from, _tree.IndexOf(last));
+  return last;
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::mapped_type &map<Key, T>::operator[](const Key &key) {
-  std::pair<typename AvlTree<value_type>::iterator, bool> inserted =
-      tree_->Insert(Pair(std::pair<Key, T>(key, T())));
-  if (!inserted.second) {
-    return at(key);
-  }
-  return (*(inserted.first)).second();
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::size_type map<Key, T, Compare>::erase_range(
+    const Key &lo, const Key &hi) {
+  return _tree.EraseRange(lo, hi);
 }
 
-template <typename Key, typename T>
-std::pair<typename map<Key, T>::iterator, bool> map<Key, T>::insert(
-    const value_type &value) {
-  return tree_->Insert(value);
+template <typename Key, typename T, typename Compare>
+map<Key, T, Compare> map<Key, T, Compare>::extract_range(const Key &lo,
+                                                         const Key &hi) {
+  map<Key, T, Compare> result;
+  result._tree = _tree.ExtractRange(lo, hi);
+  return result;
 }
 
-template <typename Key, typename T>
-std::pair<typename map<Key, T>::iterator, bool> map<Key, T>::insert(
-    const Key &key, const T &obj) {
-  return tree_->Insert(std::pair<Key, T>(key, obj));
+template <typename Key, typename T, typename Compare>
+bool map<Key, T, Compare>::empty() {
+  return _tree.IsEmpty();
 }
 
-template <typename Key, typename T>
-std::pair<typename map<Key, T>::iterator, bool> map<Key, T>::insert_or_assign(
-    const Key &key, const T &obj) {
-  typename AvlTree<value_type>::iterator tmp =
-      tree_->Find(Pair(std::pair<Key, T>(key, obj)));
-  if (tmp == tree_->end()) {
-    return insert(key, obj);
-  }
-  (*tmp).second() = obj;
-  return std::pair<typename map<Key, T>::iterator, bool>(tmp, false);
+template <typename Key, typename T, typename Compare>
+void map<Key, T, Compare>::swap(map &other) {
+  _tree.Swap(other._tree);
 }
 
-template <typename Key, typename T>
-void map<Key, T>::erase(iterator pos) {
-  tree_->Remove(*pos);
+template <typename Key, typename T, typename Compare>
+void map<Key, T, Compare>::merge(map &other) {
+  _tree.Absorb(other._tree);
 }
 
-template <typename Key, typename T>
-bool map<Key, T>::empty() {
-  return tree_->IsEmpty();
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::node_type map<Key, T, Compare>::extract(
+    iterator pos) {
+  return _tree.Extract(pos);
 }
 
-template <typename Key, typename T>
-void map<Key, T>::swap(map &other) {
-  std::swap(tree_, other.tree_);
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::node_type map<Key, T, Compare>::extract(
+    const Key &key) {
+  return _tree.Extract(key);
 }
 
-template <typename Key, typename T>
-void map<Key, T>::merge(map &other) {
-  for (auto it = other.begin(); it != other.end(); ++it) {
-    insert(*it);
-  }
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::insert_return_type map<Key, T, Compare>::insert(
+    node_type &&node) {
+  auto res = _tree.Insert(std::move(node));
+  return insert_return_type{res.first, res.second, std::move(node)};
+}
+
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::iterator map<Key, T, Compare>::insert(
+    iterator hint, node_type &&node) {
+  return _tree.Insert(hint, std::move(node));
+}
+
+template <typename Key, typename T, typename Compare>
+bool map<Key, T, Compare>::contains(const Key &key) {
+  return _tree.Include(key);
+}
+
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::iterator map<Key, T, Compare>::lower_bound(
+    const Key &key) {
+  return _tree.LowerBound(key);
+}
+
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::iterator map<Key, T, Compare>::upper_bound(
+    const Key &key) {
+  return _tree.UpperBound(key);
+}
+
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::iterator map<Key, T, Compare>::find(
+    const Key &key) {
+  return _tree.Find(key);
+}
+
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::iterator map<Key, T, Compare>::nth(size_type k) {
+  return _tree.Select(k);
+}
+
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::size_type map<Key, T, Compare>::rank(
+    const Key &key) const {
+  return _tree.Rank(key);
+}
+
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::size_type map<Key, T, Compare>::count_range(
+    const Key &lo, const Key &hi) const {
+  return _tree.CountRange(lo, hi);
 }
 
-template <typename Key, typename T>
-bool map<Key, T>::contains(const Key &key) {
-  return tree_->Include(Pair(std::make_pair(key, T())));
+template <typename Key, typename T, typename Compare>
+frozen_map<Key, T, Compare> map<Key, T, Compare>::freeze() {
+  return frozen_map<Key, T, Compare>(_tree.begin(), _tree.size());
 }
 
-template <typename Key, typename T>
+template <typename Key, typename T, typename Compare>
 template <typename... Args>
-s21::vector<std::pair<typename map<Key, T>::iterator, bool>>
-map<Key, T>::insert_many(Args &&...args) {
-  s21::vector<std::pair<typename map<Key, T>::iterator, bool>> result;
-  for (const auto &arg : {args...}) {
-    result.push_back(insert(arg));
-  }
+s21::vector<std::pair<typename map<Key, T, Compare>::iterator, bool>>
+map<Key, T, Compare>::insert_many(Args &&...args) {
+  s21::vector<std::pair<typename map<Key, T, Compare>::iterator, bool>> result;
+  (result.push_back(emplace(std::forward<Args>(args))), ...);
   return result;
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::iterator map<Key, T>::begin() {
-  return tree_->begin();
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::iterator map<Key, T, Compare>::begin() {
+  return _tree.begin();
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::iterator map<Key, T>::end() {
-  return tree_->end();
+template <typename Key, typename T, typename Compare>
+typename map<Key, T, Compare>::iterator map<Key, T, Compare>::end() {
+  return _tree.end();
 }
 }  // namespace s21
 
@@ -9,151 +9,261 @@
 
 namespace s21 {
 
-template <typename T>
-multiset<T>::multiset() {
-  _tree = AvlTree<T>();
+template <typename T, typename Compare>
+multiset<T, Compare>::multiset() {
+  _tree = tree_type();
 }
 
-template <typename T>
-multiset<T>::multiset(const std::initializer_list<value_type> &items) {
-  _tree = AvlTree<T>();
-
-  for (const auto &it : items) {
-    _tree.Insert(it);
-  }
+template <typename T, typename Compare>
+multiset<T, Compare>::multiset(const std::initializer_list<value_type> &items) {
+  _tree = tree_type();
+  _tree.Assign(items.begin(), items.end());
 }
 
-template <typename T>
-multiset<T>::multiset(const multiset &s) {
-  _tree = AvlTree<T>(s._tree);
+template <typename T, typename Compare>
+template <typename InputIt, typename>
+multiset<T, Compare>::multiset(InputIt first, InputIt last) {
+  _tree.Assign(first, last);
 }
 
-template <typename T>
-multiset<T>::multiset(multiset &&s) noexcept {
-  _tree = AvlTree<T>(std::move(s._tree));
+template <typename T, typename Compare>
+multiset<T, Compare>::multiset(const multiset &s) {
+  _tree = tree_type(s._tree);
 }
 
-template <typename T>
-multiset<T> &multiset<T>::operator=(const multiset &s) {
-  _tree = AvlTree<T>(s._tree);
+template <typename T, typename Compare>
+multiset<T, Compare>::multiset(multiset &&s) noexcept
+    : _tree(std::move(s._tree)) {}
+
+template <typename T, typename Compare>
+multiset<T, Compare> &multiset<T, Compare>::operator=(const multiset &s) {
+  _tree = tree_type(s._tree);
 
   return *this;
 }
 
-template <typename T>
-bool multiset<T>::empty() {
+template <typename T, typename Compare>
+multiset<T, Compare> &multiset<T, Compare>::operator=(multiset &&s) noexcept {
+  _tree = std::move(s._tree);
+  return *this;
+}
+
+template <typename T, typename Compare>
+bool multiset<T, Compare>::empty() {
   return _tree.IsEmpty();
 }
 
-template <typename T>
-void multiset<T>::clear() {
-  _tree.~AvlTree();
+template <typename T, typename Compare>
+void multiset<T, Compare>::clear() {
+  _tree.Clear();
 }
 
-template <typename T>
-std::pair<typename multiset<T>::iterator, bool> multiset<T>::insert(
-    const value_type &value) {
+template <typename T, typename Compare>
+std::pair<typename multiset<T, Compare>::iterator, bool>
+multiset<T, Compare>::insert(const value_type &value) {
   auto res = _tree.Insert(value);
   return std::pair<iterator, bool>(MultiSetIterator(res.first), res.second);
 }
 
-template <typename T>
-void multiset<T>::erase(multiset::iterator pos) {
-  if (pos != this->end()) {
-    _tree.Remove(*pos);
-  }
+template <typename T, typename Compare>
+std::pair<typename multiset<T, Compare>::iterator, bool>
+multiset<T, Compare>::insert(value_type &&value) {
+  auto res = _tree.Insert(std::move(value));
+  return std::pair<iterator, bool>(MultiSetIterator(res.first), res.second);
 }
 
-template <typename T>
-void multiset<T>::swap(multiset<T> &other) {
-  AvlTree<T> buf = other._tree;
-  other._tree = this->_tree;
-  this->_tree = buf;
+template <typename T, typename Compare>
+template <typename... Args>
+std::pair<typename multiset<T, Compare>::iterator, bool>
+multiset<T, Compare>::emplace(Args &&...args) {
+  auto res = _tree.Emplace(std::forward<Args>(args)...);
+  return std::pair<iterator, bool>(MultiSetIterator(res.first), res.second);
 }
 
-template <typename T>
-void multiset<T>::merge(multiset<T> &other) {
-  for (const auto &it : other) {
-    _tree.Insert(*it);
-  }
+template <typename T, typename Compare>
+typename multiset<T, Compare>::iterator multiset<T, Compare>::insert(
+    iterator hint, const value_type &value) {
+  return MultiSetIterator(_tree.Insert(hint, value));
 }
 
-template <typename T>
-typename multiset<T>::iterator multiset<T>::find(const key_type &key) {
+template <typename T, typename Compare>
+typename multiset<T, Compare>::iterator multiset<T, Compare>::insert(
+    iterator hint, value_type &&value) {
+  return MultiSetIterator(_tree.Insert(hint, std::move(value)));
+}
+
+template <typename T, typename Compare>
+template <typename... Args>
+typename multiset<T, Compare>::iterator multiset<T, Compare>::emplace_hint(
+    iterator hint, Args &&...args) {
+  return MultiSetIterator(_tree.EmplaceHint(hint, std::forward<Args>(args)...));
+}
+
+template <typename T, typename Compare>
+template <typename InputIt>
+void multiset<T, Compare>::assign_sorted(InputIt first, InputIt last) {
+  _tree.AssignSorted(first, last);
+}
+
+template <typename T, typename Compare>
+typename multiset<T, Compare>::iterator multiset<T, Compare>::erase(
+    iterator pos) {
+  /// удаляется именно элемент pos, а не первый из равных ему
+  if (pos == this->end()) return pos;
+  return _tree.Erase(pos);
+}
+
+template <typename T, typename Compare>
+typename multiset<T, Compare>::iterator multiset<T, Compare>::erase(
+    iterator first, iterator last) {
+  if (first == last) return last;
+  size_type from = _tree.IndexOf(first);
+  _tree.EraseRank(from, _tree.IndexOf(last));
+  return last;
+}
+
+template <typename T, typename Compare>
+typename multiset<T, Compare>::size_type multiset<T, Compare>::erase_range(
+    const key_type &lo, const key_type &hi) {
+  return _tree.EraseRange(lo, hi);
+}
+
+template <typename T, typename Compare>
+multiset<T, Compare> multiset<T, Compare>::extract_range(const key_type &lo,
+                                                         const key_type &hi) {
+  multiset<T, Compare> result;
+  result._tree = _tree.ExtractRange(lo, hi);
+  return result;
+}
+
+template <typename T, typename Compare>
+void multiset<T, Compare>::swap(multiset<T, Compare> &other) {
+  _tree.Swap(other._tree);
+}
+
+template <typename T, typename Compare>
+void multiset<T, Compare>::merge(multiset<T, Compare> &other) {
+  /// переходят все узлы other, слияние через split/join без копирования
+  _tree.Merge(std::move(other._tree));
+}
+
+template <typename T, typename Compare>
+typename multiset<T, Compare>::node_type multiset<T, Compare>::extract(
+    iterator pos) {
+  return _tree.Extract(pos);
+}
+
+template <typename T, typename Compare>
+typename multiset<T, Compare>::node_type multiset<T, Compare>::extract(
+    const key_type &key) {
+  return _tree.Extract(key);
+}
+
+template <typename T, typename Compare>
+typename multiset<T, Compare>::iterator multiset<T, Compare>::insert(
+    node_type &&node) {
+  return MultiSetIterator(_tree.Insert(std::move(node)).first);
+}
+
+template <typename T, typename Compare>
+typename multiset<T, Compare>::iterator multiset<T, Compare>::insert(
+    iterator hint, node_type &&node) {
+  return MultiSetIterator(_tree.Insert(hint, std::move(node)));
+}
+
+template <typename T, typename Compare>
+typename multiset<T, Compare>::iterator multiset<T, Compare>::find(
+    const key_type &key) {
   return MultiSetIterator(_tree.Find(key));
 }
 
-template <typename T>
-bool multiset<T>::contains(const key_type &key) {
+template <typename T, typename Compare>
+bool multiset<T, Compare>::contains(const key_type &key) {
   return _tree.Include(key);
 }
 
-template <typename T>
-multiset<T>::~multiset() {
-  _tree.~AvlTree();
+template <typename T, typename Compare>
+typename multiset<T, Compare>::iterator multiset<T, Compare>::nth(size_type k) {
+  return MultiSetIterator(_tree.Select(k));
+}
+
+template <typename T, typename Compare>
+typename multiset<T, Compare>::size_type multiset<T, Compare>::rank(
+    const key_type &key) const {
+  return _tree.Rank(key);
+}
+
+template <typename T, typename Compare>
+typename multiset<T, Compare>::size_type multiset<T, Compare>::count_range(
+    const key_type &lo, const key_type &hi) const {
+  return _tree.CountRange(lo, hi);
 }
 
-template <typename T>
-typename multiset<T>::iterator multiset<T>::begin() {
+template <typename T, typename Compare>
+typename multiset<T, Compare>::iterator multiset<T, Compare>::begin() {
   return MultiSetIterator(_tree.begin());
 }
 
-template <typename T>
-typename multiset<T>::iterator multiset<T>::end() {
+template <typename T, typename Compare>
+typename multiset<T, Compare>::iterator multiset<T, Compare>::end() {
   return MultiSetIterator(_tree.end());
 }
 
-template <typename T>
+template <typename T, typename Compare>
 template <class... Args>
-vector<std::pair<typename multiset<T>::iterator, bool>>
-multiset<T>::insert_many(Args &&...args) {
+vector<std::pair<typename multiset<T, Compare>::iterator, bool>>
+multiset<T, Compare>::insert_many(Args &&...args) {
   vector<std::pair<iterator, bool>> res_vec;
-  for (const auto &it : {args...}) {
-    auto res_ins = _tree.Insert(it);
-    res_vec.push_back(std::pair<typename multiset<T>::iterator, bool>(
-        MultiSetIterator(res_ins.first), res_ins.second));
-  }
+  (res_vec.push_back(emplace(std::forward<Args>(args))), ...);
   return res_vec;
 }
 
-template <typename T>
-std::pair<typename multiset<T>::iterator, typename multiset<T>::iterator>
-multiset<T>::equal_range(const T &key) {
-  if (!_tree.Include(key)) {
+template <typename T, typename Compare>
+std::pair<typename multiset<T, Compare>::iterator,
+          typename multiset<T, Compare>::iterator>
+multiset<T, Compare>::equal_range(const T &key) {
+  auto start = _tree.LowerBound(key);
+  auto end = _tree.UpperBound(key);
+  if (start == end) {
     return std::pair<iterator, iterator>(this->end(), this->end());
   }
-  auto start = this->lower_bound(key);
-  auto end = --this->upper_bound(key);
-  //  auto start = _tree.Find(key);
-  //  auto end = start;
-  //  while (*end == key && end != _tree.end()) {
-  //    end++;
-  //  }
-  //  if (end != start) {
-  //    end--;
-  //  }
+  /// вторым итератором возвращается последний равный key элемент
   return std::pair<iterator, iterator>(MultiSetIterator(start),
-                                       MultiSetIterator(end));
+                                       MultiSetIterator(--end));
 }
 
-template <typename T>
-typename multiset<T>::iterator multiset<T>::lower_bound(const T &key) {
-  for (auto it = _tree.begin(); it != _tree.end(); it++) {
-    if (*it >= key) {
-      return MultiSetIterator(it);
-    }
-  }
-  return this->end();
+template <typename T, typename Compare>
+typename multiset<T, Compare>::iterator multiset<T, Compare>::lower_bound(
+    const T &key) {
+  return MultiSetIterator(_tree.LowerBound(key));
 }
 
-template <typename T>
-typename multiset<T>::iterator multiset<T>::upper_bound(const T &key) {
-  for (auto it = _tree.begin(); it != _tree.end(); it++) {
-    if (*it > key) {
-      return MultiSetIterator(it);
-    }
-  }
-  return this->end();
+template <typename T, typename Compare>
+typename multiset<T, Compare>::iterator multiset<T, Compare>::upper_bound(
+    const T &key) {
+  return MultiSetIterator(_tree.UpperBound(key));
+}
+
+template <typename T, typename Compare>
+multiset<T, Compare> set_union(multiset<T, Compare> a, multiset<T, Compare> b,
+                               ThreadPool &pool) {
+  a._tree.Union(std::move(b._tree), pool);
+  return a;
+}
+
+template <typename T, typename Compare>
+multiset<T, Compare> set_intersection(multiset<T, Compare> a,
+                                      multiset<T, Compare> b,
+                                      ThreadPool &pool) {
+  a._tree.Intersect(std::move(b._tree), pool);
+  return a;
+}
+
+template <typename T, typename Compare>
+multiset<T, Compare> set_difference(multiset<T, Compare> a,
+                                    multiset<T, Compare> b, ThreadPool &pool) {
+  a._tree.Subtract(std::move(b._tree), pool);
+  return a;
 }
 
 }  // namespace s21
@@ -0,0 +1,192 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_NODE_POOL_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_NODE_POOL_TPP_
+
+namespace s21 {
+
+template <typename N>
+NodePool<N>::NodePool(NodePool &&other) noexcept {
+  swap(other);
+}
+
+template <typename N>
+NodePool<N> &NodePool<N>::operator=(NodePool &&other) noexcept {
+  if (this != &other) {
+    Release();
+    swap(other);
+  }
+  return *this;
+}
+
+template <typename N>
+void NodePool<N>::swap(NodePool &other) noexcept {
+  std::swap(_slabs, other._slabs);
+  std::swap(_free, other._free);
+  std::swap(_free_tail, other._free_tail);
+  std::swap(_cursor, other._cursor);
+  std::swap(_cursor_end, other._cursor_end);
+  std::swap(_next_slab, other._next_slab);
+  std::swap(_forward_owner, other._forward_owner);
+  /// обмен требует монопольного доступа к обоим пулам
+  _forward.store(other._forward.exchange(_forward.load()));
+  _shared.store(other._shared.exchange(_shared.load()));
+}
+
+template <typename N>
+std::shared_ptr<NodePool<N>> NodePool<N>::Resolve(
+    std::shared_ptr<NodePool> pool) {
+  while (pool && pool->IsForwarded()) pool = pool->_forward_owner;
+  return pool;
+}
+
+template <typename N>
+std::shared_ptr<NodePool<N>> NodePool<N>::Unite(
+    const std::shared_ptr<NodePool> &a, const std::shared_ptr<NodePool> &b) {
+  for (;;) {
+    std::shared_ptr<NodePool> root = Resolve(a);
+    std::shared_ptr<NodePool> other = Resolve(b);
+    if (!root) return other;
+    if (!other || root == other) return root;
+    std::scoped_lock lock(root->_mutex, other->_mutex);
+    /// другой поток успел перенаправить один из пулов
+    if (root->IsForwarded() || other->IsForwarded()) continue;
+    root->Absorb(*other);
+    /// владельцы other теперь работают с root
+    root->Share();
+    other->Share();
+    other->_forward_owner = root;
+    other->_forward.store(root.get(), std::memory_order_release);
+    return root;
+  }
+}
+
+template <typename N>
+void NodePool<N>::Absorb(NodePool &other) {
+  /// блоки переходят целиком, остаток текущего блока other не используется
+  _slabs.insert(_slabs.end(), other._slabs.begin(), other._slabs.end());
+  other._slabs.clear();
+  if (other._free) {
+    other._free_tail->next = _free;
+    if (!_free) _free_tail = other._free_tail;
+    _free = other._free;
+  }
+  other._free = other._free_tail = nullptr;
+  other._cursor = other._cursor_end = nullptr;
+}
+
+template <typename N>
+template <typename F>
+decltype(auto) NodePool<N>::Locked(F &&f) {
+  NodePool *pool = this;
+  for (;;) {
+    std::lock_guard<std::mutex> lock(pool->_mutex);
+    NodePool *next = pool->_forward.load(std::memory_order_acquire);
+    if (!next) return f(*pool);
+    /// next жив, пока жив pool: им владеет pool->_forward_owner
+    pool = next;
+  }
+}
+
+template <typename N>
+void NodePool<N>::AddSlab(std::size_t count) {
+  /// место под запись о блоке резервируем заранее, чтобы не потерять память
+  _slabs.reserve(_slabs.size() + 1);
+  N *data = std::allocator<N>().allocate(count);
+  _slabs.push_back(Slab{data, count});
+  _cursor = data;
+  _cursor_end = data + count;
+}
+
+template <typename N>
+N *NodePool<N>::Allocate() {
+#ifdef S21_AVLTREE_HEAP_NODES
+  return std::allocator<N>().allocate(1);
+#else
+  if (!IsShared()) return TakeNode();
+  return Locked([](NodePool &pool) { return pool.TakeNode(); });
+#endif
+}
+
+template <typename N>
+N *NodePool<N>::TakeNode() {
+  /// сначала переиспользуем освобожденные узлы
+  if (_free) {
+    FreeNode *node = _free;
+    _free = node->next;
+    if (!_free) _free_tail = nullptr;
+    return reinterpret_cast<N *>(node);
+  }
+  /// затем берем следующий узел текущего блока
+  if (_cursor == _cursor_end) {
+    AddSlab(_next_slab);
+    if (_next_slab < kMaxSlab) _next_slab *= 2;
+  }
+  return _cursor++;
+}
+
+template <typename N>
+void NodePool<N>::Deallocate(N *node) noexcept {
+#ifdef S21_AVLTREE_HEAP_NODES
+  std::allocator<N>().deallocate(node, 1);
+#else
+  if (!IsShared()) return PutNode(node);
+  Locked([node](NodePool &pool) { pool.PutNode(node); });
+#endif
+}
+
+template <typename N>
+void NodePool<N>::PutNode(N *node) noexcept {
+  FreeNode *free_node = reinterpret_cast<FreeNode *>(node);
+  free_node->next = _free;
+  if (!_free) _free_tail = free_node;
+  _free = free_node;
+}
+
+template <typename N>
+void NodePool<N>::Reserve(std::size_t count) {
+#ifndef S21_AVLTREE_HEAP_NODES
+  if (!IsShared()) return ReserveNodes(count);
+  Locked([count](NodePool &pool) { pool.ReserveNodes(count); });
+#else
+  (void)count;
+#endif
+}
+
+template <typename N>
+void NodePool<N>::ReserveNodes(std::size_t count) {
+  if (static_cast<std::size_t>(_cursor_end - _cursor) < count) {
+    AddSlab(count);
+  }
+}
+
+#ifndef S21_AVLTREE_HEAP_NODES
+template <typename N>
+N *NodePool<N>::AllocateBlock(std::size_t count) {
+  auto take_block = [count](NodePool &pool) {
+    pool.ReserveNodes(count);
+    N *block = pool._cursor;
+    pool._cursor += count;
+    return block;
+  };
+  if (!IsShared()) return take_block(*this);
+  return Locked(take_block);
+}
+#endif
+
+template <typename N>
+void NodePool<N>::Release() noexcept {
+  for (const Slab &slab : _slabs) {
+    std::allocator<N>().deallocate(slab.data, slab.capacity);
+  }
+  _slabs.clear();
+  _free = _free_tail = nullptr;
+  _cursor = _cursor_end = nullptr;
+  _next_slab = kMinSlab;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_NODE_POOL_TPP_
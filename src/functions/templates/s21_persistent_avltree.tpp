@@ -0,0 +1,369 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_PERSISTENT_AVLTREE_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_PERSISTENT_AVLTREE_TPP_
+
+namespace s21 {
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+PersistentAvlTree<Key, Value, KeyOfValue, Compare> &
+PersistentAvlTree<Key, Value, KeyOfValue, Compare>::operator=(
+    const PersistentAvlTree &other) noexcept {
+  Node *root = Acquire(other._root);
+  Release(_root);
+  _root = root;
+  _size = other._size;
+  return *this;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+PersistentAvlTree<Key, Value, KeyOfValue, Compare> &
+PersistentAvlTree<Key, Value, KeyOfValue, Compare>::operator=(
+    PersistentAvlTree &&other) noexcept {
+  if (this != &other) {
+    Release(_root);
+    _root = std::exchange(other._root, nullptr);
+    _size = std::exchange(other._size, 0);
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void PersistentAvlTree<Key, Value, KeyOfValue, Compare>::Release(
+    Node *node) noexcept {
+  /// acq_rel: изменения узла до снятия чужой ссылки видны тому, кто его
+  /// освобождает
+  if (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    Release(node->left);
+    Release(node->right);
+    delete node;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void PersistentAvlTree<Key, Value, KeyOfValue, Compare>::MakeUnique(
+    Node *&slot) {
+  /// единственную ссылку держит текущая версия: другой поток не может
+  /// получить новую ссылку на узел, не имея ее
+  if (slot->refs.load(std::memory_order_acquire) == 1) return;
+  Node *copy = new Node(slot->value);
+  copy->left = Acquire(slot->left);
+  copy->right = Acquire(slot->right);
+  copy->height = slot->height;
+  Release(slot);
+  slot = copy;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void PersistentAvlTree<Key, Value, KeyOfValue, Compare>::RotateLeft(
+    Node *&slot) {
+  MakeUnique(slot->right);
+  Node *pivot = slot->right;
+  slot->right = pivot->left;
+  pivot->left = slot;
+  FixHeight(slot);
+  FixHeight(pivot);
+  slot = pivot;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void PersistentAvlTree<Key, Value, KeyOfValue, Compare>::RotateRight(
+    Node *&slot) {
+  MakeUnique(slot->left);
+  Node *pivot = slot->left;
+  slot->left = pivot->right;
+  pivot->right = slot;
+  FixHeight(slot);
+  FixHeight(pivot);
+  slot = pivot;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void PersistentAvlTree<Key, Value, KeyOfValue, Compare>::Balance(Node *&slot) {
+  FixHeight(slot);
+  int factor = BalanceFactor(slot);
+  if (factor == 2) {
+    if (BalanceFactor(slot->right) < 0) {
+      MakeUnique(slot->right);
+      RotateRight(slot->right);
+    }
+    RotateLeft(slot);
+  } else if (factor == -2) {
+    if (BalanceFactor(slot->left) > 0) {
+      MakeUnique(slot->left);
+      RotateLeft(slot->left);
+    }
+    RotateRight(slot);
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K, typename... Args>
+typename PersistentAvlTree<Key, Value, KeyOfValue, Compare>::Node *
+PersistentAvlTree<Key, Value, KeyOfValue, Compare>::InsertAt(
+    Node *&slot, const K &key, bool &inserted, std::vector<Node *> *trail,
+    Args &&...args) {
+  if (!slot) {
+    slot = new Node(std::forward<Args>(args)...);
+    inserted = true;
+    if (trail) trail->push_back(slot);
+    return slot;
+  }
+  MakeUnique(slot);
+  Node *found = slot;
+  if (Compare()(key, KeyOfValue()(slot->value))) {
+    found = InsertAt(slot->left, key, inserted, trail,
+                     std::forward<Args>(args)...);
+  } else if (Compare()(KeyOfValue()(slot->value), key)) {
+    found = InsertAt(slot->right, key, inserted, trail,
+                     std::forward<Args>(args)...);
+  }
+  /// без нового узла высоты не меняются
+  if (!inserted) {
+    if (trail) trail->push_back(slot);
+    return found;
+  }
+  /// повороты затрагивают только узлы пути, они уже собственные
+  Node *before = slot;
+  Balance(slot);
+  if (trail) Retrace(slot, before, found, *trail);
+  return found;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void PersistentAvlTree<Key, Value, KeyOfValue, Compare>::Retrace(
+    Node *top, const Node *before, const Node *target,
+    std::vector<Node *> &trail) {
+  if (top == before) {
+    trail.push_back(top);
+    return;
+  }
+  while (!trail.empty() && (trail.back() == top || trail.back() == top->left ||
+                            trail.back() == top->right)) {
+    trail.pop_back();
+  }
+  /// спуск проходит не больше двух перестроенных уровней
+  Node *walk[3];
+  int count = 0;
+  const Key &key = KeyOfValue()(target->value);
+  for (Node *node = top; trail.empty() || node != trail.back();) {
+    walk[count++] = node;
+    if (node == target) break;
+    node = Compare()(key, KeyOfValue()(node->value)) ? node->left : node->right;
+  }
+  while (count > 0) trail.push_back(walk[--count]);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K, typename... Args>
+std::pair<Value *, bool>
+PersistentAvlTree<Key, Value, KeyOfValue, Compare>::TryEmplace(
+    const K &key, const_iterator *pos, Args &&...args) {
+  std::vector<Node *> trail;
+  /// вставка увеличивает высоту не больше чем на единицу
+  if (pos) trail.reserve(Height(_root) + 1);
+  bool inserted = false;
+  Node *found = nullptr;
+  try {
+    found = InsertAt(_root, key, inserted, pos ? &trail : nullptr,
+                     std::forward<Args>(args)...);
+  } catch (...) {
+    /// узел мог войти в дерево до исключения при балансировке
+    if (inserted) ++_size;
+    throw;
+  }
+  if (inserted) ++_size;
+  if (pos) {
+    /// итератор хранит узлы, из которых путь к элементу идет влево
+    pos->_path.clear();
+    for (std::size_t i = trail.size() - 1; i > 0; --i) {
+      if (trail[i]->left == trail[i - 1]) pos->_path.push_back(trail[i]);
+    }
+    pos->_path.push_back(found);
+  }
+  return {&found->value, inserted};
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename PersistentAvlTree<Key, Value, KeyOfValue, Compare>::Node *
+PersistentAvlTree<Key, Value, KeyOfValue, Compare>::DetachMin(Node *&slot) {
+  MakeUnique(slot);
+  if (slot->left) return DetachMin(slot->left);
+  Node *min = slot;
+  slot = min->right;
+  min->right = nullptr;
+  return min;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void PersistentAvlTree<Key, Value, KeyOfValue, Compare>::BalanceLeftSpine(
+    Node *&slot) {
+  /// ветвь кончается на поддереве, перешедшем от минимального узла: оно
+  /// сбалансировано и может быть общим со снимками
+  if (!slot || slot->refs.load(std::memory_order_acquire) != 1) return;
+  BalanceLeftSpine(slot->left);
+  Balance(slot);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K>
+void PersistentAvlTree<Key, Value, KeyOfValue, Compare>::EraseAt(
+    Node *&slot, const K &key, bool &removed) {
+  if (!slot) return;
+  MakeUnique(slot);
+  if (Compare()(key, KeyOfValue()(slot->value))) {
+    EraseAt(slot->left, key, removed);
+  } else if (Compare()(KeyOfValue()(slot->value), key)) {
+    EraseAt(slot->right, key, removed);
+  } else {
+    Node *node = slot;
+    if (!node->right) {
+      /// левое поддерево без правого соседа уже сбалансировано. Оно может
+      /// быть общим со снимками, поэтому его высота не пересчитывается
+      slot = node->left;
+      node->left = nullptr;
+      removed = true;
+      Release(node);
+      return;
+    }
+    /// на место узла встает минимальный узел правого поддерева целиком,
+    /// значение не копируется
+    Node *min = DetachMin(node->right);
+    min->left = node->left;
+    min->right = node->right;
+    slot = min;
+    node->left = nullptr;
+    node->right = nullptr;
+    removed = true;
+    Release(node);
+    /// содержимое дерева уже верное: исключение при копировании общих
+    /// соседей во время балансировки оставляет корректное дерево поиска
+    BalanceLeftSpine(slot->right);
+  }
+  /// ключа нет: высоты на пути не изменились
+  if (removed) Balance(slot);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K>
+bool PersistentAvlTree<Key, Value, KeyOfValue, Compare>::Erase(const K &key) {
+  bool removed = false;
+  try {
+    EraseAt(_root, key, removed);
+  } catch (...) {
+    if (removed) --_size;
+    throw;
+  }
+  if (removed) --_size;
+  return removed;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K>
+Value *PersistentAvlTree<Key, Value, KeyOfValue, Compare>::Access(
+    const K &key) {
+  Node **slot = &_root;
+  while (*slot) {
+    MakeUnique(*slot);
+    Node *node = *slot;
+    if (Compare()(key, KeyOfValue()(node->value))) {
+      slot = &node->left;
+    } else if (Compare()(KeyOfValue()(node->value), key)) {
+      slot = &node->right;
+    } else {
+      return &node->value;
+    }
+  }
+  return nullptr;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K>
+typename PersistentAvlTree<Key, Value, KeyOfValue, Compare>::const_iterator
+PersistentAvlTree<Key, Value, KeyOfValue, Compare>::Find(const K &key) const {
+  const_iterator it = LowerBound(key);
+  if (it != end() && Compare()(key, KeyOfValue()(*it))) return end();
+  return it;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K>
+bool PersistentAvlTree<Key, Value, KeyOfValue, Compare>::Include(
+    const K &key) const {
+  const Node *node = _root;
+  while (node) {
+    if (Compare()(key, KeyOfValue()(node->value))) {
+      node = node->left;
+    } else if (Compare()(KeyOfValue()(node->value), key)) {
+      node = node->right;
+    } else {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K>
+typename PersistentAvlTree<Key, Value, KeyOfValue, Compare>::const_iterator
+PersistentAvlTree<Key, Value, KeyOfValue, Compare>::LowerBound(
+    const K &key) const {
+  const_iterator it;
+  for (const Node *node = _root; node;) {
+    if (Compare()(KeyOfValue()(node->value), key)) {
+      node = node->right;
+    } else {
+      it._path.push_back(node);
+      node = node->left;
+    }
+  }
+  return it;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K>
+typename PersistentAvlTree<Key, Value, KeyOfValue, Compare>::const_iterator
+PersistentAvlTree<Key, Value, KeyOfValue, Compare>::UpperBound(
+    const K &key) const {
+  const_iterator it;
+  for (const Node *node = _root; node;) {
+    if (Compare()(key, KeyOfValue()(node->value))) {
+      it._path.push_back(node);
+      node = node->left;
+    } else {
+      node = node->right;
+    }
+  }
+  return it;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+bool PersistentAvlTree<Key, Value, KeyOfValue, Compare>::Validate() const {
+  std::size_t count = 0;
+  return ValidateSubtree(_root, nullptr, nullptr, count) >= 0 &&
+         count == _size;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+int PersistentAvlTree<Key, Value, KeyOfValue, Compare>::ValidateSubtree(
+    const Node *node, const Node *lo, const Node *hi, std::size_t &count) {
+  if (!node) return 0;
+  const Key &key = KeyOfValue()(node->value);
+  if (node->refs.load(std::memory_order_relaxed) == 0) return -1;
+  if (lo && !Compare()(KeyOfValue()(lo->value), key)) return -1;
+  if (hi && !Compare()(key, KeyOfValue()(hi->value))) return -1;
+  ++count;
+  int left = ValidateSubtree(node->left, lo, node, count);
+  int right = ValidateSubtree(node->right, node, hi, count);
+  if (left < 0 || right < 0 || left - right > 1 || right - left > 1) {
+    return -1;
+  }
+  int height = std::max(left, right) + 1;
+  return height == node->height ? height : -1;
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_PERSISTENT_AVLTREE_TPP_
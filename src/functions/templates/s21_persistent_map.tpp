@@ -0,0 +1,72 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_PERSISTENT_MAP_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_PERSISTENT_MAP_TPP_
+
+#include "../include/s21_persistent_map.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare>
+const typename persistent_map<Key, T, Compare>::mapped_type &
+persistent_map<Key, T, Compare>::at(const Key &key) const {
+  iterator it = _tree.Find(key);
+  if (it == end()) throw std::out_of_range("s21::persistent_map::at: no key");
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare>
+typename persistent_map<Key, T, Compare>::mapped_type &
+persistent_map<Key, T, Compare>::at(const Key &key) {
+  value_type *pair = _tree.Access(key);
+  if (!pair) throw std::out_of_range("s21::persistent_map::at: no key");
+  return pair->second;
+}
+
+template <typename Key, typename T, typename Compare>
+typename persistent_map<Key, T, Compare>::mapped_type &
+persistent_map<Key, T, Compare>::operator[](const Key &key) {
+  /// один спуск: пара со значением по умолчанию создается только для
+  /// нового ключа
+  return _tree
+      .TryEmplace(key, nullptr, std::piecewise_construct,
+                  std::forward_as_tuple(key), std::forward_as_tuple())
+      .first->second;
+}
+
+template <typename Key, typename T, typename Compare>
+std::pair<typename persistent_map<Key, T, Compare>::iterator, bool>
+persistent_map<Key, T, Compare>::insert(const value_type &value) {
+  iterator pos;
+  bool inserted = _tree.TryEmplace(value.first, &pos, value).second;
+  return {pos, inserted};
+}
+
+template <typename Key, typename T, typename Compare>
+std::pair<typename persistent_map<Key, T, Compare>::iterator, bool>
+persistent_map<Key, T, Compare>::insert_or_assign(const Key &key,
+                                                  const T &obj) {
+  iterator pos;
+  auto result = _tree.TryEmplace(key, &pos, key, obj);
+  /// путь до пары уже принадлежит текущей версии
+  if (!result.second) result.first->second = obj;
+  return {pos, result.second};
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+std::pair<typename persistent_map<Key, T, Compare>::iterator, bool>
+persistent_map<Key, T, Compare>::emplace(Args &&...args) {
+  value_type value(std::forward<Args>(args)...);
+  iterator pos;
+  /// константный ключ при перемещении пары копируется, value.first остается
+  /// верным
+  bool inserted = _tree.TryEmplace(value.first, &pos, std::move(value)).second;
+  return {pos, inserted};
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_PERSISTENT_MAP_TPP_
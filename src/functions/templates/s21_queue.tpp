@@ -61,6 +61,17 @@ void queue<T>::push(typename SqContainer<T>::const_reference value) {
   list.push_front(value);  /// Head is the last element and Tail is the first
 }
 
+template <typename T>
+void queue<T>::push(typename SqContainer<T>::value_type&& value) {
+  list.push_front(std::move(value));
+}
+
+template <typename T>
+template <class... Args>
+void queue<T>::emplace(Args&&... args) {
+  list.emplace_front(std::forward<Args>(args)...);
+}
+
 template <typename T>
 void queue<T>::pop() {
   list.pop_back();  /// Head is the last element and Tail is the first
@@ -94,10 +105,8 @@ void queue<T>::swap(queue& other) {
 template <typename T>
 template <class... Args>
 void queue<T>::insert_many_back(Args&&... args) {
-  for (const auto& arg :
-       {args...}) {  /// Iterate through the variadic arguments
-    push(arg);
-  }
+  /// Construct each argument in place at the back, in order
+  (..., emplace(std::forward<Args>(args)));
 }
 
 }  // namespace s21
@@ -5,117 +5,249 @@
 
 namespace s21 {
 
-template <typename T>
-set<T>::set() {
-  _tree = AvlTree<T>();
-  _tree.SetUnique();
+template <typename T, typename Compare>
+set<T, Compare>::set() {
+  _tree = tree_type();
 }
 
-template <typename T>
-set<T>::set(const std::initializer_list<value_type> &items) {
-  _tree = AvlTree<T>();
-  _tree.SetUnique();
-  for (const auto &it : items) {
-    _tree.Insert(it);
-  }
+template <typename T, typename Compare>
+set<T, Compare>::set(const std::initializer_list<value_type> &items) {
+  _tree = tree_type();
+  _tree.Assign(items.begin(), items.end());
 }
 
-template <typename T>
-set<T>::set(const set &s) {
-  _tree = AvlTree<T>(s._tree);
-  _tree.SetUnique();
+template <typename T, typename Compare>
+template <typename InputIt, typename>
+set<T, Compare>::set(InputIt first, InputIt last) {
+  _tree.Assign(first, last);
 }
 
-template <typename T>
-set<T>::set(set &&s) noexcept {
-  _tree = AvlTree<T>(std::move(s._tree));
-  _tree.SetUnique();
+template <typename T, typename Compare>
+set<T, Compare>::set(const set &s) {
+  _tree = tree_type(s._tree);
 }
 
-template <typename T>
-set<T> &set<T>::operator=(const set &s) {
-  _tree = AvlTree<T>(s._tree);
-  _tree.SetUnique();
+template <typename T, typename Compare>
+set<T, Compare>::set(set &&s) noexcept : _tree(std::move(s._tree)) {}
+
+template <typename T, typename Compare>
+set<T, Compare> &set<T, Compare>::operator=(const set &s) {
+  _tree = tree_type(s._tree);
+  return *this;
+}
+
+template <typename T, typename Compare>
+set<T, Compare> &set<T, Compare>::operator=(set &&s) noexcept {
+  _tree = std::move(s._tree);
   return *this;
 }
 
-template <typename T>
-bool set<T>::empty() {
+template <typename T, typename Compare>
+bool set<T, Compare>::empty() {
   return _tree.IsEmpty();
 }
 
-template <typename T>
-void set<T>::clear() {
-  _tree.~AvlTree();
+template <typename T, typename Compare>
+void set<T, Compare>::clear() {
+  _tree.Clear();
 }
 
-template <typename T>
-std::pair<typename set<T>::iterator, bool> set<T>::insert(
+template <typename T, typename Compare>
+std::pair<typename set<T, Compare>::iterator, bool> set<T, Compare>::insert(
     const value_type &value) {
   auto res = _tree.Insert(value);
   return std::pair<iterator, bool>(SetIterator(res.first), res.second);
 }
 
-template <typename T>
-void set<T>::erase(set::iterator pos) {
-  if (pos != this->end()) {
-    _tree.Remove(*pos);
-  }
+template <typename T, typename Compare>
+std::pair<typename set<T, Compare>::iterator, bool> set<T, Compare>::insert(
+    value_type &&value) {
+  auto res = _tree.Insert(std::move(value));
+  return std::pair<iterator, bool>(SetIterator(res.first), res.second);
+}
+
+template <typename T, typename Compare>
+template <typename... Args>
+std::pair<typename set<T, Compare>::iterator, bool> set<T, Compare>::emplace(
+    Args &&...args) {
+  auto res = _tree.Emplace(std::forward<Args>(args)...);
+  return std::pair<iterator, bool>(SetIterator(res.first), res.second);
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::iterator set<T, Compare>::insert(
+    iterator hint, const value_type &value) {
+  return SetIterator(_tree.Insert(hint, value));
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::iterator set<T, Compare>::insert(iterator hint,
+                                                           value_type &&value) {
+  return SetIterator(_tree.Insert(hint, std::move(value)));
+}
+
+template <typename T, typename Compare>
+template <typename... Args>
+typename set<T, Compare>::iterator set<T, Compare>::emplace_hint(
+    iterator hint, Args &&...args) {
+  return SetIterator(_tree.EmplaceHint(hint, std::forward<Args>(args)...));
+}
+
+template <typename T, typename Compare>
+template <typename InputIt>
+void set<T, Compare>::assign_sorted(InputIt first, InputIt last) {
+  _tree.AssignSorted(first, last);
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::iterator set<T, Compare>::erase(iterator pos) {
+  if (pos == this->end()) return pos;
+  return iterator(_tree.Erase(pos));
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::iterator set<T, Compare>::erase(iterator first,
+                                                          iterator last) {
+  if (first == last) return last;
+  size_type from = _tree.IndexOf(first);
+  /// узлы возвращаются в собственный пул, он не становится общим
+  _tree.EraseRank(from, _tree.IndexOf(last));
+  return last;
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::size_type set<T, Compare>::erase_range(
+    const key_type &lo, const key_type &hi) {
+  return _tree.EraseRange(lo, hi);
+}
+
+template <typename T, typename Compare>
+set<T, Compare> set<T, Compare>::extract_range(const key_type &lo,
+                                               const key_type &hi) {
+  set<T, Compare> result;
+  result._tree = _tree.ExtractRange(lo, hi);
+  return result;
 }
 
-template <typename T>
-void set<T>::swap(set<T> &other) {
-  AvlTree<T> buf = other._tree;
-  other._tree = this->_tree;
-  this->_tree = buf;
+template <typename T, typename Compare>
+void set<T, Compare>::swap(set<T, Compare> &other) {
+  _tree.Swap(other._tree);
 }
 
-template <typename T>
-void set<T>::merge(set<T> &other) {
-  for (const auto &it : other) {
-    _tree.Insert(it);
-  }
+template <typename T, typename Compare>
+void set<T, Compare>::merge(set<T, Compare> &other) {
+  _tree.Absorb(other._tree);
 }
 
-template <typename T>
-typename set<T>::iterator set<T>::find(const key_type &key) {
+template <typename T, typename Compare>
+typename set<T, Compare>::node_type set<T, Compare>::extract(iterator pos) {
+  return _tree.Extract(pos);
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::node_type set<T, Compare>::extract(
+    const key_type &key) {
+  return _tree.Extract(key);
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::insert_return_type set<T, Compare>::insert(
+    node_type &&node) {
+  auto res = _tree.Insert(std::move(node));
+  return insert_return_type{SetIterator(res.first), res.second,
+                            std::move(node)};
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::iterator set<T, Compare>::insert(iterator hint,
+                                                           node_type &&node) {
+  return SetIterator(_tree.Insert(hint, std::move(node)));
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::iterator set<T, Compare>::find(const key_type &key) {
   return SetIterator(_tree.Find(key));
 }
 
-template <typename T>
-bool set<T>::contains(const key_type &key) {
+template <typename T, typename Compare>
+bool set<T, Compare>::contains(const key_type &key) {
   return _tree.Include(key);
 }
 
-template <typename T>
-set<T>::~set() {
-  _tree.~AvlTree();
+template <typename T, typename Compare>
+typename set<T, Compare>::iterator set<T, Compare>::lower_bound(
+    const key_type &key) {
+  return SetIterator(_tree.LowerBound(key));
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::iterator set<T, Compare>::upper_bound(
+    const key_type &key) {
+  return SetIterator(_tree.UpperBound(key));
 }
 
-template <typename T>
-typename set<T>::iterator set<T>::begin() {
+template <typename T, typename Compare>
+typename set<T, Compare>::iterator set<T, Compare>::nth(size_type k) {
+  return SetIterator(_tree.Select(k));
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::size_type set<T, Compare>::rank(
+    const key_type &key) const {
+  return _tree.Rank(key);
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::size_type set<T, Compare>::count_range(
+    const key_type &lo, const key_type &hi) const {
+  return _tree.CountRange(lo, hi);
+}
+
+template <typename T, typename Compare>
+frozen_set<T, Compare> set<T, Compare>::freeze() {
+  return frozen_set<T, Compare>(_tree.begin(), _tree.size());
+}
+
+template <typename T, typename Compare>
+typename set<T, Compare>::iterator set<T, Compare>::begin() {
   return SetIterator(_tree.begin());
 }
 
-template <typename T>
-typename set<T>::iterator set<T>::end() {
+template <typename T, typename Compare>
+typename set<T, Compare>::iterator set<T, Compare>::end() {
   return SetIterator(_tree.end());
 }
 
-template <typename T>
+template <typename T, typename Compare>
 template <class... Args>
-vector<std::pair<typename set<T>::iterator, bool>> set<T>::insert_many(
-    Args &&...args) {
+vector<std::pair<typename set<T, Compare>::iterator, bool>>
+set<T, Compare>::insert_many(Args &&...args) {
   vector<std::pair<iterator, bool>> res_vec;
-  for (const auto &it : {args...}) {
-    auto res_ins = _tree.Insert(it);
-    //    auto pair = std::pair<typename set<T>::iterator, bool>(
-    //                    );
-    res_vec.push_back({SetIterator(res_ins.first), res_ins.second});
-  }
+  (res_vec.push_back(emplace(std::forward<Args>(args))), ...);
   return res_vec;
 }
 
+template <typename T, typename Compare>
+set<T, Compare> set_union(set<T, Compare> a, set<T, Compare> b,
+                          ThreadPool &pool) {
+  a._tree.Union(std::move(b._tree), pool);
+  return a;
+}
+
+template <typename T, typename Compare>
+set<T, Compare> set_intersection(set<T, Compare> a, set<T, Compare> b,
+                                 ThreadPool &pool) {
+  a._tree.Intersect(std::move(b._tree), pool);
+  return a;
+}
+
+template <typename T, typename Compare>
+set<T, Compare> set_difference(set<T, Compare> a, set<T, Compare> b,
+                               ThreadPool &pool) {
+  a._tree.Subtract(std::move(b._tree), pool);
+  return a;
+}
+
 // template <typename T>
 // set<T>::~set() {
 //   this->~AvlTree();
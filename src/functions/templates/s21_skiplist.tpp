@@ -0,0 +1,331 @@
+//
+// Created by alex on 18.10.26.
+//
+
+#ifndef CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_SKIPLIST_TPP_
+#define CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_SKIPLIST_TPP_
+
+namespace s21 {
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+SkipList<Key, Value, KeyOfValue, Compare>::~SkipList() {
+  /// исключенные узлы уже отложены в EpochDomain, на нижнем уровне остались
+  /// только живые
+  Node *node = Ptr(_head->next[0].load(std::memory_order_acquire));
+  while (node) {
+    Node *next = Ptr(node->next[0].load(std::memory_order_relaxed));
+    DestroyNode(node);
+    node = next;
+  }
+  FreeNode(_head);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename SkipList<Key, Value, KeyOfValue, Compare>::Node *
+SkipList<Key, Value, KeyOfValue, Compare>::CreateNode(int height) {
+  std::size_t bytes =
+      sizeof(Node) + (height - 1) * sizeof(std::atomic<link>);
+  Node *node = static_cast<Node *>(
+      ::operator new(bytes, std::align_val_t(alignof(Node))));
+  new (node) Node;
+  node->height = height;
+  node->owners.store(2, std::memory_order_relaxed);
+  std::atomic<link> *next = node->next;
+  for (int level = 0; level < height; ++level) {
+    new (next + level) std::atomic<link>(0);
+  }
+  return node;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void SkipList<Key, Value, KeyOfValue, Compare>::FreeNode(Node *node) noexcept {
+  ::operator delete(node, std::align_val_t(alignof(Node)));
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void SkipList<Key, Value, KeyOfValue, Compare>::DestroyNode(
+    void *node) noexcept {
+  Node *target = static_cast<Node *>(node);
+  target->value().~Value();
+  FreeNode(target);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+int SkipList<Key, Value, KeyOfValue, Compare>::RandomHeight() {
+  /// xorshift64 в каждом потоке: без общего состояния генератора
+  thread_local std::uint64_t state =
+      0x9E3779B97F4A7C15ULL ^ reinterpret_cast<std::uintptr_t>(&state);
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  std::uint64_t bits = state;
+  int height = 1;
+  while (height < kMaxHeight && (bits & 3) == 0) {
+    ++height;
+    bits >>= 2;
+  }
+  return height;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename SkipList<Key, Value, KeyOfValue, Compare>::Node *
+SkipList<Key, Value, KeyOfValue, Compare>::NextLive(Node *node) {
+  Node *next = Ptr(node->next[0].load(std::memory_order_acquire));
+  while (next && Marked(next->next[0].load(std::memory_order_acquire))) {
+    next = Ptr(next->next[0].load(std::memory_order_acquire));
+  }
+  return next;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K>
+bool SkipList<Key, Value, KeyOfValue, Compare>::Search(const K &key,
+                                                       Node **preds,
+                                                       Node **succs) const {
+  int top = _height.load(std::memory_order_acquire);
+  for (int level = top; level < kMaxHeight; ++level) {
+    preds[level] = _head;
+    succs[level] = nullptr;
+  }
+retry:
+  Node *pred = _head;
+  for (int level = top - 1; level >= 0; --level) {
+    Node *curr = Ptr(pred->next[level].load(std::memory_order_acquire));
+    while (curr) {
+      link succ = curr->next[level].load(std::memory_order_acquire);
+      if (Marked(succ)) {
+        /// исключение помеченного узла. Неудача означает, что pred сам
+        /// помечен или изменился, поиск начинается заново
+        link expected = Pack(curr);
+        if (!pred->next[level].compare_exchange_strong(
+                expected, Pack(Ptr(succ)), std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+          goto retry;
+        }
+        curr = Ptr(succ);
+        continue;
+      }
+      if (!Compare()(KeyOf(curr), key)) break;
+      pred = curr;
+      curr = Ptr(succ);
+    }
+    preds[level] = pred;
+    succs[level] = curr;
+  }
+  return succs[0] && !Compare()(key, KeyOf(succs[0]));
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <bool Upper, typename K>
+typename SkipList<Key, Value, KeyOfValue, Compare>::Node *
+SkipList<Key, Value, KeyOfValue, Compare>::Bound(const K &key) const {
+  /// чтение ничего не исключает: помеченные узлы просто пропускаются, их
+  /// ссылки next после пометки не меняются и ведут дальше по порядку
+  Node *pred = _head;
+  Node *curr = nullptr;
+  for (int level = _height.load(std::memory_order_acquire) - 1; level >= 0;
+       --level) {
+    curr = Ptr(pred->next[level].load(std::memory_order_acquire));
+    while (curr) {
+      link succ = curr->next[level].load(std::memory_order_acquire);
+      if (!Marked(succ)) {
+        bool right = Upper ? !Compare()(key, KeyOf(curr))
+                           : Compare()(KeyOf(curr), key);
+        if (!right) break;
+        pred = curr;
+      }
+      curr = Ptr(succ);
+    }
+  }
+  return curr;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+std::pair<typename SkipList<Key, Value, KeyOfValue, Compare>::Node *, bool>
+SkipList<Key, Value, KeyOfValue, Compare>::Link(Node *node) {
+  Node *preds[kMaxHeight];
+  Node *succs[kMaxHeight];
+  const Key &key = KeyOf(node);
+  int height = node->height;
+  int top = _height.load(std::memory_order_relaxed);
+  while (top < height && !_height.compare_exchange_weak(
+                             top, height, std::memory_order_acq_rel)) {
+  }
+  for (;;) {
+    if (Search(key, preds, succs)) {
+      DestroyNode(node);
+      return {succs[0], false};
+    }
+    for (int level = 0; level < height; ++level) {
+      node->next[level].store(Pack(succs[level]), std::memory_order_relaxed);
+    }
+    /// связывание нижнего уровня - момент вставки
+    link expected = Pack(succs[0]);
+    if (preds[0]->next[0].compare_exchange_strong(expected, Pack(node),
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed)) {
+      break;
+    }
+  }
+  _size.fetch_add(1, std::memory_order_relaxed);
+  bool removed = false;
+  for (int level = 1; level < height && !removed; ++level) {
+    for (;;) {
+      link own = node->next[level].load(std::memory_order_acquire);
+      if (Marked(own)) {
+        removed = true;
+        break;
+      }
+      if (Ptr(own) != succs[level] &&
+          !node->next[level].compare_exchange_strong(
+              own, Pack(succs[level]), std::memory_order_acq_rel)) {
+        continue;
+      }
+      link expected = Pack(succs[level]);
+      if (preds[level]->next[level].compare_exchange_strong(
+              expected, Pack(node), std::memory_order_release,
+              std::memory_order_relaxed)) {
+        break;
+      }
+      Search(key, preds, succs);
+      if (succs[0] != node) {
+        removed = true;
+        break;
+      }
+    }
+  }
+  /// узел удалили, пока связывались верхние уровни: уровни, связанные
+  /// после исключения удалившим потоком, исключаются здесь
+  if (Marked(node->next[0].load(std::memory_order_acquire))) {
+    Search(key, preds, succs);
+  }
+  ReleaseOwner(node);
+  return {node, true};
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void SkipList<Key, Value, KeyOfValue, Compare>::ReleaseOwner(Node *node) {
+  if (node->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    EpochDomain::Instance().Retire(node, &DestroyNode);
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename V>
+std::pair<typename SkipList<Key, Value, KeyOfValue, Compare>::const_iterator,
+          bool>
+SkipList<Key, Value, KeyOfValue, Compare>::InsertValue(V &&value) {
+  EpochDomain::Guard guard = EpochDomain::Instance().Pin();
+  Node *found = Bound<false>(KeyOfValue()(value));
+  if (found && !Compare()(KeyOfValue()(value), KeyOf(found))) {
+    return {const_iterator(std::move(guard), found), false};
+  }
+  Node *node = CreateNode(RandomHeight());
+  try {
+    new (node->storage) Value(std::forward<V>(value));
+  } catch (...) {
+    FreeNode(node);
+    throw;
+  }
+  std::pair<Node *, bool> result = Link(node);
+  return {const_iterator(std::move(guard), result.first), result.second};
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename... Args>
+std::pair<typename SkipList<Key, Value, KeyOfValue, Compare>::const_iterator,
+          bool>
+SkipList<Key, Value, KeyOfValue, Compare>::Emplace(Args &&...args) {
+  EpochDomain::Guard guard = EpochDomain::Instance().Pin();
+  Node *node = CreateNode(RandomHeight());
+  try {
+    new (node->storage) Value(std::forward<Args>(args)...);
+  } catch (...) {
+    FreeNode(node);
+    throw;
+  }
+  std::pair<Node *, bool> result = Link(node);
+  return {const_iterator(std::move(guard), result.first), result.second};
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K>
+bool SkipList<Key, Value, KeyOfValue, Compare>::Erase(const K &key) {
+  EpochDomain::Guard guard = EpochDomain::Instance().Pin();
+  Node *preds[kMaxHeight];
+  Node *succs[kMaxHeight];
+  if (!Search(key, preds, succs)) return false;
+  Node *node = succs[0];
+  /// пометка сверху вниз: после пометки уровня вставка его не свяжет
+  for (int level = node->height - 1; level >= 1; --level) {
+    link next = node->next[level].load(std::memory_order_acquire);
+    while (!Marked(next) && !node->next[level].compare_exchange_weak(
+                                next, next | 1, std::memory_order_acq_rel)) {
+    }
+  }
+  /// пометка нижнего уровня - момент удаления, ее делает ровно один поток
+  link next = node->next[0].load(std::memory_order_acquire);
+  for (;;) {
+    if (Marked(next)) return false;
+    if (node->next[0].compare_exchange_weak(next, next | 1,
+                                            std::memory_order_acq_rel)) {
+      break;
+    }
+  }
+  _size.fetch_sub(1, std::memory_order_relaxed);
+  /// поиск исключает узел на всех уровнях, где он связан
+  Search(key, preds, succs);
+  ReleaseOwner(node);
+  return true;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename SkipList<Key, Value, KeyOfValue, Compare>::const_iterator
+SkipList<Key, Value, KeyOfValue, Compare>::begin() const {
+  EpochDomain::Guard guard = EpochDomain::Instance().Pin();
+  Node *first = NextLive(_head);
+  if (!first) return end();
+  return const_iterator(std::move(guard), first);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K>
+typename SkipList<Key, Value, KeyOfValue, Compare>::const_iterator
+SkipList<Key, Value, KeyOfValue, Compare>::Find(const K &key) const {
+  EpochDomain::Guard guard = EpochDomain::Instance().Pin();
+  Node *node = Bound<false>(key);
+  if (!node || Compare()(key, KeyOf(node))) return end();
+  return const_iterator(std::move(guard), node);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K>
+bool SkipList<Key, Value, KeyOfValue, Compare>::Include(const K &key) const {
+  EpochDomain::Guard guard = EpochDomain::Instance().Pin();
+  Node *node = Bound<false>(key);
+  return node && !Compare()(key, KeyOf(node));
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K>
+typename SkipList<Key, Value, KeyOfValue, Compare>::const_iterator
+SkipList<Key, Value, KeyOfValue, Compare>::LowerBound(const K &key) const {
+  EpochDomain::Guard guard = EpochDomain::Instance().Pin();
+  Node *node = Bound<false>(key);
+  if (!node) return end();
+  return const_iterator(std::move(guard), node);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename K>
+typename SkipList<Key, Value, KeyOfValue, Compare>::const_iterator
+SkipList<Key, Value, KeyOfValue, Compare>::UpperBound(const K &key) const {
+  EpochDomain::Guard guard = EpochDomain::Instance().Pin();
+  Node *node = Bound<true>(key);
+  if (!node) return end();
+  return const_iterator(std::move(guard), node);
+}
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SRC_FUNCTIONS_TEMPLATES_S21_SKIPLIST_TPP_
@@ -56,7 +56,19 @@ stack<T>& stack<T>::operator=(stack&& other) noexcept {
 
 template <typename T>
 void stack<T>::push(typename SqContainer<T>::const_reference value) {
-  typename s21::list<T>::Node* node = new typename s21::list<T>::Node(value);
+  emplace(value);
+}
+
+template <typename T>
+void stack<T>::push(typename SqContainer<T>::value_type&& value) {
+  emplace(std::move(value));
+}
+
+template <typename T>
+template <class... Args>
+void stack<T>::emplace(Args&&... args) {
+  typename s21::list<T>::Node* node = new typename s21::list<T>::Node(
+      std::in_place, std::forward<Args>(args)...);
   node->prev = nullptr;
   node->next = list.getHead();
   if (!empty()) {
@@ -100,10 +112,8 @@ void stack<T>::swap(stack& other) {
 template <typename T>
 template <class... Args>
 void stack<T>::insert_many_front(Args&&... args) {
-  for (const auto& arg :
-       {args...}) {  /// Iterate through the variadic arguments
-    push(arg);
-  }
+  /// Construct each argument in place on the top, in order
+  (..., emplace(std::forward<Args>(args)));
 }
 
 }  // namespace s21
@@ -14,27 +14,37 @@ vector<T>::vector() {
 }
 
 template <typename T>
-vector<T>::vector(size_type n) {
-  data_ = new value_type[n];
-  size_ = n;
-  capacity_ = n;
-  std::fill_n(data_, n, value_type());
+vector<T>::vector(size_type n) : data_(Allocate(n)), size_(n), capacity_(n) {
+  try {
+    std::uninitialized_value_construct_n(data_, n);
+  } catch (...) {
+    Deallocate(data_);
+    throw;
+  }
 }
 
 template <typename T>
 vector<T>::vector(std::initializer_list<value_type> const &items)
-    : data_(new value_type[items.size()]),
+    : data_(Allocate(items.size())),
       size_(items.size()),
       capacity_(items.size()) {
-  std::copy(items.begin(), items.end(), data_);
+  try {
+    std::uninitialized_copy(items.begin(), items.end(), data_);
+  } catch (...) {
+    Deallocate(data_);
+    throw;
+  }
 }
 
 template <typename T>
 vector<T>::vector(const vector &v)
-    : data_(new value_type[v.capacity_]),
-      size_(v.size_),
-      capacity_(v.capacity_) {
-  std::copy(v.data_, v.data_ + v.size_, data_);
+    : data_(Allocate(v.capacity_)), size_(v.size_), capacity_(v.capacity_) {
+  try {
+    std::uninitialized_copy(v.data_, v.data_ + v.size_, data_);
+  } catch (...) {
+    Deallocate(data_);
+    throw;
+  }
 }
 
 template <typename T>
@@ -48,7 +58,8 @@ template <typename T>
 vector<T> &vector<T>::operator=(vector<T> &&v) noexcept {
   if (this != &v) {  // Проверка на самоприсваивание
 
-    delete[] data_;
+    Destroy(data_, data_ + size_);
+    Deallocate(data_);
 
     size_ = v.size_;
     capacity_ = v.capacity_;
@@ -63,7 +74,8 @@ vector<T> &vector<T>::operator=(vector<T> &&v) noexcept {
 
 template <typename T>
 vector<T>::~vector() {
-  delete[] data_;
+  Destroy(data_, data_ + size_);
+  Deallocate(data_);
 
   size_ = 0;
   capacity_ = 0;
@@ -120,17 +132,7 @@ void vector<T>::reserve(size_type size) {
     throw std::out_of_range("vector::reserve Too large size for a max size");
   }
 
-  iterator new_data = new value_type[size];
-
-  // Копируем существующие элементы в новый массив
-  for (size_type i = 0; i < size_; ++i) {
-    new_data[i] = std::move(data_[i]);
-  }
-
-  delete[] data_;
-
-  data_ = new_data;
-  capacity_ = size;
+  Reallocate(size);
 }
 
 //  size_type capacity() { return capacity_; } // описан в хэдере
@@ -138,18 +140,15 @@ void vector<T>::reserve(size_type size) {
 template <typename T>
 void vector<T>::shrink_to_fit() {
   if (size_ < capacity_) {
-    value_type *new_data = new value_type[size_];
-    std::copy(data_, data_ + size_, new_data);
-    delete[] data_;
-    data_ = new_data;
-    capacity_ = size_;
+    Reallocate(size_);
   }
 }
 
 // методы для изменения контейнера
 template <typename T>
 void vector<T>::clear() noexcept {
-  delete[] data_;
+  Destroy(data_, data_ + size_);
+  Deallocate(data_);
   size_ = 0;
   capacity_ = 0;
   data_ = nullptr;
@@ -158,6 +157,19 @@ void vector<T>::clear() noexcept {
 template <typename T>
 typename vector<T>::iterator vector<T>::insert(iterator pos,
                                                const_reference value) {
+  return emplace(pos, value);
+}
+
+template <typename T>
+typename vector<T>::iterator vector<T>::insert(iterator pos,
+                                               value_type &&value) {
+  return emplace(pos, std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+typename vector<T>::iterator vector<T>::emplace(const_iterator pos,
+                                                Args &&...args) {
   size_type index = pos - begin();  // Рассчитываем индекс позиции вставки
 
   if (index > size_) {
@@ -165,27 +177,26 @@ typename vector<T>::iterator vector<T>::insert(iterator pos,
         "vector::insert The insertion position is out of range of the vector"
         "memory");
   }
-  // Проверяем, есть ли достаточно места для вставки нового элемента
-  size_type new_capacity = 1;
-  if (capacity_ > 0) {
-    new_capacity = capacity_ * 2;
+  // Нет места - новый элемент создается сразу в новом буфере
+  if (size_ == capacity_) {
+    return EmplaceReallocate(index, std::forward<Args>(args)...);
   }
 
-  if (size_ >= capacity_) {
-    // Увеличиваем capacity и выделяем новый буфер
-    reserve(new_capacity);
-    pos = begin() + index;  // Обновляем итератор после перевыделения памяти
+  if (index == size_) {
+    new (data_ + size_) value_type(std::forward<Args>(args)...);
+  } else {
+    // Аргументы могут ссылаться на элементы вектора, поэтому значение
+    // создается до сдвига
+    value_type value(std::forward<Args>(args)...);
+    // Сдвигаем элементы вправо, начиная с позиции вставки
+    new (data_ + size_) value_type(std::move(data_[size_ - 1]));
+    std::move_backward(data_ + index, data_ + size_ - 1, data_ + size_);
+    data_[index] = std::move(value);
   }
-
-  // Сдвигаем элементы вправо, начиная с позиции вставки
-  std::move_backward(pos, end(), end() + 1);
-
-  // Вставляем новый элемент
-  *pos = value;
   ++size_;
 
   // Возвращаем итератор на вставленный элемент
-  return pos;
+  return data_ + index;
 }
 
 template <typename T>
@@ -195,26 +206,36 @@ void vector<T>::erase(iterator pos) {
   // Сдвигаем элементы влево, начиная с позиции удаления
   std::move(pos + 1, end(), pos);
 
-  // Уменьшаем размер вектора
+  // Уменьшаем размер вектора, освободившийся последний элемент разрушается
   --size_;
+  data_[size_].~value_type();
 }
 
 template <typename T>
 void vector<T>::push_back(const_reference value) {
+  emplace_back(value);
+}
+
+template <typename T>
+void vector<T>::push_back(value_type &&value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+typename vector<T>::reference vector<T>::emplace_back(Args &&...args) {
   if (size_ == capacity_) {
-    if (capacity_ != 0) {
-      reserve(capacity_ * 2);
-    } else {
-      reserve(1);
-    }
+    return *EmplaceReallocate(size_, std::forward<Args>(args)...);
   }
-  data_[size_++] = value;
+  new (data_ + size_) value_type(std::forward<Args>(args)...);
+  return data_[size_++];
 }
 
 template <typename T>
 void vector<T>::pop_back() {
   if (size_ > 0) {
     --size_;
+    data_[size_].~value_type();
   }
 }
 
@@ -239,27 +260,22 @@ typename vector<T>::iterator vector<T>::insert_many(
 
   // Рассчитываем индекс позиции вставки относительно начала вектора
   typename vector<T>::size_type index = pos - begin();
+  constexpr size_type count = sizeof...(Args);
 
-  // Вычисляем новую емкость вектора после вставки элементов
-  typename vector<T>::size_type new_capacity = size_ + sizeof...(args);
-
-  // Если новая емкость превышает текущую, увеличиваем емкость вектора
-  if (new_capacity > capacity_) {
-    reserve(new_capacity);
-    pos = begin() + index;  // Обновляем итератор после перевыделения памяти
+  if (index > size_) {
+    throw std::out_of_range(
+        "vector::insert_many The insertion position is out of range of the "
+        "vector memory");
+  }
+  if constexpr (count == 0) {
+    return begin() + index;
+  } else {
+    // Нет места - новые элементы создаются сразу в новом буфере
+    if (size_ + count > capacity_) {
+      return InsertManyReallocate(index, std::forward<Args>(args)...);
+    }
+    return InsertManyShift(index, std::forward<Args>(args)...);
   }
-
-  // Определяем позицию вставки вектора
-  auto insert_position = begin() + index;
-
-  // Вставляем каждый аргумент перед позицией вставки
-  ((void)(data_[index++] = std::forward<Args>(args)), ...);
-
-  // Увеличиваем размер вектора на количество вставленных элементов
-  size_ += sizeof...(args);
-
-  // Возвращаем итератор на первый вставленный элемент
-  return insert_position;
 }
 
 template <typename T>
@@ -273,11 +289,169 @@ void vector<T>::insert_many_back(Args &&...args) {
     reserve(new_size);
   }
 
-  // Вставляем новые элементы в конец вектора
-  T *dest = data_ + size_;
-  (..., (void)(*dest++ = std::forward<Args>(args)));  // Вставка всех элементов
+  // Создаем новые элементы на месте в конце вектора
+  (..., (void)emplace_back(std::forward<Args>(args)));
+}
+
+// вспомогательные методы управления памятью
+template <typename T>
+typename vector<T>::iterator vector<T>::Allocate(size_type n) {
+  if (n == 0) return nullptr;
+  return static_cast<iterator>(::operator new(n * sizeof(value_type)));
+}
+
+template <typename T>
+void vector<T>::Deallocate(iterator data) noexcept {
+  ::operator delete(data);
+}
+
+template <typename T>
+void vector<T>::Destroy(iterator first, iterator last) noexcept {
+  for (; first != last; ++first) first->~value_type();
+}
+
+template <typename T>
+void vector<T>::Reallocate(size_type new_capacity) {
+  iterator new_data = Allocate(new_capacity);
+  try {
+    std::uninitialized_move(data_, data_ + size_, new_data);
+  } catch (...) {
+    Deallocate(new_data);
+    throw;
+  }
+  Destroy(data_, data_ + size_);
+  Deallocate(data_);
+  data_ = new_data;
+  capacity_ = new_capacity;
+}
+
+template <typename T>
+template <typename... Args>
+typename vector<T>::iterator vector<T>::EmplaceReallocate(size_type index,
+                                                          Args &&...args) {
+  size_type new_capacity = GrowthCapacity();
+  iterator new_data = Allocate(new_capacity);
+  iterator created = new_data + index;
+  try {
+    new (created) value_type(std::forward<Args>(args)...);
+  } catch (...) {
+    Deallocate(new_data);
+    throw;
+  }
+  try {
+    std::uninitialized_move(data_, data_ + index, new_data);
+    try {
+      std::uninitialized_move(data_ + index, data_ + size_, created + 1);
+    } catch (...) {
+      Destroy(new_data, created);
+      throw;
+    }
+  } catch (...) {
+    created->~value_type();
+    Deallocate(new_data);
+    throw;
+  }
+  Destroy(data_, data_ + size_);
+  Deallocate(data_);
+  data_ = new_data;
+  size_++;
+  capacity_ = new_capacity;
+  return created;
+}
+
+template <typename T>
+template <typename... Args>
+void vector<T>::ConstructMany(iterator first, Args &&...args) {
+  size_type built = 0;
+  try {
+    (..., (void)(new (first + built) value_type(std::forward<Args>(args)),
+                 ++built));
+  } catch (...) {
+    Destroy(first, first + built);
+    throw;
+  }
+}
+
+template <typename T>
+template <typename... Args>
+typename vector<T>::iterator vector<T>::InsertManyShift(size_type index,
+                                                        Args &&...args) {
+  constexpr size_type count = sizeof...(Args);
+  iterator old_end = data_ + size_;
+  size_type tail = size_ - index;
+  if (tail == 0) {
+    ConstructMany(old_end, std::forward<Args>(args)...);
+    size_ += count;
+    return data_ + index;
+  }
+
+  // Аргументы могут ссылаться на элементы вектора, поэтому значения
+  // создаются до сдвига во временном буфере
+  alignas(value_type) unsigned char storage[sizeof(value_type) * count];
+  iterator values = reinterpret_cast<iterator>(storage);
+  ConstructMany(values, std::forward<Args>(args)...);
+
+  // Хвост сдвигается один раз сразу на count позиций
+  try {
+    if (tail > count) {
+      std::uninitialized_move(old_end - count, old_end, old_end);
+      size_ += count;
+      std::move_backward(data_ + index, old_end - count, old_end);
+      std::move(values, values + count, data_ + index);
+    } else {
+      // Хвост целиком уходит в неинициализированную память, промежуток
+      // между ним и старым концом заполняют последние значения
+      std::uninitialized_move(values + tail, values + count, old_end);
+      try {
+        std::uninitialized_move(data_ + index, old_end, data_ + index + count);
+      } catch (...) {
+        Destroy(old_end, data_ + index + count);
+        throw;
+      }
+      size_ += count;
+      std::move(values, values + tail, data_ + index);
+    }
+  } catch (...) {
+    Destroy(values, values + count);
+    throw;
+  }
+  Destroy(values, values + count);
+  return data_ + index;
+}
 
-  size_ = new_size;
+template <typename T>
+template <typename... Args>
+typename vector<T>::iterator vector<T>::InsertManyReallocate(size_type index,
+                                                             Args &&...args) {
+  constexpr size_type count = sizeof...(Args);
+  size_type new_capacity = std::max(GrowthCapacity(), size_ + count);
+  iterator new_data = Allocate(new_capacity);
+  iterator created = new_data + index;
+  try {
+    ConstructMany(created, std::forward<Args>(args)...);
+  } catch (...) {
+    Deallocate(new_data);
+    throw;
+  }
+  try {
+    std::uninitialized_move(data_, data_ + index, new_data);
+    try {
+      std::uninitialized_move(data_ + index, data_ + size_, created + count);
+    } catch (...) {
+      Destroy(new_data, created);
+      throw;
+    }
+  } catch (...) {
+    Destroy(created, created + count);
+    Deallocate(new_data);
+    throw;
+  }
+  Destroy(data_, data_ + size_);
+  Deallocate(data_);
+  data_ = new_data;
+  size_ += count;
+  capacity_ = new_capacity;
+  return created;
 }
 
 }  // namespace s21
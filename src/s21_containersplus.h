@@ -5,7 +5,18 @@
 #ifndef CPP2_S21_CONTAINERS_1_SRC_S21_CONTAINERSPLUS_H_
 #define CPP2_S21_CONTAINERS_1_SRC_S21_CONTAINERSPLUS_H_
 
+#include "functions/include/s21_aggregate_map.h"
 #include "functions/include/s21_array.h"
+#include "functions/include/s21_btree_map.h"
+#include "functions/include/s21_btree_multiset.h"
+#include "functions/include/s21_btree_set.h"
+#include "functions/include/s21_compact_map.h"
+#include "functions/include/s21_compact_set.h"
+#include "functions/include/s21_concurrent_map.h"
+#include "functions/include/s21_concurrent_skiplist_map.h"
+#include "functions/include/s21_concurrent_skiplist_set.h"
+#include "functions/include/s21_interval_map.h"
 #include "functions/include/s21_multiset.h"
+#include "functions/include/s21_persistent_map.h"
 #include "s21_containers.h"
 #endif  // CPP2_S21_CONTAINERS_1_SRC_S21_CONTAINERSPLUS_H_
@@ -0,0 +1,120 @@
+#include <map>
+#include <random>
+#include <string>
+
+#include "test_entry.h"
+
+namespace {
+/// некоммутативный агрегат: склейка строк по возрастанию ключей
+struct Concat {
+  using type = std::string;
+  static type Neutral() { return ""; }
+  static type Make(const std::string &value) { return value; }
+  static type Combine(const type &a, const type &b) { return a + b; }
+};
+
+/// считает копии значения
+struct Copies {
+  static int count;
+  int data = 0;
+  explicit Copies(int d) : data(d) {}
+  Copies(const Copies &other) : data(other.data) { ++count; }
+  Copies &operator=(const Copies &other) {
+    data = other.data;
+    ++count;
+    return *this;
+  }
+};
+int Copies::count = 0;
+
+/// сумма полей data
+struct CopiesSum {
+  using type = int;
+  static type Neutral() { return 0; }
+  static type Make(const Copies &value) { return value.data; }
+  static type Combine(const type &a, const type &b) { return a + b; }
+};
+}  // namespace
+
+TEST(AggregateMapTest, ExistingKeyCostsNoNode) {
+  s21::aggregate_map<int, Copies, CopiesSum> map;
+  EXPECT_TRUE(map.insert(1, Copies(1)).second);
+  EXPECT_TRUE(map.insert(2, Copies(2)).second);
+  Copies::count = 0;
+  /// повтор ключа не создает узел с копией значения
+  EXPECT_FALSE(map.insert(1, Copies(5)).second);
+  EXPECT_EQ(Copies::count, 0);
+  EXPECT_FALSE(map.insert_or_assign(1, Copies(5)).second);
+  EXPECT_EQ(Copies::count, 1);
+  EXPECT_EQ(map.aggregate(), 7);
+  EXPECT_EQ(map.erase(2), 1U);
+  map.erase(map.find(1));
+  EXPECT_EQ(map.aggregate(), 0);
+  EXPECT_TRUE(map.insert(3, Copies(3)).second);
+  EXPECT_EQ(map.aggregate(), 3);
+  EXPECT_TRUE(map.validate());
+}
+
+TEST(AggregateMapTest, SumMinMaxMatchBruteForce) {
+  s21::aggregate_map<int, long> sums;
+  s21::aggregate_map<int, long, s21::MinAggregate<long>> mins;
+  s21::aggregate_map<int, long, s21::MaxAggregate<long>> maxs;
+  std::map<int, long> reference;
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<int> key(0, 2000);
+  std::uniform_int_distribution<long> value(-1000, 1000);
+  for (int step = 0; step < 6000; ++step) {
+    int k = key(gen);
+    long v = value(gen);
+    if (step % 4 == 0) {
+      EXPECT_EQ(sums.erase(k), reference.erase(k));
+      mins.erase(k);
+      maxs.erase(k);
+    } else {
+      EXPECT_EQ(sums.insert_or_assign(k, v).second,
+                reference.insert_or_assign(k, v).second);
+      mins.insert_or_assign(k, v);
+      maxs.insert_or_assign(k, v);
+    }
+  }
+  ASSERT_TRUE(sums.validate());
+  ASSERT_TRUE(mins.validate());
+  EXPECT_EQ(sums.size(), reference.size());
+  for (int q = 0; q < 300; ++q) {
+    int lo = key(gen) - 10;
+    int hi = lo + key(gen) / 4;
+    long sum = 0;
+    long min = std::numeric_limits<long>::max();
+    long max = std::numeric_limits<long>::lowest();
+    for (auto it = reference.lower_bound(lo);
+         it != reference.end() && it->first < hi; ++it) {
+      sum += it->second;
+      min = std::min(min, it->second);
+      max = std::max(max, it->second);
+    }
+    EXPECT_EQ(sums.aggregate(lo, hi), sum);
+    EXPECT_EQ(mins.aggregate(lo, hi), min);
+    EXPECT_EQ(maxs.aggregate(lo, hi), max);
+  }
+  long total = 0;
+  for (const auto &item : reference) total += item.second;
+  EXPECT_EQ(sums.aggregate(), total);
+}
+
+TEST(AggregateMapTest, UpdateAndOrder) {
+  s21::aggregate_map<int, std::string, Concat> map = {
+      {3, "c"}, {1, "a"}, {2, "b"}, {5, "e"}, {4, "d"}};
+  EXPECT_EQ(map.aggregate(), "abcde");
+  EXPECT_EQ(map.aggregate(2, 5), "bcd");
+  EXPECT_EQ(map.aggregate(5, 2), "");
+  EXPECT_FALSE(map.insert(2, "x").second);
+  EXPECT_TRUE(map.update(2, [](std::string &value) { value = "B"; }));
+  EXPECT_FALSE(map.update(9, [](std::string &) {}));
+  map.insert_or_assign(4, "D");
+  EXPECT_EQ(map.aggregate(0, 100), "aBcDe");
+  map.erase(map.find(3));
+  EXPECT_EQ(map.aggregate(2, 5), "BD");
+  EXPECT_EQ(map.at(5), "e");
+  EXPECT_THROW(map.at(3), std::out_of_range);
+  EXPECT_TRUE(map.validate());
+}
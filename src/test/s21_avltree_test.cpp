@@ -1,5 +1,17 @@
+#include <atomic>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
 #include "test_entry.h"
 
+namespace {
+/// дерево без дубликатов
+using UniqueTree =
+    s21::AvlTree<int, int, s21::Identity<int>, std::less<int>, true>;
+}  // namespace
+
 TEST(AvlTree, test_default_constructor) {
   s21::AvlTree<int> avl_tree;
   EXPECT_TRUE(avl_tree.IsEmpty());
@@ -13,7 +25,7 @@ TEST(AvlTree, test_constructor_with_initial_value) {
 }
 
 TEST(AvlTree, test_constructor_with_initial_value_unique_tree) {
-  s21::AvlTree<int> avl_tree(5, true);
+  UniqueTree avl_tree(5);
   EXPECT_FALSE(avl_tree.IsEmpty());
   EXPECT_TRUE(avl_tree.IsUnique());
   EXPECT_EQ(avl_tree.Top(), 5);
@@ -43,7 +55,7 @@ TEST(AvlTree, test_multiple_elements_in_top) {
 }
 
 TEST(AvlTree, test_multiple_elements_in_top_unique_tree) {
-  s21::AvlTree<int> avl_tree(5, true);
+  UniqueTree avl_tree(5);
   avl_tree.Insert(10);
   avl_tree.Insert(15);
   EXPECT_EQ(avl_tree.Top(), 10);
@@ -57,7 +69,7 @@ TEST(AvlTree, test_duplicate_elements_in_top) {
 }
 
 TEST(AvlTree, test_duplicate_element_in_top_unique_tree) {
-  s21::AvlTree<int> avl_tree(5, true);
+  UniqueTree avl_tree(5);
   avl_tree.Insert(5);
   EXPECT_EQ(avl_tree.Top(), 5);
   EXPECT_TRUE(avl_tree.IsUnique());
@@ -116,7 +128,7 @@ TEST(AvlTree, test_include_tree_after_removal) {
 }
 
 TEST(AvlTree, test_include_unique_tree_after_removal) {
-  s21::AvlTree<int> avl_tree(5, true);
+  UniqueTree avl_tree(5);
   avl_tree.Insert(5);
   avl_tree.Remove(5);
   EXPECT_FALSE(avl_tree.Include(5));
@@ -166,7 +178,7 @@ TEST(AvlTree, test_remove_duplicate_elements) {
 }
 
 TEST(AvlTree, test_remove_duplicate_elements_unique_tree) {
-  s21::AvlTree<int> avl_tree(5, true);
+  UniqueTree avl_tree(5);
   avl_tree.Insert(10);
   avl_tree.Insert(10);
   avl_tree.Remove(10);
@@ -233,7 +245,7 @@ TEST(AvlTree, test_insert_duplicate_elements) {
 }
 
 TEST(AvlTree, test_insert_duplicate_elements_unique_tree) {
-  s21::AvlTree<int> avl_tree(5, true);
+  UniqueTree avl_tree(5);
   avl_tree.Insert(5);
   avl_tree.Insert(5);
   EXPECT_EQ(avl_tree.Count(5), 1);
@@ -272,7 +284,7 @@ TEST(AvlTreeTest, InsertEmptyTree) {
 }
 
 TEST(AvlTreeTest, InsertExistingValue) {
-  s21::AvlTree<int> tree(10, true);
+  UniqueTree tree(10);
   auto result = tree.Insert(10);
   EXPECT_FALSE(result.second);  // Insertion failed, value already exists
                                 // Add more assertions if needed
@@ -349,7 +361,7 @@ TEST(AvlTree, test_count_duplicate_elements) {
 }
 
 TEST(AvlTree, test_count_duplicate_elements_unique_tree) {
-  s21::AvlTree<int> avl_tree(5, true);
+  UniqueTree avl_tree(5);
   avl_tree.Insert(5);
   avl_tree.Insert(5);
   EXPECT_EQ(avl_tree.Count(5), 1);
@@ -513,7 +525,7 @@ TEST(AvlTreeIterationTest, DuplicateValues) {
 
 TEST(AvlTreeIterationTest, DuplicateValuesWithUniqueTree) {
   // Create an AVL tree with duplicate values
-  s21::AvlTree<int> tree(10, true);
+  UniqueTree tree(10);
   tree.Insert(10);
   tree.Insert(20);
   tree.Insert(10);
@@ -529,3 +541,688 @@ TEST(AvlTreeIterationTest, DuplicateValuesWithUniqueTree) {
     count++;
   }
 }
+
+namespace {
+/// тип, подсчитывающий свои копирования
+struct CopyCounter {
+  static int copies;
+  int value;
+  explicit CopyCounter(int v) : value(v) {}
+  CopyCounter(const CopyCounter &other) : value(other.value) { copies++; }
+  CopyCounter(CopyCounter &&other) noexcept : value(other.value) {}
+  CopyCounter &operator=(const CopyCounter &other) {
+    value = other.value;
+    copies++;
+    return *this;
+  }
+  bool operator<(const CopyCounter &other) const {
+    return value < other.value;
+  }
+  bool operator==(const CopyCounter &other) const {
+    return value == other.value;
+  }
+};
+int CopyCounter::copies = 0;
+}  // namespace
+
+TEST(AvlTree, test_insert_copies_value_once) {
+  s21::AvlTree<CopyCounter> tree;
+  for (int i = 0; i < 1000; ++i) tree.Insert(CopyCounter(i));
+  CopyCounter key(500);
+  CopyCounter::copies = 0;
+  tree.Insert(key);
+  EXPECT_EQ(CopyCounter::copies, 1);
+  CopyCounter::copies = 0;
+  EXPECT_TRUE(tree.Include(key));
+  tree.Find(key);
+  tree.Remove(key);
+  EXPECT_EQ(CopyCounter::copies, 0);
+}
+
+TEST(AvlTree, test_random_insert_remove_keeps_order) {
+  s21::AvlTree<int> tree;
+  std::multiset<int> orig;
+  unsigned seed = 42;
+  for (int i = 0; i < 5000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int value = static_cast<int>((seed >> 16) % 500);
+    if (seed & 1) {
+      tree.Remove(value);
+      auto it = orig.find(value);
+      if (it != orig.end()) orig.erase(it);
+    } else {
+      tree.Insert(value);
+      orig.insert(value);
+    }
+  }
+  EXPECT_EQ(tree.size(), orig.size());
+  auto it = orig.begin();
+  for (const auto &value : tree) {
+    EXPECT_EQ(value, *it);
+    ++it;
+  }
+  /// обратный обход проверяет корректность ссылок на родителей
+  auto rit = orig.rbegin();
+  auto tree_it = tree.end();
+  while (tree_it != tree.begin()) {
+    --tree_it;
+    EXPECT_EQ(*tree_it, *rit);
+    ++rit;
+  }
+}
+
+TEST(AvlTree, test_copy_keeps_parent_links) {
+  s21::AvlTree<int> tree;
+  for (int i = 0; i < 100; ++i) tree.Insert(i);
+  s21::AvlTree<int> copy(tree);
+  int expected = 0;
+  for (const auto &value : copy) EXPECT_EQ(value, expected++);
+  EXPECT_EQ(expected, 100);
+  copy.Insert(100);
+  copy.Remove(0);
+  EXPECT_EQ(*copy.begin(), 1);
+}
+
+TEST(AvlTree, test_clear_and_reuse) {
+  s21::AvlTree<std::string> tree;
+  for (int i = 0; i < 1000; ++i) tree.Insert(std::to_string(i));
+  tree.Clear();
+  EXPECT_TRUE(tree.IsEmpty());
+  EXPECT_EQ(tree.size(), (size_t)0);
+  for (int i = 0; i < 100; ++i) tree.Insert(std::to_string(i));
+  EXPECT_EQ(tree.size(), (size_t)100);
+  EXPECT_TRUE(tree.Include("42"));
+}
+
+TEST(AvlTree, test_pool_reuses_erased_nodes) {
+  s21::AvlTree<int> tree;
+  for (int i = 0; i < 100; ++i) tree.Insert(i);
+  auto first = tree.Find(0);
+  const int *address = &*first;
+  tree.Remove(0);
+  auto inserted = tree.Insert(1000);
+  EXPECT_EQ(&*inserted.first, address);
+}
+
+TEST(AvlTree, test_move_constructor_moves_nodes) {
+  s21::AvlTree<std::string> tree;
+  for (int i = 0; i < 100; ++i) tree.Insert(std::to_string(i));
+  const std::string *address = &*tree.Find("50");
+  s21::AvlTree<std::string> moved(std::move(tree));
+  EXPECT_TRUE(tree.IsEmpty());
+  EXPECT_EQ(&*moved.Find("50"), address);
+  EXPECT_EQ(moved.size(), (size_t)100);
+}
+
+TEST(AvlTree, test_select_and_rank_after_random_updates) {
+  s21::AvlTree<int> tree;
+  std::multiset<int> orig;
+  unsigned seed = 7;
+  for (int i = 0; i < 3000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int value = static_cast<int>((seed >> 16) % 300);
+    if (seed & 2) {
+      tree.Remove(value);
+      auto it = orig.find(value);
+      if (it != orig.end()) orig.erase(it);
+    } else {
+      tree.Insert(value);
+      orig.insert(value);
+    }
+  }
+  size_t k = 0;
+  for (auto it = orig.begin(); it != orig.end(); ++it, ++k) {
+    EXPECT_EQ(*tree.Select(k), *it);
+  }
+  for (int value = 0; value < 300; value += 13) {
+    EXPECT_EQ(tree.Rank(value),
+              (size_t)std::distance(orig.begin(), orig.lower_bound(value)));
+    EXPECT_EQ(tree.Count(value), (int)orig.count(value));
+  }
+}
+
+TEST(AvlTree, test_assign_sorted_builds_balanced_tree) {
+  std::vector<int> values;
+  for (int i = 0; i < 1023; ++i) values.push_back(i);
+  s21::AvlTree<int> tree;
+  tree.Insert(-1);
+  tree.AssignSorted(values.begin(), values.end());
+  EXPECT_EQ(tree.size(), (size_t)1023);
+  EXPECT_EQ(tree.Top(), 511);
+  EXPECT_FALSE(tree.Include(-1));
+  EXPECT_EQ(*tree.Select(100), 100);
+  /// дерево остается рабочим после вставок и удалений
+  for (int i = 0; i < 1023; i += 2) tree.Remove(i);
+  tree.Insert(2000);
+  int expected = 1;
+  for (auto it = tree.begin(); *it != 2000; ++it, expected += 2) {
+    EXPECT_EQ(*it, expected);
+  }
+  EXPECT_EQ(tree.size(), (size_t)512);
+}
+
+TEST(AvlTree, test_assign_unsorted_unique_tree) {
+  std::vector<int> values = {5, 3, 9, 3, 1, 5, 7};
+  UniqueTree tree(0);
+  tree.Assign(values.begin(), values.end());
+  std::vector<int> result(tree.begin(), tree.end());
+  EXPECT_EQ(result, std::vector<int>({1, 3, 5, 7, 9}));
+}
+
+TEST(AvlTree, test_split_and_join) {
+  s21::AvlTree<int> tree;
+  for (int i = 0; i < 1000; ++i) tree.Insert((i * 7) % 1000);
+  s21::AvlTree<int> right = tree.Split(400);
+  EXPECT_TRUE(tree.Validate());
+  EXPECT_TRUE(right.Validate());
+  EXPECT_EQ(tree.size(), (size_t)400);
+  EXPECT_EQ(right.size(), (size_t)600);
+  EXPECT_EQ(*right.begin(), 400);
+  tree.Join(std::move(right));
+  EXPECT_TRUE(tree.Validate());
+  EXPECT_TRUE(right.IsEmpty());
+  EXPECT_EQ(tree.size(), (size_t)1000);
+  EXPECT_EQ(*tree.Select(999), 999);
+}
+
+TEST(AvlTree, test_consumed_operands_are_reusable_on_other_threads) {
+  s21::AvlTree<int> tree;
+  s21::AvlTree<int> other;
+  s21::AvlTree<int> right;
+  for (int i = 0; i < 3000; ++i) {
+    tree.Insert(i * 2);
+    other.Insert(i * 3);
+    right.Insert(10000 + i);
+  }
+  tree.Union(std::move(other));
+  tree.Join(std::move(right));
+  EXPECT_TRUE(other.IsEmpty());
+  EXPECT_TRUE(right.IsEmpty());
+  /// поглощенные деревья больше не делят память с tree
+  auto churn = [](s21::AvlTree<int> &target, int base) {
+    for (int round = 0; round < 10; ++round) {
+      for (int i = 0; i < 1000; ++i) target.Insert(base + i);
+      for (int i = 0; i < 1000; ++i) target.Remove(base + i);
+    }
+  };
+  std::thread worker1([&] { churn(tree, 50000); });
+  std::thread worker2([&] {
+    churn(other, 0);
+    churn(right, 0);
+  });
+  worker1.join();
+  worker2.join();
+  EXPECT_TRUE(tree.Validate());
+  EXPECT_EQ(tree.size(), (size_t)(3000 + 3000 - 1000 + 3000));
+  EXPECT_TRUE(other.IsEmpty());
+}
+
+TEST(AvlTree, test_split_outlives_source) {
+  s21::AvlTree<std::string> right;
+  {
+    s21::AvlTree<std::string> tree;
+    for (int i = 0; i < 100; ++i) tree.Insert(std::to_string(i + 100));
+    right = tree.Split("150");
+  }
+  EXPECT_EQ(right.size(), (size_t)50);
+  EXPECT_EQ(*right.begin(), "150");
+  right.Insert("999");
+  EXPECT_TRUE(right.Validate());
+}
+
+TEST(AvlTree, test_extract_rank_and_range) {
+  s21::AvlTree<int> tree;
+  for (int i = 0; i < 1000; ++i) tree.Insert((i * 7) % 1000);
+  for (size_t i = 0; i <= 1000; i += 97) {
+    EXPECT_EQ(tree.IndexOf(tree.Select(i)), i);
+  }
+  s21::AvlTree<int> middle = tree.ExtractRank(100, 350);
+  EXPECT_TRUE(tree.Validate());
+  EXPECT_TRUE(middle.Validate());
+  EXPECT_EQ(tree.size(), (size_t)750);
+  EXPECT_EQ(middle.size(), (size_t)250);
+  EXPECT_EQ(*middle.begin(), 100);
+  EXPECT_EQ(*tree.Select(100), 350);
+  /// полуинтервал по ключам захватывает и уже пустой участок
+  s21::AvlTree<int> range = tree.ExtractRange(300, 500);
+  EXPECT_TRUE(tree.Validate());
+  EXPECT_TRUE(range.Validate());
+  EXPECT_EQ(range.size(), (size_t)150);
+  EXPECT_EQ(*range.begin(), 350);
+  EXPECT_EQ(*tree.LowerBound(300), 500);
+  EXPECT_TRUE(tree.ExtractRange(600, 600).IsEmpty());
+  EXPECT_TRUE(tree.ExtractRank(5, 2).IsEmpty());
+  EXPECT_EQ(tree.ExtractRank(590, 5000).size(), (size_t)10);
+  EXPECT_EQ(tree.size(), (size_t)590);
+}
+
+TEST(AvlTree, test_erase_rank_and_range_reuse_own_nodes) {
+  s21::AvlTree<std::string> tree;
+  for (int i = 0; i < 100; ++i) tree.Insert(std::to_string(1000 + i));
+  std::set<const std::string *> erased;
+  for (auto it = tree.LowerBound("1010"); it != tree.LowerBound("1020"); ++it) {
+    erased.insert(&*it);
+  }
+  EXPECT_EQ(tree.EraseRange("1020", "1020"), (size_t)0);
+  EXPECT_EQ(tree.EraseRank(7, 7), (size_t)0);
+  EXPECT_EQ(tree.EraseRange("1010", "1020"), (size_t)10);
+  /// узлы вернулись в пул дерева и берутся следующей вставкой
+  EXPECT_EQ(erased.count(&*tree.Insert("x").first), 1U);
+  EXPECT_EQ(tree.EraseRank(0, 5), (size_t)5);
+  EXPECT_EQ(tree.EraseRank(80, 500), (size_t)6);
+  EXPECT_TRUE(tree.Validate());
+  EXPECT_EQ(tree.size(), (size_t)80);
+  EXPECT_EQ(*tree.begin(), "1005");
+  EXPECT_EQ(*tree.LowerBound("1010"), "1020");
+}
+
+TEST(AvlTree, test_set_operations_match_std) {
+  s21::ThreadPool pool(3);
+  unsigned seed = 5;
+  std::multiset<int> first;
+  std::multiset<int> second;
+  s21::AvlTree<int> first_tree;
+  s21::AvlTree<int> second_tree;
+  for (int i = 0; i < 40000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int value = static_cast<int>((seed >> 16) % 20000);
+    if (i % 3) {
+      first.insert(value);
+      first_tree.Insert(value);
+    } else {
+      second.insert(value);
+      second_tree.Insert(value);
+    }
+  }
+  auto check = [&](void (s21::AvlTree<int>::*op)(s21::AvlTree<int> &&,
+                                                 s21::ThreadPool &),
+                   std::vector<int> expected) {
+    s21::AvlTree<int> a(first_tree);
+    s21::AvlTree<int> b(second_tree);
+    (a.*op)(std::move(b), pool);
+    EXPECT_TRUE(a.Validate());
+    EXPECT_TRUE(b.IsEmpty());
+    EXPECT_EQ(std::vector<int>(a.begin(), a.end()), expected);
+  };
+  std::vector<int> expected;
+  std::set_union(first.begin(), first.end(), second.begin(), second.end(),
+                 std::back_inserter(expected));
+  check(&s21::AvlTree<int>::Union, expected);
+  expected.clear();
+  std::merge(first.begin(), first.end(), second.begin(), second.end(),
+             std::back_inserter(expected));
+  check(&s21::AvlTree<int>::Merge, expected);
+  expected.clear();
+  std::set_intersection(first.begin(), first.end(), second.begin(),
+                        second.end(), std::back_inserter(expected));
+  check(&s21::AvlTree<int>::Intersect, expected);
+  expected.clear();
+  std::set_difference(first.begin(), first.end(), second.begin(),
+                      second.end(), std::back_inserter(expected));
+  check(&s21::AvlTree<int>::Subtract, expected);
+}
+
+TEST(AvlTree, test_bounds_match_std) {
+  std::multiset<int> orig;
+  s21::AvlTree<int> tree;
+  unsigned seed = 11;
+  for (int i = 0; i < 2000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int value = static_cast<int>((seed >> 16) % 500) * 2;
+    orig.insert(value);
+    tree.Insert(value);
+  }
+  for (int value = -3; value < 1005; ++value) {
+    auto lower = tree.LowerBound(value);
+    auto upper = tree.UpperBound(value);
+    auto orig_lower = orig.lower_bound(value);
+    auto orig_upper = orig.upper_bound(value);
+    if (orig_lower == orig.end()) {
+      EXPECT_EQ(lower, tree.end());
+    } else {
+      EXPECT_EQ(*lower, *orig_lower);
+    }
+    if (orig_upper == orig.end()) {
+      EXPECT_EQ(upper, tree.end());
+    } else {
+      EXPECT_EQ(*upper, *orig_upper);
+    }
+    EXPECT_EQ((size_t)std::distance(lower, upper), orig.count(value));
+    if (orig_lower != orig.begin()) {
+      EXPECT_EQ(*--lower, *--orig_lower);
+    }
+  }
+}
+
+TEST(AvlTree, test_header_tracks_extremes) {
+  EXPECT_EQ(sizeof(s21::AvlTree<int>::iterator), sizeof(void *));
+  s21::AvlTree<int> tree;
+  EXPECT_EQ(--tree.end(), tree.end());
+  std::multiset<int> orig;
+  unsigned seed = 3;
+  for (int i = 0; i < 3000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int value = static_cast<int>((seed >> 16) % 300);
+    if (seed & 1 && !orig.empty()) {
+      /// чаще всего удаляются крайние элементы
+      int extreme = (seed & 2) ? *orig.begin() : *orig.rbegin();
+      tree.Remove(extreme);
+      orig.erase(orig.find(extreme));
+    } else {
+      tree.Insert(value);
+      orig.insert(value);
+    }
+    ASSERT_TRUE(tree.Validate());
+    if (orig.empty()) {
+      EXPECT_EQ(tree.begin(), tree.end());
+    } else {
+      EXPECT_EQ(*tree.begin(), *orig.begin());
+      EXPECT_EQ(*--tree.end(), *orig.rbegin());
+    }
+  }
+  s21::AvlTree<int> moved(std::move(tree));
+  EXPECT_TRUE(moved.Validate());
+  EXPECT_TRUE(tree.Validate());
+  EXPECT_EQ(tree.begin(), tree.end());
+  EXPECT_EQ((size_t)std::distance(moved.begin(), moved.end()), orig.size());
+  EXPECT_THROW(*moved.end(), std::runtime_error);
+}
+
+TEST(AvlTree, test_policies_are_compile_time) {
+  static_assert(UniqueTree::IsUnique());
+  static_assert(!s21::AvlTree<int>::IsUnique());
+  using Descending =
+      s21::AvlTree<int, int, s21::Identity<int>, std::greater<int>, true>;
+  Descending tree;
+  for (int value : {4, 8, 1, 8, 6, 1}) tree.Insert(value);
+  std::vector<int> result(tree.begin(), tree.end());
+  EXPECT_EQ(result, std::vector<int>({8, 6, 4, 1}));
+  EXPECT_EQ(*tree.LowerBound(5), 4);
+  EXPECT_EQ(tree.Rank(6), 1u);
+  EXPECT_TRUE(tree.Validate());
+}
+
+TEST(AvlTree, test_key_of_value_orders_by_key_only) {
+  /// второй элемент пары не сравнивается и не обязан иметь operator<
+  struct Payload {
+    int data;
+  };
+  using Entry = std::pair<const int, Payload>;
+  using Tree =
+      s21::AvlTree<int, Entry, s21::SelectFirst<Entry>, std::less<int>, true>;
+  Tree tree;
+  EXPECT_TRUE(tree.Insert(Entry(2, Payload{20})).second);
+  EXPECT_TRUE(tree.Insert(Entry(1, Payload{10})).second);
+  auto repeated = tree.Insert(Entry(2, Payload{99}));
+  EXPECT_FALSE(repeated.second);
+  EXPECT_EQ((*repeated.first).second.data, 20);
+  EXPECT_EQ((*tree.Find(1)).second.data, 10);
+  EXPECT_EQ(tree.Count(2), 1);
+  tree.Remove(1);
+  EXPECT_FALSE(tree.Include(1));
+  EXPECT_TRUE(tree.Validate());
+}
+
+TEST(AvlTree, test_emplace_constructs_in_place) {
+  using Entry = std::pair<const int, std::unique_ptr<int>>;
+  using Tree =
+      s21::AvlTree<int, Entry, s21::SelectFirst<Entry>, std::less<int>, true>;
+  Tree tree;
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(tree.Emplace((i * 37) % 100, new int(i)).second);
+  }
+  auto repeated = tree.Emplace(37, nullptr);
+  EXPECT_FALSE(repeated.second);
+  EXPECT_EQ(*(*repeated.first).second, 1);
+  EXPECT_EQ(tree.size(), 100U);
+  EXPECT_TRUE(tree.Validate());
+}
+
+TEST(AvlTree, test_hinted_insert_ascending_and_descending) {
+  UniqueTree tree;
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(*tree.Insert(tree.end(), i), i);
+  }
+  for (int i = -1; i >= -1000; --i) {
+    EXPECT_EQ(*tree.Insert(tree.begin(), i), i);
+  }
+  /// повтор ключа возвращает существующий элемент
+  auto repeated = tree.Insert(tree.Find(5), 5);
+  EXPECT_EQ(repeated, tree.Find(5));
+  EXPECT_EQ(tree.size(), 2000U);
+  EXPECT_TRUE(tree.Validate());
+  int expected = -1000;
+  for (int value : tree) EXPECT_EQ(value, expected++);
+}
+
+/// сравнение int, считающее свои вызовы
+struct CountingLess {
+  static inline std::size_t calls = 0;
+  bool operator()(int a, int b) const {
+    ++calls;
+    return a < b;
+  }
+};
+
+TEST(AvlTree, test_hinted_insert_costs_constant_comparisons) {
+  s21::AvlTree<int, int, s21::Identity<int>, CountingLess, true> tree;
+  const std::size_t n = 1 << 14;
+  CountingLess::calls = 0;
+  for (int i = 0; i < static_cast<int>(n); ++i) tree.Insert(tree.end(), i);
+  /// верная подсказка: не больше двух сравнений на вставку, без спуска
+  EXPECT_LE(CountingLess::calls, 2 * n);
+  CountingLess::calls = 0;
+  for (int i = -1; i >= -static_cast<int>(n); --i) tree.Insert(i);
+  /// без подсказки спуск от корня стоит порядка log n сравнений
+  EXPECT_GT(CountingLess::calls, 10 * n);
+  EXPECT_TRUE(tree.Validate());
+}
+
+TEST(AvlTree, test_hinted_insert_matches_std_for_any_hint) {
+  std::multiset<int> orig;
+  s21::AvlTree<int> multi;
+  UniqueTree unique;
+  unsigned seed = 5;
+  for (int i = 0; i < 3000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int value = static_cast<int>((seed >> 16) % 700);
+    /// подсказка бывает верной, соседней или произвольной
+    auto hint = multi.LowerBound(value + static_cast<int>(seed % 3) - 1);
+    auto inserted = multi.Insert(hint, value);
+    EXPECT_EQ(*inserted, value);
+    auto unique_hint = unique.LowerBound(value + static_cast<int>(seed % 5));
+    EXPECT_EQ(*unique.EmplaceHint(unique_hint, value), value);
+    orig.insert(value);
+  }
+  EXPECT_TRUE(multi.Validate());
+  EXPECT_TRUE(unique.Validate());
+  EXPECT_TRUE(std::equal(orig.begin(), orig.end(), multi.begin(), multi.end()));
+  std::set<int> orig_unique(orig.begin(), orig.end());
+  EXPECT_TRUE(std::equal(orig_unique.begin(), orig_unique.end(),
+                         unique.begin(), unique.end()));
+}
+
+TEST(AvlTree, test_hinted_insert_keeps_equal_keys_before_hint) {
+  using Entry = std::pair<int, int>;
+  s21::AvlTree<int, Entry, s21::SelectFirst<Entry>> tree;
+  tree.Insert({1, 0});
+  auto last = tree.Insert({1, 1}).first;
+  tree.Insert({2, 0});
+  /// равный ключ встает непосредственно перед подсказкой
+  auto inserted = tree.Insert(last, {1, 2});
+  EXPECT_EQ((*++inserted).second, 1);
+  std::vector<int> order;
+  for (const auto &value : tree) order.push_back(value.second);
+  EXPECT_EQ(order, (std::vector<int>{0, 2, 1, 0}));
+  EXPECT_TRUE(tree.Validate());
+}
+
+TEST(AvlTree, test_extract_and_insert_node_keep_address) {
+  UniqueTree source;
+  UniqueTree target;
+  for (int i = 0; i < 100; ++i) source.Insert(i);
+  const int *address = &*source.Find(42);
+  auto handle = source.Extract(source.Find(42));
+  EXPECT_FALSE(handle.empty());
+  EXPECT_EQ(&handle.value(), address);
+  EXPECT_EQ(source.size(), 99U);
+  EXPECT_FALSE(source.Include(42));
+  auto inserted = target.Insert(std::move(handle));
+  EXPECT_TRUE(inserted.second);
+  EXPECT_TRUE(handle.empty());
+  EXPECT_EQ(&*inserted.first, address);
+  /// повтор ключа оставляет узел в дескрипторе
+  auto again = source.Extract(43);
+  target.Insert(43);
+  EXPECT_FALSE(target.Insert(std::move(again)).second);
+  EXPECT_EQ(again.value(), 43);
+  EXPECT_TRUE(source.Extract(1000).empty());
+  EXPECT_TRUE(source.Validate());
+  EXPECT_TRUE(target.Validate());
+}
+
+TEST(AvlTree, test_extracted_node_outlives_source) {
+  using Tree = s21::AvlTree<std::string>;
+  Tree::NodeHandle handle;
+  {
+    Tree source;
+    for (int i = 0; i < 50; ++i) source.Insert(std::to_string(i));
+    handle = source.Extract(source.Find(std::string("7")));
+  }
+  EXPECT_EQ(handle.value(), "7");
+  handle.value() = "x";
+  Tree target;
+  target.Insert(std::move(handle));
+  EXPECT_TRUE(target.Include(std::string("x")));
+}
+
+TEST(AvlTree, test_absorb_and_swap) {
+  UniqueTree left;
+  UniqueTree right;
+  for (int i = 0; i < 200; i += 2) left.Insert(i);
+  for (int i = 0; i < 300; i += 3) right.Insert(i);
+  const int *address = &*right.Find(3);
+  left.Absorb(right);
+  /// в right остаются только ключи, которые уже были в left
+  EXPECT_EQ(&*left.Find(3), address);
+  for (int value : right) EXPECT_TRUE(value % 6 == 0 && value < 200);
+  EXPECT_EQ(left.size() + right.size(), 200U);
+  EXPECT_TRUE(left.Validate());
+  EXPECT_TRUE(right.Validate());
+  auto max = left.Find(297);
+  left.Swap(right);
+  EXPECT_EQ(*max, 297);
+  EXPECT_TRUE(right.Include(297));
+  EXPECT_FALSE(left.Include(297));
+  EXPECT_TRUE(left.Validate());
+  EXPECT_TRUE(right.Validate());
+}
+
+TEST(AvlTree, test_absorb_matches_std_merge) {
+  /// оба размера выше порога параллельного выполнения
+  UniqueTree left;
+  UniqueTree right;
+  std::set<int> expected_left;
+  std::set<int> expected_right;
+  unsigned seed = 17;
+  for (int i = 0; i < 60000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int value = static_cast<int>((seed >> 16) % 50000);
+    if (i % 2) {
+      left.Insert(value);
+      expected_left.insert(value);
+    } else {
+      right.Insert(value);
+      expected_right.insert(value);
+    }
+  }
+  std::vector<const int *> addresses;
+  for (const int &value : right) addresses.push_back(&value);
+  left.Absorb(right);
+  expected_left.merge(expected_right);
+  EXPECT_TRUE(left.Validate());
+  EXPECT_TRUE(right.Validate());
+  EXPECT_TRUE(std::equal(left.begin(), left.end(), expected_left.begin(),
+                         expected_left.end()));
+  EXPECT_TRUE(std::equal(right.begin(), right.end(), expected_right.begin(),
+                         expected_right.end()));
+  /// узлы не копируются: каждый адрес остался в одном из деревьев
+  size_t found = 0;
+  for (const int *address : addresses) {
+    auto in_left = left.Find(*address);
+    auto in_right = right.Find(*address);
+    found += &*in_left == address ||
+             (in_right != right.end() && &*in_right == address);
+  }
+  EXPECT_EQ(found, addresses.size());
+  right.Insert(-1);
+  left.Absorb(right);
+  EXPECT_TRUE(left.Include(-1));
+  EXPECT_EQ(right.size(), expected_right.size());
+}
+
+TEST(AvlTree, test_clone_is_contiguous_in_order) {
+  s21::AvlTree<int> tree;
+  unsigned seed = 3;
+  for (int i = 0; i < 100000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    tree.Insert(static_cast<int>((seed >> 8) % 50000));
+  }
+  s21::ThreadPool pool(3);
+  s21::AvlTree<int> copy = tree.Clone(pool);
+  EXPECT_TRUE(copy.Validate());
+  EXPECT_EQ(copy.size(), tree.size());
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), copy.begin(), copy.end()));
+  /// соседние по порядку элементы лежат в памяти подряд
+  const int *prev = nullptr;
+  std::ptrdiff_t step = 0;
+  bool contiguous = true;
+  for (const int &value : copy) {
+    if (prev) {
+      std::ptrdiff_t diff = reinterpret_cast<const char *>(&value) -
+                            reinterpret_cast<const char *>(prev);
+      if (step == 0) step = diff;
+      contiguous = contiguous && diff == step && step > 0;
+    }
+    prev = &value;
+  }
+  EXPECT_TRUE(contiguous);
+  /// ссылки на родителей верны: обход в обратную сторону
+  auto it = copy.end();
+  auto orig = tree.end();
+  for (size_t i = 0; i < copy.size(); ++i) EXPECT_EQ(*--it, *--orig);
+  EXPECT_EQ(it, copy.begin());
+}
+
+namespace {
+/// Значение, копирование которого падает после заданного числа копий
+struct FragileCopy {
+  /// копии создаются из нескольких потоков
+  static std::atomic<int> live;
+  static std::atomic<int> copies_left;
+  int data;
+  explicit FragileCopy(int d) : data(d) { ++live; }
+  FragileCopy(const FragileCopy &other) : data(other.data) {
+    if (copies_left-- == 0) throw std::runtime_error("copy failed");
+    ++live;
+  }
+  ~FragileCopy() { --live; }
+  bool operator<(const FragileCopy &other) const { return data < other.data; }
+};
+std::atomic<int> FragileCopy::live{0};
+std::atomic<int> FragileCopy::copies_left{0};
+}  // namespace
+
+TEST(AvlTree, test_clone_failure_destroys_partial_copy) {
+  s21::AvlTree<FragileCopy> tree;
+  for (int i = 0; i < 40000; ++i) tree.Emplace(i);
+  int live = FragileCopy::live;
+  s21::ThreadPool pool(2);
+  FragileCopy::copies_left = 30000;
+  EXPECT_THROW(tree.Clone(pool), std::runtime_error);
+  EXPECT_EQ(FragileCopy::live, live);
+  FragileCopy::copies_left = 1 << 30;
+  s21::AvlTree<FragileCopy> copy = tree.Clone(pool);
+  EXPECT_EQ(FragileCopy::live, 2 * live);
+  EXPECT_TRUE(copy.Validate());
+}
@@ -0,0 +1,267 @@
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "test_entry.h"
+
+namespace {
+/// узлы по три значения: деления и слияния на каждом шаге
+using SmallTree =
+    s21::BTree<int, int, s21::Identity<int>, std::less<int>, true, 16>;
+using SmallMultiTree =
+    s21::BTree<int, int, s21::Identity<int>, std::less<int>, false, 16>;
+
+/// сравнение поиска в узле с std::lower_bound / std::upper_bound
+template <typename T>
+void CheckSimdSearch(std::vector<T> keys) {
+  std::sort(keys.begin(), keys.end());
+  for (std::size_t count = 0; count <= keys.size(); ++count) {
+    for (T key : keys) {
+      for (T probe : {key, static_cast<T>(key - 1), static_cast<T>(key + 1)}) {
+        auto lower = std::lower_bound(keys.begin(), keys.begin() + count,
+                                      probe) -
+                     keys.begin();
+        auto upper = std::upper_bound(keys.begin(), keys.begin() + count,
+                                      probe) -
+                     keys.begin();
+        ASSERT_EQ(s21::btree_simd::CountLess(keys.data(),
+                                             static_cast<int>(count), probe),
+                  lower);
+        ASSERT_EQ(s21::btree_simd::CountNotGreater(
+                      keys.data(), static_cast<int>(count), probe),
+                  upper);
+      }
+    }
+  }
+}
+}  // namespace
+
+TEST(BTree, test_random_insert_erase_matches_std_set) {
+  SmallTree tree;
+  std::set<int> expected;
+  std::mt19937 gen(7);
+  for (int step = 0; step < 20000; ++step) {
+    int key = static_cast<int>(gen() % 2000);
+    if (gen() % 3) {
+      auto res = tree.Insert(key);
+      EXPECT_EQ(res.second, expected.insert(key).second);
+      EXPECT_EQ(*res.first, key);
+    } else {
+      auto it = tree.Find(key);
+      EXPECT_EQ(it != tree.end(), expected.erase(key) == 1);
+      if (it != tree.end()) tree.Erase(it);
+    }
+    if (step % 500 == 0) {
+      ASSERT_TRUE(tree.Validate());
+    }
+  }
+  ASSERT_TRUE(tree.Validate());
+  EXPECT_EQ(tree.size(), expected.size());
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(),
+                         expected.end()));
+  while (!tree.IsEmpty()) tree.Erase(tree.begin());
+  EXPECT_TRUE(tree.Validate());
+  EXPECT_EQ(tree.begin(), tree.end());
+}
+
+TEST(BTree, test_multi_tree_keeps_duplicates_in_order) {
+  SmallMultiTree tree;
+  std::multiset<int> expected;
+  std::mt19937 gen(11);
+  for (int step = 0; step < 5000; ++step) {
+    int key = static_cast<int>(gen() % 50);
+    if (gen() % 4) {
+      tree.Insert(key);
+      expected.insert(key);
+    } else if (expected.count(key)) {
+      tree.Erase(tree.Find(key));
+      expected.erase(expected.find(key));
+    }
+  }
+  ASSERT_TRUE(tree.Validate());
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(),
+                         expected.end()));
+  for (int key = -1; key <= 50; ++key) {
+    EXPECT_EQ(tree.Count(key), expected.count(key));
+    EXPECT_EQ(std::distance(tree.begin(), tree.LowerBound(key)),
+              std::distance(expected.begin(), expected.lower_bound(key)));
+    EXPECT_EQ(std::distance(tree.begin(), tree.UpperBound(key)),
+              std::distance(expected.begin(), expected.upper_bound(key)));
+  }
+}
+
+TEST(BTree, test_reverse_iteration) {
+  SmallTree tree;
+  for (int i = 0; i < 1000; ++i) tree.Insert((i * 37) % 1000);
+  int expected = 999;
+  auto it = tree.end();
+  while (it != tree.begin()) {
+    --it;
+    EXPECT_EQ(*it, expected--);
+  }
+  EXPECT_EQ(expected, -1);
+}
+
+TEST(BTree, test_hinted_insert) {
+  SmallMultiTree tree;
+  for (int i = 0; i < 1000; ++i) tree.Insert(tree.end(), i / 3);
+  /// подсказка в середине и неверная подсказка
+  tree.Insert(tree.Find(100), 100);
+  tree.Insert(tree.begin(), 500);
+  ASSERT_TRUE(tree.Validate());
+  EXPECT_EQ(tree.size(), 1002u);
+  EXPECT_EQ(tree.Count(100), 4u);
+  EXPECT_EQ(tree.Count(500), 1u);
+}
+
+TEST(BTree, test_copy_is_independent) {
+  SmallTree tree;
+  for (int i = 0; i < 500; ++i) tree.Insert(i);
+  SmallTree copy(tree);
+  tree.Erase(tree.Find(10));
+  EXPECT_TRUE(copy.Validate());
+  EXPECT_EQ(copy.size(), 500u);
+  EXPECT_TRUE(copy.Include(10));
+  EXPECT_FALSE(tree.Include(10));
+  copy = tree;
+  EXPECT_EQ(copy.size(), 499u);
+}
+
+TEST(BTree, test_simd_search_signed_and_unsigned) {
+  CheckSimdSearch<int>({-7, -3, -3, 0, 1, 5, 5, 5, 9, 12, 40,
+                        std::numeric_limits<int>::min() + 1,
+                        std::numeric_limits<int>::max() - 1});
+  CheckSimdSearch<unsigned>({0u, 1u, 2u, 7u, 7u, 0x7fffffffu, 0x80000000u,
+                             0x80000001u, 0xfffffff0u});
+  CheckSimdSearch<long long>({-5000000000LL, -1LL, 0LL, 3LL, 3LL,
+                              4294967296LL, 4294967297LL, -4294967296LL,
+                              std::numeric_limits<long long>::min() + 1});
+  CheckSimdSearch<std::uint64_t>({0ull, 1ull, 0xffffffffull, 0x100000000ull,
+                                  0x8000000000000000ull,
+                                  0x8000000000000001ull, 42ull});
+}
+
+TEST(BTreeSet, test_interface) {
+  s21::btree_set<int> set = {5, 1, 3, 3, 9};
+  EXPECT_EQ(set.size(), 4u);
+  EXPECT_EQ(*set.begin(), 1);
+  EXPECT_FALSE(set.insert(3).second);
+  EXPECT_TRUE(set.insert(4).second);
+  EXPECT_TRUE(set.contains(4));
+  EXPECT_EQ(*set.lower_bound(6), 9);
+  EXPECT_EQ(*set.upper_bound(4), 5);
+  EXPECT_EQ(set.find(7), set.end());
+  EXPECT_EQ(set.count(9), 1u);
+  set.erase(set.find(1));
+  EXPECT_EQ(*set.begin(), 3);
+
+  s21::btree_set<int> moved(std::move(set));
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(moved.size(), 4u);
+  s21::btree_set<int> copy = moved;
+  copy.clear();
+  EXPECT_EQ(moved.size(), 4u);
+}
+
+TEST(BTreeSet, test_insert_many_returns_valid_iterators) {
+  s21::btree_set<int> set;
+  for (int i = 0; i < 200; ++i) set.insert(i * 2);
+  auto res = set.insert_many(1, 2, 3, 401, 5);
+  ASSERT_EQ(res.size(), 5u);
+  EXPECT_FALSE(res[1].second);
+  EXPECT_TRUE(res[3].second);
+  int expected[] = {1, 2, 3, 401, 5};
+  for (std::size_t i = 0; i < res.size(); ++i) {
+    EXPECT_EQ(*res[i].first, expected[i]);
+  }
+}
+
+TEST(BTreeSet, test_merge_keeps_duplicates_in_source) {
+  s21::btree_set<int> a = {1, 2, 3};
+  s21::btree_set<int> b = {3, 4, 5};
+  a.merge(b);
+  EXPECT_EQ(a.size(), 5u);
+  EXPECT_EQ(b.size(), 1u);
+  EXPECT_TRUE(b.contains(3));
+  a.swap(b);
+  EXPECT_EQ(a.size(), 1u);
+}
+
+TEST(BTreeSet, test_transparent_lookup) {
+  s21::btree_set<std::string, std::less<>> set;
+  for (int i = 0; i < 300; ++i) set.emplace("key_" + std::to_string(i));
+  EXPECT_TRUE(set.contains(std::string_view("key_42")));
+  EXPECT_EQ(*set.find("key_299"), "key_299");
+  EXPECT_EQ(set.count("key_300"), 0u);
+  EXPECT_EQ(*set.lower_bound(std::string_view("key_10")), "key_10");
+}
+
+TEST(BTreeMultiset, test_interface) {
+  s21::btree_multiset<long long> set = {3, 1, 3, -4, 3};
+  EXPECT_EQ(set.size(), 5u);
+  EXPECT_EQ(set.count(3), 3u);
+  auto range = set.equal_range(3);
+  EXPECT_EQ(std::distance(range.first, range.second), 3);
+  set.erase(set.find(3));
+  EXPECT_EQ(set.count(3), 2u);
+  EXPECT_EQ(*set.begin(), -4);
+  s21::btree_multiset<long long> other = {3, 7};
+  set.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(set.count(3), 3u);
+}
+
+TEST(BTreeMap, test_interface) {
+  s21::btree_map<int, std::string> map = {{2, "two"}, {1, "one"}};
+  map[3] = "three";
+  EXPECT_EQ(map.at(1), "one");
+  EXPECT_THROW(map.at(4), std::out_of_range);
+  EXPECT_FALSE(map.insert(2, "second").second);
+  EXPECT_FALSE(map.insert_or_assign(2, "TWO").second);
+  EXPECT_EQ(map[2], "TWO");
+  map.erase(map.find(1));
+  EXPECT_FALSE(map.contains(1));
+  std::string joined;
+  for (const auto &entry : map) joined += entry.second;
+  EXPECT_EQ(joined, "TWOthree");
+}
+
+TEST(BTreeMap, test_non_trivial_values_match_std_map) {
+  s21::btree_map<int, std::string> map;
+  std::map<int, std::string> expected;
+  std::mt19937 gen(3);
+  for (int step = 0; step < 20000; ++step) {
+    int key = static_cast<int>(gen() % 3000);
+    if (gen() % 3) {
+      std::string value(20 + key % 7, static_cast<char>('a' + key % 26));
+      map.insert_or_assign(key, value);
+      expected[key] = value;
+    } else if (expected.erase(key)) {
+      map.erase(map.find(key));
+    }
+  }
+  EXPECT_EQ(map.size(), expected.size());
+  EXPECT_TRUE(std::equal(map.begin(), map.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(BTreeMap, test_move_only_values) {
+  s21::btree_map<int, std::unique_ptr<int>> map;
+  for (int i = 0; i < 500; ++i) map.emplace(i, std::make_unique<int>(i));
+  for (int i = 0; i < 500; i += 2) map.erase(map.find(i));
+  EXPECT_EQ(map.size(), 250u);
+  for (const auto &entry : map) EXPECT_EQ(*entry.second, entry.first);
+}
+
+TEST(BTreeMap, test_memory_usage) {
+  s21::btree_map<int, int> map;
+  for (int i = 0; i < 100000; ++i) map.emplace_hint(map.end(), i, i);
+  /// у узла Avl дерева на пару приходятся три указателя, счетчики и высота
+  EXPECT_LT(map.memory_usage(), map.size() * 24);
+  EXPECT_GE(map.memory_usage(), map.size() * sizeof(std::pair<int, int>));
+}
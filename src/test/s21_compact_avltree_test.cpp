@@ -0,0 +1,211 @@
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+
+#include "test_entry.h"
+
+namespace {
+using CompactTree = s21::CompactAvlTree<int, int, s21::Identity<int>,
+                                        std::less<int>, true>;
+using CompactMultiTree = s21::CompactAvlTree<int, int, s21::Identity<int>,
+                                             std::less<int>, false>;
+}  // namespace
+
+TEST(CompactAvlTree, test_random_insert_erase_matches_std_set) {
+  CompactTree tree;
+  std::set<int> expected;
+  std::mt19937 gen(7);
+  for (int step = 0; step < 40000; ++step) {
+    int key = static_cast<int>(gen() % 3000);
+    if (gen() % 3) {
+      auto res = tree.Insert(key);
+      EXPECT_EQ(res.second, expected.insert(key).second);
+      EXPECT_EQ(*res.first, key);
+    } else {
+      auto it = tree.Find(key);
+      EXPECT_EQ(it != tree.end(), expected.erase(key) == 1);
+      if (it != tree.end()) {
+        auto next = tree.Erase(it);
+        auto want = expected.upper_bound(key);
+        if (want == expected.end()) {
+          EXPECT_EQ(next, tree.end());
+        } else {
+          EXPECT_EQ(*next, *want);
+        }
+      }
+    }
+    if (step % 500 == 0) {
+      ASSERT_TRUE(tree.Validate());
+    }
+  }
+  ASSERT_TRUE(tree.Validate());
+  EXPECT_EQ(tree.size(), expected.size());
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_TRUE(std::equal(std::make_reverse_iterator(tree.end()),
+                         std::make_reverse_iterator(tree.begin()),
+                         expected.rbegin(), expected.rend()));
+  while (!tree.IsEmpty()) tree.Erase(tree.begin());
+  EXPECT_TRUE(tree.Validate());
+  EXPECT_EQ(tree.begin(), tree.end());
+}
+
+TEST(CompactAvlTree, test_multi_tree_keeps_duplicates_in_order) {
+  s21::CompactAvlTree<int, std::pair<int, int>,
+                      s21::SelectFirst<std::pair<int, int>>, std::less<int>,
+                      false>
+      tree;
+  for (int i = 0; i < 3000; ++i) tree.Insert({i % 10, i});
+  ASSERT_TRUE(tree.Validate());
+  EXPECT_EQ(tree.Count(4), 300u);
+  int last = -1;
+  for (auto it = tree.LowerBound(4); it != tree.UpperBound(4); ++it) {
+    EXPECT_GT(it->second, last);
+    last = it->second;
+  }
+  CompactMultiTree multi;
+  for (int i = 0; i < 100; ++i) multi.Insert(i % 3);
+  for (auto it = multi.Find(1); it != multi.end() && *it == 1;) {
+    it = multi.Erase(it);
+  }
+  EXPECT_TRUE(multi.Validate());
+  EXPECT_EQ(multi.size(), 67u);
+  EXPECT_FALSE(multi.Include(1));
+}
+
+TEST(CompactAvlTree, test_iterators_survive_other_changes) {
+  CompactTree tree;
+  for (int i = 0; i < 1000; ++i) tree.Insert(i);
+  auto kept = tree.Find(500);
+  for (int i = 0; i < 1000; i += 2) {
+    if (i != 500) tree.Erase(tree.Find(i));
+  }
+  for (int i = 1000; i < 5000; ++i) tree.Insert(i);
+  EXPECT_EQ(*kept, 500);
+  EXPECT_EQ(*++kept, 501);
+  EXPECT_TRUE(tree.Validate());
+}
+
+TEST(CompactAvlTree, test_copy_reuses_layout_and_free_list) {
+  CompactTree tree;
+  for (int i = 0; i < 700; ++i) tree.Insert(i);
+  for (int i = 0; i < 700; i += 3) tree.Erase(tree.Find(i));
+  CompactTree copy(tree);
+  EXPECT_TRUE(copy.Validate());
+  EXPECT_EQ(copy.MemoryUsage(), tree.MemoryUsage());
+  tree.Erase(tree.Find(10));
+  EXPECT_TRUE(copy.Include(10));
+  EXPECT_FALSE(tree.Include(10));
+  /// освободившиеся узлы используются повторно
+  std::size_t memory = copy.MemoryUsage();
+  for (int i = 0; i < 700; i += 3) copy.Insert(i);
+  EXPECT_EQ(copy.MemoryUsage(), memory);
+  EXPECT_EQ(copy.size(), 700u);
+  EXPECT_TRUE(copy.Validate());
+  copy = tree;
+  EXPECT_EQ(copy.size(), tree.size());
+  CompactTree moved(std::move(copy));
+  EXPECT_TRUE(copy.IsEmpty());
+  EXPECT_TRUE(moved.Validate());
+}
+
+TEST(CompactAvlTree, test_chunk_boundaries) {
+  CompactTree tree;
+  /// блоки арены: 64, 64, 128, ..., 32768 узлов, затем по 65536
+  for (int i = 0; i < 200000; ++i) tree.Insert(i);
+  ASSERT_TRUE(tree.Validate());
+  int expected = 0;
+  for (int key : tree) EXPECT_EQ(key, expected++);
+  EXPECT_EQ(expected, 200000);
+  for (int key : {63, 64, 127, 128, 65535, 65536, 131071, 131072}) {
+    EXPECT_EQ(*tree.Find(key), key);
+  }
+}
+
+TEST(CompactSet, test_interface) {
+  s21::compact_set<int> set = {5, 1, 3, 3, 9};
+  EXPECT_EQ(set.size(), 4u);
+  EXPECT_EQ(*set.begin(), 1);
+  EXPECT_FALSE(set.insert(3).second);
+  EXPECT_TRUE(set.insert(4).second);
+  EXPECT_TRUE(set.contains(4));
+  EXPECT_EQ(*set.lower_bound(6), 9);
+  EXPECT_EQ(*set.upper_bound(4), 5);
+  EXPECT_EQ(set.find(7), set.end());
+  EXPECT_EQ(set.count(9), 1u);
+  EXPECT_EQ(*set.erase(set.find(1)), 3);
+  EXPECT_EQ(set.erase(9), 1u);
+  EXPECT_EQ(set.erase(9), 0u);
+  auto res = set.insert_many(2, 3, 8);
+  ASSERT_EQ(res.size(), 3u);
+  EXPECT_FALSE(res[1].second);
+  EXPECT_EQ(*res[2].first, 8);
+
+  s21::compact_set<int> moved(std::move(set));
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(moved.size(), 5u);
+  s21::compact_set<int> copy = moved;
+  copy.clear();
+  EXPECT_EQ(moved.size(), 5u);
+}
+
+TEST(CompactMap, test_interface) {
+  s21::compact_map<int, std::string> map = {{1, "one"}, {2, "two"}};
+  EXPECT_EQ(map.at(1), "one");
+  EXPECT_THROW(map.at(5), std::out_of_range);
+  map[3] = "three";
+  EXPECT_FALSE(map.insert(3, "drei").second);
+  EXPECT_FALSE(map.insert_or_assign(2, "TWO").second);
+  EXPECT_EQ(map.erase(1), 1u);
+  std::string joined;
+  for (const auto &entry : map) joined += entry.second;
+  EXPECT_EQ(joined, "TWOthree");
+  EXPECT_EQ(map.erase(map.find(2))->first, 3);
+  EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(CompactMap, test_non_trivial_values_match_std_map) {
+  s21::compact_map<int, std::string> map;
+  std::map<int, std::string> expected;
+  std::mt19937 gen(3);
+  for (int step = 0; step < 20000; ++step) {
+    int key = static_cast<int>(gen() % 3000);
+    if (gen() % 3) {
+      std::string value(20 + key % 7, static_cast<char>('a' + key % 26));
+      map.insert_or_assign(key, value);
+      expected[key] = value;
+    } else {
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+    }
+  }
+  EXPECT_EQ(map.size(), expected.size());
+  EXPECT_TRUE(std::equal(map.begin(), map.end(), expected.begin(),
+                         expected.end()));
+  s21::compact_map<int, std::string> copy(map);
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(CompactMap, test_move_only_values) {
+  s21::compact_map<int, std::unique_ptr<int>> map;
+  for (int i = 0; i < 500; ++i) map.emplace(i, std::make_unique<int>(i));
+  for (int i = 0; i < 500; i += 2) map.erase(map.find(i));
+  EXPECT_EQ(map.size(), 250u);
+  for (const auto &entry : map) EXPECT_EQ(*entry.second, entry.first);
+}
+
+TEST(CompactMap, test_memory_usage) {
+  s21::compact_set<int> set;
+  s21::compact_map<int, int> map;
+  for (int i = 0; i < 100000; ++i) {
+    set.insert(i);
+    map.insert(i, i);
+  }
+  /// узел int - 16 байт, узел пары int - 20 байт, блоки заполнены не
+  /// полностью
+  EXPECT_LT(set.memory_usage(), set.size() * 16 * 3 / 2);
+  EXPECT_LT(map.memory_usage(), map.size() * 20 * 3 / 2);
+  EXPECT_GE(set.memory_usage(), set.size() * 16);
+}
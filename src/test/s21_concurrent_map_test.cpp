@@ -0,0 +1,108 @@
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test_entry.h"
+
+TEST(ConcurrentMapTest, SingleThreadOperations) {
+  s21::concurrent_map<int, std::string, 4> map = {
+      {2, "two"}, {1, "one"}, {2, "dos"}};
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_EQ(map.find(2).value(), "two");
+  EXPECT_FALSE(map.find(3).has_value());
+  EXPECT_FALSE(map.insert(1, "uno"));
+  EXPECT_FALSE(map.insert_or_assign(1, "uno"));
+  EXPECT_TRUE(map.insert_or_assign(3, "three"));
+  EXPECT_EQ(map.find(1).value(), "uno");
+  EXPECT_TRUE(map.update(3, [](std::string &value) { value += "!"; }));
+  EXPECT_FALSE(map.update(4, [](std::string &value) { value.clear(); }));
+  EXPECT_EQ(map.find(3).value(), "three!");
+  EXPECT_EQ(map.erase(2), 1U);
+  EXPECT_EQ(map.erase(2), 0U);
+  EXPECT_FALSE(map.contains(2));
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
+
+namespace {
+/// считает копии значения
+struct Copies {
+  static int count;
+  int data = 0;
+  explicit Copies(int d) : data(d) {}
+  Copies(const Copies &other) : data(other.data) { ++count; }
+  Copies &operator=(const Copies &other) {
+    data = other.data;
+    ++count;
+    return *this;
+  }
+};
+int Copies::count = 0;
+}  // namespace
+
+TEST(ConcurrentMapTest, ExistingKeyCostsNoNode) {
+  s21::concurrent_map<int, Copies, 2> map;
+  Copies value(1);
+  EXPECT_TRUE(map.insert(1, value));
+  Copies::count = 0;
+  /// повтор ключа не создает узел с копией значения
+  EXPECT_FALSE(map.insert(1, Copies(2)));
+  EXPECT_EQ(Copies::count, 0);
+  EXPECT_FALSE(map.insert_or_assign(1, Copies(3)));
+  EXPECT_EQ(Copies::count, 1);
+  EXPECT_TRUE(map.update(1, [](Copies &stored) { EXPECT_EQ(stored.data, 3); }));
+  EXPECT_EQ(map.erase(1), 1U);
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(ConcurrentMapTest, ForEachMergesShardsInOrder) {
+  s21::concurrent_map<int, int, 7> map;
+  std::map<int, int> reference;
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> key(-5000, 5000);
+  for (int i = 0; i < 3000; ++i) {
+    int k = key(gen);
+    map.insert_or_assign(k, i);
+    reference[k] = i;
+  }
+  std::vector<std::pair<int, int>> items;
+  map.for_each([&](const std::pair<const int, int> &item) {
+    items.emplace_back(item.first, item.second);
+  });
+  std::vector<std::pair<int, int>> expected(reference.begin(),
+                                            reference.end());
+  EXPECT_EQ(items, expected);
+  s21::concurrent_map<int, int> empty;
+  empty.for_each([](const std::pair<const int, int> &) { FAIL(); });
+}
+
+TEST(ConcurrentMapTest, ConcurrentWritersAndReaders) {
+  s21::concurrent_map<int, int, 8> map;
+  const int kThreads = 4;
+  const int kKeys = 2000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&map, t] {
+      /// свои ключи у каждого потока и общие счетчики
+      for (int i = 0; i < kKeys; ++i) {
+        map.insert(t * kKeys + i, i);
+        map.insert(-1 - i % 10, 0);
+        map.update(-1 - i % 10, [](int &value) { ++value; });
+        if (i % 2) map.erase(t * kKeys + i - 1);
+        map.find(i);
+      }
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  EXPECT_EQ(map.size(), static_cast<std::size_t>(kThreads * kKeys / 2 + 10));
+  for (int i = 1; i <= 10; ++i) {
+    EXPECT_EQ(map.find(-i).value(), kThreads * kKeys / 10);
+  }
+  int previous = -11;
+  map.for_each([&](const std::pair<const int, int> &item) {
+    EXPECT_LT(previous, item.first);
+    previous = item.first;
+  });
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "test_entry.h"
+
+namespace {
+using Intervals = s21::interval_map<int, int>;
+
+/// пересекающие отрезки перебором
+std::vector<int> Naive(const std::vector<std::pair<int, int>> &items, int lo,
+                       int hi) {
+  std::vector<int> ids;
+  for (std::size_t i = 0; i < items.size(); ++i) {
+    if (items[i].first <= hi && items[i].second >= lo) {
+      ids.push_back(static_cast<int>(i));
+    }
+  }
+  return ids;
+}
+}  // namespace
+
+TEST(IntervalMapTest, StabAndOverlap) {
+  s21::interval_map<int, std::string> map = {
+      {{1, 5}, "a"}, {{3, 3}, "b"}, {{6, 9}, "c"}, {{1, 5}, "d"}};
+  EXPECT_EQ(map.size(), 4U);
+  std::vector<std::string> found;
+  for (auto it : map.stab(3)) found.push_back((*it).second);
+  EXPECT_EQ(found, (std::vector<std::string>{"a", "d", "b"}));
+  EXPECT_TRUE(map.stab(0).empty());
+  EXPECT_EQ(map.overlapping(5, 6).size(), 3U);
+  EXPECT_TRUE(map.overlaps(9, 100));
+  EXPECT_FALSE(map.overlaps(10, 100));
+  EXPECT_THROW(map.insert(4, 2, "x"), std::invalid_argument);
+  (*map.find(6, 9)).second = "e";
+  std::string joined;
+  map.for_each_overlapping(7, 7, [&](auto &item) { joined += item.second; });
+  EXPECT_EQ(joined, "e");
+  EXPECT_EQ(map.erase(1, 5), 2U);
+  EXPECT_EQ(map.erase(1, 5), 0U);
+  EXPECT_EQ(map.stab(3).size(), 1U);
+  EXPECT_TRUE(map.validate());
+}
+
+TEST(IntervalMapTest, MatchesBruteForce) {
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> start(0, 10000);
+  std::uniform_int_distribution<int> length(0, 300);
+  std::vector<std::pair<int, int>> items;
+  Intervals map;
+  for (int i = 0; i < 3000; ++i) {
+    int lo = start(gen);
+    items.emplace_back(lo, lo + length(gen));
+    map.insert(items.back().first, items.back().second, i);
+  }
+  /// удаление части отрезков перестраивает дерево поворотами
+  for (auto it = map.begin(); it != map.end();) {
+    auto next = it;
+    ++next;
+    if ((*it).second % 3 == 0) {
+      items[(*it).second] = {-2, -1};
+      map.erase(it);
+    }
+    it = next;
+  }
+  ASSERT_TRUE(map.validate());
+  for (int q = 0; q < 500; ++q) {
+    int lo = start(gen) - 100;
+    int hi = lo + length(gen) / 10;
+    std::vector<int> ids;
+    for (auto it : map.overlapping(lo, hi)) ids.push_back((*it).second);
+    std::sort(ids.begin(), ids.end());
+    std::vector<int> expected = Naive(items, lo, hi);
+    EXPECT_EQ(ids, expected);
+    EXPECT_EQ(map.overlaps(lo, hi), !expected.empty());
+  }
+}
@@ -1,3 +1,5 @@
+#include <memory>
+
 #include "test_entry.h"
 
 TEST(ListContainer, test_compare_iters) {
@@ -482,4 +484,19 @@ TEST(ListContainer, test_insert_many_front) {
   EXPECT_EQ(*it, 3);
   ++it;
   EXPECT_EQ(*it, 4);
-}
\ No newline at end of file
+}
+TEST(ListContainer, test_emplace_move_only) {
+  s21::list<std::unique_ptr<int>> list;
+  list.emplace_back(new int(2));
+  list.emplace_front(new int(0));
+  list.push_back(std::make_unique<int>(4));
+  auto it = list.begin();
+  ++it;
+  EXPECT_EQ(**list.emplace(it, new int(1)), 1);
+  list.insert(list.begin(), std::make_unique<int>(-1));
+  int expected[] = {-1, 0, 1, 2, 4};
+  std::size_t i = 0;
+  for (auto &value : list) EXPECT_EQ(*value, expected[i++]);
+  EXPECT_EQ(list.size(), 5U);
+  EXPECT_EQ(*list.back(), 4);
+}
@@ -1,4 +1,5 @@
 #include <map>
+#include <memory>
 
 #include "test_entry.h"
 
@@ -23,7 +24,7 @@ TEST(Map, test_initializer_list) {
   auto it = our_dict.begin();
   auto it_ = orig_dict.begin();
   for (; it != our_dict.end() || it_ != orig_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -97,7 +98,7 @@ TEST(Map, iterator) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -119,7 +120,7 @@ TEST(Map, at) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -141,7 +142,7 @@ TEST(Map, brackets_insert) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end() || it_ != orig_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -163,7 +164,7 @@ TEST(Map, brackets_edit) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -192,7 +193,7 @@ TEST(Map, insert) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -215,7 +216,7 @@ TEST(Map, insert_many) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end() || it_ != orig_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -242,7 +243,7 @@ TEST(Map, insert_existing_key) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -264,7 +265,7 @@ TEST(Map, insert_many_existing_key) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -282,7 +283,7 @@ TEST(Map, insert_many_empty_map) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -299,7 +300,7 @@ TEST(Map, insert_empty_map) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end() || it_ != orig_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -326,7 +327,7 @@ TEST(Map, insert_or_assign) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -343,7 +344,7 @@ TEST(Map, insert_or_assign_empty_map) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end() || it_ != orig_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -366,7 +367,7 @@ TEST(Map, test_erase) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end() || it_ != orig_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -394,10 +395,27 @@ TEST(Map, test_erase_2) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end() || it_ != orig_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
+TEST(Map, test_erase_returns_next) {
+  s21::map<int, int> our_dict;
+  for (int i = 0; i < 1000; ++i) our_dict.insert(i, i * i);
+  for (auto it = our_dict.begin(); it != our_dict.end();) {
+    if ((*it).first % 2) {
+      it = our_dict.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  EXPECT_EQ(our_dict.count_range(0, 1000), (size_t)500);
+  EXPECT_EQ(our_dict.at(998), 998 * 998);
+  EXPECT_FALSE(our_dict.contains(999));
+  auto next = our_dict.erase(our_dict.find(10));
+  EXPECT_EQ((*next).first, 12);
+}
+
 TEST(Map, test_erase_doesnt_exist) {
   s21::map<std::string, int> our_dict = {
       {"Igor", 2001},
@@ -415,13 +433,13 @@ TEST(Map, test_erase_doesnt_exist) {
       {"Christie", 2019},
   };
 
-  auto iter = our_buf.begin();
-  our_dict.erase(iter);
+  auto iter = our_dict.find((*our_buf.begin()).first);
+  EXPECT_EQ(our_dict.erase(iter), our_dict.end());
 
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end() || it_ != orig_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -445,7 +463,7 @@ TEST(Map, test_merge) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end() || it_ != orig_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -468,7 +486,7 @@ TEST(Map, merge_empty_map) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end() || it_ != orig_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
   }
 }
 
@@ -489,6 +507,318 @@ TEST(Map, merge_to_empty_map) {
   typename s21::map<std::string, int>::iterator it = our_dict.begin();
   typename std::map<std::string, int>::iterator it_ = orig_dict.begin();
   for (; it != our_dict.end() || it_ != orig_dict.end(); ++it, ++it_) {
-    EXPECT_EQ((*it).second(), (*it_).second);
+    EXPECT_EQ((*it).second, (*it_).second);
+  }
+}
+
+TEST(Map, test_order_statistics) {
+  s21::map<int, std::string> our_dict;
+  for (int i = 0; i < 100; ++i) our_dict.insert(i * 2, std::to_string(i));
+
+  EXPECT_EQ((*our_dict.nth(10)).second, "10");
+  EXPECT_EQ(our_dict.rank(21), (size_t)11);
+  EXPECT_EQ(our_dict.count_range(10, 20), (size_t)5);
+  EXPECT_EQ(our_dict.nth(100), our_dict.end());
+}
+
+TEST(Map, test_range_constructor) {
+  std::vector<std::pair<std::string, int>> items = {
+      {"Igor", 2001}, {"Anna", 1983}, {"Igor", 1999}, {"Boris", 1970}};
+  s21::map<std::string, int> our_dict(items.begin(), items.end());
+  std::map<std::string, int> orig_dict(items.begin(), items.end());
+
+  EXPECT_EQ(our_dict.at("Igor"), 2001);
+  auto it = our_dict.begin();
+  auto it_ = orig_dict.begin();
+  for (; it != our_dict.end() || it_ != orig_dict.end(); ++it, ++it_) {
+    EXPECT_EQ((*it).second, (*it_).second);
+  }
+}
+
+TEST(Map, test_assign_sorted) {
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 1000; ++i) items.push_back({i, i * i});
+  s21::map<int, int> our_dict = {{-1, 1}};
+  our_dict.assign_sorted(items.begin(), items.end());
+
+  EXPECT_FALSE(our_dict.contains(-1));
+  EXPECT_EQ(our_dict.at(30), 900);
+  EXPECT_EQ(our_dict.rank(500), (size_t)500);
+  our_dict[1000] = 7;
+  EXPECT_EQ(our_dict.at(1000), 7);
+}
+
+TEST(Map, test_lower_and_upper_bound) {
+  s21::map<int, std::string> our_dict = {{10, "a"}, {20, "b"}, {30, "c"}};
+  std::map<int, std::string> orig_dict = {{10, "a"}, {20, "b"}, {30, "c"}};
+
+  for (int key = 0; key < 40; ++key) {
+    auto lower = our_dict.lower_bound(key);
+    auto upper = our_dict.upper_bound(key);
+    auto orig_lower = orig_dict.lower_bound(key);
+    auto orig_upper = orig_dict.upper_bound(key);
+    if (orig_lower == orig_dict.end()) {
+      EXPECT_EQ(lower, our_dict.end());
+    } else {
+      EXPECT_EQ((*lower).second, orig_lower->second);
+    }
+    if (orig_upper == orig_dict.end()) {
+      EXPECT_EQ(upper, our_dict.end());
+    } else {
+      EXPECT_EQ((*upper).second, orig_upper->second);
+    }
+  }
+}
+
+TEST(Map, test_find_and_count) {
+  s21::map<int, std::string> dict = {{1, "one"}, {2, "two"}};
+
+  EXPECT_EQ((*dict.find(2)).second, "two");
+  EXPECT_EQ(dict.find(3), dict.end());
+  EXPECT_EQ(dict.count(1), 1u);
+  EXPECT_EQ(dict.count(5), 0u);
+}
+
+TEST(Map, test_transparent_lookup) {
+  s21::map<std::string, int, std::less<>> dict = {
+      {"apple", 1}, {"banana", 2}, {"cherry", 3}};
+  std::string_view probe = "banana";
+
+  EXPECT_EQ(dict.at(probe), 2);
+  EXPECT_EQ(dict.at("cherry"), 3);
+  EXPECT_THROW(dict.at(std::string_view("durian")), std::out_of_range);
+  EXPECT_TRUE(dict.contains(probe));
+  EXPECT_FALSE(dict.contains("fig"));
+  EXPECT_EQ((*dict.find(probe)).first, "banana");
+  EXPECT_EQ(dict.count("apple"), 1u);
+  EXPECT_EQ((*dict.lower_bound("b")).first, "banana");
+  EXPECT_EQ((*dict.upper_bound(probe)).first, "cherry");
+  dict.at("apple") = 10;
+  EXPECT_EQ(dict["apple"], 10);
+}
+
+TEST(Map, test_emplace_move_only) {
+  s21::map<int, std::unique_ptr<int>> map;
+  EXPECT_TRUE(map.emplace(2, std::make_unique<int>(20)).second);
+  EXPECT_TRUE(map.insert({1, std::make_unique<int>(10)}).second);
+  auto repeated = map.emplace(2, std::make_unique<int>(99));
+  EXPECT_FALSE(repeated.second);
+  EXPECT_EQ(*(*repeated.first).second, 20);
+  auto hinted = map.emplace_hint(map.end(), 3, std::make_unique<int>(30));
+  EXPECT_EQ((*hinted).first, 3);
+  map[4] = std::make_unique<int>(40);
+  int expected = 1;
+  for (auto it = map.begin(); it != map.end(); ++it, ++expected) {
+    EXPECT_EQ((*it).first, expected);
+    EXPECT_EQ(*(*it).second, expected * 10);
+  }
+}
+
+TEST(Map, test_hinted_insert) {
+  s21::map<int, int> map;
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ((*map.insert(map.end(), {i, i * 2})).first, i);
+  }
+  auto repeated = map.insert(map.find(10), {10, 0});
+  EXPECT_EQ((*repeated).second, 20);
+  EXPECT_EQ((*map.emplace_hint(map.begin(), -1, 5)).second, 5);
+  EXPECT_EQ(std::distance(map.begin(), map.end()), 101);
+}
+
+namespace {
+/// Значение, считающее свои копирования и перемещения
+struct Tracked {
+  static int copies;
+  static int moves;
+  int data;
+  explicit Tracked(int d) : data(d) {}
+  Tracked(const Tracked &other) : data(other.data) { ++copies; }
+  Tracked(Tracked &&other) noexcept : data(other.data) { ++moves; }
+  Tracked &operator=(const Tracked &) = default;
+};
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+}  // namespace
+
+TEST(Map, test_node_handles_move_entries_without_copies) {
+  s21::map<int, Tracked> shard1;
+  s21::map<int, Tracked> shard2;
+  for (int i = 0; i < 1000; ++i) shard1.emplace(i, i * 10);
+  Tracked::copies = Tracked::moves = 0;
+  for (int i = 0; i < 1000; i += 2) {
+    auto node = shard1.extract(i);
+    EXPECT_EQ(node.key(), i);
+    EXPECT_EQ(node.mapped().data, i * 10);
+    EXPECT_TRUE(shard2.insert(std::move(node)).inserted);
+  }
+  shard2.swap(shard1);
+  shard1.merge(shard2);
+  EXPECT_EQ(Tracked::copies, 0);
+  EXPECT_EQ(Tracked::moves, 0);
+  EXPECT_TRUE(shard2.empty());
+  int expected = 0;
+  for (auto it = shard1.begin(); it != shard1.end(); ++it, ++expected) {
+    EXPECT_EQ((*it).first, expected);
+    EXPECT_EQ((*it).second.data, expected * 10);
+  }
+  EXPECT_EQ(expected, 1000);
+}
+
+TEST(Map, test_lookups_do_not_construct_mapped_values) {
+  /// у Tracked нет конструктора по умолчанию: поиск не может создать T()
+  s21::map<int, Tracked> map;
+  for (int i = 0; i < 100; ++i) map.emplace(i, i);
+  Tracked::copies = Tracked::moves = 0;
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_EQ(map.contains(i), i < 100);
+    EXPECT_EQ(map.count(i), i < 100 ? 1u : 0u);
+    EXPECT_EQ(map.find(i) != map.end(), i < 100);
+    if (i < 100) {
+      EXPECT_EQ(map.at(i).data, i);
+    } else {
+      EXPECT_THROW(map.at(i), std::out_of_range);
+    }
+  }
+  EXPECT_EQ(map.rank(50), 50u);
+  EXPECT_EQ(map.count_range(10, 20), 10u);
+  EXPECT_EQ((*map.lower_bound(42)).second.data, 42);
+  Tracked replacement(500);
+  EXPECT_FALSE(map.insert_or_assign(5, replacement).second);
+  EXPECT_EQ(map.at(5).data, 500);
+  EXPECT_EQ(Tracked::copies, 0);
+  EXPECT_EQ(Tracked::moves, 0);
+}
+
+namespace {
+/// считает вызовы конструктора по умолчанию
+struct Counted {
+  static int defaults;
+  int data = 0;
+  Counted() { ++defaults; }
+  explicit Counted(int d) : data(d) {}
+};
+int Counted::defaults = 0;
+}  // namespace
+
+TEST(Map, test_try_emplace_constructs_value_only_for_new_key) {
+  s21::map<int, Tracked> map;
+  Tracked::copies = Tracked::moves = 0;
+  auto res = map.try_emplace(1, 10);
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ((*res.first).second.data, 10);
+  Tracked value(20);
+  res = map.try_emplace(1, std::move(value));
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ((*res.first).second.data, 10);
+  EXPECT_EQ(Tracked::copies, 0);
+  EXPECT_EQ(Tracked::moves, 0);
+  /// на новом ключе значение перемещается в узел ровно один раз
+  EXPECT_TRUE(map.try_emplace(2, std::move(value)).second);
+  EXPECT_EQ(Tracked::moves, 1);
+  EXPECT_TRUE(map.insert_or_assign(3, Tracked(30)).second);
+  EXPECT_FALSE(map.insert_or_assign(3, Tracked(31)).second);
+  EXPECT_EQ(map.at(3).data, 31);
+  EXPECT_EQ(Tracked::copies, 0);
+  EXPECT_EQ(Tracked::moves, 2);
+
+  s21::map<std::string, std::unique_ptr<int>> owners;
+  auto ptr = std::make_unique<int>(7);
+  EXPECT_TRUE(owners.try_emplace("a", std::move(ptr)).second);
+  ptr = std::make_unique<int>(8);
+  EXPECT_FALSE(owners.try_emplace("a", std::move(ptr)).second);
+  /// при существующем ключе аргумент не тронут
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(*owners.at("a"), 7);
+}
+
+TEST(Map, test_subscript_default_constructs_only_missing_values) {
+  s21::map<std::string, Counted> map;
+  Counted::defaults = 0;
+  map["a"].data = 1;
+  std::string key = "b";
+  map[std::move(key)].data = 2;
+  EXPECT_EQ(Counted::defaults, 2);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(map["a"].data, 1);
+    EXPECT_EQ(map["b"].data, 2);
+  }
+  EXPECT_EQ(Counted::defaults, 2);
+  EXPECT_EQ(map.count_range("a", "c"), 2u);
+}
+
+TEST(Map, test_tree_is_stored_inline) {
+  s21::map<int, int> map = {{1, 1}, {2, 2}};
+  s21::map<int, int> moved(std::move(map));
+  EXPECT_TRUE(map.empty());
+  map[5] = 5;
+  EXPECT_EQ(map.at(5), 5);
+  EXPECT_EQ(moved.at(2), 2);
+  map = std::move(moved);
+  EXPECT_EQ(map.at(1), 1);
+  s21::map<int, int> copy;
+  copy = map;
+  copy[1] = 10;
+  EXPECT_EQ(map.at(1), 1);
+  EXPECT_EQ(copy.at(1), 10);
+}
+
+TEST(Map, test_extracted_key_can_change) {
+  s21::map<std::string, int> map = {{"a", 1}, {"b", 2}};
+  auto node = map.extract("a");
+  node.key() = "c";
+  map.insert(std::move(node));
+  EXPECT_FALSE(map.contains("a"));
+  EXPECT_EQ(map.at("c"), 1);
+}
+
+TEST(Map, test_freeze) {
+  s21::map<int, std::string> live;
+  for (int i = 0; i < 1000; ++i) live.insert(i * 2, std::to_string(i));
+  s21::frozen_map<int, std::string> frozen = live.freeze();
+  live = s21::map<int, std::string>();
+  EXPECT_EQ(frozen.size(), 1000U);
+  EXPECT_EQ(frozen.at(10), "5");
+  EXPECT_THROW(frozen.at(11), std::out_of_range);
+  EXPECT_TRUE(frozen.contains(1998));
+  EXPECT_FALSE(frozen.contains(1999));
+  EXPECT_EQ(frozen.lower_bound(11)->first, 12);
+  EXPECT_EQ(frozen.upper_bound(12)->first, 14);
+  int expected = 0;
+  for (const auto &entry : frozen) {
+    EXPECT_EQ(entry.first, expected);
+    expected += 2;
+  }
+}
+
+TEST(Map, test_frozen_map_keeps_first_duplicate) {
+  s21::frozen_map<std::string, int> frozen = {
+      {"b", 1}, {"a", 2}, {"b", 3}, {"c", 4}};
+  EXPECT_EQ(frozen.size(), 3U);
+  EXPECT_EQ(frozen.at("b"), 1);
+  EXPECT_EQ(frozen.begin()->first, "a");
+}
+
+TEST(Map, test_erase_and_extract_range) {
+  s21::map<int, std::string> map;
+  std::map<int, std::string> orig;
+  for (int i = 0; i < 500; ++i) {
+    map.insert(i * 3, std::to_string(i));
+    orig.insert({i * 3, std::to_string(i)});
+  }
+  auto it = map.erase(map.find(30), map.find(300));
+  orig.erase(orig.find(30), orig.find(300));
+  EXPECT_EQ((*it).first, 300);
+  EXPECT_EQ(map.erase_range(1000, 1200), (size_t)66);
+  orig.erase(orig.lower_bound(1000), orig.lower_bound(1200));
+  s21::map<int, std::string> old = map.extract_range(0, 30);
+  EXPECT_EQ(old.at(27), "9");
+  EXPECT_FALSE(map.contains(27));
+  orig.erase(orig.begin(), orig.lower_bound(30));
+  auto expected = orig.begin();
+  for (auto pos = map.begin(); pos != map.end(); ++pos, ++expected) {
+    ASSERT_TRUE(expected != orig.end());
+    EXPECT_EQ((*pos).first, expected->first);
+    EXPECT_EQ((*pos).second, expected->second);
   }
+  EXPECT_TRUE(expected == orig.end());
 }
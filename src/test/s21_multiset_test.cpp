@@ -1,4 +1,5 @@
 #include <iterator>
+#include <vector>
 
 #include "test_entry.h"
 
@@ -164,6 +165,51 @@ TEST(MultiSetEraseTest, EraseLastElement) {
   EXPECT_EQ(multiset.count(3), (size_t)0);
 }
 
+namespace {
+/// элемент с ключом и меткой, равные ключи различаются только меткой
+struct Tagged {
+  int key;
+  int tag;
+};
+struct TaggedLess {
+  bool operator()(const Tagged &a, const Tagged &b) const {
+    return a.key < b.key;
+  }
+};
+}  // namespace
+
+TEST(MultiSetEraseTest, EraseRemovesExactlyThePointedDuplicate) {
+  s21::multiset<Tagged, TaggedLess> multiset;
+  for (int tag = 0; tag < 5; ++tag) multiset.insert(Tagged{7, tag});
+  multiset.insert(Tagged{9, 0});
+  auto it = multiset.lower_bound(Tagged{7, 0});
+  ++it;
+  ++it;
+  auto next = multiset.erase(it);
+  EXPECT_EQ((*next).tag, 3);
+  std::vector<int> tags;
+  for (const Tagged &item : multiset) {
+    if (item.key == 7) tags.push_back(item.tag);
+  }
+  EXPECT_EQ(tags, std::vector<int>({0, 1, 3, 4}));
+}
+
+TEST(MultiSetEraseTest, EraseWhileIterating) {
+  s21::multiset<int> multiset;
+  for (int i = 0; i < 1000; ++i) multiset.insert(i % 10);
+  for (auto it = multiset.begin(); it != multiset.end();) {
+    if (*it % 2) {
+      it = multiset.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  EXPECT_EQ(multiset.size(), (size_t)500);
+  EXPECT_EQ(multiset.count(3), (size_t)0);
+  EXPECT_EQ(multiset.count(4), (size_t)100);
+  EXPECT_EQ(multiset.erase(multiset.end()), multiset.end());
+}
+
 TEST(MultiSetFindTest, FindExistingElement) {
   s21::multiset<int> multiset = {1, 2, 2, 3, 4};
   auto it = multiset.find(2);
@@ -477,4 +523,136 @@ TEST(MultiSetInsertManyTest, InsertManyDuplicates) {
 //  }
 //
 //  EXPECT_EQ(multiset.size(), (size_t)4);
-//}
\ No newline at end of file
+//}
+TEST(MultiSetOrderStatisticTest, NthWithDuplicates) {
+  s21::multiset<int> multiset = {5, 1, 3, 3, 3, 2, 4};
+
+  EXPECT_EQ(*multiset.nth(0), 1);
+  EXPECT_EQ(*multiset.nth(2), 3);
+  EXPECT_EQ(*multiset.nth(4), 3);
+  EXPECT_EQ(*multiset.nth(5), 4);
+  EXPECT_EQ(multiset.nth(7), multiset.end());
+  EXPECT_EQ(multiset.rank(3), (size_t)2);
+  EXPECT_EQ(multiset.rank(4), (size_t)5);
+  EXPECT_EQ(multiset.count(3), (size_t)3);
+}
+
+TEST(MultiSetOrderStatisticTest, PercentileByCountRange) {
+  s21::multiset<int> latencies;
+  for (int i = 0; i < 100; ++i) {
+    latencies.insert(i % 10);
+  }
+
+  EXPECT_EQ(latencies.count_range(0, 5), (size_t)50);
+  EXPECT_EQ(latencies.count_range(9, 10), (size_t)10);
+  /// 90-й перцентиль
+  EXPECT_EQ(*latencies.nth(latencies.size() * 90 / 100), 9);
+}
+
+TEST(MultiSetBulkConstructionTest, RangeConstructorKeepsDuplicates) {
+  std::vector<int> values = {3, 1, 2, 3, 1};
+  s21::multiset<int> multiset(values.begin(), values.end());
+
+  EXPECT_EQ(multiset.size(), (size_t)5);
+  EXPECT_EQ(multiset.count(1), (size_t)2);
+  EXPECT_EQ(multiset.count(3), (size_t)2);
+  EXPECT_EQ(*multiset.begin(), 1);
+}
+
+TEST(MultiSetBulkConstructionTest, AssignSorted) {
+  std::vector<int> values = {1, 1, 2, 2, 2, 3};
+  s21::multiset<int> multiset;
+  multiset.assign_sorted(values.begin(), values.end());
+
+  EXPECT_EQ(multiset.size(), (size_t)6);
+  EXPECT_EQ(multiset.count(2), (size_t)3);
+  multiset.insert(2);
+  EXPECT_EQ(multiset.count(2), (size_t)4);
+}
+
+TEST(MultiSetOperationsTest, MultiplicitiesFollowStd) {
+  s21::multiset<int> multiset1 = {1, 1, 1, 2, 3, 3};
+  s21::multiset<int> multiset2 = {1, 3, 3, 3, 4};
+
+  auto united = s21::set_union(multiset1, multiset2);
+  auto common = s21::set_intersection(multiset1, multiset2);
+  auto diff = s21::set_difference(multiset1, multiset2);
+
+  EXPECT_EQ(united.count(1), (size_t)3);
+  EXPECT_EQ(united.count(3), (size_t)3);
+  EXPECT_EQ(united.size(), (size_t)8);
+  EXPECT_EQ(common.count(1), (size_t)1);
+  EXPECT_EQ(common.count(3), (size_t)2);
+  EXPECT_EQ(common.size(), (size_t)3);
+  EXPECT_EQ(diff.count(1), (size_t)2);
+  EXPECT_EQ(diff.count(2), (size_t)1);
+  EXPECT_EQ(diff.size(), (size_t)3);
+}
+
+TEST(MultiSetOperationsTest, MergeKeepsAllElements) {
+  s21::multiset<int> multiset1 = {1, 2, 2};
+  s21::multiset<int> multiset2 = {2, 3};
+
+  multiset1.merge(multiset2);
+
+  EXPECT_EQ(multiset1.size(), (size_t)5);
+  EXPECT_EQ(multiset1.count(2), (size_t)3);
+  EXPECT_TRUE(multiset2.empty());
+}
+
+TEST(MultiSetBoundsTest, BoundsOnLargeMultiset) {
+  s21::multiset<int> multiset;
+  for (int i = 0; i < 10000; ++i) multiset.insert(i / 4);
+
+  auto lower = multiset.lower_bound(100);
+  auto upper = multiset.upper_bound(100);
+  EXPECT_EQ(*lower, 100);
+  EXPECT_EQ(*upper, 101);
+  EXPECT_EQ(*--lower, 99);
+  EXPECT_EQ(std::distance(multiset.lower_bound(100), upper), 4);
+  auto range = multiset.equal_range(2499);
+  EXPECT_EQ(*range.first, 2499);
+  EXPECT_EQ(*range.second, 2499);
+  EXPECT_EQ(++range.second, multiset.end());
+  EXPECT_EQ(multiset.upper_bound(2499), multiset.end());
+}
+
+TEST(MultiSetTransparentTest, StringViewLookup) {
+  s21::multiset<std::string, std::less<>> words = {"b", "a", "b", "c", "b"};
+  std::string_view probe = "b";
+
+  EXPECT_EQ(words.count(probe), 3u);
+  EXPECT_TRUE(words.contains("c"));
+  EXPECT_FALSE(words.contains("d"));
+  EXPECT_EQ(*words.find(probe), "b");
+  EXPECT_EQ(std::distance(words.lower_bound(probe), words.upper_bound(probe)),
+            3);
+}
+
+TEST(MultiSetOperationsTest, ExtractAndInsertNode) {
+  s21::multiset<int> multiset1 = {1, 2, 2};
+  s21::multiset<int> multiset2 = {2};
+  auto node = multiset1.extract(2);
+  EXPECT_EQ(*multiset2.insert(std::move(node)), 2);
+  EXPECT_EQ(multiset1.count(2), (size_t)1);
+  EXPECT_EQ(multiset2.count(2), (size_t)2);
+  multiset1.swap(multiset2);
+  EXPECT_EQ(multiset1.size(), (size_t)2);
+  EXPECT_EQ(multiset2.size(), (size_t)2);
+}
+
+TEST(MultiSetOperationsTest, EraseAndExtractRange) {
+  s21::multiset<int> multiset;
+  for (int i = 0; i < 300; ++i) multiset.insert(i % 100);
+  EXPECT_EQ(multiset.erase_range(10, 20), (size_t)30);
+  EXPECT_EQ(multiset.count(15), (size_t)0);
+  auto last = multiset.upper_bound(50);
+  auto it = multiset.erase(multiset.lower_bound(50), last);
+  EXPECT_EQ(*it, 51);
+  EXPECT_EQ(multiset.count(50), (size_t)0);
+  s21::multiset<int> head = multiset.extract_range(0, 10);
+  EXPECT_EQ(head.size(), (size_t)30);
+  EXPECT_EQ(head.count(9), (size_t)3);
+  EXPECT_EQ(multiset.size(), (size_t)237);
+  EXPECT_EQ(*multiset.begin(), 20);
+}
@@ -0,0 +1,226 @@
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test_entry.h"
+
+namespace {
+/// сравнение версии словаря с эталоном
+template <typename Map, typename Reference>
+bool SameContents(const Map &map, const Reference &reference) {
+  if (map.size() != reference.size()) return false;
+  auto it = reference.begin();
+  for (const auto &item : map) {
+    if (item.first != it->first || item.second != it->second) return false;
+    ++it;
+  }
+  return true;
+}
+
+/// сравнение int, считающее свои вызовы
+struct CountingLess {
+  static inline std::size_t calls = 0;
+  bool operator()(int a, int b) const {
+    ++calls;
+    return a < b;
+  }
+};
+
+/// количество сравнений, которое делает f
+template <typename F>
+std::size_t Comparisons(F f) {
+  CountingLess::calls = 0;
+  f();
+  return CountingLess::calls;
+}
+}  // namespace
+
+TEST(PersistentMapTest, InsertEraseAndLookup) {
+  s21::persistent_map<int, std::string> map = {
+      {5, "five"}, {1, "one"}, {3, "three"}, {1, "uno"}};
+  EXPECT_EQ(map.size(), 3U);
+  EXPECT_EQ(map.at(1), "one");
+  EXPECT_FALSE(map.insert(3, "tres").second);
+  EXPECT_TRUE(map.insert_or_assign(3, "tres").first->second == "tres");
+  map[7] = "seven";
+  EXPECT_EQ(map.find(7)->second, "seven");
+  EXPECT_EQ(map.lower_bound(4)->first, 5);
+  EXPECT_EQ(map.upper_bound(5)->first, 7);
+  EXPECT_EQ(map.erase(1), 1U);
+  EXPECT_EQ(map.erase(1), 0U);
+  EXPECT_EQ(map.begin()->first, 3);
+  EXPECT_TRUE(map.find(1) == map.end());
+  EXPECT_THROW(map.at(1), std::out_of_range);
+  EXPECT_TRUE(map.validate());
+}
+
+TEST(PersistentMapTest, SnapshotsAreIsolated) {
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<int> key(0, 300);
+  s21::persistent_map<int, int> map;
+  std::map<int, int> reference;
+  std::vector<s21::persistent_map<int, int>> snapshots;
+  std::vector<std::map<int, int>> expected;
+  for (int step = 0; step < 3000; ++step) {
+    int k = key(gen);
+    if (step % 3 == 2) {
+      EXPECT_EQ(map.erase(k), reference.erase(k));
+    } else {
+      map.insert_or_assign(k, step);
+      reference[k] = step;
+    }
+    if (step % 100 == 0) {
+      snapshots.push_back(map.snapshot());
+      expected.push_back(reference);
+    }
+  }
+  EXPECT_TRUE(map.validate());
+  EXPECT_TRUE(SameContents(map, reference));
+  for (std::size_t i = 0; i < snapshots.size(); ++i) {
+    EXPECT_TRUE(snapshots[i].validate());
+    EXPECT_TRUE(SameContents(snapshots[i], expected[i]));
+  }
+  /// снимки тоже можно изменять, это независимые версии
+  snapshots[0].clear();
+  snapshots[1][1000] = 1;
+  EXPECT_FALSE(map.contains(1000));
+  EXPECT_TRUE(SameContents(snapshots[2], expected[2]));
+}
+
+TEST(PersistentMapTest, SnapshotSharesUntouchedNodes) {
+  s21::persistent_map<int, int> map;
+  for (int i = 0; i < 1024; ++i) map.insert(i, i);
+  s21::persistent_map<int, int> snapshot = map.snapshot();
+  EXPECT_EQ(&*map.find(0), &*snapshot.find(0));
+  map[1000] = -1;
+  map.insert(5000, 5000);
+  /// скопирован только путь до измененных пар
+  EXPECT_NE(&map.at(1000), &snapshot.at(1000));
+  EXPECT_EQ(snapshot.at(1000), 1000);
+  std::size_t shared = 0;
+  for (auto it = map.begin(), old = snapshot.begin(); old != snapshot.end();
+       ++it, ++old) {
+    shared += &*it == &*old;
+  }
+  EXPECT_GT(shared, 1000U);
+  /// без снимков узлы изменяются на месте
+  s21::persistent_map<int, int> alone;
+  alone.insert(1, 1);
+  const int *before = &alone.at(1);
+  alone[1] = 2;
+  EXPECT_EQ(before, &alone.at(1));
+}
+
+TEST(PersistentMapTest, UpdatesTakeOneDescent) {
+  s21::persistent_map<int, int, CountingLess> map;
+  for (int i = 0; i < 1000; ++i) map.insert(i * 2, i);
+  s21::persistent_map<int, int, CountingLess> snapshot = map.snapshot();
+  for (int key = -1; key < 2001; key += 37) {
+    std::size_t lookup = Comparisons([&] { map.contains(key); });
+    /// новый ключ: тот же путь и не больше двух сравнений после поворота
+    EXPECT_LE(Comparisons([&] { map.insert_or_assign(key, 1); }), lookup + 2);
+    /// существующий ключ: ровно путь поиска, без повторных спусков
+    lookup = Comparisons([&] { map.contains(key); });
+    EXPECT_EQ(Comparisons([&] { map.insert_or_assign(key, 2); }), lookup);
+    EXPECT_EQ(Comparisons([&] { map[key] = 3; }), lookup);
+    EXPECT_EQ(Comparisons([&] { map.at(key); }), lookup);
+    EXPECT_EQ(Comparisons([&] { map.insert(key, 4); }), lookup);
+    EXPECT_EQ(Comparisons([&] { map.erase(key); }), lookup);
+  }
+  EXPECT_TRUE(map.validate());
+  EXPECT_TRUE(snapshot.validate());
+  EXPECT_EQ(snapshot.size(), 1000U);
+}
+
+TEST(PersistentMapTest, InsertReturnsWorkingIterator) {
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> key(0, 2000);
+  s21::persistent_map<int, int> map;
+  std::vector<s21::persistent_map<int, int>> snapshots;
+  for (int step = 0; step < 2000; ++step) {
+    int k = key(gen);
+    auto result = step % 2 ? map.insert(k, step) : map.emplace(k, step);
+    EXPECT_EQ(result.first->first, k);
+    /// путь итератора верен и после поворотов: обход идет до конца
+    auto it = result.first;
+    auto found = map.find(k);
+    for (int i = 0; i < 3 && found != map.end(); ++i, ++it, ++found) {
+      EXPECT_TRUE(it == found);
+    }
+    if (step % 50 == 0) snapshots.push_back(map.snapshot());
+  }
+  EXPECT_TRUE(map.validate());
+  for (const auto &snapshot : snapshots) EXPECT_TRUE(snapshot.validate());
+}
+
+TEST(PersistentMapTest, EraseLeavesSnapshotNodesAlone) {
+  s21::persistent_map<int, int> map;
+  for (int i = 0; i < 4000; ++i) map.insert(i, i);
+  s21::persistent_map<int, int> snapshot = map.snapshot();
+  std::atomic<bool> done{false};
+  std::atomic<int> passes{0};
+  std::atomic<int> errors{0};
+  /// читатель проверяет высоты снимка, пока писатель удаляет из своей
+  /// версии: общие узлы не должны изменяться
+  std::thread reader([&] {
+    while (!done.load()) {
+      if (!snapshot.validate()) ++errors;
+      ++passes;
+    }
+  });
+  while (passes.load() == 0) std::this_thread::yield();
+  /// у максимума нет правого соседа, на его место встает левое поддерево
+  for (int i = 3999; i >= 2000; --i) map.erase(i);
+  for (int i = 0; i < 2000; i += 2) map.erase(i);
+  done = true;
+  reader.join();
+  EXPECT_EQ(errors.load(), 0);
+  EXPECT_EQ(map.size(), 1000U);
+  EXPECT_TRUE(map.validate());
+  EXPECT_EQ(snapshot.size(), 4000U);
+}
+
+TEST(PersistentMapTest, ReadersDoNotBlockWriter) {
+  s21::persistent_map<int, int> map;
+  std::atomic<bool> done{false};
+  std::atomic<int> errors{0};
+  /// писатель публикует снимки под мьютексом, читатели забирают копию и
+  /// читают ее без блокировок
+  std::mutex published_mutex;
+  s21::persistent_map<int, int> published;
+  auto reader = [&] {
+    while (!done.load()) {
+      s21::persistent_map<int, int> view;
+      {
+        std::lock_guard<std::mutex> lock(published_mutex);
+        view = published;
+      }
+      /// в каждой версии значения равны удвоенным ключам, ключи 0..size-1
+      int expected = 0;
+      for (const auto &item : view) {
+        if (item.first != expected++ || item.second != 2 * item.first) {
+          ++errors;
+        }
+      }
+      if (static_cast<std::size_t>(expected) != view.size()) ++errors;
+    }
+  };
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 3; ++i) readers.emplace_back(reader);
+  for (int i = 0; i < 3000; ++i) {
+    map.insert(i, 2 * i);
+    if (i % 10 == 0) {
+      std::lock_guard<std::mutex> lock(published_mutex);
+      published = map.snapshot();
+    }
+  }
+  done = true;
+  for (std::thread &thread : readers) thread.join();
+  EXPECT_EQ(errors.load(), 0);
+  EXPECT_EQ(map.size(), 3000U);
+  EXPECT_TRUE(map.validate());
+}
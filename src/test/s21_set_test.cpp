@@ -1,3 +1,5 @@
+#include <thread>
+
 #include "test_entry.h"
 
 TEST(SetConstructorTest, EmptyConstructor) {
@@ -30,7 +32,7 @@ TEST(SetConstructorTest, InitializerListConstructorEmpty) {
 
 TEST(SetConstructorTest, DefaultMaxSizeConstructor) {
   s21::set<int> mySet;
-  EXPECT_EQ(mySet.max_size(), std::numeric_limits<size_t>::max() / 32);
+  EXPECT_EQ(mySet.max_size(), std::numeric_limits<size_t>::max() / 40);
 }
 
 TEST(SetConstructorTest, InsertConstructor) {
@@ -200,6 +202,28 @@ TEST(SetEraseTest, EraseLastElement) {
   EXPECT_EQ(mySet.size(), (size_t)1);
 }
 
+TEST(SetEraseTest, EraseReturnsNextAndKeepsOrder) {
+  s21::set<int> mySet;
+  for (int i = 0; i < 2000; ++i) mySet.insert(i);
+  for (auto it = mySet.begin(); it != mySet.end();) {
+    if (*it % 3 == 0) {
+      int erased = *it;
+      it = mySet.erase(it);
+      if (it != mySet.end()) {
+        EXPECT_EQ(*it, erased + 1);
+      }
+    } else {
+      ++it;
+    }
+  }
+  EXPECT_EQ(mySet.size(), (size_t)1333);
+  EXPECT_FALSE(mySet.contains(999));
+  EXPECT_EQ(*mySet.begin(), 1);
+  auto last = mySet.find(1999);
+  EXPECT_EQ(mySet.erase(last), mySet.end());
+  EXPECT_EQ(mySet.erase(mySet.end()), mySet.end());
+}
+
 TEST(SetSwapTest, SwapEmptySets) {
   s21::set<int> set1;
   s21::set<int> set2;
@@ -271,7 +295,7 @@ TEST(SetMergeTest, MergeEmptyWithNonEmptySet) {
   set1.merge(set2);
 
   EXPECT_EQ(set1.size(), (size_t)3);
-  EXPECT_EQ(set2.size(), (size_t)3);
+  EXPECT_TRUE(set2.empty());
 }
 
 TEST(SetMergeTest, MergeNonEmptySets) {
@@ -625,3 +649,346 @@ TEST(SetInsertManyTest, InsertManyDuplicateArguments) {
     EXPECT_FALSE(result[i].second);
   }
 }
+
+TEST(SetOrderStatisticTest, NthAndRank) {
+  s21::set<int> set;
+  for (int i = 0; i < 1000; ++i) set.insert((i * 7919) % 1000);
+
+  for (int k = 0; k < 1000; k += 37) {
+    EXPECT_EQ(*set.nth(k), k);
+    EXPECT_EQ(set.rank(k), (size_t)k);
+  }
+  EXPECT_EQ(set.nth(1000), set.end());
+  EXPECT_EQ(set.rank(-5), (size_t)0);
+  EXPECT_EQ(set.rank(5000), (size_t)1000);
+}
+
+TEST(SetOrderStatisticTest, RankAfterErase) {
+  s21::set<int> set = {10, 20, 30, 40, 50};
+  set.erase(set.find(20));
+
+  EXPECT_EQ(set.rank(30), (size_t)1);
+  EXPECT_EQ(*set.nth(1), 30);
+  EXPECT_EQ(set.count_range(10, 50), (size_t)3);
+  EXPECT_EQ(set.count_range(15, 45), (size_t)2);
+  EXPECT_EQ(set.count_range(45, 15), (size_t)0);
+}
+
+TEST(SetBulkConstructionTest, RangeConstructorUnsorted) {
+  std::vector<int> values = {9, 4, 7, 1, 4, 9, 3};
+  s21::set<int> set(values.begin(), values.end());
+
+  EXPECT_EQ(set.size(), (size_t)5);
+  int expected[] = {1, 3, 4, 7, 9};
+  int i = 0;
+  for (auto it = set.begin(); it != set.end(); ++it) {
+    EXPECT_EQ(*it, expected[i++]);
+  }
+}
+
+TEST(SetBulkConstructionTest, AssignSortedReplacesContent) {
+  s21::set<int> set = {100, 200};
+  std::vector<int> values;
+  for (int i = 0; i < 10000; ++i) values.push_back(i / 2);
+  set.assign_sorted(values.begin(), values.end());
+
+  EXPECT_EQ(set.size(), (size_t)5000);
+  EXPECT_FALSE(set.contains(100 * 100));
+  EXPECT_TRUE(set.contains(4999));
+  EXPECT_EQ(*set.nth(2500), 2500);
+  EXPECT_FALSE(set.insert(10).second);
+  EXPECT_TRUE(set.insert(6000).second);
+}
+
+TEST(SetOperationsTest, UnionIntersectionDifference) {
+  s21::set<int> set1 = {1, 2, 3, 4, 5};
+  s21::set<int> set2 = {4, 5, 6, 7};
+
+  s21::set<int> united = s21::set_union(set1, set2);
+  s21::set<int> common = s21::set_intersection(set1, set2);
+  s21::set<int> diff = s21::set_difference(set1, set2);
+
+  EXPECT_EQ(united.size(), (size_t)7);
+  EXPECT_EQ(common.size(), (size_t)2);
+  EXPECT_TRUE(common.contains(4));
+  EXPECT_TRUE(common.contains(5));
+  EXPECT_EQ(diff.size(), (size_t)3);
+  EXPECT_FALSE(diff.contains(4));
+  EXPECT_EQ(set1.size(), (size_t)5);
+  EXPECT_EQ(set2.size(), (size_t)4);
+}
+
+TEST(SetOperationsTest, LargeParallelUnionByMove) {
+  s21::ThreadPool pool(3);
+  std::vector<int> evens;
+  std::vector<int> thirds;
+  for (int i = 0; i < 100000; ++i) {
+    evens.push_back(i * 2);
+    thirds.push_back(i * 3);
+  }
+  s21::set<int> set1;
+  s21::set<int> set2;
+  set1.assign_sorted(evens.begin(), evens.end());
+  set2.assign_sorted(thirds.begin(), thirds.end());
+
+  s21::set<int> united =
+      s21::set_union(std::move(set1), std::move(set2), pool);
+
+  EXPECT_TRUE(set1.empty());
+  /// чисел вида 2k и 3k без общих 6k
+  EXPECT_EQ(united.size(), (size_t)(100000 + 100000 - 33334));
+  int previous = -1;
+  for (auto it = united.begin(); it != united.end(); ++it) {
+    EXPECT_LT(previous, *it);
+    previous = *it;
+  }
+  EXPECT_EQ(*united.nth(3), 4);
+}
+
+TEST(SetBoundsTest, LowerAndUpperBound) {
+  s21::set<int> set = {10, 20, 30, 40};
+
+  EXPECT_EQ(*set.lower_bound(20), 20);
+  EXPECT_EQ(*set.upper_bound(20), 30);
+  EXPECT_EQ(*set.lower_bound(21), 30);
+  EXPECT_EQ(*set.lower_bound(-5), 10);
+  EXPECT_EQ(set.lower_bound(41), set.end());
+  EXPECT_EQ(set.upper_bound(40), set.end());
+  EXPECT_EQ(*--set.upper_bound(40), 40);
+}
+
+namespace {
+/// элемент множества, который нельзя построить из ключа поиска
+struct Person {
+  int id;
+  std::string name;
+};
+/// прозрачное сравнение Person по id, в том числе с голым id
+struct ById {
+  using is_transparent = void;
+  bool operator()(const Person &a, const Person &b) const {
+    return a.id < b.id;
+  }
+  bool operator()(const Person &a, int id) const { return a.id < id; }
+  bool operator()(int id, const Person &b) const { return id < b.id; }
+};
+}  // namespace
+
+TEST(SetTransparentTest, LookupWithoutKeyConstruction) {
+  s21::set<Person, ById> people = {{3, "c"}, {1, "a"}, {2, "b"}, {1, "x"}};
+
+  EXPECT_EQ(people.size(), 3u);
+  EXPECT_EQ((*people.find(2)).name, "b");
+  EXPECT_EQ((*people.find(1)).name, "a");
+  EXPECT_EQ(people.find(7), people.end());
+  EXPECT_TRUE(people.contains(3));
+  EXPECT_FALSE(people.contains(0));
+  EXPECT_EQ(people.count(2), 1u);
+  EXPECT_EQ((*people.lower_bound(2)).id, 2);
+  EXPECT_EQ((*people.upper_bound(2)).id, 3);
+  EXPECT_EQ(people.upper_bound(3), people.end());
+}
+
+TEST(SetTransparentTest, StringViewLookup) {
+  s21::set<std::string, std::less<>> words = {"delta", "alpha", "charlie"};
+  std::string_view probe = "charlie";
+
+  EXPECT_EQ(*words.find(probe), "charlie");
+  EXPECT_TRUE(words.contains("alpha"));
+  EXPECT_FALSE(words.contains(std::string_view("bravo")));
+  EXPECT_EQ(*words.lower_bound("bravo"), "charlie");
+  EXPECT_EQ(words.count(std::string("delta")), 1u);
+}
+
+TEST(SetEmplaceTest, ConstructsFromArguments) {
+  s21::set<std::string> set;
+  EXPECT_TRUE(set.emplace(3, 'a').second);
+  EXPECT_TRUE(set.emplace("b").second);
+  auto repeated = set.emplace(std::string("aaa"));
+  EXPECT_FALSE(repeated.second);
+  EXPECT_EQ(*repeated.first, "aaa");
+  EXPECT_EQ(*set.emplace_hint(set.end(), "c"), "c");
+  EXPECT_EQ(set.size(), 3U);
+}
+
+TEST(SetEmplaceTest, HintedInsert) {
+  s21::set<int> set;
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(*set.insert(set.end(), i), i);
+  EXPECT_EQ(*set.insert(set.begin(), 50), 50);
+  EXPECT_EQ(*set.insert(set.find(20), -1), -1);
+  EXPECT_EQ(set.size(), 101U);
+  int expected = -1;
+  for (int value : set) EXPECT_EQ(value, expected++);
+}
+
+TEST(SetNodeHandleTest, ExtractInsertAndMerge) {
+  s21::set<int> set1 = {1, 2, 3};
+  s21::set<int> set2 = {3, 4};
+  auto node = set1.extract(2);
+  EXPECT_EQ(node.value(), 2);
+  EXPECT_FALSE(set1.contains(2));
+  auto res = set2.insert(std::move(node));
+  EXPECT_TRUE(res.inserted);
+  EXPECT_EQ(*res.position, 2);
+  EXPECT_TRUE(res.node.empty());
+  auto repeated = set2.insert(set1.extract(set1.find(3)));
+  EXPECT_FALSE(repeated.inserted);
+  EXPECT_EQ(repeated.node.value(), 3);
+  set1.insert(std::move(repeated.node));
+  /// равные элементы остаются в источнике
+  set1.merge(set2);
+  EXPECT_EQ(set1.size(), 4U);
+  EXPECT_EQ(set2.size(), 1U);
+  EXPECT_TRUE(set2.contains(3));
+}
+
+TEST(SetNodeHandleTest, SwapAndMoveKeepElements) {
+  s21::set<int> set1 = {1, 2, 3};
+  s21::set<int> set2 = {10};
+  auto it = set1.find(2);
+  set1.swap(set2);
+  EXPECT_EQ(*it, 2);
+  EXPECT_EQ(set1.size(), 1U);
+  EXPECT_EQ(set2.size(), 3U);
+  s21::set<int> set3;
+  set3 = std::move(set2);
+  EXPECT_EQ(*it, 2);
+  EXPECT_TRUE(set3.contains(2));
+  EXPECT_TRUE(set2.empty());
+}
+
+namespace {
+/// вставки и удаления в множестве из отдельного потока
+void ChurnInThread(s21::set<int> &set, int base) {
+  for (int round = 0; round < 20; ++round) {
+    for (int i = 0; i < 1000; ++i) set.insert(base + i);
+    for (int i = 0; i < 1000; ++i) set.erase(set.find(base + i));
+  }
+}
+}  // namespace
+
+TEST(SetNodeHandleTest, MergedSetsAreUsableFromTwoThreads) {
+  s21::set<int> set1;
+  s21::set<int> set2;
+  for (int i = 0; i < 2000; i += 2) set1.insert(i);
+  for (int i = 0; i < 2000; ++i) set2.insert(i);
+  /// после слияния узлы обоих множеств лежат в одной памяти
+  set1.merge(set2);
+  auto node = set1.extract(0);
+  ASSERT_EQ(set2.size(), 1000U);
+  std::thread worker1([&] { ChurnInThread(set1, 100000); });
+  std::thread worker2([&] {
+    ChurnInThread(set2, 200000);
+    node = {};
+  });
+  worker1.join();
+  worker2.join();
+  EXPECT_EQ(set1.size(), 1999U);
+  EXPECT_EQ(set2.size(), 1000U);
+  EXPECT_EQ(*set2.begin(), 0);
+}
+
+TEST(SetFreezeTest, MatchesLiveSetForEverySize) {
+  for (int n = 0; n <= 70; ++n) {
+    s21::set<int> live;
+    for (int i = 0; i < n; ++i) live.insert(i * 3);
+    s21::frozen_set<int> frozen = live.freeze();
+    ASSERT_EQ(frozen.size(), static_cast<size_t>(n));
+    EXPECT_TRUE(std::equal(frozen.begin(), frozen.end(), live.begin(),
+                           live.end()));
+    for (int key = -1; key <= 3 * n; ++key) {
+      EXPECT_EQ(frozen.contains(key), live.contains(key));
+      auto lower = frozen.lower_bound(key);
+      auto upper = frozen.upper_bound(key);
+      if (key <= 3 * (n - 1)) {
+        EXPECT_EQ(*lower, *live.lower_bound(key));
+      } else {
+        EXPECT_EQ(lower, frozen.end());
+      }
+      if (key < 3 * (n - 1)) {
+        EXPECT_EQ(*upper, *live.upper_bound(key));
+      } else {
+        EXPECT_EQ(upper, frozen.end());
+      }
+    }
+    /// обратный обход от end()
+    int expected = 3 * (n - 1);
+    for (auto it = frozen.end(); it != frozen.begin(); expected -= 3) {
+      EXPECT_EQ(*--it, expected);
+    }
+    EXPECT_EQ(expected, -3);
+  }
+}
+
+TEST(SetFreezeTest, RangeConstructorSortsAndDeduplicates) {
+  std::vector<int> items = {5, -1, 5, 3, 9, -1, 0};
+  s21::frozen_set<int> frozen(items.begin(), items.end());
+  std::vector<int> expected = {-1, 0, 3, 5, 9};
+  EXPECT_TRUE(std::equal(frozen.begin(), frozen.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_EQ(frozen.count(5), 1U);
+  EXPECT_EQ(frozen.find(4), frozen.end());
+  EXPECT_EQ(*frozen.find(9), 9);
+  /// массив значений и одна неиспользуемая ячейка, без узлов
+  EXPECT_EQ(frozen.memory_usage(), sizeof(frozen) + 6 * sizeof(int));
+}
+
+TEST(SetFreezeTest, TransparentLookupAndCopy) {
+  s21::set<std::string, std::less<>> live;
+  for (int i = 0; i < 100; ++i) live.insert("key_" + std::to_string(i));
+  s21::frozen_set<std::string, std::less<>> frozen = live.freeze();
+  s21::frozen_set<std::string, std::less<>> copy = frozen;
+  live.clear();
+  EXPECT_TRUE(copy.contains(std::string_view("key_42")));
+  EXPECT_EQ(*copy.lower_bound("key_99"), "key_99");
+  EXPECT_EQ(copy.find("key_100"), copy.end());
+  EXPECT_EQ(frozen.size(), 100U);
+}
+
+TEST(SetRangeEraseTest, EraseIteratorRange) {
+  s21::set<int> set;
+  for (int i = 0; i < 100; ++i) set.insert(i);
+  auto last = set.find(60);
+  auto it = set.erase(set.find(20), last);
+  EXPECT_EQ(*it, 60);
+  EXPECT_EQ(set.size(), (size_t)60);
+  EXPECT_EQ(*--it, 19);
+  EXPECT_EQ(set.erase(set.begin(), set.begin()), set.begin());
+  EXPECT_EQ(set.erase(set.find(90), set.end()), set.end());
+  EXPECT_EQ(set.size(), (size_t)50);
+  set.erase(set.begin(), set.end());
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(SetRangeEraseTest, EraseAndExtractKeyRange) {
+  s21::set<int> set;
+  for (int i = 0; i < 1000; i += 2) set.insert(i);
+  EXPECT_EQ(set.erase_range(-10, 101), (size_t)51);
+  EXPECT_EQ(*set.begin(), 102);
+  EXPECT_EQ(set.erase_range(500, 500), (size_t)0);
+  const int *address = &*set.find(700);
+  s21::set<int> tail = set.extract_range(700, 2000);
+  EXPECT_EQ(tail.size(), (size_t)150);
+  EXPECT_EQ(set.size(), (size_t)299);
+  /// элементы переходят без копирования
+  EXPECT_EQ(&*tail.begin(), address);
+  EXPECT_FALSE(set.contains(700));
+  tail.insert(701);
+  set.merge(tail);
+  EXPECT_EQ(set.size(), (size_t)450);
+  EXPECT_EQ(set.count_range(102, 1000), (size_t)450);
+}
+
+TEST(SetRangeEraseTest, ExtractedRangeIsUsableFromAnotherThread) {
+  s21::set<int> set;
+  for (int i = 0; i < 4000; ++i) set.insert(i);
+  s21::set<int> middle = set.extract_range(1000, 3000);
+  std::thread worker1([&] { ChurnInThread(set, 100000); });
+  std::thread worker2([&] { ChurnInThread(middle, 100000); });
+  worker1.join();
+  worker2.join();
+  EXPECT_EQ(set.size(), (size_t)2000);
+  EXPECT_EQ(middle.size(), (size_t)2000);
+  EXPECT_EQ(*middle.begin(), 1000);
+  EXPECT_EQ(*set.lower_bound(1000), 3000);
+}
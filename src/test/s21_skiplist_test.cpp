@@ -0,0 +1,138 @@
+#include <atomic>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test_entry.h"
+
+namespace {
+/// значение со счетчиком живых объектов: проверка отложенного удаления
+struct Tracked {
+  static std::atomic<int> alive;
+  int value;
+  explicit Tracked(int v) : value(v) { ++alive; }
+  Tracked(const Tracked &other) : value(other.value) { ++alive; }
+  ~Tracked() { --alive; }
+};
+std::atomic<int> Tracked::alive{0};
+}  // namespace
+
+TEST(SkipListSetTest, MatchesStdSet) {
+  s21::concurrent_skiplist_set<int> set = {5, 1, 3, 1};
+  std::set<int> reference = {5, 1, 3};
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> key(0, 500);
+  for (int step = 0; step < 5000; ++step) {
+    int k = key(gen);
+    if (step % 3 == 0) {
+      EXPECT_EQ(set.erase(k), reference.erase(k));
+    } else {
+      EXPECT_EQ(set.insert(k).second, reference.insert(k).second);
+    }
+  }
+  EXPECT_EQ(set.size(), reference.size());
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), reference.begin(),
+                         reference.end()));
+  for (int k = -1; k <= 501; ++k) {
+    EXPECT_EQ(set.contains(k), reference.count(k) == 1);
+    auto lower = set.lower_bound(k);
+    auto expected = reference.lower_bound(k);
+    ASSERT_EQ(lower == set.end(), expected == reference.end());
+    if (expected != reference.end()) {
+      EXPECT_EQ(*lower, *expected);
+    }
+    auto upper = set.upper_bound(k);
+    expected = reference.upper_bound(k);
+    ASSERT_EQ(upper == set.end(), expected == reference.end());
+    if (expected != reference.end()) {
+      EXPECT_EQ(*upper, *expected);
+    }
+  }
+  set.erase(set.begin());
+  EXPECT_EQ(*set.begin(), *std::next(reference.begin()));
+  set.clear();
+  EXPECT_TRUE(set.empty());
+  EXPECT_TRUE(set.begin() == set.end());
+}
+
+TEST(SkipListMapTest, Operations) {
+  s21::concurrent_skiplist_map<std::string, int> map = {{"b", 2}, {"a", 1}};
+  EXPECT_EQ(map.at("a"), 1);
+  EXPECT_THROW(map.at("c"), std::out_of_range);
+  EXPECT_TRUE(map.insert("c", 3).second);
+  EXPECT_FALSE(map.emplace("c", 4).second);
+  EXPECT_EQ(map.find("c")->second, 3);
+  /// итератор на удаленную пару остается читаемым
+  auto it = map.find("b");
+  map.erase("b");
+  EXPECT_EQ(it->second, 2);
+  EXPECT_FALSE(map.contains("b"));
+  std::vector<std::string> keys;
+  for (const auto &item : map) keys.push_back(item.first);
+  EXPECT_EQ(keys, (std::vector<std::string>{"a", "c"}));
+  map.erase(map.begin());
+  EXPECT_EQ(map.size(), 1U);
+}
+
+TEST(SkipListSetTest, ConcurrentStress) {
+  s21::concurrent_skiplist_set<int> set;
+  const int kThreads = 4;
+  const int kOps = 20000;
+  std::atomic<long> balance{0};
+  std::atomic<bool> writing{true};
+  std::atomic<int> order_errors{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      std::mt19937 gen(t);
+      /// маленький диапазон ключей: много столкновений вставок и удалений
+      std::uniform_int_distribution<int> key(0, 255);
+      long local = 0;
+      for (int i = 0; i < kOps; ++i) {
+        int k = key(gen);
+        if (gen() % 2) {
+          local += set.insert(k).second;
+        } else {
+          local -= static_cast<long>(set.erase(k));
+        }
+        set.contains(key(gen));
+      }
+      balance += local;
+    });
+  }
+  std::thread reader([&] {
+    while (writing.load()) {
+      int previous = -1;
+      for (int value : set) {
+        if (value <= previous) ++order_errors;
+        previous = value;
+      }
+    }
+  });
+  for (std::thread &thread : threads) thread.join();
+  writing = false;
+  reader.join();
+  EXPECT_EQ(order_errors.load(), 0);
+  EXPECT_EQ(static_cast<long>(set.size()), balance.load());
+  EXPECT_EQ(std::distance(set.begin(), set.end()), balance.load());
+}
+
+TEST(SkipListMapTest, RetiredValuesAreDestroyed) {
+  {
+    s21::concurrent_skiplist_map<int, Tracked> map;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+      threads.emplace_back([&map, t] {
+        for (int i = 0; i < 3000; ++i) {
+          map.emplace(i % 100, Tracked(t));
+          map.erase((i + 50) % 100);
+        }
+      });
+    }
+    for (std::thread &thread : threads) thread.join();
+  }
+  s21::EpochDomain::Instance().Collect();
+  EXPECT_EQ(Tracked::alive.load(), 0);
+}
@@ -1,8 +1,27 @@
 
+#include <memory>
 #include <vector>
 
 #include "test_entry.h"
 
+namespace {
+/// считает перемещения элемента
+struct Moves {
+  static int count;
+  int data = 0;
+  Moves(int d) : data(d) {}
+  Moves(const Moves &other) = default;
+  Moves(Moves &&other) noexcept : data(other.data) { ++count; }
+  Moves &operator=(const Moves &other) = default;
+  Moves &operator=(Moves &&other) noexcept {
+    data = other.data;
+    ++count;
+    return *this;
+  }
+};
+int Moves::count = 0;
+}  // namespace
+
 TEST(VectorMemberFunctions, constructor_n_values) {
   s21::vector<int> own_vector(5);
   EXPECT_FALSE(own_vector.empty());
@@ -435,3 +454,76 @@ TEST(VectorInsertManyBackTest, InsertManyBackTest) {
   EXPECT_EQ(vec[8], 40);
   EXPECT_EQ(vec[9], 50);
 }
+
+TEST(VectorEmplaceTest, MoveOnlyElements) {
+  s21::vector<std::unique_ptr<int>> vec;
+  for (int i = 0; i < 10; ++i) vec.emplace_back(new int(i));
+  vec.push_back(std::make_unique<int>(10));
+  EXPECT_EQ(vec.size(), 11U);
+  auto it = vec.emplace(vec.begin() + 1, new int(-1));
+  EXPECT_EQ(**it, -1);
+  vec.insert(vec.begin(), std::make_unique<int>(-2));
+  vec.insert_many_back(std::make_unique<int>(11), std::make_unique<int>(12));
+  vec.erase(vec.begin() + 2);
+  vec.shrink_to_fit();
+  std::vector<int> expected{-2, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  ASSERT_EQ(vec.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(*vec[i], expected[i]);
+  }
+  vec.pop_back();
+  EXPECT_EQ(*vec.back(), 11);
+}
+
+TEST(VectorEmplaceTest, InsertManyShiftsTailOnce) {
+  s21::vector<Moves> vec;
+  vec.reserve(1010);
+  for (int i = 0; i < 1000; ++i) vec.emplace_back(i);
+  Moves::count = 0;
+  vec.insert_many(vec.begin() + 10, 1, 2, 3, 4, 5);
+  /// хвост из 990 элементов сдвигается один раз, значения переносятся из
+  /// временного буфера
+  EXPECT_EQ(Moves::count, 990 + 5);
+  EXPECT_EQ(vec.size(), 1005U);
+  EXPECT_EQ(vec[9].data, 9);
+  EXPECT_EQ(vec[10].data, 1);
+  EXPECT_EQ(vec[14].data, 5);
+  EXPECT_EQ(vec[15].data, 10);
+  EXPECT_EQ(vec[1004].data, 999);
+  /// хвост короче вставки
+  vec.insert_many(vec.end() - 2, 7, 8, 9, 10, 11);
+  EXPECT_EQ(vec.size(), 1010U);
+  EXPECT_EQ(vec[1002].data, 997);
+  EXPECT_EQ(vec[1003].data, 7);
+  EXPECT_EQ(vec[1007].data, 11);
+  EXPECT_EQ(vec[1008].data, 998);
+  EXPECT_EQ(vec[1009].data, 999);
+}
+
+TEST(VectorEmplaceTest, InsertManyArgumentsMayAliasElements) {
+  s21::vector<std::string> vec{"a", "b", "c"};
+  vec.insert_many(vec.begin(), vec[2], vec[1]);
+  std::vector<std::string> expected{"c", "b", "a", "b", "c"};
+  ASSERT_EQ(vec.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(vec[i], expected[i]);
+  }
+  /// с перевыделением буфера
+  vec.shrink_to_fit();
+  vec.insert_many(vec.begin() + 1, vec[4], vec[0], vec[3]);
+  expected = {"c", "c", "c", "b", "b", "a", "b", "c"};
+  ASSERT_EQ(vec.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(vec[i], expected[i]);
+  }
+}
+
+TEST(VectorEmplaceTest, InsertManyShiftsTail) {
+  s21::vector<int> vec{1, 2, 3};
+  vec.insert_many(vec.begin() + 1, 10, 20);
+  std::vector<int> expected{1, 10, 20, 2, 3};
+  ASSERT_EQ(vec.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(vec[i], expected[i]);
+  }
+}